@@ -41,6 +41,16 @@ CMR_ERROR CMRcamionStatsInit(
   CMR_CAMION_STATISTICS* stats  /**< Pointer to statistics. */
 );
 
+/**
+ * \brief Adds the statistics \p source for [Camion-signing](\ref camion) algorithm to \p target.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRcamionStatsAdd(
+  CMR_CAMION_STATISTICS* target, /**< Pointer to statistics to add to. */
+  CMR_CAMION_STATISTICS* source  /**< Pointer to statistics to be added. */
+);
+
 /**
  * \brief Prints statistics for [Camion-signing](\ref camion) algorithm.
  */
@@ -86,6 +86,10 @@ CMR_ERROR CMRctuComplementRowColumn(
  * \p pcomplementColumn != \c NULL, then \p *pcomplementRow and \p *pcomplementColumn will indicate the row and column
  * that need to be complemented for obtaining a matrix that is not [totally unimodular](\ref tu).
  * If no row/column needs to be complemented, then the respective variables are set to \c SIZE_MAX.
+ *
+ * The complemented matrices are tested by as many threads as specified via \ref CMRsetNumThreads, stopping as soon as
+ * a non-totally-unimodular one is found. The reported pair is the first one in the order in which rows (and for each
+ * row the columns) are enumerated, independent of the number of threads.
  */
 
 CMR_EXPORT
@@ -107,6 +107,28 @@ CMR_ERROR CMRfreeEnvironment(
   CMR** pcmr  /**< Pointer to \ref CMR environment. */
 );
 
+/**
+ * \brief Sets the number of threads that may be used for computations.
+ *
+ * The default is 1. If the library was compiled without thread support, then the value is stored but all
+ * computations are carried out sequentially.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRsetNumThreads(
+  CMR* cmr,       /**< \ref CMR environment. */
+  int numThreads  /**< Number of threads; must be positive. */
+);
+
+/**
+ * \brief Returns the number of threads that may be used for computations.
+ */
+
+CMR_EXPORT
+int CMRgetNumThreads(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
 /**
  * \brief Allocates block memory for *\p ptr.
  *
@@ -51,6 +51,16 @@ CMR_ERROR CMRgraphicStatsInit(
   CMR_GRAPHIC_STATISTICS* stats /**< Pointer to statistics. */
 );
 
+/**
+ * \brief Adds the statistics \p source for graphicness computations to \p target.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRgraphicStatsAdd(
+  CMR_GRAPHIC_STATISTICS* target, /**< Pointer to statistics to add to. */
+  CMR_GRAPHIC_STATISTICS* source  /**< Pointer to statistics to be added. */
+);
+
 /**
  * \brief Prints statistics for graphicness computations.
  */
@@ -49,6 +49,16 @@ CMR_ERROR CMRnetworkStatsInit(
   CMR_NETWORK_STATISTICS* stats /**< Pointer to statistics. */
 );
 
+/**
+ * \brief Adds the statistics \p source for recognition algorithm for [network matrices](\ref network) to \p target.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRnetworkStatsAdd(
+  CMR_NETWORK_STATISTICS* target, /**< Pointer to statistics to add to. */
+  CMR_NETWORK_STATISTICS* source  /**< Pointer to statistics to be added. */
+);
+
 /**
  * \brief Prints statistics for recognition algorithm for [network matrices](\ref network).
  */
@@ -123,6 +123,37 @@ CMR_ERROR CMRregularRefineDecomposition(
   double timeLimit            /**< Time limit to impose. */
 );
 
+/**
+ * \brief Tests a modified binary matrix for regularity, reusing the decomposition tree of the original matrix.
+ *
+ * The rows of \p matrix correspond to the rows of the matrix of \p previous via \p rowsToPrevious, where \c SIZE_MAX
+ * indicates an added row. Previous rows that no row maps to are considered removed. If \p rowsToPrevious is \c NULL,
+ * then the first rows are mapped to the previous rows with the same index and all others are added. The columns are
+ * mapped via \p columnsToPrevious in the same way. Changed entries are detected by comparison.
+ *
+ * Each 1-connected component of \p matrix whose rows and columns map, in the same order, to those of a child of the
+ * 1-sum node \p previous (or to those of \p previous itself) and whose entries are unchanged reuses that node's
+ * subtree by reference; see \ref CMRseymourCapture. Only the remaining components are decomposed. If \p matrix
+ * consists of a single reused component whose node has no matrix (see \ref CMR_SEYMOUR_PARAMS.lowMemory), then the
+ * new root is a copy of that node that shares its children. The previous decomposition is not modified and must still
+ * be released by the caller.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRregularUpdateDecomposition(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* previous, /**< Root of the decomposition tree of the previous matrix. */
+  CMR_CHRMAT* matrix,         /**< New matrix. */
+  size_t* rowsToPrevious,     /**< Array mapping rows of \p matrix to previous rows or \c SIZE_MAX (may be \c NULL). */
+  size_t* columnsToPrevious,  /**< Array mapping columns of \p matrix to previous columns or \c SIZE_MAX
+                               **  (may be \c NULL). */
+  bool* pisRegular,           /**< Pointer for storing whether \p matrix is regular (may be \c NULL). */
+  CMR_SEYMOUR_NODE** proot,   /**< Pointer for storing the new decomposition tree (may be \c NULL). */
+  CMR_REGULAR_PARAMS* params, /**< Parameters for the computation (may be \c NULL for defaults). */
+  CMR_REGULAR_STATS* stats,   /**< Statistics for the computation (may be \c NULL). */
+  double timeLimit            /**< Time limit to impose. */
+);
+
 #ifdef __cplusplus
 }
 #endif
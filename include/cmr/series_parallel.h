@@ -17,6 +17,65 @@ extern "C" {
 #include <cmr/matrix.h>
 #include <cmr/separation.h>
 
+/**
+ * \brief Data structures on which series-parallel reductions are carried out.
+ *
+ * \see The desired engine can be set by modifying \ref CMR_SP_PARAMS.engine.
+ */
+
+typedef enum
+{
+  CMR_SP_ENGINE_LIST = 0,
+    /**< Each nonzero is part of a doubly-linked list for its row and one for its column. */
+  CMR_SP_ENGINE_COMPACT = 1,
+    /**< Compressed row and column storage in which removed rows and columns are only marked and skipped. A row or
+     **  column is compacted once it consists mostly of removed entries. */
+} CMR_SP_ENGINE;
+
+/**
+ * \brief Data structures on which the search for a wheel-submatrix is carried out.
+ *
+ * \see The desired variant can be set by modifying \ref CMR_SP_PARAMS.wheelSearch.
+ */
+
+typedef enum
+{
+  CMR_SP_WHEEL_SEARCH_AUTO = 0,
+    /**< Use \ref CMR_SP_WHEEL_SEARCH_BITSET if the SP-reduced submatrix has at least one nonzero per 64 entries, and
+     **  \ref CMR_SP_WHEEL_SEARCH_LIST otherwise. */
+  CMR_SP_WHEEL_SEARCH_LIST = 1,
+    /**< Breadth-first searches traverse the linked lists of the rows and columns. */
+  CMR_SP_WHEEL_SEARCH_BITSET = 2,
+    /**< Breadth-first searches operate on rows and columns of the SP-reduced submatrix that are packed into 64-bit
+     **  words, which are masked with the already visited rows (resp. columns). */
+} CMR_SP_WHEEL_SEARCH;
+
+/**
+ * \brief Parameters for series-parallel recognition algorithm.
+ */
+
+typedef struct
+{
+  CMR_SP_ENGINE engine;
+  /**< \brief Data structure for carrying out the reductions; default: \ref CMR_SP_ENGINE_COMPACT.
+   **
+   ** The engines produce the same reductions. If a wheel or \f$ M_2 \f$ submatrix is searched, then the compact
+   ** engine creates the linked-list representation only for the SP-reduced submatrix. */
+  CMR_SP_WHEEL_SEARCH wheelSearch;
+  /**< \brief Data structure for the search for a wheel-submatrix; default: \ref CMR_SP_WHEEL_SEARCH_AUTO.
+   **
+   ** All variants find the same wheel-submatrix or 2-separation. */
+} CMR_SP_PARAMS;
+
+/**
+ * \brief Initializes the default parameters for series-parallel recognition.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRspParamsInit(
+  CMR_SP_PARAMS* params  /**< Pointer to parameters. */
+);
+
 /**
  * \brief Statistics for series-parallel recognition algorithm.
  */
@@ -27,10 +86,13 @@ typedef struct
   double totalTime;       /**< Total time of all invocations. */
   uint32_t reduceCount;     /**< Number of calls to reduction algorithm. */
   double reduceTime;      /**< Time of reduction algorithm calls. */
-  uint32_t wheelCount;      /**< Number of wheel matrix searches. */
-  double wheelTime;       /**< Time of wheel matrix searches. */
+  uint32_t wheelCount;      /**< Number of wheel matrix searches on linked lists. */
+  double wheelTime;       /**< Time of wheel matrix searches on linked lists. */
+  uint32_t bitsetWheelCount;  /**< Number of wheel matrix searches on bitsets. */
+  double bitsetWheelTime;   /**< Time of wheel matrix searches on bitsets. */
   uint32_t nonbinaryCount;  /**< Number of searches for \f$ M_2 \f$ matrix. */
   double nonbinaryTime;   /**< Time of searches for \f$ M_2 \f$ matrix. */
+  uint32_t compactionCount; /**< Number of row or column compactions by \ref CMR_SP_ENGINE_COMPACT. */
 } CMR_SP_STATISTICS;
 
 /**
@@ -42,6 +104,16 @@ CMR_ERROR CMRspStatsInit(
   CMR_SP_STATISTICS* stats /**< Pointer to statistics. */
 );
 
+/**
+ * \brief Adds the statistics \p source for series-parallel computations to \p target.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRspStatsAdd(
+  CMR_SP_STATISTICS* target, /**< Pointer to statistics to add to. */
+  CMR_SP_STATISTICS* source  /**< Pointer to statistics to be added. */
+);
+
 /**
  * \brief Prints statistics for series-parallel computations.
  */
@@ -76,6 +148,36 @@ char* CMRspReductionString(
                                **/
 );
 
+/**
+ * \brief Writes the series-parallel \p reductions to \p stream.
+ *
+ * The first line contains the number of reductions, followed by one line per reduction as produced by
+ * \ref CMRspReductionString. The result can be read by \ref CMRspReadReductions, e.g., in order to replay the
+ * reductions via \ref CMRspReplayBinary or \ref CMRspReplayTernary.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRspWriteReductions(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_SP_REDUCTION* reductions, /**< Series-parallel reductions. */
+  size_t numReductions,         /**< Number of series-parallel reductions. */
+  FILE* stream                  /**< Stream to write to. */
+);
+
+/**
+ * \brief Reads series-parallel reductions from \p stream in the format of \ref CMRspWriteReductions.
+ *
+ * The array \p *preductions must be freed with \ref CMRfreeBlockArray.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRspReadReductions(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  FILE* stream,                   /**< Stream to read from. */
+  CMR_SP_REDUCTION** preductions, /**< Pointer for storing the array of series-parallel reductions. */
+  size_t* pnumReductions          /**< Pointer for storing the number of series-parallel reductions. */
+);
+
 /**
  * \brief Returns \c true if the series-parallel \p reduction removes a row, i.e., is series.
  */
@@ -172,6 +274,7 @@ CMR_ERROR CMRspTestBinary(
   size_t* pnumReductions,           /**< Pointer for storing the number of SP-reductions. */
   CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a wheel-submatrix (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation (may be \c NULL for defaults). */
   CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
   double timeLimit                  /**< Time limit to impose. */
 );
@@ -200,6 +303,7 @@ CMR_ERROR CMRspTestTernary(
   size_t* pnumReductions,           /**< Pointer for storing the number of SP-reductions. */
   CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a signed wheel- or \f$ M_2 \f$-submatrix (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation (may be \c NULL for defaults). */
   CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
   double timeLimit                  /**< Time limit to impose. */
 );
@@ -235,6 +339,7 @@ CMR_ERROR CMRspDecomposeBinary(
   CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a wheel-submatrix (may be \c NULL). */
   CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation (may be \c NULL for defaults). */
   CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
   double timeLimit                  /**< Time limit to impose. */
 );
@@ -276,6 +381,70 @@ CMR_ERROR CMRspDecomposeTernary(
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a signed wheel- or \f$ M_2 \f$-submatrix (may be
                                      **  \c NULL). */
   CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation (may be \c NULL for defaults). */
+  CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
+  double timeLimit                  /**< Time limit to impose. */
+);
+
+/**
+ * \brief Replays the series-parallel reductions \p script for the binary \p matrix \f$ A \f$ and continues with
+ *        \ref CMRspDecomposeBinary.
+ *
+ * The reductions of \p script are carried out in their order as long as each one is valid for the matrix that
+ * remains after the previous ones. The number of these reductions is stored in \p *pnumReplayed, and they form the
+ * beginning of \p reductions. Afterwards, the reduction continues as in \ref CMRspDecomposeBinary, whose description
+ * also applies to the remaining parameters.
+ *
+ * This allows to reuse the reductions computed for a matrix, e.g., written by \ref CMRspWriteReductions, for a
+ * similar matrix that shares most of its rows and columns.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRspReplayBinary(
+  CMR* cmr,                         /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,               /**< Sparse char matrix. */
+  CMR_SP_REDUCTION* script,         /**< Reductions to replay (may be \c NULL if \p numScript is 0). */
+  size_t numScript,                 /**< Number of reductions to replay. */
+  size_t* pnumReplayed,             /**< Pointer for storing the number of replayed reductions (may be \c NULL). */
+  bool* pisSeriesParallel,          /**< Pointer for storing the result. */
+  CMR_SP_REDUCTION* reductions,     /**< Array for storing the SP-reductions. If not \c NULL, it must have
+                                     **  capacity at least number of rows + number of columns. */
+  size_t maxNumReductions,          /**< Maximum number of SP-reductions. Stops when this would be exceeded. */
+  size_t* pnumReductions,           /**< Pointer for storing the number of SP-reductions; stores \c SIZE_MAX if
+                                     **< \p maxNumReductions was exceeded.  */
+  CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
+  CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a wheel-submatrix (may be \c NULL). */
+  CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation (may be \c NULL for defaults). */
+  CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
+  double timeLimit                  /**< Time limit to impose. */
+);
+
+/**
+ * \brief Replays the series-parallel reductions \p script for the ternary \p matrix \f$ A \f$ and continues with
+ *        \ref CMRspDecomposeTernary.
+ *
+ * As \ref CMRspReplayBinary, except that copies must agree up to negation.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRspReplayTernary(
+  CMR* cmr,                         /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,               /**< Sparse char matrix. */
+  CMR_SP_REDUCTION* script,         /**< Reductions to replay (may be \c NULL if \p numScript is 0). */
+  size_t numScript,                 /**< Number of reductions to replay. */
+  size_t* pnumReplayed,             /**< Pointer for storing the number of replayed reductions (may be \c NULL). */
+  bool* pisSeriesParallel,          /**< Pointer for storing the result. */
+  CMR_SP_REDUCTION* reductions,     /**< Array for storing the SP-reductions. If not \c NULL, it must have
+                                     **  capacity at least number of rows + number of columns. */
+  size_t maxNumReductions,          /**< Maximum number of SP-reductions. Stops when this would be exceeded. */
+  size_t* pnumReductions,           /**< Pointer for storing the number of SP-reductions; stores \c SIZE_MAX if
+                                     **< \p maxNumReductions was exceeded.  */
+  CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
+  CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a signed wheel- or \f$ M_2 \f$-submatrix (may be
+                                     **  \c NULL). */
+  CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation (may be \c NULL for defaults). */
   CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
   double timeLimit                  /**< Time limit to impose. */
 );
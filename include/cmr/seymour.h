@@ -60,6 +60,36 @@ typedef enum
     /**< This triggers only 3-sum decompositions as defined by Truemper; \see \ref seymour_decomposition. */
 } CMR_SEYMOUR_DECOMPOSE_FLAG;
 
+/**
+ * \brief Policies for the order in which pending decomposition nodes are processed.
+ *
+ * \see The desired policy can be set by modifying \ref CMR_SEYMOUR_PARAMS.schedule.
+ **/
+
+typedef enum
+{
+  CMR_SEYMOUR_SCHEDULE_LIFO = 0,
+    /**< Process the most recently created node first (depth-first). */
+  CMR_SEYMOUR_SCHEDULE_FIFO = 1,
+    /**< Process the least recently created node first (breadth-first). */
+  CMR_SEYMOUR_SCHEDULE_SMALLEST = 2,
+    /**< Process the node with the fewest rows plus columns first. */
+  CMR_SEYMOUR_SCHEDULE_IRREGULAR = 3,
+    /**< Process nodes that are known to be neither (co)graphic nor (co)network first, followed by those for which
+     **  one of the two properties failed; within each class, smaller and then denser matrices come first. */
+} CMR_SEYMOUR_SCHEDULE;
+
+/**
+ * \brief Trace of a Seymour decomposition computation.
+ *
+ * A trace records a span for each processing step of a decomposition node in the Chrome trace event format, which
+ * can be inspected with trace viewers such as Perfetto or \c chrome://tracing.
+ *
+ * \see \ref CMRseymourTraceCreate and \ref CMR_SEYMOUR_PARAMS.trace.
+ */
+
+typedef struct _CMR_SEYMOUR_TRACE CMR_SEYMOUR_TRACE;
+
 /**
  * \brief Parameters for Seymour decomposition algorithm.
  */
@@ -114,6 +144,24 @@ typedef struct
   /**< \brief Whether to construct (co)graphs for all leaf nodes that are (co)graphic or (co)network. */
   bool constructAllGraphs;
   /**< \brief Whether to construct (co)graphs for all nodes that are (co)graphic or (co)network. */
+  CMR_SEYMOUR_SCHEDULE schedule;
+  /**< \brief Order in which pending nodes are processed; default: \ref CMR_SEYMOUR_SCHEDULE_LIFO.
+   **
+   ** With \ref stopWhenIrregular, \ref CMR_SEYMOUR_SCHEDULE_IRREGULAR or \ref CMR_SEYMOUR_SCHEDULE_SMALLEST often
+   ** detect an irregular node before large regular parts are decomposed. */
+  bool lowMemory;
+  /**< \brief Whether to free intermediate data of nodes as soon as their type is determined; default: \c false.
+   **
+   ** This concerns transposed matrices, data of the search for nested minor sequences and, for nodes with children,
+   ** (co)graphs unless \ref constructAllGraphs is set. Moreover, matrices of nodes with children are freed, except
+   ** for the root nodes of the decomposition. */
+  CMR_SP_PARAMS seriesParallelParams;
+  /**< \brief Parameters for series-parallel reductions. */
+  CMR_SEYMOUR_TRACE* trace;
+  /**< \brief Trace to which a span is written for each processing step (may be \c NULL); default: \c NULL.
+   **
+   ** Each span carries the processed node, its matrix size, the step, the change of allocated memory and the type of
+   ** the node afterwards. The steps of a decomposition are enclosed in a span for the whole computation. */
 } CMR_SEYMOUR_PARAMS;
 
 /**
@@ -127,8 +175,36 @@ CMR_ERROR CMRseymourParamsInit(
   CMR_SEYMOUR_PARAMS* params  /**< Pointer to parameters. */
 );
 
+/**
+ * \brief Creates a trace that writes Chrome trace events to \p stream.
+ *
+ * The events form a JSON array that is completed by \ref CMRseymourTraceFree. Timestamps are relative to the
+ * creation of the trace. The same trace may be used for several decompositions.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRseymourTraceCreate(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  FILE* stream,               /**< File stream to write the events to. */
+  CMR_SEYMOUR_TRACE** ptrace  /**< Pointer for storing the trace. */
+);
+
+/**
+ * \brief Completes the JSON array of the trace and frees it.
+ *
+ * The stream is flushed but not closed.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRseymourTraceFree(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_SEYMOUR_TRACE** ptrace  /**< Pointer to the trace (may be \c NULL). */
+);
+
 /**
  * \brief Statistics for Seymour decomposition algorithm.
+ *
+ * Memory consumption is only measured if the platform can report the size of heap blocks, and is 0 otherwise.
  */
 
 typedef struct
@@ -148,6 +224,9 @@ typedef struct
   uint32_t simpleThreeSeparationsCount;   /**< Number of calls to simple 3-separation search. */
   uint32_t simpleThreeSeparationsSuccess; /**< Number of simple 3-separations found. */
   double simpleThreeSeparationsTime;      /**< Time of simple 3-separation search. */
+  size_t peakBytes;                       /**< Maximum additional heap memory in bytes during a decomposition. */
+  size_t retainedBytes;                   /**< Heap memory in bytes retained by the computed decomposition trees. */
+  size_t peakStackBytes;                  /**< Maximum stack memory in bytes used during a decomposition. */
 } CMR_SEYMOUR_STATS;
 
 
@@ -160,6 +239,16 @@ CMR_ERROR CMRseymourStatsInit(
   CMR_SEYMOUR_STATS* stats /**< Pointer to statistics. */
 );
 
+/**
+ * \brief Adds the statistics \p source for Seymour decomposition computations to \p target.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRseymourStatsAdd(
+  CMR_SEYMOUR_STATS* target, /**< Pointer to statistics to add to. */
+  CMR_SEYMOUR_STATS* source  /**< Pointer to statistics to be added. */
+);
+
 /**
  * \brief Prints statistics for Seymour decomposition computations.
  */
@@ -308,6 +397,23 @@ CMR_MINOR* CMRseymourMinor(
   size_t minorIndex         /**< Index of minor. */
 );
 
+/**
+ * \brief Extracts a submatrix of the matrix of \p node with a bad determinant or a bad entry from its subtree.
+ *
+ * Searches the subtree of \p node for a node with such a violator that needs no pivots, and maps it upwards using the
+ * row and column maps of the child nodes. Mappings are only followed if the submatrix appears unchanged in the parent,
+ * i.e., violators involving pivoted rows or columns or markers of 2- or 3-sums cannot be extracted. In that case, or if
+ * no violator is known, \p *pviolator is set to \c NULL. The violator need not be minimal, but its rows and columns
+ * are sorted.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRseymourExtractViolator(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* node, /**< Seymour decomposition node. */
+  CMR_SUBMAT** pviolator  /**< Pointer for storing the violating submatrix of the matrix of \p node. */
+);
+
 /**
  * \brief Indicates graphicness/being network.
  *
@@ -622,6 +728,43 @@ CMR_EXPORT
 CMR_ERROR CMRseymourCloneSubtrees(CMR* cmr, size_t numSubtrees, CMR_SEYMOUR_NODE** subtreeRoots,
   CMR_SEYMOUR_NODE** clonedSubtrees);
 
+/**
+ * \brief Writes the Seymour decomposition tree rooted at \p node to \p stream in a compact binary format.
+ *
+ * The tree may be complete or partial, i.e., contain nodes of type \ref CMR_SEYMOUR_NODE_TYPE_UNKNOWN. All data of
+ * the nodes is written, including matrices, the mappings of rows and columns to children and parents, special rows
+ * and columns of 3-sums, minors, (co)graphs with their (co)forests, series-parallel reductions, pivots and the state
+ * of the search for a sequence of nested minors. Nodes that are referenced by several parents are written once.
+ * Integers are stored as little-endian 7-bit groups, so the result does not depend on the machine.
+ *
+ * The stream should be opened in binary mode.
+ *
+ * \see \ref CMRseymourCreateFromStream for reading it back.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRseymourWrite(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* node, /**< Root of the Seymour decomposition (sub)tree. */
+  FILE* stream            /**< File stream to write to. */
+);
+
+/**
+ * \brief Reads a Seymour decomposition tree that was written by \ref CMRseymourWrite from \p stream.
+ *
+ * The returned root must be released with \ref CMRseymourRelease. Nodes of type
+ * \ref CMR_SEYMOUR_NODE_TYPE_UNKNOWN can be decomposed further, e.g., via \ref CMRregularRefineDecomposition.
+ *
+ * Returns \ref CMR_ERROR_INPUT if the stream does not contain a valid tree. In this case, \p *proot is \c NULL.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRseymourCreateFromStream(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  FILE* stream,             /**< File stream to read from. */
+  CMR_SEYMOUR_NODE** proot  /**< Pointer for storing the root of the Seymour decomposition. */
+);
+
 /**@}*/
 
 #ifdef __cplusplus
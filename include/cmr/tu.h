@@ -31,8 +31,11 @@ typedef struct
   CMR_SEYMOUR_PARAMS seymour; /**< \brief Parameters for testing via Seymour decomposition. */
   bool ternary;               /**< \brief Whether to create a ternary Seymour decomposition tree (default: \c true). */
   bool camionFirst;           /**< \brief If \c ternary is \c false, then whether to run the Camion test first. */
-  bool naiveSubmatrix;        /**< \brief Whether to use the naive submatrix search instead of a greedy algorithm
+  bool naiveSubmatrix;        /**< \brief Whether to use the naive submatrix search instead of delta debugging
                                **         (default: \c false). */
+  size_t screeningBudget;     /**< \brief Number of elementary steps for screening for small violators, namely
+                               **         2-by-2 and 3-by-3 ones and randomly sampled cycle submatrices, before
+                               **         running \ref algorithm; 0 disables screening (default: 0). */
 } CMR_TU_PARAMS;
 
 /**
@@ -64,6 +67,10 @@ typedef struct
   uint32_t partitionRowSubsets;       /**< Number of considered row subsets in partition algorithm. */
   uint32_t partitionColumnSubsets;    /**< Number of considered column subsets in partition algorithm. */
   double partitionTime;               /**< Total time of partition algorithm. */
+
+  uint32_t screeningCount;            /**< Number of screenings for small violators. */
+  uint32_t screeningSuccess;          /**< Number of screenings that found a violator. */
+  double screeningTime;               /**< Total time of screenings. */
 } CMR_TU_STATS;
 
 /**
@@ -75,6 +82,16 @@ CMR_ERROR CMRtuStatsInit(
   CMR_TU_STATS* stats /**< Pointer to statistics. */
 );
 
+/**
+ * \brief Adds the statistics \p source for recognition of [totally unimodular](\ref tu) matrices to \p target.
+ */
+
+CMR_EXPORT
+CMR_ERROR CMRtuStatsAdd(
+  CMR_TU_STATS* target, /**< Pointer to statistics to add to. */
+  CMR_TU_STATS* source  /**< Pointer to statistics to be added. */
+);
+
 /**
  * \brief Prints statistics for recognition algorithm for [totally unimodular](\ref tu) matrices.
  */
@@ -96,6 +113,8 @@ CMR_ERROR CMRtuStatsPrint(
  *
  * If \f$ M \f$ is not totally unimodular and \p psubmatrix != \c NULL, then \p *psubmatrix will indicate a submatrix
  * of \f$ M \f$ with determinant \f$ -2 \f$ or \f$ 2 \f$.
+ *
+ * If \c params->screeningBudget is positive and screening finds a violator, then no decomposition tree is computed.
  */
 
 CMR_EXPORT
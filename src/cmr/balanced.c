@@ -504,7 +504,7 @@ CMR_ERROR balancedTestConnected(
     /* TODO: Consider 2-separations as well; to this end, use CMRdecomposeTernarySeriesParallel instead. */
 
     CMR_CALL( CMRspTestTernary(cmr, matrix, &isSeriesParallel, NULL, NULL, &reducedSubmatrix,
-      &violatorSubmatrix, stats ? &stats->seriesParallel : NULL, timeLimit) );
+      &violatorSubmatrix, NULL, stats ? &stats->seriesParallel : NULL, timeLimit) );
 
     /* Stop if the matrix is actually series-parallel. */
     if (isSeriesParallel)
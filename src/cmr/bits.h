@@ -0,0 +1,59 @@
+#ifndef CMR_BITS_INTERNAL_H
+#define CMR_BITS_INTERNAL_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Returns the index of the least significant 1-bit of \p word, which must be nonzero.
+ */
+
+static inline
+size_t CMRlowestBit(
+  uint64_t word /**< Nonzero word. */
+)
+{
+  assert(word);
+
+#if defined(__GNUC__)
+  return (size_t) __builtin_ctzll(word);
+#else
+  size_t index = 0;
+  while (!(word & 1))
+  {
+    word >>= 1;
+    ++index;
+  }
+  return index;
+#endif /* __GNUC__ */
+}
+
+/**
+ * \brief Returns the number of 1-bits of \p word.
+ */
+
+static inline
+size_t CMRcountBits(
+  uint64_t word /**< Word. */
+)
+{
+#if defined(__GNUC__)
+  return (size_t) __builtin_popcountll(word);
+#else
+  size_t count = 0;
+  for (; word; word &= word - 1)
+    ++count;
+  return count;
+#endif /* __GNUC__ */
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMR_BITS_INTERNAL_H */
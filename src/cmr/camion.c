@@ -30,6 +30,21 @@ CMR_ERROR CMRcamionStatsInit(CMR_CAMION_STATISTICS* stats)
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRcamionStatsAdd(CMR_CAMION_STATISTICS* target, CMR_CAMION_STATISTICS* source)
+{
+  assert(target);
+  assert(source);
+
+  target->generalCount += source->generalCount;
+  target->generalTime += source->generalTime;
+  target->graphCount += source->graphCount;
+  target->graphTime += source->graphTime;
+  target->totalCount += source->totalCount;
+  target->totalTime += source->totalTime;
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRcamionStatsPrint(FILE* stream, CMR_CAMION_STATISTICS* stats, const char* prefix)
 {
   assert(stream);
@@ -5,6 +5,7 @@
 #include <cmr/tu.h>
 
 #include "env_internal.h"
+#include "parallel.h"
 
 #include <assert.h>
 #include <stdint.h>
@@ -53,125 +54,279 @@ CMR_ERROR CMRstatsComplementTotalUnimodularityPrint(FILE* stream, CMR_CTU_STATIS
 }
 
 
-CMR_ERROR CMRctuComplementRowColumn(CMR* cmr, CMR_CHRMAT* matrix, size_t complementRow, size_t complementColumn,
-  CMR_CHRMAT** presult)
+/**
+ * \brief Appends a row to \p result whose support is the symmetric difference of two sorted lists of columns and
+ *        an extra column.
+ *
+ * If \p complement is \c true, then the complement of that symmetric difference is appended instead.
+ */
+
+static
+CMR_ERROR ctuAppendRow(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_CHRMAT* result,       /**< Matrix to append to; its \c numNonzeros is the number of entries so far. */
+  size_t* pmemNonzeros,     /**< Pointer to the capacity of \p result. */
+  size_t numColumns,        /**< Number of columns. */
+  size_t* first,            /**< First sorted array of columns. */
+  size_t lengthFirst,       /**< Length of \p first. */
+  size_t* second,           /**< Second sorted array of columns. */
+  size_t lengthSecond,      /**< Length of \p second. */
+  size_t extraColumn,       /**< Extra column, or \c SIZE_MAX. */
+  bool complement           /**< Whether to complement the resulting row. */
+)
 {
   assert(cmr);
-  assert(matrix);
-  assert(complementRow < matrix->numRows || complementRow == SIZE_MAX);
-  assert(complementColumn < matrix->numColumns || complementColumn == SIZE_MAX);
-  assert(presult);
-
-  /* We copy directly if no complementing is requested. */
+  assert(result);
+  assert(pmemNonzeros);
 
-  if (complementRow == SIZE_MAX && complementColumn == SIZE_MAX)
+  size_t maxLength = complement ? numColumns : lengthFirst + lengthSecond + 1;
+  if (result->numNonzeros + maxLength > *pmemNonzeros)
   {
-    CMR_CALL( CMRchrmatCopy(cmr, matrix, presult) );
-
-    return CMR_OKAY;
+    size_t newMemNonzeros = 2 * *pmemNonzeros;
+    if (newMemNonzeros < result->numNonzeros + maxLength)
+      newMemNonzeros = result->numNonzeros + maxLength;
+    CMR_CALL( CMRreallocBlockArray(cmr, &result->entryColumns, newMemNonzeros) );
+    CMR_CALL( CMRreallocBlockArray(cmr, &result->entryValues, newMemNonzeros) );
+    *pmemNonzeros = newMemNonzeros;
   }
 
-  /* Create a dense copy of the column to be complemented. */
-  signed char* complementColumnEntries = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &complementColumnEntries, matrix->numRows) );
-  if (complementColumn < SIZE_MAX)
+  size_t* entryColumns = result->entryColumns;
+  size_t numNonzeros = result->numNonzeros;
+  size_t i = 0;
+  size_t j = 0;
+  if (complement)
   {
-    for (size_t row = 0; row < matrix->numRows; ++row)
+    for (size_t column = 0; column < numColumns; ++column)
     {
-      size_t e;
-      CMR_CALL( CMRchrmatFindEntry(matrix, row, complementColumn, &e) );
-      complementColumnEntries[row] = (e == SIZE_MAX) ? 0 : 1;
+      bool inSet = (column == extraColumn);
+      if (i < lengthFirst && first[i] == column)
+      {
+        inSet = !inSet;
+        ++i;
+      }
+      if (j < lengthSecond && second[j] == column)
+      {
+        inSet = !inSet;
+        ++j;
+      }
+      if (!inSet)
+        entryColumns[numNonzeros++] = column;
     }
   }
   else
   {
-    for (size_t row = 0; row < matrix->numRows; ++row)
-      complementColumnEntries[row] = 0;
+    while (true)
+    {
+      size_t column = extraColumn;
+      if (i < lengthFirst && first[i] < column)
+        column = first[i];
+      if (j < lengthSecond && second[j] < column)
+        column = second[j];
+      if (column == SIZE_MAX)
+        break;
+
+      bool inSet = false;
+      if (column == extraColumn)
+      {
+        inSet = true;
+        extraColumn = SIZE_MAX;
+      }
+      if (i < lengthFirst && first[i] == column)
+      {
+        inSet = !inSet;
+        ++i;
+      }
+      if (j < lengthSecond && second[j] == column)
+      {
+        inSet = !inSet;
+        ++j;
+      }
+      if (inSet)
+        entryColumns[numNonzeros++] = column;
+    }
   }
+  result->numNonzeros = numNonzeros;
 
-  /* Create a dense copy of the row to be complemented. */
-  signed char* complementRowEntries = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &complementRowEntries, matrix->numColumns) );
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Fills \p result with the support of \p matrix after complementing a row and a column.
+ *
+ * Let \f$ r \f$ and \f$ c \f$ be the complemented row and column and let \f$ a = M_{r,c} \f$. Every row
+ * \f$ i \neq r \f$ is the symmetric difference of row \f$ i \f$ and row \f$ r \f$ of \f$ M \f$, which is additionally
+ * complemented except for column \f$ c \f$ if \f$ a + M_{i,c} \f$ is odd. Row \f$ r \f$ is complemented except for
+ * column \f$ c \f$ if \f$ a = 1 \f$. Hence, the running time is linear in the number of nonzeros of \p matrix and
+ * of \p result, and no dense copy is needed.
+ */
+
+static
+CMR_ERROR ctuComplementSparse(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,       /**< Input matrix. */
+  size_t complementRow,     /**< Row to be complemented (\c SIZE_MAX for no row complement). */
+  size_t complementColumn,  /**< Column to be complemented (\c SIZE_MAX for no column complement). */
+  CMR_CHRMAT* result,       /**< Matrix to be filled; must have the dimensions of \p matrix. */
+  size_t* pmemNonzeros      /**< Pointer to the capacity of \p result; updated on reallocation. */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(result);
+  assert(result->numRows == matrix->numRows);
+  assert(result->numColumns == matrix->numColumns);
+
+  size_t* complementRowColumns = NULL;
+  size_t complementRowLength = 0;
+  bool complementRowColumn1 = false;
   if (complementRow < SIZE_MAX)
   {
-    for (size_t column = 0; column < matrix->numColumns; ++column)
-      complementRowEntries[column] = 0;
-    size_t first = matrix->rowSlice[complementRow];
-    size_t beyond = matrix->rowSlice[complementRow + 1];
-    for (size_t entry = first; entry < beyond; ++entry)
-      complementRowEntries[matrix->entryColumns[entry]] = 1;
-  }
-  else
-  {
-    for (size_t column = 0; column < matrix->numColumns; ++column)
-      complementRowEntries[column] = 0;
+    complementRowColumns = &matrix->entryColumns[matrix->rowSlice[complementRow]];
+    complementRowLength = matrix->rowSlice[complementRow + 1] - matrix->rowSlice[complementRow];
+    if (complementColumn < SIZE_MAX)
+    {
+      size_t entry;
+      CMR_CALL( CMRchrmatFindEntry(matrix, complementRow, complementColumn, &entry) );
+      complementRowColumn1 = entry != SIZE_MAX;
+    }
   }
 
-  /* Indicator for entry in complementRow, complementColumn. */
-  signed char complementRowColumn1 = complementColumn < SIZE_MAX ? complementRowEntries[complementColumn] : 0;
-
-  /* Swipe over the matrix to create the complemented one. */
-  CMR_CALL( CMRchrmatCreate(cmr, presult, matrix->numRows, matrix->numColumns, 0) );
-  CMR_CHRMAT* result = *presult;
-  size_t memNonzeros = matrix->numNonzeros + 256;
-  CMR_CALL( CMRallocBlockArray(cmr, &result->entryColumns, memNonzeros) );
-  size_t resultEntry = 0;
+  result->numNonzeros = 0;
   result->rowSlice[0] = 0;
   for (size_t row = 0; row < matrix->numRows; ++row)
   {
-    size_t matrixEntry = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    size_t matrixColumn = (matrixEntry < beyond) ? matrix->entryColumns[matrixEntry] : SIZE_MAX;
-    for (size_t column = 0; column < matrix->numColumns; ++column)
+    size_t first = matrix->rowSlice[row];
+    size_t length = matrix->rowSlice[row + 1] - first;
+    if (row == complementRow)
     {
-      bool isNonzero = (column == matrixColumn);
-      if (isNonzero)
+      CMR_CALL( ctuAppendRow(cmr, result, pmemNonzeros, matrix->numColumns, &matrix->entryColumns[first], length,
+        NULL, 0, complementRowColumn1 ? complementColumn : SIZE_MAX, complementRowColumn1) );
+    }
+    else
+    {
+      bool complement = complementRowColumn1;
+      if (complementColumn < SIZE_MAX)
       {
-        ++matrixEntry;
-        matrixColumn = (matrixEntry < beyond) ? matrix->entryColumns[matrixEntry] : SIZE_MAX;
+        size_t entry;
+        CMR_CALL( CMRchrmatFindEntry(matrix, row, complementColumn, &entry) );
+        if (entry != SIZE_MAX)
+          complement = !complement;
       }
+      CMR_CALL( ctuAppendRow(cmr, result, pmemNonzeros, matrix->numColumns, &matrix->entryColumns[first], length,
+        complementRowColumns, complementRowLength, complement ? complementColumn : SIZE_MAX, complement) );
+    }
+    result->rowSlice[row + 1] = result->numNonzeros;
+  }
 
-      if (row == complementRow)
-      {
-        if (column != complementColumn && complementRowColumn1)
-          isNonzero = !isNonzero;
-      }
-      else
-      {
-        if (column == complementColumn)
-        {
-          if (complementRowColumn1)
-            isNonzero = !isNonzero;
-        }
-        else
-        {
-          if (complementRowColumn1 + complementColumnEntries[row] + complementRowEntries[column] % 2 == 1)
-            isNonzero = !isNonzero;
-        }
-      }
+  for (size_t e = 0; e < result->numNonzeros; ++e)
+    result->entryValues[e] = 1;
 
-      if (isNonzero)
-      {
-        if (resultEntry == memNonzeros)
-        {
-          memNonzeros *= 2;
-          CMR_CALL( CMRreallocBlockArray(cmr, &result->entryColumns, memNonzeros) );
-        }
-        result->entryColumns[resultEntry++] = column;
-      }
-    }
-    result->rowSlice[row + 1] = resultEntry;
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRctuComplementRowColumn(CMR* cmr, CMR_CHRMAT* matrix, size_t complementRow, size_t complementColumn,
+  CMR_CHRMAT** presult)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(complementRow < matrix->numRows || complementRow == SIZE_MAX);
+  assert(complementColumn < matrix->numColumns || complementColumn == SIZE_MAX);
+  assert(presult);
+
+  /* We copy directly if no complementing is requested. */
+
+  if (complementRow == SIZE_MAX && complementColumn == SIZE_MAX)
+  {
+    CMR_CALL( CMRchrmatCopy(cmr, matrix, presult) );
+
+    return CMR_OKAY;
   }
 
-  /* Finalize the size of entryColumns, allocate entryValues for the first time and fill the latter with 1s. */
+  size_t memNonzeros = matrix->numNonzeros + 256;
+  CMR_CALL( CMRchrmatCreate(cmr, presult, matrix->numRows, matrix->numColumns, memNonzeros) );
+  CMR_CHRMAT* result = *presult;
+  CMR_CALL( ctuComplementSparse(cmr, matrix, complementRow, complementColumn, result, &memNonzeros) );
 
-  if (resultEntry < memNonzeros)
-    CMR_CALL( CMRchrmatChangeNumNonzeros(cmr, result, resultEntry) );
-  for (size_t e = 0; e < resultEntry; ++e)
-    result->entryValues[e] = 1;
+  /* Finalize the size of the entry arrays. */
 
-  CMR_CALL( CMRfreeStackArray(cmr, &complementRowEntries) );
-  CMR_CALL( CMRfreeStackArray(cmr, &complementColumnEntries) );
+  if (result->numNonzeros < memNonzeros)
+    CMR_CALL( CMRchrmatChangeNumNonzeros(cmr, result, result->numNonzeros) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Data shared by all tasks of \ref CMRctuTest.
+ *
+ * Task \f$ t \f$ corresponds to complementing row \f$ \lfloor t / (n+1) \rfloor \f$ and column \f$ t \bmod (n+1) \f$,
+ * where index \f$ m \f$ (resp. \f$ n \f$) means that no row (resp. column) is complemented.
+ */
+
+typedef struct
+{
+  CMR* owner;                       /**< \brief \ref CMR environment that owns the buffers. */
+  CMR_CHRMAT* matrix;               /**< \brief Input matrix. */
+  CMR_CHRMAT** workerMatrices;      /**< \brief Complemented matrix buffer for each worker (created on first use). */
+  CMR** workerEnvs;                 /**< \brief Environment that allocated the buffer of each worker. */
+  size_t* workerMemNonzeros;        /**< \brief Capacity of the complemented matrix buffer for each worker. */
+  CMR_TU_STATS* workerStats;        /**< \brief TU statistics for each worker (may be \c NULL). */
+  CMR_TU_PARAMS* params;            /**< \brief Parameters for the TU tests. */
+  double startTime;                 /**< \brief Wall clock time at which the test was started. */
+  double timeLimit;                 /**< \brief Time limit to impose. */
+} CtuSearch;
+
+/**
+ * \brief Tests a single complemented matrix for total unimodularity; to be called by \ref CMRparallelFindFirst.
+ */
+
+static
+CMR_ERROR ctuTask(
+  CMR* cmr,     /**< \ref CMR environment of the worker. */
+  size_t task,  /**< Index of the complement pair. */
+  void* data,   /**< Pointer to the \ref CtuSearch. */
+  bool* pfound  /**< Pointer for storing whether the complemented matrix is not TU. */
+)
+{
+  CtuSearch* search = (CtuSearch*) data;
+  size_t worker = CMRparallelWorkerIndex(search->owner, cmr);
+  size_t numRows = search->matrix->numRows;
+  size_t numColumns = search->matrix->numColumns;
+  size_t complementRow = task / (numColumns + 1);
+  size_t complementColumn = task % (numColumns + 1);
+
+  /* The buffer is created by the worker itself such that it is always reallocated in the allocating environment. */
+  if (!search->workerMatrices[worker])
+  {
+    CMR_CALL( CMRchrmatCreate(cmr, &search->workerMatrices[worker], numRows, numColumns,
+      search->workerMemNonzeros[worker]) );
+    search->workerEnvs[worker] = cmr;
+  }
+  CMR_CHRMAT* complementedMatrix = search->workerMatrices[worker];
+  assert(search->workerEnvs[worker] == cmr);
+
+  double remainingTime = search->timeLimit - (CMRwallClock() - search->startTime);
+  if (remainingTime <= 0)
+    return CMR_ERROR_TIMEOUT;
+
+  CMR_CALL( ctuComplementSparse(cmr, search->matrix, complementRow < numRows ? complementRow : SIZE_MAX,
+    complementColumn < numColumns ? complementColumn : SIZE_MAX, complementedMatrix,
+    &search->workerMemNonzeros[worker]) );
+
+#if defined(CMR_DEBUG)
+  CMRdbgMsg(2, "Matrix after complementing r%zu and c%zu:\n", complementRow, complementColumn);
+  CMR_CALL( CMRchrmatPrintDense(cmr, complementedMatrix, stdout, '0', true) );
+#endif /* CMR_DEBUG */
+
+  bool isTU = false;
+  CMR_ERROR error = CMRtuTest(cmr, complementedMatrix, &isTU, NULL, NULL, search->params,
+    search->workerStats ? &search->workerStats[worker] : NULL, remainingTime);
+  if (error == CMR_ERROR_TIMEOUT)
+    return error;
+  CMR_CALL( error );
+
+  CMRdbgMsg(2, "-> %sTU.\n", isTU ? "IS " : "is NOT ");
+
+  *pfound = !isTU;
 
   return CMR_OKAY;
 }
@@ -191,116 +346,73 @@ CMR_ERROR CMRctuTest(CMR* cmr, CMR_CHRMAT* matrix, bool* pisComplementTotallyUni
     params = &defaultParams;
   }
 
-  CMR_ERROR error = CMR_OKAY;
   clock_t totalClock = clock();
-  
-  /* Create a dense version on the stack. */
-
   size_t numRows = matrix->numRows;
   size_t numColumns = matrix->numColumns;
-  signed char* dense = NULL;
-  size_t sizeDense = numRows * numColumns;
-  CMR_CALL( CMRallocStackArray(cmr, &dense, sizeDense) );
-  for (size_t i = 0; i < sizeDense; ++i)
-    dense[i] = 0;
-  for (size_t row = 0; row < numRows; ++row)
+
+  /* Each worker gets its own complemented matrix and statistics. The matrices are created by the workers and grow on
+   * demand. All stack memory is released at once at the end. */
+
+  CtuSearch search;
+  search.owner = cmr;
+  search.matrix = matrix;
+  search.params = &params->tu;
+  search.startTime = CMRwallClock();
+  search.timeLimit = timeLimit;
+  CMR_STACKMARK stackMark;
+  CMR_CALL( CMRstackMark(cmr, &stackMark) );
+  size_t numWorkers = CMRparallelNumWorkers(cmr);
+  search.workerMatrices = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.workerMatrices, numWorkers) );
+  search.workerMemNonzeros = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.workerMemNonzeros, numWorkers) );
+  search.workerEnvs = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.workerEnvs, numWorkers) );
+  for (size_t w = 0; w < numWorkers; ++w)
   {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    for (size_t entry = first; entry < beyond; ++entry)
-      dense[numColumns * row + matrix->entryColumns[entry]] = matrix->entryValues[entry];
+    search.workerMatrices[w] = NULL;
+    search.workerMemNonzeros[w] = 2 * matrix->numNonzeros + numRows + numColumns;
+    search.workerEnvs[w] = NULL;
   }
-
-  /* Create complemented matrices and call test for total unimodularity. */
-  CMR_CHRMAT* complementedMatrix = NULL;
-  CMR_CALL( CMRchrmatCreate(cmr, &complementedMatrix, numRows, numColumns, sizeDense) );
-  for (size_t i = 0; i < sizeDense; ++i)
-    complementedMatrix->entryValues[i] = 1;
-  *pisComplementTotallyUnimodular = true;
-  for (size_t complementRow = 0; complementRow <= numRows && *pisComplementTotallyUnimodular; ++complementRow)
+  search.workerStats = NULL;
+  if (stats)
   {
-    bool hasComplementRow = complementRow < numRows;
-    for (size_t complementColumn = 0; complementColumn <= numColumns; ++complementColumn)
-    {
-      bool hasComplementColumn = complementColumn < numColumns;
-
-      /* Indicator for entry in complementRow, complementColumn. */
-      signed char complementRowColumn1 = hasComplementRow && hasComplementColumn ?
-        dense[numColumns * complementRow + complementColumn] : 0;
-
-      /* Fill complemented matrix as a sparse char matrix. */
-      complementedMatrix->numNonzeros = 0;
-      complementedMatrix->rowSlice[0] = 0;
-      for (size_t row = 0; row < numRows; ++row)
-      {
-        for (size_t column = 0; column < numColumns; ++column)
-        {
-          bool isNonzero = dense[numColumns * row + column];
-          if (row == complementRow)
-          {
-            if (column != complementColumn && complementRowColumn1)
-              isNonzero = !isNonzero;
-          }
-          else
-          {
-            if (column == complementColumn)
-            {
-              if (complementRowColumn1)
-                isNonzero = !isNonzero;
-            }
-            else
-            {
-              if ((complementRowColumn1 + (hasComplementColumn ? dense[numColumns * row + complementColumn] : 0)
-                + (hasComplementRow ? dense[numColumns * complementRow + column] : 0)) % 2 == 1)
-              {
-                isNonzero = !isNonzero;
-              }
-            }
-          }
-
-          if (isNonzero)
-          {
-            complementedMatrix->entryColumns[complementedMatrix->numNonzeros] = column;
-            complementedMatrix->numNonzeros++;
-          }
-        }
-        complementedMatrix->rowSlice[row + 1] = complementedMatrix->numNonzeros;
-      }
-
-      double remainingTime = timeLimit - (clock() - totalClock) * 1.0 / CLOCKS_PER_SEC;
-      if (remainingTime <= 0)
-      {
-        error = CMR_ERROR_TIMEOUT;
-        goto cleanup;
-      }
-
-#if defined(CMR_DEBUG)
-      CMRdbgMsg(2, "Matrix after complementing r%zu and c%zu:\n", complementRow, complementColumn);
-      CMR_CALL( CMRchrmatPrintDense(cmr, complementedMatrix, stdout, '0', true) );
-#endif /* CMR_DEBUG */
-
-      bool isTU = false;
-      CMR_CALL( CMRtuTest(cmr, complementedMatrix, &isTU, NULL, NULL, &params->tu,
-        stats ? &stats->tu : NULL, remainingTime) );
-
-      CMRdbgMsg(2, "-> %sTU.\n", isTU ? "IS " : "is NOT ");
+    CMR_CALL( CMRallocStackArray(cmr, &search.workerStats, numWorkers) );
+    for (size_t w = 0; w < numWorkers; ++w)
+      CMR_CALL( CMRtuStatsInit(&search.workerStats[w]) );
+  }
 
-      if (!isTU)
-      {
-        if (pcomplementRow)
-          *pcomplementRow = complementRow;
-        if (pcomplementColumn)
-          *pcomplementColumn = complementColumn;
+  /* Test the complemented matrices for total unimodularity. */
 
-        *pisComplementTotallyUnimodular = false;
-        break;
-      }
+  size_t first;
+  CMR_ERROR error = CMRparallelFindFirst(cmr, (numRows + 1) * (numColumns + 1), ctuTask, &search, &first);
+  if (error == CMR_OKAY)
+  {
+    *pisComplementTotallyUnimodular = (first == SIZE_MAX);
+    if (first < SIZE_MAX)
+    {
+      size_t complementRow = first / (numColumns + 1);
+      size_t complementColumn = first % (numColumns + 1);
+      if (pcomplementRow)
+        *pcomplementRow = complementRow < numRows ? complementRow : SIZE_MAX;
+      if (pcomplementColumn)
+        *pcomplementColumn = complementColumn < numColumns ? complementColumn : SIZE_MAX;
     }
   }
+  else if (error != CMR_ERROR_TIMEOUT)
+    CMR_CALL( error );
 
-cleanup:
-  CMR_CALL( CMRchrmatFree(cmr, &complementedMatrix) );
-  CMR_CALL( CMRfreeStackArray(cmr, &dense) );
+  if (stats)
+  {
+    for (size_t w = 0; w < numWorkers; ++w)
+      CMR_CALL( CMRtuStatsAdd(&stats->tu, &search.workerStats[w]) );
+  }
+  for (size_t w = numWorkers; w > 0; --w)
+  {
+    if (search.workerMatrices[w-1])
+      CMR_CALL( CMRchrmatFree(search.workerEnvs[w-1], &search.workerMatrices[w-1]) );
+  }
+  CMR_CALL( CMRstackRelease(cmr, &stackMark, NULL) );
 
   if (stats)
   {
@@ -1,28 +1,39 @@
 // #define CMR_DEBUG /* Uncomment to debug this file. */
 
 #include "env_internal.h"
+#include "bits.h"
 #include "densematrix.h"
 
 #include <assert.h>
 #include <stdint.h>
 
-
 CMR_ERROR CMRdensebinmatrixCreate(CMR* cmr, size_t numRows, size_t numColumns, DenseBinaryMatrix** presult)
 {
   assert(cmr);
 
   CMR_CALL( CMRallocBlock(cmr, presult) );
   DenseBinaryMatrix* matrix = *presult;
-  
-  size_t size = (numRows * numColumns + (8 * sizeof(size_t)) - 1) / (8 * sizeof(size_t));
-  CMRdbgMsg(10, "Creating %zux%zu DenseBinaryMatrix using %zu blocks each of which having %zu bytes.\n", numRows,
-    numColumns, size, sizeof(size_t));
+
   matrix->numRows = numRows;
   matrix->numColumns = numColumns;
-  matrix->data = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &matrix->data, size) );
-  for (size_t i = 0; i < size; ++i)
-    matrix->data[i] = (size_t) 0;
+  matrix->numTileRows = (numRows + CMR_DENSEBINMATRIX_TILE_MASK) >> CMR_DENSEBINMATRIX_TILE_SHIFT;
+  matrix->numTileColumns = (numColumns + CMR_DENSEBINMATRIX_TILE_MASK) >> CMR_DENSEBINMATRIX_TILE_SHIFT;
+  matrix->numAllocatedTiles = 0;
+  matrix->numTransposedTiles = 0;
+  size_t numTiles = matrix->numTileRows * matrix->numTileColumns;
+  CMRdbgMsg(10, "Creating %zux%zu DenseBinaryMatrix with a directory of %zu tiles.\n", numRows, numColumns, numTiles);
+  matrix->tiles = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &matrix->tiles, numTiles > 0 ? numTiles : 1) );
+  matrix->columnTiles = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &matrix->columnTiles, numTiles > 0 ? numTiles : 1) );
+  matrix->tileNumNonzeros = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &matrix->tileNumNonzeros, numTiles > 0 ? numTiles : 1) );
+  for (size_t t = 0; t < numTiles; ++t)
+  {
+    matrix->tiles[t] = NULL;
+    matrix->columnTiles[t] = NULL;
+    matrix->tileNumNonzeros[t] = 0;
+  }
 
   return CMR_OKAY;
 }
@@ -32,11 +43,188 @@ CMR_ERROR CMRdensebinmatrixFree(CMR* cmr, DenseBinaryMatrix** pmatrix)
   assert(cmr);
   assert(pmatrix);
 
-  if (!*pmatrix)
+  DenseBinaryMatrix* matrix = *pmatrix;
+  if (!matrix)
+    return CMR_OKAY;
+
+  size_t numTiles = matrix->numTileRows * matrix->numTileColumns;
+  for (size_t t = 0; t < numTiles; ++t)
+  {
+    if (matrix->tiles[t])
+      CMR_CALL( CMRfreeBlockArray(cmr, &matrix->tiles[t]) );
+    if (matrix->columnTiles[t])
+      CMR_CALL( CMRfreeBlockArray(cmr, &matrix->columnTiles[t]) );
+  }
+  CMR_CALL( CMRfreeBlockArray(cmr, &matrix->tileNumNonzeros) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &matrix->columnTiles) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &matrix->tiles) );
+  CMR_CALL( CMRfreeBlock(cmr, pmatrix) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRdensebinmatrixAllocateTile(CMR* cmr, DenseBinaryMatrix* matrix, size_t row, size_t column)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(row < matrix->numRows);
+  assert(column < matrix->numColumns);
+
+  uint64_t** ptile = CMRdensebinmatrixTile(matrix, row, column);
+  assert(!*ptile);
+  assert(!*CMRdensebinmatrixColumnTile(matrix, row, column));
+
+  CMR_CALL( CMRallocBlockArray(cmr, ptile, CMR_DENSEBINMATRIX_TILE_SIZE) );
+  for (size_t i = 0; i < CMR_DENSEBINMATRIX_TILE_SIZE; ++i)
+    (*ptile)[i] = 0;
+  matrix->tileNumNonzeros[CMRdensebinmatrixTileIndex(matrix, row, column)] = 0;
+  matrix->numAllocatedTiles++;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRdensebinmatrixUpdateTile(CMR* cmr, DenseBinaryMatrix* matrix, size_t row, size_t column)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(row < matrix->numRows);
+  assert(column < matrix->numColumns);
+
+  uint64_t** ptile = CMRdensebinmatrixTile(matrix, row, column);
+  if (!*ptile)
     return CMR_OKAY;
 
-  CMR_CALL( CMRfreeBlockArray(cmr, &(*pmatrix)->data) );
-  CMR_CALL( CMRfreeBlockArray(cmr, pmatrix) );
+  uint64_t** pcolumnTile = CMRdensebinmatrixColumnTile(matrix, row, column);
+  size_t numNonzeros = matrix->tileNumNonzeros[CMRdensebinmatrixTileIndex(matrix, row, column)];
+  if (*pcolumnTile && numNonzeros < CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS / 2)
+  {
+    CMRdbgMsg(10, "Freeing transposed tile containing entry (%zu,%zu).\n", row, column);
+    CMR_CALL( CMRfreeBlockArray(cmr, pcolumnTile) );
+    matrix->numTransposedTiles--;
+  }
+  else if (!*pcolumnTile && numNonzeros >= CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS)
+  {
+    CMRdbgMsg(10, "Transposing tile containing entry (%zu,%zu).\n", row, column);
+    CMR_CALL( CMRallocBlockArray(cmr, pcolumnTile, CMR_DENSEBINMATRIX_TILE_SIZE) );
+    uint64_t* tile = *ptile;
+    uint64_t* columnTile = *pcolumnTile;
+    for (size_t i = 0; i < CMR_DENSEBINMATRIX_TILE_SIZE; ++i)
+      columnTile[i] = 0;
+    for (size_t i = 0; i < CMR_DENSEBINMATRIX_TILE_SIZE; ++i)
+    {
+      for (uint64_t word = tile[i]; word; word &= word - 1)
+        columnTile[CMRlowestBit(word)] |= UINT64_C(1) << i;
+    }
+    matrix->numTransposedTiles++;
+  }
+
+  if (!numNonzeros)
+  {
+    CMRdbgMsg(10, "Freeing zero tile containing entry (%zu,%zu).\n", row, column);
+    CMR_CALL( CMRfreeBlockArray(cmr, ptile) );
+    matrix->numAllocatedTiles--;
+  }
 
   return CMR_OKAY;
 }
+
+size_t CMRdensebinmatrixRowNext(DenseBinaryMatrix* matrix, size_t row, size_t column)
+{
+  assert(matrix);
+  assert(row < matrix->numRows);
+
+  if (column >= matrix->numColumns)
+    return matrix->numColumns;
+
+  uint64_t** tiles = &matrix->tiles[(row >> CMR_DENSEBINMATRIX_TILE_SHIFT) * matrix->numTileColumns];
+  size_t offset = row & CMR_DENSEBINMATRIX_TILE_MASK;
+  for (size_t tileColumn = column >> CMR_DENSEBINMATRIX_TILE_SHIFT; tileColumn < matrix->numTileColumns;
+    ++tileColumn)
+  {
+    uint64_t* tile = tiles[tileColumn];
+    if (tile)
+    {
+      uint64_t word = tile[offset];
+      if ((tileColumn << CMR_DENSEBINMATRIX_TILE_SHIFT) < column)
+        word &= ~UINT64_C(0) << (column & CMR_DENSEBINMATRIX_TILE_MASK);
+      if (word)
+        return (tileColumn << CMR_DENSEBINMATRIX_TILE_SHIFT) + CMRlowestBit(word);
+    }
+  }
+
+  return matrix->numColumns;
+}
+
+size_t CMRdensebinmatrixColumnNext(DenseBinaryMatrix* matrix, size_t row, size_t column)
+{
+  assert(matrix);
+  assert(column < matrix->numColumns);
+
+  if (row >= matrix->numRows)
+    return matrix->numRows;
+
+  for (size_t tileRow = row >> CMR_DENSEBINMATRIX_TILE_SHIFT; tileRow < matrix->numTileRows; ++tileRow)
+  {
+    uint64_t word = CMRdensebinmatrixColumnWord(matrix, tileRow, column);
+    if ((tileRow << CMR_DENSEBINMATRIX_TILE_SHIFT) < row)
+      word &= ~UINT64_C(0) << (row & CMR_DENSEBINMATRIX_TILE_MASK);
+    if (word)
+      return (tileRow << CMR_DENSEBINMATRIX_TILE_SHIFT) + CMRlowestBit(word);
+  }
+
+  return matrix->numRows;
+}
+
+CMR_ERROR CMRdensebinmatrixAddRow(CMR* cmr, DenseBinaryMatrix* matrix, size_t sourceRow, size_t targetRow)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(sourceRow < matrix->numRows);
+  assert(targetRow < matrix->numRows);
+  assert(sourceRow != targetRow);
+
+  uint64_t** sourceTiles = &matrix->tiles[(sourceRow >> CMR_DENSEBINMATRIX_TILE_SHIFT) * matrix->numTileColumns];
+  uint64_t** targetTiles = &matrix->tiles[(targetRow >> CMR_DENSEBINMATRIX_TILE_SHIFT) * matrix->numTileColumns];
+  size_t sourceOffset = sourceRow & CMR_DENSEBINMATRIX_TILE_MASK;
+  size_t targetOffset = targetRow & CMR_DENSEBINMATRIX_TILE_MASK;
+  for (size_t tileColumn = 0; tileColumn < matrix->numTileColumns; ++tileColumn)
+  {
+    uint64_t word = sourceTiles[tileColumn] ? sourceTiles[tileColumn][sourceOffset] : 0;
+    if (!word)
+      continue;
+
+    size_t firstColumn = tileColumn << CMR_DENSEBINMATRIX_TILE_SHIFT;
+    if (!targetTiles[tileColumn])
+      CMR_CALL( CMRdensebinmatrixAllocateTile(cmr, matrix, targetRow, firstColumn) );
+    uint64_t oldWord = targetTiles[tileColumn][targetOffset];
+    uint64_t newWord = oldWord ^ word;
+    targetTiles[tileColumn][targetOffset] = newWord;
+    uint16_t* pnumNonzeros = &matrix->tileNumNonzeros[CMRdensebinmatrixTileIndex(matrix, targetRow, firstColumn)];
+    *pnumNonzeros = (uint16_t) (*pnumNonzeros + CMRcountBits(newWord) - CMRcountBits(oldWord));
+
+    /* The target row's bit changes in the transposed words of exactly the columns of the source row's nonzeros. */
+    uint64_t* columnTile = *CMRdensebinmatrixColumnTile(matrix, targetRow, firstColumn);
+    if (columnTile)
+    {
+      uint64_t targetBit = UINT64_C(1) << targetOffset;
+      for (uint64_t remaining = word; remaining; remaining &= remaining - 1)
+        columnTile[CMRlowestBit(remaining)] ^= targetBit;
+    }
+
+    CMR_CALL( CMRdensebinmatrixUpdateTile(cmr, matrix, targetRow, firstColumn) );
+  }
+
+  return CMR_OKAY;
+}
+
+size_t CMRdensebinmatrixRowCount(DenseBinaryMatrix* matrix, size_t row)
+{
+  assert(matrix);
+  assert(row < matrix->numRows);
+
+  size_t count = 0;
+  for (size_t tileColumn = 0; tileColumn < matrix->numTileColumns; ++tileColumn)
+    count += CMRcountBits(CMRdensebinmatrixRowWord(matrix, row, tileColumn));
+
+  return count;
+}
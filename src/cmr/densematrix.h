@@ -5,19 +5,43 @@
 
 #include <cmr/matrix.h>
 
+#include <assert.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define CMR_DENSEBINMATRIX_TILE_SHIFT 6 /**< \brief Logarithm of the number of rows and columns of a tile. */
+#define CMR_DENSEBINMATRIX_TILE_SIZE (1 << CMR_DENSEBINMATRIX_TILE_SHIFT) /**< \brief Rows and columns per tile. */
+#define CMR_DENSEBINMATRIX_TILE_MASK (CMR_DENSEBINMATRIX_TILE_SIZE - 1) /**< \brief Index mask within a tile. */
+#define CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS (CMR_DENSEBINMATRIX_TILE_SIZE * CMR_DENSEBINMATRIX_TILE_SIZE / 16)
+  /**< \brief Tiles with at least this many nonzeros are also stored transposed. */
+
 /**
- * \brief Dense matrix.
+ * \brief Binary matrix with constant-time access to each entry.
+ *
+ * The matrix is partitioned into tiles of \ref CMR_DENSEBINMATRIX_TILE_SIZE rows and columns, each of which is
+ * stored as one 64-bit word per row. Tiles with at least \ref CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS nonzeros are
+ * additionally stored transposed, as one 64-bit word per column, such that their columns can be scanned word by word
+ * as well; the transposed copy is freed once the tile has less than half as many nonzeros. For sparse tiles, the words
+ * of columns are gathered from the rows. Only tiles that contain a nonzero are allocated and tiles that become zero are
+ * freed again, which is why the memory is proportional to the number of nonzero tiles plus directories with one
+ * pointer per tile instead of the number of entries.
  */
 
 typedef struct
 {
-  size_t* data;
-  size_t numRows;
-  size_t numColumns;
+  uint64_t** tiles;         /**< \brief Directory of tiles in row-major order; \c NULL for a zero tile. */
+  uint64_t** columnTiles;   /**< \brief Directory of transposed tiles in column-major order; \c NULL for a tile
+                             **         that is not stored transposed. */
+  uint16_t* tileNumNonzeros;/**< \brief Number of nonzeros of each tile in row-major order. */
+  size_t numTileRows;       /**< \brief Number of rows of tiles. */
+  size_t numTileColumns;    /**< \brief Number of columns of tiles. */
+  size_t numAllocatedTiles; /**< \brief Number of tiles that are not \c NULL. */
+  size_t numTransposedTiles;/**< \brief Number of transposed tiles that are not \c NULL. */
+  size_t numRows;           /**< \brief Number of rows. */
+  size_t numColumns;        /**< \brief Number of columns. */
 } DenseBinaryMatrix;
 
 CMR_ERROR CMRdensebinmatrixCreate(
@@ -32,6 +56,164 @@ CMR_ERROR CMRdensebinmatrixFree(
   DenseBinaryMatrix** pmatrix /**< Pointer for storing the result. */
 );
 
+/**
+ * \brief Allocates the zero tile that contains entry (\p row, \p column).
+ *
+ * The transposed tile is only allocated by \ref CMRdensebinmatrixUpdateTile once the tile is dense enough.
+ */
+
+CMR_ERROR CMRdensebinmatrixAllocateTile(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< Row index. */
+  size_t column               /**< Column index. */
+);
+
+/**
+ * \brief Adapts the storage of the tile that contains entry (\p row, \p column) to its number of nonzeros.
+ *
+ * A zero tile is freed. A transposed copy is created if the tile has at least
+ * \ref CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS nonzeros, and freed if it has less than half as many.
+ */
+
+CMR_ERROR CMRdensebinmatrixUpdateTile(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< Row index. */
+  size_t column               /**< Column index. */
+);
+
+/**
+ * \brief Returns the smallest column \f$ j \geq \f$ \p column with a nonzero in \p row, or the number of columns.
+ *
+ * Zero tiles are skipped in constant time.
+ */
+
+size_t CMRdensebinmatrixRowNext(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< Row index. */
+  size_t column               /**< First column to consider. */
+);
+
+/**
+ * \brief Returns the smallest row \f$ i \geq \f$ \p row with a nonzero in \p column, or the number of rows.
+ *
+ * Zero tiles are skipped in constant time and the rows of a transposed tile are scanned as a word.
+ */
+
+size_t CMRdensebinmatrixColumnNext(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< First row to consider. */
+  size_t column               /**< Column index. */
+);
+
+/**
+ * \brief Adds row \p sourceRow to row \p targetRow over GF(2).
+ *
+ * Works on whole 64-bit words of allocated tiles of \p sourceRow, allocating the corresponding tiles of \p targetRow
+ * if necessary and freeing those that become zero.
+ */
+
+CMR_ERROR CMRdensebinmatrixAddRow(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t sourceRow,           /**< Row that is added. */
+  size_t targetRow            /**< Row that is modified. */
+);
+
+/**
+ * \brief Returns the number of nonzeros in \p row.
+ */
+
+size_t CMRdensebinmatrixRowCount(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row                  /**< Row index. */
+);
+
+/**
+ * \brief Returns the entries of \p row in the columns of tile column \p tileColumn as a word.
+ *
+ * Bit \f$ j \f$ of the result is the entry in column \p tileColumn \f$ \cdot \f$
+ * \ref CMR_DENSEBINMATRIX_TILE_SIZE \f$ + j \f$.
+ */
+
+static inline
+uint64_t CMRdensebinmatrixRowWord(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< Row index. */
+  size_t tileColumn           /**< Index of the column of tiles. */
+)
+{
+  uint64_t* tile = matrix->tiles[(row >> CMR_DENSEBINMATRIX_TILE_SHIFT) * matrix->numTileColumns + tileColumn];
+  return tile ? tile[row & CMR_DENSEBINMATRIX_TILE_MASK] : 0;
+}
+
+/**
+ * \brief Returns the entries of \p column in the rows of tile row \p tileRow as a word.
+ *
+ * Bit \f$ i \f$ of the result is the entry in row \p tileRow \f$ \cdot \f$ \ref CMR_DENSEBINMATRIX_TILE_SIZE
+ * \f$ + i \f$.
+ */
+
+static inline
+uint64_t CMRdensebinmatrixColumnWord(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t tileRow,             /**< Index of the row of tiles. */
+  size_t column               /**< Column index. */
+)
+{
+  size_t tileColumn = column >> CMR_DENSEBINMATRIX_TILE_SHIFT;
+  size_t offset = column & CMR_DENSEBINMATRIX_TILE_MASK;
+  uint64_t* columnTile = matrix->columnTiles[tileColumn * matrix->numTileRows + tileRow];
+  if (columnTile)
+    return columnTile[offset];
+
+  uint64_t* tile = matrix->tiles[tileRow * matrix->numTileColumns + tileColumn];
+  if (!tile)
+    return 0;
+
+  /* Sparse tiles are not stored transposed, so we gather the bits of the column from the rows. */
+  uint64_t word = 0;
+  for (size_t i = 0; i < CMR_DENSEBINMATRIX_TILE_SIZE; ++i)
+    word |= ((tile[i] >> offset) & 1) << i;
+  return word;
+}
+
+/**
+ * \brief Returns the index of the tile that contains entry (\p row, \p column) in row-major order.
+ */
+
+static inline
+size_t CMRdensebinmatrixTileIndex(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< Row index. */
+  size_t column               /**< Column index. */
+)
+{
+  return (row >> CMR_DENSEBINMATRIX_TILE_SHIFT) * matrix->numTileColumns + (column >> CMR_DENSEBINMATRIX_TILE_SHIFT);
+}
+
+static inline
+uint64_t** CMRdensebinmatrixTile(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< Row index. */
+  size_t column               /**< Column index. */
+)
+{
+  return &matrix->tiles[CMRdensebinmatrixTileIndex(matrix, row, column)];
+}
+
+static inline
+uint64_t** CMRdensebinmatrixColumnTile(
+  DenseBinaryMatrix* matrix,  /**< Matrix. */
+  size_t row,                 /**< Row index. */
+  size_t column               /**< Column index. */
+)
+{
+  return &matrix->columnTiles[(column >> CMR_DENSEBINMATRIX_TILE_SHIFT) * matrix->numTileRows
+    + (row >> CMR_DENSEBINMATRIX_TILE_SHIFT)];
+}
+
 static inline
 bool CMRdensebinmatrixGet(
   DenseBinaryMatrix* matrix,  /**< Matrix. */
@@ -39,82 +221,98 @@ bool CMRdensebinmatrixGet(
   size_t column               /**< Column index. */
 )
 {
-  size_t index = row * matrix->numColumns + column;
-  size_t block = matrix->data[index / (8 * sizeof(size_t))];
-//   CMRdbgMsg(8, "CMRdensebinmatrixGet(%zu,%zu) uses index %zu in block %zu at %zu -> %d\n", row, column, index,
-//     index / (8 * sizeof(size_t)), (index % (8 * sizeof(size_t))),
-//     (block & (1UL << (index % (8 * sizeof(size_t))))) ? 1 : 0);
-  return block & ( ((size_t) 1) << (index % (8 * sizeof(size_t))));
+  uint64_t* tile = *CMRdensebinmatrixTile(matrix, row, column);
+  if (!tile)
+    return false;
+  return (tile[row & CMR_DENSEBINMATRIX_TILE_MASK] >> (column & CMR_DENSEBINMATRIX_TILE_MASK)) & 1;
 }
 
 static inline
-void CMRdensebinmatrixSet0(
+CMR_ERROR CMRdensebinmatrixSet0(
+  CMR* cmr,                   /**< \ref CMR environment. */
   DenseBinaryMatrix* matrix,  /**< Matrix. */
   size_t row,                 /**< Row index. */
   size_t column               /**< Column index. */
 )
 {
-  size_t index = row * matrix->numColumns + column;
-//   CMRdbgMsg(8, "CMRdensebinmatrixSet0(%zu,%zu) uses index %zu in block %zu at %zu.\n", row, column, index,
-//     index / (8 * sizeof(size_t)), (index % (8 * sizeof(size_t))));
-  size_t* pblock = &matrix->data[index / (8 * sizeof(size_t))];
-  *pblock &= ~( ((size_t) 1) << (index % (8 * sizeof(size_t))));
+  uint64_t* tile = *CMRdensebinmatrixTile(matrix, row, column);
+  uint64_t bit = UINT64_C(1) << (column & CMR_DENSEBINMATRIX_TILE_MASK);
+  if (!tile || !(tile[row & CMR_DENSEBINMATRIX_TILE_MASK] & bit))
+    return CMR_OKAY;
+
+  tile[row & CMR_DENSEBINMATRIX_TILE_MASK] &= ~bit;
+  uint64_t* columnTile = *CMRdensebinmatrixColumnTile(matrix, row, column);
+  if (columnTile)
+    columnTile[column & CMR_DENSEBINMATRIX_TILE_MASK] &= ~(UINT64_C(1) << (row & CMR_DENSEBINMATRIX_TILE_MASK));
+  size_t numNonzeros = --matrix->tileNumNonzeros[CMRdensebinmatrixTileIndex(matrix, row, column)];
+  if (!numNonzeros || (columnTile && numNonzeros < CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS / 2))
+    CMR_CALL( CMRdensebinmatrixUpdateTile(cmr, matrix, row, column) );
+
+  return CMR_OKAY;
 }
 
 static inline
-void CMRdensebinmatrixSet1(
+CMR_ERROR CMRdensebinmatrixSet1(
+  CMR* cmr,                   /**< \ref CMR environment. */
   DenseBinaryMatrix* matrix,  /**< Matrix. */
   size_t row,                 /**< Row index. */
   size_t column               /**< Column index. */
 )
 {
-  size_t index = row * matrix->numColumns + column;
-//   CMRdbgMsg(8, "CMRdensebinmatrixSet1(%zu,%zu) uses index %zu in block %zu at %zu.\n", row, column, index,
-//     index / (8 * sizeof(size_t)), (index % (8 * sizeof(size_t))));
-  size_t* pblock = &matrix->data[index / (8 * sizeof(size_t))];
-  *pblock |= ( ((size_t) 1) << (index % (8 * sizeof(size_t))));
+  uint64_t** ptile = CMRdensebinmatrixTile(matrix, row, column);
+  if (!*ptile)
+    CMR_CALL( CMRdensebinmatrixAllocateTile(cmr, matrix, row, column) );
+  uint64_t bit = UINT64_C(1) << (column & CMR_DENSEBINMATRIX_TILE_MASK);
+  if ((*ptile)[row & CMR_DENSEBINMATRIX_TILE_MASK] & bit)
+    return CMR_OKAY;
+
+  (*ptile)[row & CMR_DENSEBINMATRIX_TILE_MASK] |= bit;
+  uint64_t* columnTile = *CMRdensebinmatrixColumnTile(matrix, row, column);
+  if (columnTile)
+    columnTile[column & CMR_DENSEBINMATRIX_TILE_MASK] |= UINT64_C(1) << (row & CMR_DENSEBINMATRIX_TILE_MASK);
+  size_t numNonzeros = ++matrix->tileNumNonzeros[CMRdensebinmatrixTileIndex(matrix, row, column)];
+  if (!columnTile && numNonzeros >= CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS)
+    CMR_CALL( CMRdensebinmatrixUpdateTile(cmr, matrix, row, column) );
+
+  return CMR_OKAY;
 }
 
 static inline
-void CMRdensebinmatrixSet(
+CMR_ERROR CMRdensebinmatrixSet(
+  CMR* cmr,                   /**< \ref CMR environment. */
   DenseBinaryMatrix* matrix,  /**< Matrix. */
   size_t row,                 /**< Row index. */
   size_t column,              /**< Column index. */
   bool value                  /**< Value. */
 )
 {
-  size_t index = row * matrix->numColumns + column;
-  CMRdbgMsg(8, "CMRdensebinmatrixSet(%zu,%zu,%d) uses index %zu in block %zu at %zu.\n", row, column, value ? 1 : 0, index,
-    index / (8 * sizeof(size_t)), (index % (8 * sizeof(size_t))));
-  size_t* pblock = &matrix->data[index / (8 * sizeof(size_t))];
-  size_t mask = ( ((size_t) 1) << (index % (8 * sizeof(size_t))));
+  CMRdbgMsg(8, "CMRdensebinmatrixSet(%zu,%zu,%d).\n", row, column, value ? 1 : 0);
   if (value)
-    *pblock |= mask;
+    CMR_CALL( CMRdensebinmatrixSet1(cmr, matrix, row, column) );
   else
-    *pblock &= ~mask;
-}
+    CMR_CALL( CMRdensebinmatrixSet0(cmr, matrix, row, column) );
 
+  return CMR_OKAY;
+}
 
 static inline
-void CMRdensebinmatrixFlip(
+CMR_ERROR CMRdensebinmatrixFlip(
+  CMR* cmr,                   /**< \ref CMR environment. */
   DenseBinaryMatrix* matrix,  /**< Matrix. */
   size_t row,                 /**< Row index. */
   size_t column               /**< Column index. */
 )
 {
-  size_t index = row * matrix->numColumns + column;
-//   CMRdbgMsg(8, "CMRdensebinmatrixFlip(%zu,%zu) uses index %zu in block %zu at %zu.\n", row, column, index,
-//     index / (8 * sizeof(size_t)), (index % (8 * sizeof(size_t))));
-  size_t* pblock = &matrix->data[index / (8 * sizeof(size_t))];
-  size_t mask = ( ((size_t) 1) << (index % (8 * sizeof(size_t))));
-  if (*pblock & mask)
-    *pblock &= ~mask;
+  if (CMRdensebinmatrixGet(matrix, row, column))
+    CMR_CALL( CMRdensebinmatrixSet0(cmr, matrix, row, column) );
   else
-    *pblock |= mask;
+    CMR_CALL( CMRdensebinmatrixSet1(cmr, matrix, row, column) );
+
+  return CMR_OKAY;
 }
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* CMR_LISTMATRIX_INTERNAL_H */
+#endif /* CMR_DENSEMATRIX_INTERNAL_H */
@@ -9,9 +9,24 @@
 #include <limits.h>
 #include <stdarg.h>
 #include <string.h>
+#include <time.h>
+
+#if defined(CMR_WITH_MALLOC_USABLE_SIZE)
+#include <malloc.h>
+#define BLOCK_SIZE(ptr) malloc_usable_size(ptr)
+#elif defined(CMR_WITH_MALLOC_SIZE)
+#include <malloc/malloc.h>
+#define BLOCK_SIZE(ptr) malloc_size(ptr)
+#else
+#define BLOCK_SIZE(ptr) ((size_t) 0)
+#endif
 
 static const size_t FIRST_STACK_SIZE = 4096L; /**< Size of the first stack. */
 static const int INITIAL_MEM_STACKS = 16;     /**< Initial number of allocated stacks. */
+static const size_t FIRST_SLAB_BLOCK_SIZE = 65536L; /**< Size of the first block of the slab pool. */
+static const size_t SLAB_BLOCK_SIZE = 1048576L;     /**< Default size of further blocks of the slab pool. */
+static const size_t LARGE_SLAB_SIZE = 1048576L;     /**< Slabs of at least this size are separate blocks. */
+static const size_t MIN_SLAB_CLASS = 6;             /**< Size class of the smallest slabs (64 bytes). */
 
 #if !defined(NDEBUG) && !defined(REPLACE_STACK_BY_MALLOC)
 static const int PROTECTION = INT_MIN / 42;   /**< Protection bytes to detect corruption. */
@@ -32,6 +47,20 @@ CMR_ERROR CMRcreateEnvironment(CMR** pcmr)
   cmr->closeOutput = false;
   cmr->numThreads = 1;
   cmr->verbosity = 1;
+  cmr->workerIndex = 0;
+  cmr->numWorkers = 0;
+  cmr->workers = NULL;
+  cmr->workersBusy = false;
+  cmr->blockMemory = 0;
+  cmr->peakBlockMemory = 0;
+
+  /* Initialize slab memory. */
+  cmr->slabPool.firstBlock = NULL;
+  cmr->slabPool.currentBlock = NULL;
+  cmr->slabPool.currentUsed = 0;
+  for (size_t c = 0; c < CMR_SLAB_NUM_CLASSES; ++c)
+    cmr->slabPool.freeSlabs[c] = NULL;
+  cmr->slabPool.numUsedSlabs = 0;
 
   /* Initialize stack memory. */
   cmr->stacks = malloc(INITIAL_MEM_STACKS * sizeof(CMR_STACK));
@@ -53,6 +82,9 @@ CMR_ERROR CMRcreateEnvironment(CMR** pcmr)
   cmr->memStacks = INITIAL_MEM_STACKS;
   cmr->numStacks = 1;
   cmr->currentStack = 0;
+  cmr->stackUsage = 0;
+  cmr->peakStackUsage = 0;
+  cmr->lastMallocChunk = NULL;
 
   return CMR_OKAY;
 }
@@ -70,6 +102,26 @@ CMR_ERROR CMRfreeEnvironment(CMR** pcmr)
   if (cmr->closeOutput)
     fclose(cmr->output);
 
+  for (size_t w = 1; w < cmr->numWorkers; ++w)
+  {
+    if (cmr->workers[w])
+      CMR_CALL( CMRfreeEnvironment(&cmr->workers[w]) );
+  }
+  free(cmr->workers);
+
+  assert(cmr->slabPool.numUsedSlabs == 0);
+  for (CMR_SLABBLOCK* block = cmr->slabPool.firstBlock; block; )
+  {
+    CMR_SLABBLOCK* next = block->next;
+    free(block);
+    block = next;
+  }
+
+#if defined(REPLACE_STACK_BY_MALLOC)
+  /* Free the chunks that were not freed yet by releasing everything since the creation. */
+  CMR_STACKMARK initialMark = { 0, 0, 0, 0 };
+  CMR_CALL( CMRstackRelease(cmr, &initialMark, NULL) );
+#endif /* REPLACE_STACK_BY_MALLOC */
   for (size_t s = 0; s < cmr->numStacks; ++s)
     free(cmr->stacks[s].memory);
   free(cmr->stacks);
@@ -79,26 +131,82 @@ CMR_ERROR CMRfreeEnvironment(CMR** pcmr)
   return CMR_OKAY;
 }
 
-CMR_ERROR _CMRallocBlock(CMR* cmr, void** ptr, size_t size)
+CMR_ERROR CMRsetNumThreads(CMR* cmr, int numThreads)
 {
-  CMR_UNUSED(cmr);
+  assert(cmr);
+
+  if (numThreads < 1)
+    return CMR_ERROR_PARAMS;
+
+  cmr->numThreads = numThreads;
+
+  return CMR_OKAY;
+}
+
+int CMRgetNumThreads(CMR* cmr)
+{
+  assert(cmr);
+
+  return cmr->numThreads;
+}
+
+/**
+ * \brief Accounts for the allocation of the block \p ptr.
+ */
+
+static
+void countBlockAllocation(
+  CMR* cmr, /**< \ref CMR environment. */
+  void* ptr /**< Allocated block (may be \c NULL). */
+)
+{
+  if (!ptr)
+    return;
+
+  cmr->blockMemory += BLOCK_SIZE(ptr);
+  if (cmr->blockMemory > cmr->peakBlockMemory)
+    cmr->peakBlockMemory = cmr->blockMemory;
+}
 
+/**
+ * \brief Accounts for the deallocation of the block \p ptr.
+ *
+ * Blocks must be freed and reallocated by the environment that allocated them.
+ */
+
+static
+void countBlockDeallocation(
+  CMR* cmr, /**< \ref CMR environment. */
+  void* ptr /**< Block to be freed (may be \c NULL). */
+)
+{
+  if (!ptr)
+    return;
+
+  size_t size = BLOCK_SIZE(ptr);
+  assert(size <= cmr->blockMemory);
+  cmr->blockMemory -= size;
+}
+
+CMR_ERROR _CMRallocBlock(CMR* cmr, void** ptr, size_t size)
+{
   assert(cmr);
   assert(ptr);
   assert(*ptr == NULL);
   *ptr = malloc(size);
+  countBlockAllocation(cmr, *ptr);
 
   return *ptr ? CMR_OKAY : CMR_ERROR_MEMORY;
 }
 
 CMR_ERROR _CMRfreeBlock(CMR* cmr, void** ptr, size_t size)
 {
-  CMR_UNUSED(cmr);
   CMR_UNUSED(size);
 
   assert(cmr);
   assert(ptr);
   assert(*ptr);
+  countBlockDeallocation(cmr, *ptr);
   free(*ptr);
   *ptr = NULL;
 
@@ -107,12 +215,11 @@ CMR_ERROR _CMRfreeBlock(CMR* cmr, void** ptr, size_t size)
 
 CMR_ERROR _CMRallocBlockArray(CMR* cmr, void** ptr, size_t size, size_t length)
 {
-  CMR_UNUSED(cmr);
-
   assert(cmr);
   assert(ptr);
   assert(*ptr == NULL);
   *ptr = malloc(size * length);
+  countBlockAllocation(cmr, *ptr);
 
   return *ptr ? CMR_OKAY : CMR_ERROR_MEMORY;
 }
@@ -120,11 +227,11 @@ CMR_ERROR _CMRallocBlockArray(CMR* cmr, void** ptr, size_t size, size_t length)
 
 CMR_ERROR _CMRreallocBlockArray(CMR* cmr, void** ptr, size_t size, size_t length)
 {
-  CMR_UNUSED(cmr);
-
   assert(cmr);
   assert(ptr);
+  countBlockDeallocation(cmr, *ptr);
   *ptr = realloc(*ptr, size * length);
+  countBlockAllocation(cmr, *ptr);
 
   return *ptr ? CMR_OKAY : CMR_ERROR_MEMORY;
 }
@@ -144,19 +251,176 @@ CMR_ERROR _CMRduplicateBlockArray(CMR* cmr, void** ptr, size_t size, size_t leng
 }
 
 CMR_ERROR _CMRfreeBlockArray(CMR* cmr, void** ptr)
+{
+  assert(cmr);
+  assert(ptr);
+  countBlockDeallocation(cmr, *ptr);
+  free(*ptr);
+  *ptr = NULL;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Header in front of each slab.
+ */
+
+typedef struct
+{
+  CMR* owner;       /**< \brief Environment whose pool the slab belongs to. */
+  size_t sizeClass; /**< \brief Size class of the slab. */
+} SlabHeader;
+
+CMR_ERROR _CMRallocSlab(CMR* cmr, void** ptr, size_t size)
+{
+  assert(cmr);
+  assert(ptr);
+  assert(*ptr == NULL);
+
+  CMR_SLABPOOL* pool = &cmr->slabPool;
+  if (size + sizeof(SlabHeader) >= LARGE_SLAB_SIZE)
+  {
+    /* Large slabs are allocated with their exact size and bypass the pool, such that they are neither rounded to a
+     * size class nor keep the pool from being rewound. */
+    SlabHeader* header = NULL;
+    CMR_CALL( _CMRallocBlock(cmr, (void**) &header, size + sizeof(SlabHeader)) );
+    header->owner = cmr;
+    header->sizeClass = CMR_SLAB_NUM_CLASSES;
+    *ptr = header + 1;
+    return CMR_OKAY;
+  }
+
+  size_t sizeClass = MIN_SLAB_CLASS;
+  while (((size_t) 1 << sizeClass) < size + sizeof(SlabHeader))
+    ++sizeClass;
+  assert(sizeClass < CMR_SLAB_NUM_CLASSES);
+
+  SlabHeader* header = pool->freeSlabs[sizeClass];
+  if (header)
+    pool->freeSlabs[sizeClass] = *((void**) (header + 1));
+  else
+  {
+    /* Carve the slab from the first block (starting at the current one) that has enough space left. */
+    size_t slabSize = (size_t) 1 << sizeClass;
+    while (!pool->currentBlock || pool->currentUsed + slabSize > pool->currentBlock->size)
+    {
+      if (pool->currentBlock && pool->currentBlock->next)
+      {
+        pool->currentBlock = pool->currentBlock->next;
+        pool->currentUsed = sizeof(CMR_SLABBLOCK);
+        continue;
+      }
+
+      /* Append a new block to the chain. Like the first stack, the first block is kept for the lifetime of the
+       * environment and hence not counted as block memory. All further blocks are freed when the pool is rewound. */
+      CMR_SLABBLOCK* block = NULL;
+      size_t blockSize = FIRST_SLAB_BLOCK_SIZE;
+      if (pool->currentBlock)
+      {
+        blockSize = SLAB_BLOCK_SIZE;
+        if (blockSize < slabSize + sizeof(CMR_SLABBLOCK))
+          blockSize = slabSize + sizeof(CMR_SLABBLOCK);
+        CMR_CALL( _CMRallocBlock(cmr, (void**) &block, blockSize) );
+      }
+      else
+      {
+        block = malloc(blockSize);
+        if (!block)
+          return CMR_ERROR_MEMORY;
+      }
+      block->next = NULL;
+      block->size = blockSize;
+      if (pool->currentBlock)
+        pool->currentBlock->next = block;
+      else
+        pool->firstBlock = block;
+      pool->currentBlock = block;
+      pool->currentUsed = sizeof(CMR_SLABBLOCK);
+    }
+    header = (SlabHeader*) ((char*) pool->currentBlock + pool->currentUsed);
+    pool->currentUsed += slabSize;
+  }
+
+  header->owner = cmr;
+  header->sizeClass = sizeClass;
+  pool->numUsedSlabs++;
+  *ptr = header + 1;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR _CMRfreeSlab(CMR* cmr, void** ptr)
 {
   CMR_UNUSED(cmr);
 
   assert(cmr);
   assert(ptr);
-  free(*ptr);
+
+  if (!*ptr)
+    return CMR_OKAY;
+
+  SlabHeader* header = ((SlabHeader*) *ptr) - 1;
+  CMR* owner = header->owner;
+  if (header->sizeClass == CMR_SLAB_NUM_CLASSES)
+  {
+    CMR_CALL( _CMRfreeBlock(owner, (void**) &header, 0) );
+    *ptr = NULL;
+    return CMR_OKAY;
+  }
+
+  CMR_SLABPOOL* pool = &owner->slabPool;
+  assert(pool->numUsedSlabs > 0);
+  pool->numUsedSlabs--;
+  if (pool->numUsedSlabs == 0)
+  {
+    /* No slab is in use anymore, so we rewind the whole pool and free all blocks but the first. */
+    for (size_t c = 0; c < CMR_SLAB_NUM_CLASSES; ++c)
+      pool->freeSlabs[c] = NULL;
+    while (pool->firstBlock->next)
+    {
+      CMR_SLABBLOCK* block = pool->firstBlock->next;
+      pool->firstBlock->next = block->next;
+      CMR_CALL( _CMRfreeBlock(owner, (void**) &block, block->size) );
+    }
+    pool->currentBlock = pool->firstBlock;
+    pool->currentUsed = sizeof(CMR_SLABBLOCK);
+  }
+  else
+  {
+    *((void**) *ptr) = pool->freeSlabs[header->sizeClass];
+    pool->freeSlabs[header->sizeClass] = header;
+  }
   *ptr = NULL;
 
   return CMR_OKAY;
 }
 
+double CMRwallClock(void)
+{
+#if defined(CMR_WITH_CLOCK_GETTIME)
+  struct timespec now;
+  if (!clock_gettime(CLOCK_MONOTONIC, &now))
+    return now.tv_sec + now.tv_nsec * 1.0e-9;
+#endif /* CMR_WITH_CLOCK_GETTIME */
+
+  return clock() * 1.0 / CLOCKS_PER_SEC;
+}
+
 #if defined(REPLACE_STACK_BY_MALLOC)
 
+/**
+ * \brief Header of a chunk of stack memory that was allocated by malloc.
+ *
+ * The chunks form a list from the most recently allocated one, which allows \ref CMRstackRelease to free all chunks
+ * allocated after a mark.
+ */
+
+typedef struct _CMR_MALLOCCHUNK
+{
+  struct _CMR_MALLOCCHUNK* previous;  /**< \brief Previously allocated chunk or \c NULL. */
+  size_t size;                        /**< \brief Number of bytes of the chunk, including this header. */
+} CMR_MALLOCCHUNK;
+
 CMR_ERROR _CMRallocStack(
   CMR* cmr,
   void** ptr,
@@ -170,9 +434,21 @@ CMR_ERROR _CMRallocStack(
   if (size < 4)
     size = 4;
 
-  *ptr = malloc(size);
+  size_t requiredSpace = size + sizeof(CMR_MALLOCCHUNK);
+  CMR_MALLOCCHUNK* chunk = malloc(requiredSpace);
+  if (!chunk)
+    return CMR_ERROR_MEMORY;
 
-  return *ptr ? CMR_OKAY : CMR_ERROR_MEMORY;
+  chunk->previous = cmr->lastMallocChunk;
+  chunk->size = requiredSpace;
+  cmr->lastMallocChunk = chunk;
+  *ptr = chunk + 1;
+
+  cmr->stackUsage += requiredSpace;
+  if (cmr->stackUsage > cmr->peakStackUsage)
+    cmr->peakStackUsage = cmr->stackUsage;
+
+  return CMR_OKAY;
 }
 
 CMR_ERROR _CMRfreeStack(
@@ -184,7 +460,20 @@ CMR_ERROR _CMRfreeStack(
   assert(ptr);
   assert(*ptr);
 
-  free(*ptr);
+  /* Chunks are usually freed in reverse order of allocation, which makes the search cheap. */
+  CMR_MALLOCCHUNK* chunk = ((CMR_MALLOCCHUNK*) *ptr) - 1;
+  CMR_MALLOCCHUNK** plink = (CMR_MALLOCCHUNK**) &cmr->lastMallocChunk;
+  while (*plink != chunk)
+  {
+    assert(*plink);
+    plink = &(*plink)->previous;
+  }
+  *plink = chunk->previous;
+
+  assert(cmr->stackUsage >= chunk->size);
+  cmr->stackUsage -= chunk->size;
+  free(chunk);
+  *ptr = NULL;
 
   return CMR_OKAY;
 }
@@ -196,9 +485,48 @@ void CMRassertStackConsistency(CMR* cmr)
 
 size_t CMRgetStackUsage(CMR* cmr)
 {
-  CMR_UNUSED(cmr);
+  assert(cmr);
+
+  return cmr->stackUsage;
+}
+
+CMR_ERROR CMRstackMark(CMR* cmr, CMR_STACKMARK* pmark)
+{
+  assert(cmr);
+  assert(pmark);
+
+  pmark->stack = 0;
+  pmark->top = 0;
+  pmark->usage = cmr->stackUsage;
+  pmark->outerPeak = cmr->peakStackUsage;
+  cmr->peakStackUsage = cmr->stackUsage;
+
+  return CMR_OKAY;
+}
 
-  return 0;
+CMR_ERROR CMRstackRelease(CMR* cmr, CMR_STACKMARK* mark, size_t* ppeakUsage)
+{
+  assert(cmr);
+  assert(mark);
+  assert(mark->usage <= cmr->stackUsage);
+
+  /* The chunks allocated after the mark are exactly the most recent ones. */
+  while (cmr->stackUsage > mark->usage)
+  {
+    CMR_MALLOCCHUNK* chunk = cmr->lastMallocChunk;
+    assert(chunk);
+    cmr->lastMallocChunk = chunk->previous;
+    cmr->stackUsage -= chunk->size;
+    free(chunk);
+  }
+  assert(cmr->stackUsage == mark->usage);
+
+  if (ppeakUsage)
+    *ppeakUsage = cmr->peakStackUsage - mark->usage;
+  if (mark->outerPeak > cmr->peakStackUsage)
+    cmr->peakStackUsage = mark->outerPeak;
+
+  return CMR_OKAY;
 }
 
 #else
@@ -258,8 +586,11 @@ CMR_ERROR _CMRallocStack(
       cmr->stacks[cmr->numStacks].memory = malloc(cmr->stacks[cmr->numStacks].top * sizeof(char));
       ++cmr->numStacks;
     }
-
-    assert(cmr->stacks[cmr->currentStack].top == (FIRST_STACK_SIZE << cmr->currentStack));
+    else
+    {
+      /* The stack may still contain chunks that were released via CMRstackRelease. */
+      cmr->stacks[cmr->currentStack].top = FIRST_STACK_SIZE << cmr->currentStack;
+    }
   }
 
   /* The chunk fits into the last stack. */
@@ -274,6 +605,10 @@ CMR_ERROR _CMRallocStack(
   pstack->top -= sizeof(void*);
   *((size_t*) &pstack->memory[pstack->top]) = size;
 
+  cmr->stackUsage += requiredSpace;
+  if (cmr->stackUsage > cmr->peakStackUsage)
+    cmr->peakStackUsage = cmr->stackUsage;
+
 #if defined(DEBUG_STACK)
   printf("Writing size %ld to %p.\n", size, &pstack->memory[pstack->top]);
 #endif /* DEBUG_STACK */
@@ -319,10 +654,13 @@ CMR_ERROR _CMRfreeStack(CMR* cmr, void** ptr)
   }
 #endif /* !NDEBUG */
 
-  stack->top += size + sizeof(void*);
+  size_t chunkSpace = size + sizeof(void*);
 #if !defined(NDEBUG)
-  stack->top += sizeof(int);
+  chunkSpace += sizeof(int);
 #endif /* !NDEBUG */
+  stack->top += chunkSpace;
+  assert(cmr->stackUsage >= chunkSpace);
+  cmr->stackUsage -= chunkSpace;
 
   while (stack->top == (FIRST_STACK_SIZE << cmr->currentStack) && cmr->currentStack > 0)
   {
@@ -334,6 +672,40 @@ CMR_ERROR _CMRfreeStack(CMR* cmr, void** ptr)
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRstackMark(CMR* cmr, CMR_STACKMARK* pmark)
+{
+  assert(cmr);
+  assert(pmark);
+
+  pmark->stack = cmr->currentStack;
+  pmark->top = cmr->stacks[cmr->currentStack].top;
+  pmark->usage = cmr->stackUsage;
+  pmark->outerPeak = cmr->peakStackUsage;
+  cmr->peakStackUsage = cmr->stackUsage;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRstackRelease(CMR* cmr, CMR_STACKMARK* mark, size_t* ppeakUsage)
+{
+  assert(cmr);
+  assert(mark);
+  assert(mark->stack <= cmr->currentStack);
+  assert(mark->usage <= cmr->stackUsage);
+
+  /* Stacks above the marked one are reset when they are used again. */
+  cmr->currentStack = mark->stack;
+  cmr->stacks[mark->stack].top = mark->top;
+  cmr->stackUsage = mark->usage;
+
+  if (ppeakUsage)
+    *ppeakUsage = cmr->peakStackUsage - mark->usage;
+  if (mark->outerPeak > cmr->peakStackUsage)
+    cmr->peakStackUsage = mark->outerPeak;
+
+  return CMR_OKAY;
+}
+
 #if !defined(NDEBUG)
 
 void CMRassertStackConsistency(
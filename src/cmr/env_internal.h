@@ -7,6 +7,10 @@
 
 #include <cmr/env.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #if defined(CMR_DEBUG)
 
 static inline
@@ -41,6 +45,48 @@ typedef struct
   size_t top;   /**< \brief First used byte. */
 } CMR_STACK;
 
+/**
+ * \brief Mark of the stack memory created by \ref CMRstackMark.
+ */
+
+typedef struct
+{
+  size_t stack;     /**< \brief Index of the current stack at the time of marking. */
+  size_t top;       /**< \brief First used byte of that stack at the time of marking. */
+  size_t usage;     /**< \brief Stack usage at the time of marking. */
+  size_t outerPeak; /**< \brief Peak stack usage before marking, which is restored on release. */
+} CMR_STACKMARK;
+
+#define CMR_SLAB_NUM_CLASSES 48 /**< \brief Number of size classes of slabs; class \c k has \f$ 2^k \f$ bytes. */
+
+/**
+ * \brief Block of raw memory from which slabs are carved.
+ */
+
+typedef struct _CMR_SLABBLOCK
+{
+  struct _CMR_SLABBLOCK* next;  /**< \brief Next block or \c NULL. */
+  size_t size;                  /**< \brief Number of bytes of the block, including this header. */
+} CMR_SLABBLOCK;
+
+/**
+ * \brief Pool of slabs.
+ *
+ * Slabs are carved from a chain of blocks that never move. Freed slabs are kept in a free list per size class. As soon
+ * as no slab is in use anymore, the whole pool is rewound and all blocks but the first one are freed. Slabs of at least
+ * 1 MB are allocated as separate blocks of exact size instead; they are neither counted in \ref numUsedSlabs nor
+ * carved from the chain.
+ */
+
+typedef struct
+{
+  CMR_SLABBLOCK* firstBlock;              /**< \brief First block of raw memory. */
+  CMR_SLABBLOCK* currentBlock;            /**< \brief Block from which new slabs are carved. */
+  size_t currentUsed;                     /**< \brief Number of used bytes of \ref currentBlock. */
+  void* freeSlabs[CMR_SLAB_NUM_CLASSES];  /**< \brief Free list of slabs per size class. */
+  size_t numUsedSlabs;                    /**< \brief Number of slabs currently in use. */
+} CMR_SLABPOOL;
+
 struct CMR_ENVIRONMENT
 {
   char* errorMessage;   /**< \brief Error message. */
@@ -54,6 +100,20 @@ struct CMR_ENVIRONMENT
   size_t memStacks;     /**< \brief Memory for stack array. */
   size_t currentStack;  /**< \brief Index of last used stack. */
   CMR_STACK* stacks;     /**< \brief Array of stacks. */
+
+  size_t stackUsage;      /**< \brief Number of bytes of all allocated stack chunks. */
+  size_t peakStackUsage;  /**< \brief Maximum of \ref stackUsage since the last mark. */
+  void* lastMallocChunk;  /**< \brief Most recently allocated chunk if stack memory is replaced by malloc. */
+
+  size_t workerIndex;   /**< \brief Index of this environment among the workers of its owner (0 for the owner). */
+  size_t numWorkers;    /**< \brief Number of allocated worker environments. */
+  CMR** workers;        /**< \brief Array of worker environments used by additional threads (index 0 is unused). */
+  bool workersBusy;     /**< \brief Whether the workers are currently running, which prevents nested parallelism. */
+
+  size_t blockMemory;     /**< \brief Number of bytes of block memory currently allocated (0 if not measurable). */
+  size_t peakBlockMemory; /**< \brief Maximum of \ref blockMemory since the last reset. */
+
+  CMR_SLABPOOL slabPool;  /**< \brief Pool for slab memory. */
 };
 
 #include <cmr/env.h>
@@ -114,6 +174,39 @@ CMR_ERROR _CMRfreeStack(
 #define CMRfreeStackArray(cmr, ptr) \
   _CMRfreeStack(cmr, (void**) ptr)
 
+/**
+ * \brief Marks the current state of the stack memory.
+ *
+ * A subsequent call to \ref CMRstackRelease frees all stack memory allocated after the mark at once, regardless of
+ * the order of allocation. Marks must be released in the reverse order of marking.
+ */
+
+CMR_ERROR CMRstackMark(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_STACKMARK* pmark  /**< Pointer for storing the mark. */
+);
+
+/**
+ * \brief Frees all stack memory allocated since \p mark was created by \ref CMRstackMark.
+ *
+ * Pointers to such memory must not be used or freed afterwards.
+ */
+
+CMR_ERROR CMRstackRelease(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_STACKMARK* mark,  /**< Mark. */
+  size_t* ppeakUsage    /**< Pointer for storing the maximum number of bytes used on top of the mark (may be \c NULL). */
+);
+
+/**
+ * \brief Returns the wall clock time in seconds since an arbitrary fixed point.
+ *
+ * In contrast to \c clock(), which sums up the processor time of all threads, it is suitable for time limits of
+ * computations that use several workers. Falls back to processor time if no monotonic clock is available.
+ */
+
+double CMRwallClock(void);
+
 #if !defined(NDEBUG)
 
 /**
@@ -139,6 +232,48 @@ void CMRassertStackConsistency(
 
 #endif /* !NDEBUG */
 
+/**
+ * \brief Allocates slab memory for an array of \p length entries at *\p ptr.
+ *
+ * Slab memory is taken from a pool owned by the environment and may be freed in any order with
+ * \ref CMRfreeSlabArray. After warm-up, allocation and deallocation take constant time.
+ */
+
+#define CMRallocSlabArray(cmr, ptr, length) \
+  _CMRallocSlab(cmr, (void**) ptr, sizeof(**ptr) * (length))
+
+/**
+ * \brief Carries out the allocation for \ref CMRallocSlabArray.
+ *
+ * \note Use \ref CMRallocSlabArray to allocate slab memory.
+ */
+
+CMR_ERROR _CMRallocSlab(
+  CMR* cmr,   /**< \ref CMR environment. */
+  void** ptr, /**< Pointer where the space shall be allocated. */
+  size_t size /**< Space to allocate. */
+);
+
+/**
+ * \brief Frees slab memory that was allocated with \ref CMRallocSlabArray.
+ */
+
+#define CMRfreeSlabArray(cmr, ptr) \
+  _CMRfreeSlab(cmr, (void**) ptr)
+
+/**
+ * \brief Carries out the deallocation for \ref CMRfreeSlabArray.
+ *
+ * The slab is returned to the pool of the environment that allocated it, which must not be running in parallel.
+ *
+ * \note Use \ref CMRfreeSlabArray to free slab memory.
+ */
+
+CMR_ERROR _CMRfreeSlab(
+  CMR* cmr,   /**< \ref CMR environment. */
+  void** ptr  /**< Pointer of space to be freed. */
+);
+
 void CMRraiseErrorMessage(
   CMR* cmr,           /**< \ref CMR environment. */
   const char* format, /**< Format string in printf-style. */
@@ -184,4 +319,8 @@ char* CMRconsistencyMessage(const char* format, ...);
 
 #endif
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* CMR_ENV_INTERNAL_H */
@@ -0,0 +1,190 @@
+// #define CMR_DEBUG /* Uncomment to debug this file. */
+
+#include "fingerprint.h"
+
+#include "parallel.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+#define PARALLEL_MIN_NONZEROS 65536 /**< Minimum number of nonzeros for scanning the matrices in parallel. */
+
+CMR_ERROR CMRfingerprintWeightsCreate(CMR* cmr, long long** pweights, size_t size)
+{
+  assert(cmr);
+  assert(pweights);
+
+  CMR_CALL( CMRallocStackArray(cmr, pweights, size) );
+  long long* weights = *pweights;
+  long long h = 1;
+  for (size_t e = 0; e < size; ++e)
+  {
+    weights[e] = h;
+    h = CMRfingerprintUpdate(0, h, 3);
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Computes the fingerprints of a range of rows of a matrix.
+ */
+
+static
+void computeRowFingerprints(
+  CMR_CHRMAT* matrix,     /**< Matrix. */
+  long long* weights,     /**< Weights of the column indices. */
+  bool isSigned,          /**< Whether the entries' values shall be taken into account. */
+  size_t firstRow,        /**< First row of the range. */
+  size_t beyondRow,       /**< Row beyond the range. */
+  long long* fingerprints /**< Array for storing the fingerprint of each row. */
+)
+{
+  for (size_t row = firstRow; row < beyondRow; ++row)
+  {
+    long long fingerprint = 0;
+    size_t beyond = matrix->rowSlice[row + 1];
+    for (size_t e = matrix->rowSlice[row]; e < beyond; ++e)
+    {
+      fingerprint = CMRfingerprintUpdate(fingerprint, weights[matrix->entryColumns[e]],
+        isSigned ? matrix->entryValues[e] : 1);
+    }
+    fingerprints[row] = fingerprint;
+  }
+}
+
+/**
+ * \brief Data of the tasks of \ref CMRfingerprintsCreate.
+ */
+
+typedef struct
+{
+  Fingerprints* fingerprints; /**< \brief Fingerprints to compute. */
+  CMR_CHRMAT* matrix;         /**< \brief Matrix. */
+  CMR_CHRMAT* transpose;      /**< \brief Transpose of \ref matrix. */
+  size_t numRowTasks;         /**< \brief Number of tasks for rows; the remaining ones are for columns. */
+  size_t numColumnTasks;      /**< \brief Number of tasks for columns. */
+} FingerprintScan;
+
+/**
+ * \brief Computes the fingerprints of a range of rows or of columns.
+ */
+
+static
+CMR_ERROR fingerprintScanTask(
+  CMR* cmr,     /**< \ref CMR environment of the worker. */
+  size_t task,  /**< Index of the task. */
+  void* data,   /**< Pointer to the \ref FingerprintScan. */
+  bool* pfound  /**< Pointer for storing whether the task was successful (never). */
+)
+{
+  CMR_UNUSED(cmr);
+  CMR_UNUSED(pfound);
+
+  FingerprintScan* scan = (FingerprintScan*) data;
+  Fingerprints* fingerprints = scan->fingerprints;
+  if (task < scan->numRowTasks)
+  {
+    size_t numRows = fingerprints->numRows;
+    computeRowFingerprints(scan->matrix, fingerprints->weights, fingerprints->isSigned,
+      task * numRows / scan->numRowTasks, (task + 1) * numRows / scan->numRowTasks, fingerprints->rowFingerprints);
+  }
+  else
+  {
+    task -= scan->numRowTasks;
+    size_t numColumns = fingerprints->numColumns;
+    computeRowFingerprints(scan->transpose, fingerprints->weights, fingerprints->isSigned,
+      task * numColumns / scan->numColumnTasks, (task + 1) * numColumns / scan->numColumnTasks,
+      fingerprints->columnFingerprints);
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRfingerprintsCreate(CMR* cmr, CMR_CHRMAT* matrix, CMR_CHRMAT* transpose, bool isSigned,
+  Fingerprints** pfingerprints)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(!transpose || (transpose->numRows == matrix->numColumns && transpose->numColumns == matrix->numRows));
+  assert(pfingerprints);
+
+  CMR_CALL( CMRallocBlock(cmr, pfingerprints) );
+  Fingerprints* fingerprints = *pfingerprints;
+  fingerprints->numRows = matrix->numRows;
+  fingerprints->numColumns = matrix->numColumns;
+  fingerprints->isSigned = isSigned;
+  fingerprints->weights = NULL;
+  fingerprints->rowFingerprints = NULL;
+  fingerprints->columnFingerprints = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &fingerprints->rowFingerprints, matrix->numRows) );
+  CMR_CALL( CMRallocBlockArray(cmr, &fingerprints->columnFingerprints, matrix->numColumns) );
+
+  /* The weights are created like by CMRfingerprintWeightsCreate, but in block memory. */
+  size_t numWeights = matrix->numRows > matrix->numColumns ? matrix->numRows : matrix->numColumns;
+  CMR_CALL( CMRallocBlockArray(cmr, &fingerprints->weights, numWeights) );
+  long long h = 1;
+  for (size_t e = 0; e < numWeights; ++e)
+  {
+    fingerprints->weights[e] = h;
+    h = CMRfingerprintUpdate(0, h, 3);
+  }
+
+  size_t numWorkers = CMRparallelNumWorkers(cmr);
+  if (transpose && numWorkers > 1 && matrix->numNonzeros >= PARALLEL_MIN_NONZEROS)
+  {
+    FingerprintScan scan;
+    scan.fingerprints = fingerprints;
+    scan.matrix = matrix;
+    scan.transpose = transpose;
+    scan.numRowTasks = 2 * numWorkers;
+    scan.numColumnTasks = 2 * numWorkers;
+    CMR_CALL( CMRparallelFor(cmr, scan.numRowTasks + scan.numColumnTasks, fingerprintScanTask, &scan) );
+  }
+  else if (transpose)
+  {
+    computeRowFingerprints(matrix, fingerprints->weights, isSigned, 0, matrix->numRows,
+      fingerprints->rowFingerprints);
+    computeRowFingerprints(transpose, fingerprints->weights, isSigned, 0, transpose->numRows,
+      fingerprints->columnFingerprints);
+  }
+  else
+  {
+    /* Without the transpose, the column fingerprints are computed in the same scan. */
+    for (size_t column = 0; column < matrix->numColumns; ++column)
+      fingerprints->columnFingerprints[column] = 0;
+    for (size_t row = 0; row < matrix->numRows; ++row)
+    {
+      long long fingerprint = 0;
+      size_t beyond = matrix->rowSlice[row + 1];
+      for (size_t e = matrix->rowSlice[row]; e < beyond; ++e)
+      {
+        size_t column = matrix->entryColumns[e];
+        long long multiplier = isSigned ? matrix->entryValues[e] : 1;
+        fingerprint = CMRfingerprintUpdate(fingerprint, fingerprints->weights[column], multiplier);
+        fingerprints->columnFingerprints[column] = CMRfingerprintUpdate(fingerprints->columnFingerprints[column],
+          fingerprints->weights[row], multiplier);
+      }
+      fingerprints->rowFingerprints[row] = fingerprint;
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRfingerprintsFree(CMR* cmr, Fingerprints** pfingerprints)
+{
+  assert(cmr);
+  assert(pfingerprints);
+
+  Fingerprints* fingerprints = *pfingerprints;
+  if (!fingerprints)
+    return CMR_OKAY;
+
+  CMR_CALL( CMRfreeBlockArray(cmr, &fingerprints->weights) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &fingerprints->columnFingerprints) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &fingerprints->rowFingerprints) );
+  CMR_CALL( CMRfreeBlock(cmr, pfingerprints) );
+
+  return CMR_OKAY;
+}
@@ -0,0 +1,119 @@
+#ifndef CMR_FINGERPRINT_INTERNAL_H
+#define CMR_FINGERPRINT_INTERNAL_H
+
+#include "env_internal.h"
+#include "hashtable.h"
+
+#include <cmr/matrix.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Creates the weights of the row/column indices for computing fingerprints (on the stack).
+ *
+ * The weight of index \f$ i \f$ is \f$ 3^i \f$, reduced as in \ref CMRfingerprintUpdate.
+ */
+
+CMR_ERROR CMRfingerprintWeightsCreate(
+  CMR* cmr,             /**< \ref CMR environment. */
+  long long** pweights, /**< Pointer for storing the weights. */
+  size_t size           /**< Number of weights. */
+);
+
+/**
+ * \brief Returns \p fingerprint after adding \p multiplier times \p weight.
+ *
+ * The arithmetic is carried out modulo \f$ 2 \cdot \f$ \ref RANGE_SIGNED_HASH \f$ - 1 \f$ with representatives in the
+ * range of \ref projectSignedHash. In contrast to \ref projectSignedHash, no intermediate result overflows, which is
+ * why removing an entry (via the negated \p multiplier) exactly undoes adding it, and why the fingerprint of \f$ -v
+ * \f$ is the negated fingerprint of \f$ v \f$.
+ */
+
+static inline
+long long CMRfingerprintUpdate(
+  long long fingerprint,  /**< Fingerprint in the range of \ref projectSignedHash. */
+  long long weight,       /**< Weight of the other index of the entry, in the range of \ref projectSignedHash. */
+  long long multiplier    /**< Multiplier of \p weight, e.g., the entry or 1. */
+)
+{
+  const long long modulus = 2 * RANGE_SIGNED_HASH - 1;
+
+  if (multiplier < 0)
+  {
+    weight = -weight;
+    multiplier = -multiplier;
+  }
+  while (multiplier)
+  {
+    if (multiplier & 1)
+    {
+      fingerprint += weight;
+      if (fingerprint >= RANGE_SIGNED_HASH)
+        fingerprint -= modulus;
+      else if (fingerprint <= -RANGE_SIGNED_HASH)
+        fingerprint += modulus;
+    }
+    multiplier >>= 1;
+    if (multiplier)
+    {
+      weight += weight;
+      if (weight >= RANGE_SIGNED_HASH)
+        weight -= modulus;
+      else if (weight <= -RANGE_SIGNED_HASH)
+        weight += modulus;
+    }
+  }
+
+  return fingerprint;
+}
+
+/**
+ * \brief Fingerprints of all rows and columns of a matrix.
+ *
+ * The fingerprint of a row is the sum of the weights of the columns of its nonzeros, multiplied by the entries if
+ * \ref Fingerprints::isSigned is \c true, where each addition is projected via \ref projectSignedHash. The
+ * fingerprints of columns are defined similarly. Since the additions are carried out in the order of the indices,
+ * equal rows (resp. columns) have equal fingerprints.
+ */
+
+typedef struct
+{
+  size_t numRows;               /**< \brief Number of rows. */
+  size_t numColumns;            /**< \brief Number of columns. */
+  bool isSigned;                /**< \brief Whether the entries' values are taken into account. */
+  long long* weights;           /**< \brief Weights of the indices; see \ref CMRfingerprintWeightsCreate. */
+  long long* rowFingerprints;   /**< \brief Fingerprint of each row. */
+  long long* columnFingerprints;/**< \brief Fingerprint of each column. */
+} Fingerprints;
+
+/**
+ * \brief Computes the fingerprints of all rows and columns of \p matrix.
+ *
+ * If \p transpose is given, then the rows of \p matrix and of \p transpose are scanned independently, using multiple
+ * threads for large matrices (see \ref CMRsetNumThreads). The fingerprints do not depend on the number of threads.
+ */
+
+CMR_ERROR CMRfingerprintsCreate(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,           /**< Matrix. */
+  CMR_CHRMAT* transpose,        /**< Transpose of \p matrix (may be \c NULL). */
+  bool isSigned,                /**< Whether the entries' values shall be taken into account. */
+  Fingerprints** pfingerprints  /**< Pointer for storing the fingerprints. */
+);
+
+/**
+ * \brief Frees the fingerprints.
+ */
+
+CMR_ERROR CMRfingerprintsFree(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  Fingerprints** pfingerprints  /**< Pointer to the fingerprints. */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMR_FINGERPRINT_INTERNAL_H */
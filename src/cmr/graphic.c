@@ -43,6 +43,23 @@ CMR_ERROR CMRgraphicStatsInit(CMR_GRAPHIC_STATISTICS* stats)
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRgraphicStatsAdd(CMR_GRAPHIC_STATISTICS* target, CMR_GRAPHIC_STATISTICS* source)
+{
+  assert(target);
+  assert(source);
+
+  target->totalCount += source->totalCount;
+  target->totalTime += source->totalTime;
+  target->checkCount += source->checkCount;
+  target->checkTime += source->checkTime;
+  target->applyCount += source->applyCount;
+  target->applyTime += source->applyTime;
+  target->transposeCount += source->transposeCount;
+  target->transposeTime += source->transposeTime;
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRgraphicStatsPrint(FILE* stream, CMR_GRAPHIC_STATISTICS* stats, const char* prefix)
 {
   assert(stream);
@@ -98,8 +115,8 @@ CMR_ERROR CMRcomputeRepresentationMatrix(CMR* cmr, CMR_GRAPH* digraph, bool tern
 
   DijkstraNodeData* nodeData = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &nodeData, CMRgraphMemNodes(digraph)) );
-  CMR_INTHEAP heap;
-  CMR_CALL( CMRintheapInitStack(cmr, &heap, CMRgraphMemNodes(digraph)) );
+  CMR_INTQUEUE queue; /* All lengths are 0 or 1, so the 0-1 queue suffices. */
+  CMR_CALL( CMRintqueueInitStack(cmr, &queue, CMR_INTQUEUE_DEQUE, CMRgraphMemNodes(digraph)) );
   int* lengths = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &lengths, CMRgraphMemEdges(digraph)) );
   for (CMR_GRAPH_NODE v = CMRgraphNodesFirst(digraph); CMRgraphNodesValid(digraph, v);
@@ -137,11 +154,11 @@ CMR_ERROR CMRcomputeRepresentationMatrix(CMR* cmr, CMR_GRAPH* digraph, bool tern
     nodeData[s].predecessor = -1;
     nodeData[s].rootEdge = -1;
     ++countComponents;
-    CMRintheapInsert(&heap, s, 0);
-    while (!CMRintheapEmpty(&heap))
+    CMRintqueueDecreaseInsert(&queue, s, 0);
+    while (!CMRintqueueEmpty(&queue))
     {
-      int distance = CMRintheapMinimumValue(&heap);
-      CMR_GRAPH_NODE v = CMRintheapExtractMinimum(&heap);
+      int distance;
+      CMR_GRAPH_NODE v = CMRintqueueExtractMinimum(&queue, &distance);
       CMRdbgMsg(4, "Processing node %d at distance %d.\n", v, distance);
       nodeData[v].stage = COMPLETED;
       for (CMR_GRAPH_ITER i = CMRgraphIncFirst(digraph, v); CMRgraphIncValid(digraph, i);
@@ -156,9 +173,9 @@ CMR_ERROR CMRcomputeRepresentationMatrix(CMR* cmr, CMR_GRAPH* digraph, bool tern
 
         CMR_GRAPH_EDGE e = CMRgraphIncEdge(digraph, i);
         int newDistance = distance + lengths[e];
-        if (newDistance < CMRintheapGetValueInfinity(&heap, w))
+        if (newDistance < CMRintqueueGetValueInfinity(&queue, w))
         {
-          CMRdbgMsg(6, "Updating distance of (%d,%d) from %d to %d.\n", v, w, CMRintheapGetValueInfinity(&heap, w),
+          CMRdbgMsg(6, "Updating distance of (%d,%d) from %d to %d.\n", v, w, CMRintqueueGetValueInfinity(&queue, w),
             newDistance);
           nodeData[w].stage = SEEN;
           nodeData[w].predecessor = v;
@@ -166,7 +183,7 @@ CMR_ERROR CMRcomputeRepresentationMatrix(CMR* cmr, CMR_GRAPH* digraph, bool tern
           nodeData[w].reversed = arcsReversed ? arcsReversed[e] : false;
           if (w == CMRgraphEdgeU(digraph, e))
             nodeData[w].reversed = !nodeData[w].reversed;
-          CMRintheapDecreaseInsert(&heap, w, newDistance);
+          CMRintqueueDecreaseInsert(&queue, w, newDistance);
         }
       }
     }
@@ -174,7 +191,7 @@ CMR_ERROR CMRcomputeRepresentationMatrix(CMR* cmr, CMR_GRAPH* digraph, bool tern
 
   CMRassertStackConsistency(cmr);
   CMR_CALL( CMRfreeStackArray(cmr, &lengths) );
-  CMR_CALL( CMRintheapClearStack(cmr, &heap) );
+  CMR_CALL( CMRintqueueClearStack(cmr, &queue) );
 
   /* Now nodeData[.].predecessor is an arborescence for each connected component. */
 
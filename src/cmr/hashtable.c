@@ -1,6 +1,7 @@
 // #define CMR_DEBUG /* Uncomment to debug the hash table. */
 
 #include "hashtable.h"
+#include "bits.h"
 
 #include <stdio.h>
 #include <limits.h>
@@ -8,6 +9,10 @@
 #include <stdlib.h>
 #include <stdint.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
 #include "env_internal.h"
 
 typedef struct
@@ -242,25 +247,171 @@ CMR_ERROR CMRlinearhashtableArrayInsert(CMR* cmr, CMR_LINEARHASHTABLE_ARRAY* has
 }
 
 
+#define LISTHASHTABLE_GROUP_WIDTH 16  /**< Number of control bytes that are probed at once. */
+#define LISTHASHTABLE_EMPTY 0x80      /**< Control byte of a slot that was never used. */
+#define LISTHASHTABLE_DELETED 0xFE    /**< Control byte of a slot whose entry was removed (tombstone). */
+
+/**
+ * \brief Entry of a \ref CMR_LISTHASHTABLE.
+ *
+ * Entries are stored in a separate array such that they remain valid when the slots are rehashed.
+ */
+
 typedef struct
 {
-  CMR_LISTHASHTABLE_HASH hash;
-  CMR_LISTHASHTABLE_ENTRY next;
-  CMR_LISTHASHTABLE_VALUE value;
+  CMR_LISTHASHTABLE_HASH hash;    /**< \brief Hash value. */
+  CMR_LISTHASHTABLE_VALUE value;  /**< \brief Stored value. */
+  size_t slot;                    /**< \brief Slot of this entry, or next free entry if unused. */
 } ListhashtableNode;
 
-typedef ListhashtableNode* _CMR_LISTHASHTABLE_NODE;
+/**
+ * \brief Open-addressing hash table with control bytes, similar to Swiss tables.
+ *
+ * The control byte of a slot is \ref LISTHASHTABLE_EMPTY, \ref LISTHASHTABLE_DELETED or the lowest 7 bits of the
+ * scrambled hash of its entry. A search scans groups of \ref LISTHASHTABLE_GROUP_WIDTH consecutive control bytes
+ * (using SSE2 if available) for the 7-bit hash, starting at the slot determined by the remaining bits, until it
+ * encounters an empty slot. The first \ref LISTHASHTABLE_GROUP_WIDTH control bytes are repeated after the last one
+ * such that groups can wrap around.
+ */
 
 struct _CMR_LISTHASHTABLE
 {
-  size_t numBuckets;                /**< \brief Number of buckets. */
-  CMR_LISTHASHTABLE_ENTRY* buckets;  /**< \brief Array with buckets. */
-
-  size_t memNodes;                  /**< \brief Memory allocated for nodes. */
-  ListhashtableNode* nodes;         /**< \brief Array with entries. */
-  CMR_LISTHASHTABLE_ENTRY firstFree; /**< \brief Start of free list. */
+  size_t numSlots;                    /**< \brief Number of slots; a power of 2. */
+  unsigned char* controls;            /**< \brief Control byte of each slot, followed by copies of the first ones. */
+  CMR_LISTHASHTABLE_ENTRY* slots;     /**< \brief Entry of each used slot. */
+  size_t numUsed;                     /**< \brief Number of slots with an entry. */
+  size_t numDeleted;                  /**< \brief Number of slots with a tombstone. */
+
+  size_t memNodes;                    /**< \brief Memory allocated for entries. */
+  ListhashtableNode* nodes;           /**< \brief Array with entries. */
+  CMR_LISTHASHTABLE_ENTRY firstFree;  /**< \brief Start of free list. */
 };
 
+/**
+ * \brief Scrambles \p hash such that its lowest and highest bits depend on all bits.
+ */
+
+static inline
+size_t listhashtableScramble(
+  CMR_LISTHASHTABLE_HASH hash /**< Hash value. */
+)
+{
+  uint64_t scrambled = (uint64_t) hash * 0x9E3779B97F4A7C15ULL;
+  return (size_t) (scrambled ^ (scrambled >> 32));
+}
+
+/**
+ * \brief Returns the bit mask of those control bytes in the group starting at \p controls that are equal to \p byte.
+ */
+
+static inline
+unsigned listhashtableMatchGroup(
+  const unsigned char* controls,  /**< First control byte of the group. */
+  unsigned char byte              /**< Control byte to match. */
+)
+{
+#if defined(__SSE2__)
+  __m128i group = _mm_loadu_si128((const __m128i*) controls);
+  return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) byte)));
+#else
+  unsigned mask = 0;
+  for (size_t i = 0; i < LISTHASHTABLE_GROUP_WIDTH; ++i)
+  {
+    if (controls[i] == byte)
+      mask |= 1U << i;
+  }
+  return mask;
+#endif /* __SSE2__ */
+}
+
+/**
+ * \brief Sets the control byte of \p slot, including its copy after the last slot.
+ */
+
+static inline
+void listhashtableSetControl(
+  CMR_LISTHASHTABLE* hashtable, /**< Hash table. */
+  size_t slot,                  /**< Slot. */
+  unsigned char control         /**< New control byte. */
+)
+{
+  hashtable->controls[slot] = control;
+  if (slot < LISTHASHTABLE_GROUP_WIDTH)
+    hashtable->controls[hashtable->numSlots + slot] = control;
+}
+
+/**
+ * \brief Returns a slot without entry, scanning from the slot determined by \p scrambled.
+ */
+
+static
+size_t listhashtableFindFreeSlot(
+  CMR_LISTHASHTABLE* hashtable, /**< Hash table. */
+  size_t scrambled              /**< Scrambled hash value. */
+)
+{
+  size_t mask = hashtable->numSlots - 1;
+  for (size_t position = (scrambled >> 7) & mask; true; position = (position + LISTHASHTABLE_GROUP_WIDTH) & mask)
+  {
+    unsigned available = listhashtableMatchGroup(&hashtable->controls[position], LISTHASHTABLE_EMPTY)
+      | listhashtableMatchGroup(&hashtable->controls[position], LISTHASHTABLE_DELETED);
+    if (available)
+      return (position + CMRlowestBit(available)) & mask;
+  }
+}
+
+/**
+ * \brief Allocates \p numSlots empty slots and inserts all entries again.
+ */
+
+static
+CMR_ERROR listhashtableRehash(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_LISTHASHTABLE* hashtable, /**< Hash table. */
+  size_t numSlots               /**< New number of slots; a power of 2. */
+)
+{
+  assert(cmr);
+  assert(hashtable);
+  assert(numSlots >= LISTHASHTABLE_GROUP_WIDTH);
+  assert(numSlots > hashtable->numUsed);
+
+  CMRdbgMsg(6, "Rehashing listhashtable with %zu entries into %zu slots.\n", hashtable->numUsed, numSlots);
+
+  size_t oldNumSlots = hashtable->numSlots;
+  unsigned char* oldControls = hashtable->controls;
+  CMR_LISTHASHTABLE_ENTRY* oldSlots = hashtable->slots;
+
+  hashtable->numSlots = numSlots;
+  hashtable->controls = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &hashtable->controls, numSlots + LISTHASHTABLE_GROUP_WIDTH) );
+  hashtable->slots = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &hashtable->slots, numSlots) );
+  for (size_t i = 0; i < numSlots + LISTHASHTABLE_GROUP_WIDTH; ++i)
+    hashtable->controls[i] = LISTHASHTABLE_EMPTY;
+  hashtable->numDeleted = 0;
+
+  if (oldControls)
+  {
+    for (size_t oldSlot = 0; oldSlot < oldNumSlots; ++oldSlot)
+    {
+      if (oldControls[oldSlot] & 0x80)
+        continue;
+
+      CMR_LISTHASHTABLE_ENTRY entry = oldSlots[oldSlot];
+      size_t scrambled = listhashtableScramble(hashtable->nodes[entry].hash);
+      size_t slot = listhashtableFindFreeSlot(hashtable, scrambled);
+      listhashtableSetControl(hashtable, slot, scrambled & 0x7F);
+      hashtable->slots[slot] = entry;
+      hashtable->nodes[entry].slot = slot;
+    }
+
+    CMR_CALL( CMRfreeBlockArray(cmr, &oldSlots) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &oldControls) );
+  }
+
+  return CMR_OKAY;
+}
 
 CMR_ERROR CMRlisthashtableCreate(CMR* cmr, CMR_LISTHASHTABLE** phashtable, size_t initialNumBuckets, size_t initialMemNodes)
 {
@@ -272,21 +423,27 @@ CMR_ERROR CMRlisthashtableCreate(CMR* cmr, CMR_LISTHASHTABLE** phashtable, size_
   CMR_CALL( CMRallocBlock(cmr, phashtable) );
   CMR_LISTHASHTABLE* hashtable = *phashtable;
   assert(hashtable);
-  
+
   CMRdbgMsg(6, "Creating listhashtable with %d buckets and memory for %d nodes.\n", initialNumBuckets, initialMemNodes);
 
-  hashtable->numBuckets = initialNumBuckets;
-  hashtable->buckets = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &hashtable->buckets, initialNumBuckets) );
-  for (size_t i = 0; i < initialNumBuckets; ++i)
-    hashtable->buckets[i] = SIZE_MAX;
+  /* The slots shall suffice for the initial entries without exceeding the maximum load of 7/8. */
+  size_t numSlots = initialNumBuckets;
+  if (numSlots < initialMemNodes + initialMemNodes / 7 + 1)
+    numSlots = initialMemNodes + initialMemNodes / 7 + 1;
+  if (numSlots < LISTHASHTABLE_GROUP_WIDTH)
+    numSlots = LISTHASHTABLE_GROUP_WIDTH;
+  hashtable->numSlots = 0;
+  hashtable->controls = NULL;
+  hashtable->slots = NULL;
+  hashtable->numUsed = 0;
+  hashtable->nodes = NULL;
+  CMR_CALL( listhashtableRehash(cmr, hashtable, nextPower2(numSlots)) );
 
   hashtable->memNodes = initialMemNodes;
-  hashtable->nodes = NULL;
   CMR_CALL( CMRallocBlockArray(cmr, &hashtable->nodes, initialMemNodes) );
   for (size_t i = 0; i < initialMemNodes-1; ++i)
-    hashtable->nodes[i].next = i+1;
-  hashtable->nodes[initialMemNodes-1].next = SIZE_MAX;
+    hashtable->nodes[i].slot = i+1;
+  hashtable->nodes[initialMemNodes-1].slot = SIZE_MAX;
   hashtable->firstFree = 0;
 
   return CMR_OKAY;
@@ -302,34 +459,51 @@ CMR_ERROR CMRlisthashtableFree(CMR* cmr, CMR_LISTHASHTABLE** phashtable)
     return CMR_OKAY;
 
   CMR_CALL( CMRfreeBlockArray(cmr, &hashtable->nodes) );
-  CMR_CALL( CMRfreeBlockArray(cmr, &hashtable->buckets) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &hashtable->slots) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &hashtable->controls) );
   CMR_CALL( CMRfreeBlock(cmr, phashtable) );
 
   return CMR_OKAY;
 }
 
+/**
+ * \brief Returns the first entry with \p hash in a slot from \p position onwards, or \c SIZE_MAX.
+ */
+
 static inline
-CMR_LISTHASHTABLE_BUCKET listhashtableHashToBucket(CMR_LISTHASHTABLE* hashtable, CMR_LISTHASHTABLE_HASH hash)
+CMR_LISTHASHTABLE_ENTRY listhashtableScan(
+  CMR_LISTHASHTABLE* hashtable, /**< Hash table. */
+  CMR_LISTHASHTABLE_HASH hash,  /**< Hash value. */
+  size_t position               /**< First slot to inspect. */
+)
 {
-  assert(hashtable);
+  size_t mask = hashtable->numSlots - 1;
+  unsigned char control = listhashtableScramble(hash) & 0x7F;
+  for (; true; position = (position + LISTHASHTABLE_GROUP_WIDTH) & mask)
+  {
+    unsigned match = listhashtableMatchGroup(&hashtable->controls[position], control);
+    unsigned empty = listhashtableMatchGroup(&hashtable->controls[position], LISTHASHTABLE_EMPTY);
 
-  return hash % hashtable->numBuckets;
+    /* Only slots before the first empty one belong to the probe sequence. */
+    if (empty)
+      match &= (1U << CMRlowestBit(empty)) - 1;
+    while (match)
+    {
+      CMR_LISTHASHTABLE_ENTRY entry = hashtable->slots[(position + CMRlowestBit(match)) & mask];
+      if (hashtable->nodes[entry].hash == hash)
+        return entry;
+      match &= match - 1;
+    }
+    if (empty)
+      return SIZE_MAX;
+  }
 }
 
 CMR_LISTHASHTABLE_ENTRY CMRlisthashtableFindFirst(CMR_LISTHASHTABLE* hashtable, CMR_LISTHASHTABLE_HASH hash)
 {
   assert(hashtable);
 
-  CMR_LISTHASHTABLE_BUCKET bucket = listhashtableHashToBucket(hashtable, hash);
-  CMR_LISTHASHTABLE_ENTRY entry = hashtable->buckets[bucket];
-  if (entry == SIZE_MAX)
-    return SIZE_MAX;
-
-  ListhashtableNode* node = &hashtable->nodes[entry];
-  if (node->hash == hash)
-    return entry;
-
-  return CMRlisthashtableFindNext(hashtable, hash, entry);
+  return listhashtableScan(hashtable, hash, (listhashtableScramble(hash) >> 7) & (hashtable->numSlots - 1));
 }
 
 CMR_LISTHASHTABLE_ENTRY CMRlisthashtableFindNext(CMR_LISTHASHTABLE* hashtable, CMR_LISTHASHTABLE_HASH hash,
@@ -337,16 +511,9 @@ CMR_LISTHASHTABLE_ENTRY CMRlisthashtableFindNext(CMR_LISTHASHTABLE* hashtable, C
 {
   assert(hashtable);
   assert(entry < hashtable->memNodes);
+  assert(hashtable->nodes[entry].hash == hash);
 
-  while (true)
-  {
-    entry = hashtable->nodes[entry].next;
-    if (entry == SIZE_MAX)
-      return SIZE_MAX;
-
-    if (hashtable->nodes[entry].hash == hash)
-      return entry;
-  }
+  return listhashtableScan(hashtable, hash, (hashtable->nodes[entry].slot + 1) & (hashtable->numSlots - 1));
 }
 
 CMR_LISTHASHTABLE_VALUE CMRlisthashtableValue(CMR_LISTHASHTABLE* hashtable, CMR_LISTHASHTABLE_ENTRY entry)
@@ -365,7 +532,7 @@ CMR_LISTHASHTABLE_HASH CMRlisthashtableHash(CMR_LISTHASHTABLE* hashtable, CMR_LI
 
 size_t CMRlisthashtableNumBuckets(CMR_LISTHASHTABLE* hashtable)
 {
-  return hashtable->numBuckets;
+  return hashtable->numSlots;
 }
 
 CMR_ERROR CMRlisthashtableInsert(CMR* cmr, CMR_LISTHASHTABLE* hashtable, CMR_LISTHASHTABLE_HASH hash,
@@ -380,22 +547,39 @@ CMR_ERROR CMRlisthashtableInsert(CMR* cmr, CMR_LISTHASHTABLE* hashtable, CMR_LIS
     size_t newMemNodes = 2 * hashtable->memNodes;
     CMR_CALL( CMRreallocBlockArray(cmr, &hashtable->nodes, newMemNodes) );
     for (size_t i = hashtable->memNodes; i+1 < newMemNodes; ++i)
-      hashtable->nodes[i].next = i+1;
-    hashtable->nodes[newMemNodes-1].next = SIZE_MAX;
+      hashtable->nodes[i].slot = i+1;
+    hashtable->nodes[newMemNodes-1].slot = SIZE_MAX;
     hashtable->firstFree = hashtable->memNodes;
     hashtable->memNodes = newMemNodes;
   }
 
-  ListhashtableNode* newNode = &hashtable->nodes[hashtable->firstFree];
-  CMR_LISTHASHTABLE_ENTRY next = newNode->next;
+  size_t scrambled = listhashtableScramble(hash);
+  size_t slot = listhashtableFindFreeSlot(hashtable, scrambled);
+  if (hashtable->controls[slot] == LISTHASHTABLE_EMPTY
+    && 8 * (hashtable->numUsed + hashtable->numDeleted + 1) > 7 * hashtable->numSlots)
+  {
+    /* Grow if mostly used, and otherwise only get rid of the tombstones. */
+    size_t numSlots = hashtable->numSlots;
+    if (2 * (hashtable->numUsed + 1) > numSlots)
+      numSlots *= 2;
+    CMR_CALL( listhashtableRehash(cmr, hashtable, numSlots) );
+    slot = listhashtableFindFreeSlot(hashtable, scrambled);
+  }
+
+  if (hashtable->controls[slot] == LISTHASHTABLE_DELETED)
+    hashtable->numDeleted--;
+  hashtable->numUsed++;
+
+  CMR_LISTHASHTABLE_ENTRY entry = hashtable->firstFree;
+  ListhashtableNode* newNode = &hashtable->nodes[entry];
+  hashtable->firstFree = newNode->slot;
   newNode->hash = hash;
   newNode->value = value;
-  CMR_LISTHASHTABLE_BUCKET bucket = listhashtableHashToBucket(hashtable, hash);
-  newNode->next = hashtable->buckets[bucket];
+  newNode->slot = slot;
+  listhashtableSetControl(hashtable, slot, scrambled & 0x7F);
+  hashtable->slots[slot] = entry;
   if (pentry)
-    *pentry = hashtable->firstFree;
-  hashtable->buckets[bucket] = hashtable->firstFree;
-  hashtable->firstFree = next;
+    *pentry = entry;
 
   return CMR_OKAY;
 }
@@ -407,30 +591,18 @@ CMR_ERROR CMRlisthashtableRemove(CMR* cmr, CMR_LISTHASHTABLE* hashtable, CMR_LIS
   assert(cmr);
   assert(hashtable);
 
-  CMR_LISTHASHTABLE_HASH hash = hashtable->nodes[entry].hash;
-  CMR_LISTHASHTABLE_ENTRY next = hashtable->nodes[entry].next;
-  CMR_LISTHASHTABLE_BUCKET bucket = listhashtableHashToBucket(hashtable, hash);
-  
-  CMR_LISTHASHTABLE_ENTRY previous = hashtable->buckets[bucket];
-  if (previous == entry)
-  {
-    hashtable->buckets[bucket] = next;
-  }
-  else
-  {
-    CMR_LISTHASHTABLE_ENTRY current = hashtable->nodes[previous].next;
-    while (current != entry)
-    {
-      if (current == SIZE_MAX)
-        return CMR_ERROR_INVALID;
+  if (entry >= hashtable->memNodes)
+    return CMR_ERROR_INVALID;
 
-      previous = current;
-      current = hashtable->nodes[current].next;
-    }
-    hashtable->nodes[previous].next = next;
-  }
+  size_t slot = hashtable->nodes[entry].slot;
+  if (slot >= hashtable->numSlots || (hashtable->controls[slot] & 0x80) || hashtable->slots[slot] != entry)
+    return CMR_ERROR_INVALID;
+
+  listhashtableSetControl(hashtable, slot, LISTHASHTABLE_DELETED);
+  hashtable->numUsed--;
+  hashtable->numDeleted++;
 
-  hashtable->nodes[entry].next = hashtable->firstFree;
+  hashtable->nodes[entry].slot = hashtable->firstFree;
   hashtable->firstFree = entry;
 
   return CMR_OKAY;
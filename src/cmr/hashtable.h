@@ -77,6 +77,14 @@ CMR_ERROR CMRlinearhashtableArrayInsert(
 
 
 
+/**
+ * \brief Hash table that maps hash values to values, allowing several entries with the same hash value.
+ *
+ * It uses open addressing with control bytes that are probed in groups. Removed entries become tombstones, which
+ * are cleaned up when the table is rehashed. Entries remain valid until they are removed, and entries with the same
+ * hash are found in the order of their slots.
+ */
+
 typedef struct _CMR_LISTHASHTABLE CMR_LISTHASHTABLE;
 typedef size_t CMR_LISTHASHTABLE_VALUE;
 typedef size_t CMR_LISTHASHTABLE_HASH;
@@ -6,6 +6,8 @@
 #include <assert.h>
 #include <limits.h>
 
+#define HEAP_ARITY 4 /**< Number of children of each heap position. */
+
 CMR_ERROR CMRintheapInitStack(CMR* cmr, CMR_INTHEAP* heap, int memKeys)
 {
   assert(cmr);
@@ -59,41 +61,95 @@ void debugHeap(CMR_INTHEAP* heap)
 }
 #endif /* CMR_DEBUG_HEAP_CONTENT */
 
-CMR_ERROR CMRintheapInsert(CMR_INTHEAP* heap, int key, int value)
-{
-  assert(heap);
-  assert(key >= 0);
-  assert(key < heap->memKeys);
-  assert(heap->size < heap->memKeys);
-
-  CMRdbgMsg(20, "Heap insert: %d->%d.\n", key, value);
-
-  heap->data[heap->size] = key;
-  heap->positions[key] = heap->size;
-  heap->values[key] = value;
+/**
+ * \brief Moves the element at heap position \p current upwards until its parent's value is not larger.
+ */
 
-  int currentKey = key;
-  int current = heap->size;
-  int currentValue = value;
+static
+void heapSiftUp(
+  CMR_INTHEAP* heap,  /**< Heap pointer. */
+  int current         /**< Heap position of element. */
+)
+{
+  int currentKey = heap->data[current];
+  int currentValue = heap->values[currentKey];
   while (current > 0)
   {
-    int parent = (current-1) / 2;
+    int parent = (current - 1) / HEAP_ARITY;
     int parentKey = heap->data[parent];
     int parentValue = heap->values[parentKey];
+    CMRdbgMsg(22, "Parent: %d:%d->%d, child value: %d.\n", parent, parentKey, parentValue, currentValue);
     if (parentValue <= currentValue)
       break;
 
-    /* Move current upwards. */
-    heap->positions[currentKey] = parent;
+    /* Move the parent downwards. */
     heap->positions[parentKey] = current;
-    heap->data[parent] = currentKey;
-    heap->data[current]  = parentKey;
+    heap->data[current] = parentKey;
     current = parent;
-    currentKey = parentKey;
-    currentValue = parentValue;
   }
+  heap->positions[currentKey] = current;
+  heap->data[current] = currentKey;
+}
+
+/**
+ * \brief Moves the element at heap position \p current downwards until no child has a smaller value.
+ */
+
+static
+void heapSiftDown(
+  CMR_INTHEAP* heap,  /**< Heap pointer. */
+  int current         /**< Heap position of element. */
+)
+{
+  int currentKey = heap->data[current];
+  int currentValue = heap->values[currentKey];
+  while (HEAP_ARITY * current + 1 < heap->size)
+  {
+    /* Find the child with minimum value. */
+    int firstChild = HEAP_ARITY * current + 1;
+    int beyondChild = firstChild + HEAP_ARITY < heap->size ? firstChild + HEAP_ARITY : heap->size;
+    int minChild = firstChild;
+    int minChildValue = heap->values[heap->data[firstChild]];
+    for (int child = firstChild + 1; child < beyondChild; ++child)
+    {
+      int childValue = heap->values[heap->data[child]];
+      if (childValue < minChildValue)
+      {
+        minChild = child;
+        minChildValue = childValue;
+      }
+    }
+    if (currentValue <= minChildValue)
+      break;
+
+    CMRdbgMsg(22, "Swapping %d:%d->%d with child %d:%d->%d.\n", current, currentKey, currentValue, minChild,
+      heap->data[minChild], minChildValue);
+
+    /* Move the child upwards. */
+    int minChildKey = heap->data[minChild];
+    heap->positions[minChildKey] = current;
+    heap->data[current] = minChildKey;
+    current = minChild;
+  }
+  heap->positions[currentKey] = current;
+  heap->data[current] = currentKey;
+}
+
+CMR_ERROR CMRintheapInsert(CMR_INTHEAP* heap, int key, int value)
+{
+  assert(heap);
+  assert(key >= 0);
+  assert(key < heap->memKeys);
+  assert(heap->size < heap->memKeys);
+  assert(heap->positions[key] < 0);
+
+  CMRdbgMsg(20, "Heap insert: %d->%d.\n", key, value);
 
+  heap->data[heap->size] = key;
+  heap->positions[key] = heap->size;
+  heap->values[key] = value;
   ++heap->size;
+  heapSiftUp(heap, heap->size - 1);
 
   debugHeap(heap);
 
@@ -104,30 +160,11 @@ CMR_ERROR CMRintheapDecrease(CMR_INTHEAP* heap, int key, int newValue)
 {
   assert(heap);
   assert(heap->positions[key] >= 0);
+  assert(newValue <= heap->values[key]);
 
-  int currentKey = key;
-  int current = heap->positions[currentKey];
-  CMRdbgMsg(20, "Heap decrease: %d->%d to %d->%d.\n", key, heap->values[currentKey], key, newValue);
-  heap->values[currentKey] = newValue;
-  int currentValue = newValue;
-  while (current > 0)
-  {
-    int parent = (current-1) / 2;
-    int parentKey = heap->data[parent];
-    int parentValue = heap->values[parentKey];
-    CMRdbgMsg(12, "Parent: %d->%d.\n", parentKey, parentValue);
-    if (parentValue <= currentValue)
-      break;
-
-    /* Move current upwards. */
-    heap->positions[currentKey] = parent;
-    heap->positions[parentKey] = current;
-    heap->data[parent] = currentKey;
-    heap->data[current]  = parentKey;
-    current = parent;
-    currentKey = parentKey;
-    currentValue = parentValue;
-  }
+  CMRdbgMsg(20, "Heap decrease: %d->%d to %d->%d.\n", key, heap->values[key], key, newValue);
+  heap->values[key] = newValue;
+  heapSiftUp(heap, heap->positions[key]);
 
   debugHeap(heap);
 
@@ -142,39 +179,14 @@ CMR_ERROR CMRintheapDecreaseInsert(CMR_INTHEAP* heap, int key, int newValue)
 
   CMRdbgMsg(20, "Heap decrease-insert: %d->%d.\n", key, newValue);
 
-  int currentKey = key;
-  int current;
-  if (heap->positions[key] >= 0)
-  {
-    current = heap->positions[currentKey];
-  }
-  else
+  if (heap->positions[key] < 0)
   {
-    current = heap->size;
+    heap->positions[key] = heap->size;
+    heap->data[heap->size] = key;
     heap->size++;
-    heap->positions[key] = current;
-    heap->data[current] = key;
-  }
-  heap->values[currentKey] = newValue;
-  int currentValue = newValue;
-  CMRdbgMsg(22, "Initial is %d:%d->%d.\n", current, currentKey, currentValue);
-
-  while (current > 0)
-  {
-    int parent = (current-1) / 2;
-    int parentKey = heap->data[parent];
-    int parentValue = heap->values[parentKey];
-    CMRdbgMsg(22, "Parent: %d:%d->%d, child value: %d.\n", parent, parentKey, parentValue, currentValue);
-    if (parentValue <= currentValue)
-      break;
-
-    /* Move current upwards. */
-    heap->positions[currentKey] = parent;
-    heap->positions[parentKey] = current;
-    heap->data[parent] = currentKey;
-    heap->data[current]  = parentKey;
-    current = parent;
   }
+  heap->values[key] = newValue;
+  heapSiftUp(heap, heap->positions[key]);
 
   debugHeap(heap);
 
@@ -184,56 +196,358 @@ CMR_ERROR CMRintheapDecreaseInsert(CMR_INTHEAP* heap, int key, int newValue)
 int CMRintheapExtractMinimum(CMR_INTHEAP* heap)
 {
   assert(heap);
+  assert(heap->size > 0);
 
   int extracted = heap->data[0];
   heap->positions[extracted] = -1;
-  heap->data[0] = heap->data[heap->size - 1];
-  heap->positions[heap->data[0]] = 0;
   --heap->size;
 
   CMRdbgMsg(20, "Heap extract: %d->%d.\n", extracted, heap->values[extracted]);
 
-  int current = 0;
-  int currentKey = heap->data[0];
-  int currentValue = heap->values[currentKey];
-  while (2*current+1 < heap->size)
+  if (heap->size > 0)
   {
-    int left = 2*current + 1;
-    int right = left+1;
-    int leftKey = heap->data[left];
-    int leftValue = heap->values[leftKey];
-    int rightKey = right < heap->size ? heap->data[right] : -1;
-    int rightValue = right < heap->size ? heap->values[rightKey] : INT_MAX;
-    if (leftValue < rightValue)
+    heap->data[0] = heap->data[heap->size];
+    heapSiftDown(heap, 0);
+  }
+
+  debugHeap(heap);
+
+  return extracted;
+}
+
+CMR_ERROR CMRintradixheapInitStack(CMR* cmr, CMR_INTRADIXHEAP* heap, int memKeys)
+{
+  assert(cmr);
+  assert(heap);
+  assert(memKeys > 0);
+
+  heap->memKeys = memKeys;
+  heap->size = 0;
+  heap->last = 0;
+  for (int b = 0; b < CMR_INTRADIXHEAP_NUM_BUCKETS; ++b)
+    heap->first[b] = -1;
+  heap->values = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &heap->values, memKeys) );
+  heap->buckets = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &heap->buckets, memKeys) );
+  for (int i = 0; i < memKeys; ++i)
+    heap->buckets[i] = -1;
+  heap->next = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &heap->next, memKeys) );
+  heap->previous = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &heap->previous, memKeys) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRintradixheapClearStack(CMR* cmr, CMR_INTRADIXHEAP* heap)
+{
+  assert(cmr);
+  assert(heap);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &heap->previous) );
+  CMR_CALL( CMRfreeStackArray(cmr, &heap->next) );
+  CMR_CALL( CMRfreeStackArray(cmr, &heap->buckets) );
+  CMR_CALL( CMRfreeStackArray(cmr, &heap->values) );
+  heap->memKeys = 0;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Returns the bucket for \p value with respect to the value \p last of the most recently extracted element.
+ */
+
+static inline
+int radixBucket(
+  int last, /**< Value of the most recently extracted element. */
+  int value /**< Value. */
+)
+{
+  unsigned int difference = (unsigned int) value ^ (unsigned int) last;
+  if (!difference)
+    return 0;
+#if defined(__GNUC__)
+  return 32 - __builtin_clz(difference);
+#else
+  int bucket = 0;
+  while (difference)
+  {
+    ++bucket;
+    difference >>= 1;
+  }
+  return bucket;
+#endif /* __GNUC__ */
+}
+
+/**
+ * \brief Adds \p key to the bucket that corresponds to its value.
+ */
+
+static inline
+void radixLink(
+  CMR_INTRADIXHEAP* heap, /**< Heap pointer. */
+  int key                 /**< Key of element. */
+)
+{
+  int bucket = radixBucket(heap->last, heap->values[key]);
+  heap->buckets[key] = bucket;
+  heap->previous[key] = -1;
+  heap->next[key] = heap->first[bucket];
+  if (heap->first[bucket] >= 0)
+    heap->previous[heap->first[bucket]] = key;
+  heap->first[bucket] = key;
+}
+
+/**
+ * \brief Removes \p key from its bucket.
+ */
+
+static inline
+void radixUnlink(
+  CMR_INTRADIXHEAP* heap, /**< Heap pointer. */
+  int key                 /**< Key of element. */
+)
+{
+  if (heap->previous[key] >= 0)
+    heap->next[heap->previous[key]] = heap->next[key];
+  else
+    heap->first[heap->buckets[key]] = heap->next[key];
+  if (heap->next[key] >= 0)
+    heap->previous[heap->next[key]] = heap->previous[key];
+  heap->buckets[key] = -1;
+}
+
+void CMRintradixheapDecreaseInsert(CMR_INTRADIXHEAP* heap, int key, int newValue)
+{
+  assert(heap);
+  assert(key >= 0);
+  assert(key < heap->memKeys);
+
+  CMRdbgMsg(20, "Radix heap decrease-insert: %d->%d.\n", key, newValue);
+
+  /* An empty heap may start a new search. */
+  if (heap->size == 0 && newValue < heap->last)
+    heap->last = newValue;
+  assert(newValue >= heap->last);
+
+  if (heap->buckets[key] >= 0)
+  {
+    assert(newValue <= heap->values[key]);
+    radixUnlink(heap, key);
+  }
+  else
+    ++heap->size;
+  heap->values[key] = newValue;
+  radixLink(heap, key);
+}
+
+int CMRintradixheapExtractMinimum(CMR_INTRADIXHEAP* heap)
+{
+  assert(heap);
+  assert(heap->size > 0);
+
+  if (heap->first[0] < 0)
+  {
+    /* Find the first nonempty bucket and its minimum value. */
+    int bucket = 1;
+    while (heap->first[bucket] < 0)
+      ++bucket;
+    int minValue = INT_MAX;
+    for (int key = heap->first[bucket]; key >= 0; key = heap->next[key])
     {
-      if (currentValue <= leftValue)
-        break;
-
-      CMRdbgMsg(22, "Swapping %d:%d->%d with left child %d:%d->%d.\n", current, currentKey, currentValue, left, leftKey,
-        leftValue);
-      heap->positions[leftKey] = current;
-      heap->positions[currentKey] = left;
-      heap->data[current] = leftKey;
-      heap->data[left] = currentKey;
-      current = left;
+      if (heap->values[key] < minValue)
+        minValue = heap->values[key];
     }
-    else
-    {
-      if (currentValue <= rightValue)
-        break;
 
-      CMRdbgMsg(22, "Swapping %d:%d->%d with right child %d:%d->%d.\n", current, currentKey, currentValue, right, rightKey,
-        rightValue);
-
-      heap->positions[rightKey] = current;
-      heap->positions[currentKey] = right;
-      heap->data[current] = rightKey;
-      heap->data[right] = currentKey;
-      current = right;
+    /* Redistribute the elements of that bucket, which all go to smaller buckets. */
+    heap->last = minValue;
+    int key = heap->first[bucket];
+    heap->first[bucket] = -1;
+    while (key >= 0)
+    {
+      int nextKey = heap->next[key];
+      radixLink(heap, key);
+      assert(heap->buckets[key] < bucket);
+      key = nextKey;
     }
   }
 
-  debugHeap(heap);
+  int extracted = heap->first[0];
+  assert(extracted >= 0);
+  radixUnlink(heap, extracted);
+  --heap->size;
+
+  CMRdbgMsg(20, "Radix heap extract: %d->%d.\n", extracted, heap->values[extracted]);
 
   return extracted;
 }
+
+CMR_ERROR CMRintdequeInitStack(CMR* cmr, CMR_INTDEQUE* deque, int memKeys)
+{
+  assert(cmr);
+  assert(deque);
+  assert(memKeys > 0);
+
+  deque->memKeys = memKeys;
+  deque->numLive = 0;
+  deque->current = 0;
+  deque->values = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &deque->values, memKeys) );
+  deque->positions = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &deque->positions, memKeys) );
+  for (int i = 0; i < memKeys; ++i)
+    deque->positions[i] = -1;
+
+  /* Outdated entries are removed when the array is full, after which at least half of it is free. */
+  deque->memEntries = 2 * memKeys;
+  deque->entries = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &deque->entries, deque->memEntries) );
+  deque->head = 0;
+  deque->numEntries = 0;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRintdequeClearStack(CMR* cmr, CMR_INTDEQUE* deque)
+{
+  assert(cmr);
+  assert(deque);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &deque->entries) );
+  CMR_CALL( CMRfreeStackArray(cmr, &deque->positions) );
+  CMR_CALL( CMRfreeStackArray(cmr, &deque->values) );
+  deque->memKeys = 0;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Removes all outdated entries of \p deque, keeping the order of the others.
+ */
+
+static
+void dequeCompact(
+  CMR_INTDEQUE* deque /**< Queue pointer. */
+)
+{
+  int numEntries = 0;
+  for (int i = 0; i < deque->numEntries; ++i)
+  {
+    int position = (deque->head + i) % deque->memEntries;
+    int key = deque->entries[position];
+    if (deque->positions[key] != position)
+      continue;
+
+    /* Entries only move to the front, so no entry is overwritten before it is read. */
+    int newPosition = (deque->head + numEntries) % deque->memEntries;
+    deque->entries[newPosition] = key;
+    deque->positions[key] = newPosition;
+    ++numEntries;
+  }
+  assert(numEntries == deque->numLive);
+  deque->numEntries = numEntries;
+}
+
+void CMRintdequeDecreaseInsert(CMR_INTDEQUE* deque, int key, int newValue)
+{
+  assert(deque);
+  assert(key >= 0);
+  assert(key < deque->memKeys);
+
+  CMRdbgMsg(20, "Deque decrease-insert: %d->%d.\n", key, newValue);
+
+  if (deque->positions[key] >= 0)
+  {
+    assert(newValue <= deque->values[key]);
+    if (newValue == deque->values[key])
+      return;
+
+    /* The old entry becomes outdated. */
+    deque->positions[key] = -1;
+    --deque->numLive;
+  }
+
+  if (deque->numLive == 0)
+  {
+    if (newValue != deque->current && newValue != deque->current + 1)
+      deque->current = newValue;
+    deque->head = 0;
+    deque->numEntries = 0;
+  }
+  else if (deque->numEntries == deque->memEntries)
+    dequeCompact(deque);
+  assert(newValue == deque->current || newValue == deque->current + 1);
+
+  int position;
+  if (newValue == deque->current)
+  {
+    deque->head = (deque->head + deque->memEntries - 1) % deque->memEntries;
+    position = deque->head;
+  }
+  else
+    position = (deque->head + deque->numEntries) % deque->memEntries;
+  deque->entries[position] = key;
+  deque->positions[key] = position;
+  deque->values[key] = newValue;
+  ++deque->numEntries;
+  ++deque->numLive;
+}
+
+int CMRintdequeExtractMinimum(CMR_INTDEQUE* deque)
+{
+  assert(deque);
+  assert(deque->numLive > 0);
+
+  /* Skip outdated entries. */
+  int key = deque->entries[deque->head];
+  while (deque->positions[key] != deque->head)
+  {
+    deque->head = (deque->head + 1) % deque->memEntries;
+    --deque->numEntries;
+    key = deque->entries[deque->head];
+  }
+
+  deque->positions[key] = -1;
+  deque->head = (deque->head + 1) % deque->memEntries;
+  --deque->numEntries;
+  --deque->numLive;
+  deque->current = deque->values[key];
+
+  CMRdbgMsg(20, "Deque extract: %d->%d.\n", key, deque->values[key]);
+
+  return key;
+}
+
+CMR_ERROR CMRintqueueInitStack(CMR* cmr, CMR_INTQUEUE* queue, CMR_INTQUEUE_TYPE type, int memKeys)
+{
+  assert(cmr);
+  assert(queue);
+
+  queue->type = type;
+  if (type == CMR_INTQUEUE_HEAP)
+    CMR_CALL( CMRintheapInitStack(cmr, &queue->heap, memKeys) );
+  else if (type == CMR_INTQUEUE_RADIX)
+    CMR_CALL( CMRintradixheapInitStack(cmr, &queue->radix, memKeys) );
+  else if (type == CMR_INTQUEUE_DEQUE)
+    CMR_CALL( CMRintdequeInitStack(cmr, &queue->deque, memKeys) );
+  else
+    return CMR_ERROR_INPUT;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRintqueueClearStack(CMR* cmr, CMR_INTQUEUE* queue)
+{
+  assert(cmr);
+  assert(queue);
+
+  if (queue->type == CMR_INTQUEUE_HEAP)
+    CMR_CALL( CMRintheapClearStack(cmr, &queue->heap) );
+  else if (queue->type == CMR_INTQUEUE_RADIX)
+    CMR_CALL( CMRintradixheapClearStack(cmr, &queue->radix) );
+  else
+    CMR_CALL( CMRintdequeClearStack(cmr, &queue->deque) );
+
+  return CMR_OKAY;
+}
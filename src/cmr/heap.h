@@ -5,12 +5,14 @@
 #include "env_internal.h"
 #include <limits.h>
 
-#ifdef __cplus
+#ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
  * \brief Structure for min-heap with unsigned int values.
+ *
+ * The heap is 4-ary, i.e., the children of position \f$ i \f$ are the positions \f$ 4i+1, \dotsc, 4i+4 \f$.
  */
 
 typedef struct
@@ -153,6 +155,262 @@ int CMRintheapExtractMinimum(
   CMR_INTHEAP* heap  /**< Heap pointer. */
 );
 
+#define CMR_INTRADIXHEAP_NUM_BUCKETS 33 /**< \brief Number of buckets of a \ref CMR_INTRADIXHEAP. */
+
+/**
+ * \brief Structure for monotone min-heap with nonnegative int values, implemented as a radix heap.
+ *
+ * All values must be at least the value of the most recently extracted element. Bucket 0 contains the elements whose
+ * value is equal to that value, and bucket \f$ b \geq 1 \f$ contains those whose value differs from it in bit
+ * \f$ b-1 \f$ as the most significant bit. Insertions and decreases take constant time, and the amortized time for
+ * extracting the minimum is proportional to the number of bits of the values.
+ */
+
+typedef struct
+{
+  int size;                                     /**< \brief Current size of the heap. */
+  int memKeys;                                  /**< \brief Memory for keys. */
+  int last;                                     /**< \brief Value of the most recently extracted element. */
+  int* values;                                  /**< \brief Array that maps keys to values. */
+  int* buckets;                                 /**< \brief Array that maps keys to buckets, or -1. */
+  int* next;                                    /**< \brief Array that maps keys to next key in bucket, or -1. */
+  int* previous;                                /**< \brief Array that maps keys to previous key in bucket, or -1. */
+  int first[CMR_INTRADIXHEAP_NUM_BUCKETS];      /**< \brief First key of each bucket, or -1. */
+} CMR_INTRADIXHEAP;
+
+/**
+ * \brief Initializes an empty radix heap using stack memory.
+ */
+
+CMR_ERROR CMRintradixheapInitStack(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_INTRADIXHEAP* heap,   /**< Heap pointer. */
+  int memKeys               /**< Maximum number of elements and bound on key entries. */
+);
+
+/**
+ * \brief Clears the given radix \p heap.
+ */
+
+CMR_ERROR CMRintradixheapClearStack(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_INTRADIXHEAP* heap  /**< Heap pointer. */
+);
+
+/**
+ * \brief Decreases the value of \p key to \p newValue or inserts it.
+ *
+ * If the heap is nonempty, then \p newValue must not be smaller than the value of the most recently extracted
+ * element.
+ */
+
+void CMRintradixheapDecreaseInsert(
+  CMR_INTRADIXHEAP* heap, /**< Heap pointer. */
+  int key,                /**< Key of element. */
+  int newValue            /**< New value of element. */
+);
+
+/**
+ * \brief Extracts the minimum element and returns its key.
+ */
+
+int CMRintradixheapExtractMinimum(
+  CMR_INTRADIXHEAP* heap  /**< Heap pointer. */
+);
+
+/**
+ * \brief Structure for monotone min-queue whose values differ by at most 1, e.g., for breadth-first searches with
+ *        edge lengths 0 and 1.
+ *
+ * The queue is a double-ended queue whose front part contains elements with the value of the most recently extracted
+ * element and whose back part contains elements with that value plus 1. A decreased element is inserted at the front
+ * again and its old entry is skipped when it is reached.
+ */
+
+typedef struct
+{
+  int numLive;    /**< \brief Number of elements. */
+  int memKeys;    /**< \brief Memory for keys. */
+  int current;    /**< \brief Value of the most recently extracted element, i.e., of the front part. */
+  int* values;    /**< \brief Array that maps keys to values. */
+  int* positions; /**< \brief Array that maps keys to their entry in \ref entries, or -1. */
+  int* entries;   /**< \brief Circular array of keys, including outdated ones. */
+  int memEntries; /**< \brief Memory for entries. */
+  int head;       /**< \brief Position of the front entry. */
+  int numEntries; /**< \brief Number of entries, including outdated ones. */
+} CMR_INTDEQUE;
+
+/**
+ * \brief Initializes an empty 0-1 queue using stack memory.
+ */
+
+CMR_ERROR CMRintdequeInitStack(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_INTDEQUE* deque,  /**< Queue pointer. */
+  int memKeys           /**< Maximum number of elements and bound on key entries. */
+);
+
+/**
+ * \brief Clears the given 0-1 queue.
+ */
+
+CMR_ERROR CMRintdequeClearStack(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_INTDEQUE* deque   /**< Queue pointer. */
+);
+
+/**
+ * \brief Decreases the value of \p key to \p newValue or inserts it.
+ *
+ * If the queue is nonempty, then \p newValue must be equal to the value of the most recently extracted element or
+ * exceed it by 1. Otherwise, an arbitrary value starts a new search.
+ */
+
+void CMRintdequeDecreaseInsert(
+  CMR_INTDEQUE* deque,  /**< Queue pointer. */
+  int key,              /**< Key of element. */
+  int newValue          /**< New value of element. */
+);
+
+/**
+ * \brief Extracts the minimum element and returns its key.
+ */
+
+int CMRintdequeExtractMinimum(
+  CMR_INTDEQUE* deque   /**< Queue pointer. */
+);
+
+/**
+ * \brief Type of a \ref CMR_INTQUEUE.
+ */
+
+typedef enum
+{
+  CMR_INTQUEUE_HEAP = 0,  /**< 4-ary heap; see \ref CMR_INTHEAP. */
+  CMR_INTQUEUE_RADIX = 1, /**< Monotone radix heap; see \ref CMR_INTRADIXHEAP. */
+  CMR_INTQUEUE_DEQUE = 2  /**< Monotone queue for values that differ by at most 1; see \ref CMR_INTDEQUE. */
+} CMR_INTQUEUE_TYPE;
+
+/**
+ * \brief Priority queue with int keys and values whose implementation is selected by the caller.
+ *
+ * Provides the operations needed for Dijkstra's algorithm. Only the member that corresponds to \ref type is used.
+ */
+
+typedef struct
+{
+  CMR_INTQUEUE_TYPE type;   /**< \brief Implementation. */
+  CMR_INTHEAP heap;         /**< \brief Heap for type \ref CMR_INTQUEUE_HEAP. */
+  CMR_INTRADIXHEAP radix;   /**< \brief Radix heap for type \ref CMR_INTQUEUE_RADIX. */
+  CMR_INTDEQUE deque;       /**< \brief Queue for type \ref CMR_INTQUEUE_DEQUE. */
+} CMR_INTQUEUE;
+
+/**
+ * \brief Initializes an empty queue of the given \p type using stack memory.
+ */
+
+CMR_ERROR CMRintqueueInitStack(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_INTQUEUE* queue,    /**< Queue pointer. */
+  CMR_INTQUEUE_TYPE type, /**< Implementation to use. */
+  int memKeys             /**< Maximum number of elements and bound on key entries. */
+);
+
+/**
+ * \brief Clears the given \p queue.
+ */
+
+CMR_ERROR CMRintqueueClearStack(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_INTQUEUE* queue   /**< Queue pointer. */
+);
+
+/**
+ * \brief Returns \c true if the queue is empty.
+ */
+
+static inline
+bool CMRintqueueEmpty(
+  CMR_INTQUEUE* queue /**< Queue pointer. */
+)
+{
+  if (queue->type == CMR_INTQUEUE_HEAP)
+    return queue->heap.size == 0;
+  else if (queue->type == CMR_INTQUEUE_RADIX)
+    return queue->radix.size == 0;
+  else
+    return queue->deque.numLive == 0;
+}
+
+/**
+ * \brief Returns the value of \p key or \c INT_MAX if there is no such element.
+ */
+
+static inline
+int CMRintqueueGetValueInfinity(
+  CMR_INTQUEUE* queue,  /**< Queue pointer. */
+  int key               /**< Key to be searched. */
+)
+{
+  if (queue->type == CMR_INTQUEUE_HEAP)
+    return CMRintheapGetValueInfinity(&queue->heap, key);
+  else if (queue->type == CMR_INTQUEUE_RADIX)
+    return queue->radix.buckets[key] >= 0 ? queue->radix.values[key] : INT_MAX;
+  else
+    return queue->deque.positions[key] >= 0 ? queue->deque.values[key] : INT_MAX;
+}
+
+/**
+ * \brief Decreases the value of \p key to \p newValue or inserts it.
+ */
+
+static inline
+void CMRintqueueDecreaseInsert(
+  CMR_INTQUEUE* queue,  /**< Queue pointer. */
+  int key,              /**< Key of element. */
+  int newValue          /**< New value of element. */
+)
+{
+  if (queue->type == CMR_INTQUEUE_HEAP)
+    CMRintheapDecreaseInsert(&queue->heap, key, newValue);
+  else if (queue->type == CMR_INTQUEUE_RADIX)
+    CMRintradixheapDecreaseInsert(&queue->radix, key, newValue);
+  else
+    CMRintdequeDecreaseInsert(&queue->deque, key, newValue);
+}
+
+/**
+ * \brief Extracts the minimum element and returns its key.
+ */
+
+static inline
+int CMRintqueueExtractMinimum(
+  CMR_INTQUEUE* queue,  /**< Queue pointer. */
+  int* pvalue           /**< Pointer for storing the value of the extracted element (may be \c NULL). */
+)
+{
+  int key;
+  if (queue->type == CMR_INTQUEUE_HEAP)
+  {
+    key = CMRintheapExtractMinimum(&queue->heap);
+    if (pvalue)
+      *pvalue = queue->heap.values[key];
+  }
+  else if (queue->type == CMR_INTQUEUE_RADIX)
+  {
+    key = CMRintradixheapExtractMinimum(&queue->radix);
+    if (pvalue)
+      *pvalue = queue->radix.values[key];
+  }
+  else
+  {
+    key = CMRintdequeExtractMinimum(&queue->deque);
+    if (pvalue)
+      *pvalue = queue->deque.values[key];
+  }
+  return key;
+}
+
 #ifdef __cplusplus
 }
 #endif
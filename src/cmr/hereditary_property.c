@@ -2,8 +2,10 @@
 // #define CMR_DEBUG_MATRICES /* Uncomment to debug the actual matrices. */
 
 #include "hereditary_property.h"
+#include "parallel.h"
+#include "sort.h"
+
 #include <stdint.h>
-#include <time.h>
 
 /**
  * \brief Tests a submatrix of the given \p current matrix for the hereditary property defined by a given
@@ -36,7 +38,7 @@ CMR_ERROR testHereditaryPropertyNaive(
   assert(remainingColumns || numRemainingColumns == current->numColumns);
 
   CMR_ERROR error = CMR_OKAY;
-  clock_t startTime = clock();
+  double startTime = CMRwallClock();
   double remainingTime;
 
   CMR_CHRMAT* candidateMatrix = NULL;
@@ -96,8 +98,7 @@ CMR_ERROR testHereditaryPropertyNaive(
 
     /* Invoke test. */
     bool hasProperty;
-    CMR_SUBMAT* submatrix = NULL;
-    remainingTime = timeLimit - (clock() - startTime) * 1.0 / CLOCKS_PER_SEC;
+    remainingTime = timeLimit - (CMRwallClock() - startTime);
     if (remainingTime < 0)
     {
       error = CMR_ERROR_TIMEOUT;
@@ -105,14 +106,12 @@ CMR_ERROR testHereditaryPropertyNaive(
     }
 
     CMRdbgMsg(4, "\n!!!     Hereditary property test queries the test oracle!!!\n\n");
-    error = testFunction(cmr, candidateMatrix, testData, &hasProperty, &submatrix, remainingTime);
+    error = testFunction(cmr, candidateMatrix, testData, &hasProperty, NULL, remainingTime);
     if (error != CMR_OKAY)
       goto cleanup;
 
     CMRdbgMsg(4, "\n!!! Property %s present.\n\n", hasProperty ? "IS" : "is NOT");
 
-    assert(!submatrix); // TODO: we cannot deal with this, yet.
-
     if (hasProperty)
     {
       if (removedRow < SIZE_MAX)
@@ -173,7 +172,169 @@ CMR_ERROR CMRtestHereditaryPropertyNaive(CMR* cmr, CMR_CHRMAT* matrix, Hereditar
   return error;
 }
 
-CMR_ERROR CMRtestHereditaryPropertyGreedy(CMR* cmr, CMR_CHRMAT* matrix, HereditaryPropertyTest testFunction,
+/**
+ * \brief Buffers of a single worker of the delta debugging search.
+ */
+
+typedef struct
+{
+  CMR_CHRMAT* candidate;    /**< \brief Buffer for the candidate submatrix, large enough for the whole matrix. */
+  size_t* columnsMap;       /**< \brief Maps columns of the matrix to columns of \ref candidate or to \c SIZE_MAX. */
+  size_t* candidateRows;    /**< \brief Maps rows of \ref candidate to rows of the matrix. */
+  size_t* candidateColumns; /**< \brief Maps columns of \ref candidate to columns of the matrix. */
+} DeltaDebuggingWorker;
+
+/**
+ * \brief State of the delta debugging search for a minimal violator.
+ *
+ * The current violator is a view on the original matrix, given by sorted arrays of its rows and columns. Its elements
+ * are the rows followed by the columns, and they are partitioned into \ref numChunks consecutive chunks.
+ */
+
+typedef struct
+{
+  CMR* cmr;                             /**< \brief \ref CMR environment of the caller. */
+  CMR_CHRMAT* matrix;                   /**< \brief Original matrix. */
+  HereditaryPropertyTest testFunction;  /**< \brief Test function. */
+  void* testData;                       /**< \brief Data to be forwarded to the test function. */
+  size_t numRows;                       /**< \brief Number of rows of the current violator. */
+  size_t* rows;                         /**< \brief Rows of the current violator. */
+  size_t numColumns;                    /**< \brief Number of columns of the current violator. */
+  size_t* columns;                      /**< \brief Columns of the current violator. */
+  size_t numChunks;                     /**< \brief Number of chunks the elements are partitioned into. */
+  DeltaDebuggingWorker* workers;        /**< \brief Buffers of the workers. */
+  CMR_SUBMAT** chunkViolators;          /**< \brief Violators returned by the test function for each chunk, with
+                                         **         respect to the matrix. */
+  double startTime;                     /**< \brief Wall clock time at the start of the search. */
+  double timeLimit;                     /**< \brief Time limit to impose. */
+} DeltaDebuggingSearch;
+
+/**
+ * \brief Returns the first element of the given \p chunk.
+ */
+
+static
+size_t deltaDebuggingChunkStart(
+  DeltaDebuggingSearch* search, /**< Search state. */
+  size_t chunk                  /**< Chunk index; \ref DeltaDebuggingSearch::numChunks is allowed. */
+)
+{
+  return ((search->numRows + search->numColumns) * chunk) / search->numChunks;
+}
+
+/**
+ * \brief Tests whether the current violator without the given chunk still violates the property.
+ *
+ * The candidate is materialized into the worker's buffer with consecutive row and column indices.
+ */
+
+static
+CMR_ERROR deltaDebuggingTask(
+  CMR* cmr,         /**< \ref CMR environment of the worker. */
+  size_t chunk,     /**< Chunk to be removed. */
+  void* data,       /**< Pointer to the \ref DeltaDebuggingSearch. */
+  bool* pviolated   /**< Pointer for storing whether the candidate does not have the property. */
+)
+{
+  assert(cmr);
+  assert(data);
+  assert(pviolated);
+
+  DeltaDebuggingSearch* search = (DeltaDebuggingSearch*) data;
+  DeltaDebuggingWorker* worker = &search->workers[CMRparallelWorkerIndex(search->cmr, cmr)];
+  CMR_CHRMAT* matrix = search->matrix;
+  CMR_CHRMAT* candidate = worker->candidate;
+  size_t firstRemoved = deltaDebuggingChunkStart(search, chunk);
+  size_t beyondRemoved = deltaDebuggingChunkStart(search, chunk + 1);
+
+  *pviolated = false;
+
+  /* Elements 0, ..., numRows - 1 are rows and the remaining ones are columns. */
+  size_t numRemovedRows = 0;
+  if (firstRemoved < search->numRows)
+    numRemovedRows = (beyondRemoved < search->numRows ? beyondRemoved : search->numRows) - firstRemoved;
+  size_t numRemovedColumns = (beyondRemoved - firstRemoved) - numRemovedRows;
+  if (numRemovedRows == search->numRows || numRemovedColumns == search->numColumns)
+  {
+    CMRdbgMsg(4, "Skipping chunk %zu of %zu since the candidate would be empty.\n", chunk, search->numChunks);
+    return CMR_OKAY;
+  }
+
+  double remainingTime = search->timeLimit - (CMRwallClock() - search->startTime);
+  if (remainingTime < 0)
+    return CMR_ERROR_TIMEOUT;
+
+  candidate->numRows = 0;
+  candidate->numColumns = 0;
+  for (size_t c = 0; c < search->numColumns; ++c)
+  {
+    size_t element = search->numRows + c;
+    if (element < firstRemoved || element >= beyondRemoved)
+    {
+      worker->candidateColumns[candidate->numColumns] = search->columns[c];
+      worker->columnsMap[search->columns[c]] = candidate->numColumns++;
+    }
+  }
+  candidate->numNonzeros = 0;
+  for (size_t r = 0; r < search->numRows; ++r)
+  {
+    if (r >= firstRemoved && r < beyondRemoved)
+      continue;
+
+    size_t row = search->rows[r];
+    worker->candidateRows[candidate->numRows] = row;
+    candidate->rowSlice[candidate->numRows++] = candidate->numNonzeros;
+    size_t first = matrix->rowSlice[row];
+    size_t beyond = matrix->rowSlice[row + 1];
+    for (size_t e = first; e < beyond; ++e)
+    {
+      size_t column = worker->columnsMap[matrix->entryColumns[e]];
+      if (column < SIZE_MAX)
+      {
+        candidate->entryColumns[candidate->numNonzeros] = column;
+        candidate->entryValues[candidate->numNonzeros] = matrix->entryValues[e];
+        candidate->numNonzeros++;
+      }
+    }
+  }
+  candidate->rowSlice[candidate->numRows] = candidate->numNonzeros;
+  for (size_t c = 0; c < search->numColumns; ++c)
+    worker->columnsMap[search->columns[c]] = SIZE_MAX;
+
+  CMRdbgMsg(4, "Chunk %zu of %zu yields a %zux%zu candidate with %zu nonzeros.\n", chunk, search->numChunks,
+    candidate->numRows, candidate->numColumns, candidate->numNonzeros);
+#ifdef CMR_DEBUG_MATRICES
+  CMR_CALL( CMRchrmatPrintDense(cmr, candidate, stdout, '0', true) );
+#endif /* CMR_DEBUG_MATRICES */
+
+  bool hasProperty;
+  CMR_SUBMAT* submatrix = NULL;
+  CMR_ERROR error = search->testFunction(cmr, candidate, search->testData, &hasProperty, &submatrix, remainingTime);
+  if (error != CMR_OKAY)
+    return error;
+
+  CMRdbgMsg(4, "Property %s present.\n", hasProperty ? "IS" : "is NOT");
+  *pviolated = !hasProperty;
+
+  /* A violator of the candidate found by the test function is a violator of the matrix. */
+  if (submatrix && !hasProperty)
+  {
+    for (size_t r = 0; r < submatrix->numRows; ++r)
+      submatrix->rows[r] = worker->candidateRows[submatrix->rows[r]];
+    for (size_t c = 0; c < submatrix->numColumns; ++c)
+      submatrix->columns[c] = worker->candidateColumns[submatrix->columns[c]];
+    CMR_CALL( CMRsort(cmr, submatrix->numRows, submatrix->rows, sizeof(size_t), CMRsortCompareIndices) );
+    CMR_CALL( CMRsort(cmr, submatrix->numColumns, submatrix->columns, sizeof(size_t), CMRsortCompareIndices) );
+    CMRdbgMsg(4, "Test function returned a %zux%zu violator.\n", submatrix->numRows, submatrix->numColumns);
+    search->chunkViolators[chunk] = submatrix;
+  }
+  else if (submatrix)
+    CMR_CALL( CMRsubmatFree(cmr, &submatrix) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRtestHereditaryPropertyDeltaDebugging(CMR* cmr, CMR_CHRMAT* matrix, HereditaryPropertyTest testFunction,
   void* testData, CMR_SUBMAT** psubmatrix, double timeLimit)
 {
   assert(cmr);
@@ -181,185 +342,145 @@ CMR_ERROR CMRtestHereditaryPropertyGreedy(CMR* cmr, CMR_CHRMAT* matrix, Heredita
   assert(testFunction);
   assert(psubmatrix);
 
-  clock_t startTime = clock();
-  double remainingTime;
-
-  /* Remaining rows/column are those that we have restricted ourself to already. */
-  size_t* remainingRows = NULL;
-  size_t numRemainingRows = matrix->numRows;
-  CMR_CALL( CMRallocStackArray(cmr, &remainingRows, matrix->numRows) );
+  DeltaDebuggingSearch search;
+  search.cmr = cmr;
+  search.matrix = matrix;
+  search.testFunction = testFunction;
+  search.testData = testData;
+  search.startTime = CMRwallClock();
+  search.timeLimit = timeLimit;
+  search.numRows = matrix->numRows;
+  search.rows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.rows, matrix->numRows) );
   for (size_t row = 0; row < matrix->numRows; ++row)
-    remainingRows[row] = row;
-  size_t* remainingColumns = NULL;
-  size_t numRemainingColumns = matrix->numColumns;
-  CMR_CALL( CMRallocStackArray(cmr, &remainingColumns, matrix->numColumns) );
+    search.rows[row] = row;
+  search.numColumns = matrix->numColumns;
+  search.columns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.columns, matrix->numColumns) );
   for (size_t column = 0; column < matrix->numColumns; ++column)
-    remainingColumns[column] = column;
-  CMR_CHRMAT* remainingMatrix = NULL;
-  CMR_CALL( CMRchrmatCopy(cmr, matrix, &remainingMatrix) );
-
-  /* Candidate rows/columns are a subset of the remaining ones that we inspect. */
-  size_t* candidateRows = NULL;
-  size_t numCandidateRows;
-  CMR_CALL( CMRallocStackArray(cmr, &candidateRows, matrix->numRows) );
-  size_t numCandidateColumns;
-  bool* columnsCandidate = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &columnsCandidate, matrix->numColumns) );
-  CMR_CHRMAT* candidateMatrix = NULL;
-  CMR_CALL( CMRchrmatCreate(cmr, &candidateMatrix, matrix->numRows, matrix->numColumns, matrix->numNonzeros) );
-  candidateMatrix->numNonzeros = 0;
+    search.columns[column] = column;
+
+  size_t numWorkers = CMRparallelNumWorkers(cmr);
+  search.workers = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.workers, numWorkers) );
+  for (size_t w = 0; w < numWorkers; ++w)
+  {
+    DeltaDebuggingWorker* worker = &search.workers[w];
+    worker->candidate = NULL;
+    CMR_CALL( CMRchrmatCreate(cmr, &worker->candidate, matrix->numRows, matrix->numColumns, matrix->numNonzeros) );
+    worker->columnsMap = NULL;
+    CMR_CALL( CMRallocBlockArray(cmr, &worker->columnsMap, matrix->numColumns) );
+    for (size_t column = 0; column < matrix->numColumns; ++column)
+      worker->columnsMap[column] = SIZE_MAX;
+    worker->candidateRows = NULL;
+    CMR_CALL( CMRallocBlockArray(cmr, &worker->candidateRows, matrix->numRows) );
+    worker->candidateColumns = NULL;
+    CMR_CALL( CMRallocBlockArray(cmr, &worker->candidateColumns, matrix->numColumns) );
+  }
+  search.chunkViolators = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.chunkViolators, matrix->numRows + matrix->numColumns) );
+  for (size_t chunk = 0; chunk < matrix->numRows + matrix->numColumns; ++chunk)
+    search.chunkViolators[chunk] = NULL;
 
-  CMRdbgMsg(0, "Greedily searching minimal violator of %zux%zu matrix.\n", matrix->numRows, matrix->numColumns);
+  CMRdbgMsg(0, "Delta debugging search for minimal violator of %zux%zu matrix using %zu workers.\n", matrix->numRows,
+    matrix->numColumns, numWorkers);
 #ifdef CMR_DEBUG_MATRICES
   CMR_CALL( CMRchrmatPrintDense(cmr, matrix, stdout, '0', true) );
 #endif /* CMR_DEBUG_MATRICES */
 
   CMR_ERROR error = CMR_OKAY;
-  for (size_t numChunks = 16; numChunks >= 4; numChunks /= 2)
+  search.numChunks = 2;
+  while (true)
   {
-    CMRdbgMsg(2, "Remaining matrix is %zux%zu.\n", numRemainingRows, numRemainingColumns);
-
-    double fraction = 1.0 / numChunks;
-    for (size_t elementChunk = 0; elementChunk < 2 * numChunks; ++elementChunk)
-    {
-      size_t firstRemainingRow = 0;
-      size_t beyondRemainingRow = numRemainingRows;
-      size_t firstRemainingColumn = 0;
-      size_t beyondRemainingColumn = numRemainingColumns;
-      if (elementChunk < numChunks)
-      {
-        firstRemainingRow = (size_t)(fraction * elementChunk * numRemainingRows);
-        if (elementChunk + 1 < numChunks)
-          beyondRemainingRow = (size_t)(fraction * (elementChunk + 1) * numRemainingRows);
-      }
-      else
-      {
-        firstRemainingColumn = (size_t)(fraction * (elementChunk - numChunks) * numRemainingColumns );
-        if (elementChunk + 1 < 2 * numChunks)
-          beyondRemainingColumn = (size_t)(fraction * (elementChunk - numChunks + 1) * numRemainingColumns);
-      }
+    size_t numElements = search.numRows + search.numColumns;
+    if (search.numChunks > numElements)
+      search.numChunks = numElements;
 
-      numCandidateRows = beyondRemainingRow - firstRemainingRow;
-      numCandidateColumns = beyondRemainingColumn - firstRemainingColumn;
+    CMRdbgMsg(2, "Current violator is %zux%zu; testing complements of %zu chunks.\n", search.numRows,
+      search.numColumns, search.numChunks);
 
-      if (numCandidateRows < 2 || numCandidateColumns < 2)
-        continue;
+    size_t removedChunk;
+    error = CMRparallelFindFirst(cmr, search.numChunks, deltaDebuggingTask, &search, &removedChunk);
 
-      for (size_t r = 0; r < numCandidateRows; ++r)
-        candidateRows[r] = remainingRows[firstRemainingRow + r];
-      for (size_t column = 0; column < matrix->numColumns; ++column)
-        columnsCandidate[column] = false;
-      for (size_t c = firstRemainingColumn; c < beyondRemainingColumn; ++c)
-        columnsCandidate[remainingColumns[c]] = true;
-
-#ifdef CMR_DEBUG
-      CMRdbgMsg(4, "Chunk #%zu of 2*%zu restricts to %zux%zu matrix.\n", elementChunk, numChunks,
-        numCandidateRows, numCandidateColumns);
-      CMRdbgMsg(6, "Rows:   ");
-      for (size_t r = 0; r < numCandidateRows; ++r)
-        printf(" r%zu", candidateRows[r] + 1);
-      CMRdbgMsg(0, "\n");
-      CMRdbgMsg(6, "Columns:");
-      for (size_t column = 0; column < matrix->numColumns; ++column)
-      {
-        if (columnsCandidate[column])
-          printf(" c%zu", column + 1);
-      }
-      CMRdbgMsg(0, "\n");
-#endif /* CMR_DEBUG */
+    CMR_SUBMAT* violator = NULL;
+    for (size_t chunk = 0; chunk < search.numChunks; ++chunk)
+    {
+      if (chunk == removedChunk)
+        violator = search.chunkViolators[chunk];
+      else if (search.chunkViolators[chunk])
+        CMR_CALL( CMRsubmatFree(cmr, &search.chunkViolators[chunk]) );
+      search.chunkViolators[chunk] = NULL;
+    }
+    if (error != CMR_OKAY)
+    {
+      if (violator)
+        CMR_CALL( CMRsubmatFree(cmr, &violator) );
+      goto cleanup;
+    }
 
-      /* Extract the candidate matrix. */
-      candidateMatrix->numNonzeros = 0;
-      size_t nextRow = 0;
-      for (size_t r = 0; r < numCandidateRows; ++r)
+    if (violator)
+    {
+      /* Restart on the (smaller) violator found by the test function. */
+      search.numRows = violator->numRows;
+      for (size_t r = 0; r < violator->numRows; ++r)
+        search.rows[r] = violator->rows[r];
+      search.numColumns = violator->numColumns;
+      for (size_t c = 0; c < violator->numColumns; ++c)
+        search.columns[c] = violator->columns[c];
+      search.numChunks = 2;
+      CMR_CALL( CMRsubmatFree(cmr, &violator) );
+    }
+    else if (removedChunk < SIZE_MAX)
+    {
+      /* Remove the elements of the chunk from the rows and columns, maintaining their order. */
+      size_t firstRemoved = deltaDebuggingChunkStart(&search, removedChunk);
+      size_t beyondRemoved = deltaDebuggingChunkStart(&search, removedChunk + 1);
+      size_t numRows = 0;
+      for (size_t r = 0; r < search.numRows; ++r)
       {
-        size_t candidateRow = candidateRows[r];
-        for (; nextRow <= candidateRow; ++nextRow)
-          candidateMatrix->rowSlice[nextRow] = candidateMatrix->numNonzeros;
-
-        size_t first = remainingMatrix->rowSlice[candidateRow];
-        size_t beyond = remainingMatrix->rowSlice[candidateRow + 1];
-        for (size_t e = first; e < beyond; ++e)
-        {
-          size_t column = remainingMatrix->entryColumns[e];
-          if (columnsCandidate[column])
-          {
-            candidateMatrix->entryColumns[candidateMatrix->numNonzeros] = column;
-            candidateMatrix->entryValues[candidateMatrix->numNonzeros] = remainingMatrix->entryValues[e];
-            candidateMatrix->numNonzeros++;
-          }
-        }
+        if (r < firstRemoved || r >= beyondRemoved)
+          search.rows[numRows++] = search.rows[r];
       }
-      for (; nextRow <= matrix->numRows; ++nextRow)
-        candidateMatrix->rowSlice[nextRow] = candidateMatrix->numNonzeros;
-      CMRdbgMsg(4, "Candidate (sub)matrix has %zu nonzeros.\n", candidateMatrix->numNonzeros);
-#ifdef CMR_DEBUG_MATRICES
-      CMR_CALL( CMRchrmatPrintDense(cmr, candidateMatrix, stdout, '0', true) );
-#endif /* CMR_DEBUG_MATRICES */
-
-
-      /* Invoke test. */
-      bool hasProperty;
-      CMR_SUBMAT* submatrix = NULL;
-      remainingTime = timeLimit - (clock() - startTime) * 1.0 / CLOCKS_PER_SEC;
-      if (remainingTime < 0)
+      size_t numColumns = 0;
+      for (size_t c = 0; c < search.numColumns; ++c)
       {
-        error = CMR_ERROR_TIMEOUT;
-        goto cleanup;
+        size_t element = search.numRows + c;
+        if (element < firstRemoved || element >= beyondRemoved)
+          search.columns[numColumns++] = search.columns[c];
       }
+      search.numRows = numRows;
+      search.numColumns = numColumns;
+      search.numChunks = search.numChunks > 2 ? search.numChunks - 1 : 2;
+    }
+    else if (search.numChunks < numElements)
+      search.numChunks *= 2;
+    else
+      break;
+  }
 
-      CMRdbgMsg(4, "\n!!!     Hereditary property test queries the test oracle!!!\n\n");
-      error = testFunction(cmr, candidateMatrix, testData, &hasProperty, &submatrix, remainingTime);
-      if (error != CMR_OKAY)
-        goto cleanup;
-
-      CMRdbgMsg(4, "\n!!! Property %s present.\n\n", hasProperty ? "IS" : "is NOT");
+  CMRdbgMsg(2, "Extracting a %zux%zu submatrix.\n", search.numRows, search.numColumns);
 
-      assert(!submatrix); // TODO: we cannot deal with this, yet.
+  /* Since no single row or column can be removed, the violator is minimal. */
+  CMR_CALL( CMRsubmatCreate(cmr, search.numRows, search.numColumns, psubmatrix) );
+  CMR_SUBMAT* submatrix = *psubmatrix;
+  for (size_t r = 0; r < search.numRows; ++r)
+    submatrix->rows[r] = search.rows[r];
+  for (size_t c = 0; c < search.numColumns; ++c)
+    submatrix->columns[c] = search.columns[c];
 
-      if (!hasProperty)
-      {
-        /* Update remaining rows/columns. */
-        numRemainingRows = numCandidateRows;
-        for (size_t r = 0; r < numRemainingRows; ++r)
-          remainingRows[r] = candidateRows[r];
-        numRemainingColumns = numCandidateColumns;
-        size_t c = 0;
-        for (size_t column = 0; column < matrix->numColumns; ++column)
-        {
-          if (columnsCandidate[column])
-            remainingColumns[c++] = column;
-        }
-
-        /* Swap candidateMatrix and remainingMatrix. */
-        CMR_CHRMAT* temp = candidateMatrix;
-        candidateMatrix = remainingMatrix;
-        remainingMatrix = temp;
-
-        /* Ensure that #chunks does not change. */
-        numChunks *= 2;
-        break;
-      }
-    }
-  }
+cleanup:
 
-  remainingTime = timeLimit - (clock() - startTime) * 1.0 / CLOCKS_PER_SEC;
-  if (remainingTime < 0)
-    error = CMR_ERROR_TIMEOUT;
-  else
+  CMR_CALL( CMRfreeStackArray(cmr, &search.chunkViolators) );
+  for (size_t w = numWorkers; w > 0; --w)
   {
-    error = testHereditaryPropertyNaive(cmr, remainingMatrix, testFunction, testData, psubmatrix, numRemainingRows,
-      remainingRows, numRemainingColumns, remainingColumns, remainingTime);
-    remainingMatrix = NULL;
+    CMR_CALL( CMRfreeBlockArray(cmr, &search.workers[w - 1].candidateColumns) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &search.workers[w - 1].candidateRows) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &search.workers[w - 1].columnsMap) );
+    CMR_CALL( CMRchrmatFree(cmr, &search.workers[w - 1].candidate) );
   }
-
-cleanup:
-  CMR_CALL( CMRchrmatFree(cmr, &candidateMatrix) );
-  CMR_CALL( CMRfreeStackArray(cmr, &columnsCandidate) );
-  CMR_CALL( CMRfreeStackArray(cmr, &candidateRows) );
-  CMR_CALL( CMRchrmatFree(cmr, &remainingMatrix) );
-  CMR_CALL( CMRfreeStackArray(cmr, &remainingColumns) );
-  CMR_CALL( CMRfreeStackArray(cmr, &remainingRows) );
+  CMR_CALL( CMRfreeStackArray(cmr, &search.workers) );
+  CMR_CALL( CMRfreeStackArray(cmr, &search.columns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &search.rows) );
 
   return error;
 }
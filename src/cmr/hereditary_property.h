@@ -6,7 +6,7 @@
 #include <cmr/matrix.h>
 #include <cmr/element.h>
 
-#ifdef __cplus
+#ifdef __cplusplus
 extern "C" {
 #endif
 
@@ -15,7 +15,8 @@ typedef CMR_ERROR (*HereditaryPropertyTest)(
   CMR_CHRMAT* matrix,       /**< Some matrix to be tested for the property. */
   void* data,               /**< Potential additional data for the test function. */
   bool* phasProperty,       /**< Pointer for storing whether \p matrix has the property. */
-  CMR_SUBMAT** psubmatrix,  /**< Pointer for storing a proper submatrix of \p matrix without the property. */
+  CMR_SUBMAT** psubmatrix,  /**< Pointer for storing a proper submatrix of \p matrix without the property
+                             **  (may be \c NULL). */
   double timeLimit          /**< Time limit to impose. */
 ); /**< Function pointer for functions that test a hereditary matrix property. */
 
@@ -35,12 +36,20 @@ CMR_ERROR CMRtestHereditaryPropertyNaive(
 );
 
 /**
- * \brief Greedily tests a given \p matrix for the hereditary property defined by a given \p testFunction.
+ * \brief Tests a given \p matrix for the hereditary property defined by a given \p testFunction via delta debugging.
+ *
+ * The rows and columns of the current violator are partitioned into \f$ n \f$ chunks, starting with \f$ n = 2 \f$.
+ * If removing some chunk yields a violator, then the first such chunk is removed and \f$ n \f$ is decreased by 1.
+ * Otherwise, \f$ n \f$ is doubled, and the search terminates if every chunk consists of a single row or column.
+ * Candidates are materialized as compact matrices from the row and column indices of the current violator. If
+ * \p testFunction returns a violating submatrix of a candidate, then the search continues from that submatrix.
  *
- * The algorithm finds the submatrix by successively zeroing out sets of rows or columns.
+ * The candidates of one round are tested in parallel by \ref CMRparallelNumWorkers workers, each using its own
+ * \ref CMR environment. Hence, \p testFunction must be thread-safe with respect to \p testData in that case. The result
+ * does not depend on the number of workers.
  */
 
-CMR_ERROR CMRtestHereditaryPropertyGreedy(
+CMR_ERROR CMRtestHereditaryPropertyDeltaDebugging(
   CMR* cmr,                             /**< \ref CMR environment. */
   CMR_CHRMAT* matrix,                   /**< Some matrix not having the hereditary property. */
   HereditaryPropertyTest testFunction,  /**< Test function. */
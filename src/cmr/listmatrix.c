@@ -6,6 +6,128 @@
 #include <stdint.h>
 #include <math.h>
 
+/**
+ * \brief Returns the additional slabs of nonzeros of an 8-bit list matrix to the pool.
+ *
+ * Afterwards, the array of nonzeros has space for at least \p memNonzeros nonzeros.
+ */
+
+static
+CMR_ERROR listmat8ResetNonzeros(
+  CMR* cmr,             /**< \ref CMR environment. */
+  ListMat8* listmatrix, /**< List matrix. */
+  size_t memNonzeros    /**< Required memory for nonzeros. */
+)
+{
+  while (listmatrix->moreNonzeros)
+  {
+    ListMat8Nonzero* slab = listmatrix->moreNonzeros;
+    listmatrix->moreNonzeros = slab->right;
+    CMR_CALL( CMRfreeSlabArray(cmr, &slab) );
+  }
+
+  if (listmatrix->memNonzeros < memNonzeros)
+  {
+    CMR_CALL( CMRfreeSlabArray(cmr, &listmatrix->nonzeros) );
+    listmatrix->memNonzeros = memNonzeros;
+    CMR_CALL( CMRallocSlabArray(cmr, &listmatrix->nonzeros, memNonzeros) );
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Adds a slab of free nonzeros to an 8-bit list matrix without moving the existing ones.
+ *
+ * The first entry of the slab is not used as a nonzero but links the additional slabs and stores the size.
+ */
+
+static
+CMR_ERROR listmat8AddNonzeros(
+  CMR* cmr,             /**< \ref CMR environment. */
+  ListMat8* listmatrix  /**< List matrix. */
+)
+{
+  size_t size = 2 * (listmatrix->moreNonzeros ? listmatrix->moreNonzeros->row : listmatrix->memNonzeros);
+  if (size < 256)
+    size = 256;
+  CMRdbgMsg(10, "Adding a slab for %zu nonzeros to listmat8.\n", size);
+
+  ListMat8Nonzero* slab = NULL;
+  CMR_CALL( CMRallocSlabArray(cmr, &slab, size + 1) );
+  slab[0].row = size;
+  slab[0].right = listmatrix->moreNonzeros;
+  listmatrix->moreNonzeros = slab;
+
+  for (size_t i = 1; i < size; ++i)
+    slab[i].right = &slab[i + 1];
+  slab[size].right = listmatrix->firstFreeNonzero;
+  listmatrix->firstFreeNonzero = &slab[1];
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Returns the additional slabs of nonzeros of an 64-bit list matrix to the pool.
+ *
+ * Afterwards, the array of nonzeros has space for at least \p memNonzeros nonzeros.
+ */
+
+static
+CMR_ERROR listmat64ResetNonzeros(
+  CMR* cmr,             /**< \ref CMR environment. */
+  ListMat64* listmatrix, /**< List matrix. */
+  size_t memNonzeros    /**< Required memory for nonzeros. */
+)
+{
+  while (listmatrix->moreNonzeros)
+  {
+    ListMat64Nonzero* slab = listmatrix->moreNonzeros;
+    listmatrix->moreNonzeros = slab->right;
+    CMR_CALL( CMRfreeSlabArray(cmr, &slab) );
+  }
+
+  if (listmatrix->memNonzeros < memNonzeros)
+  {
+    CMR_CALL( CMRfreeSlabArray(cmr, &listmatrix->nonzeros) );
+    listmatrix->memNonzeros = memNonzeros;
+    CMR_CALL( CMRallocSlabArray(cmr, &listmatrix->nonzeros, memNonzeros) );
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Adds a slab of free nonzeros to an 64-bit list matrix without moving the existing ones.
+ *
+ * The first entry of the slab is not used as a nonzero but links the additional slabs and stores the size.
+ */
+
+static
+CMR_ERROR listmat64AddNonzeros(
+  CMR* cmr,             /**< \ref CMR environment. */
+  ListMat64* listmatrix  /**< List matrix. */
+)
+{
+  size_t size = 2 * (listmatrix->moreNonzeros ? listmatrix->moreNonzeros->row : listmatrix->memNonzeros);
+  if (size < 256)
+    size = 256;
+  CMRdbgMsg(10, "Adding a slab for %zu nonzeros to listmat64.\n", size);
+
+  ListMat64Nonzero* slab = NULL;
+  CMR_CALL( CMRallocSlabArray(cmr, &slab, size + 1) );
+  slab[0].row = size;
+  slab[0].right = listmatrix->moreNonzeros;
+  listmatrix->moreNonzeros = slab;
+
+  for (size_t i = 1; i < size; ++i)
+    slab[i].right = &slab[i + 1];
+  slab[size].right = listmatrix->firstFreeNonzero;
+  listmatrix->firstFreeNonzero = &slab[1];
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRlistmat8Alloc(CMR* cmr, size_t memRows, size_t memColumns, size_t memNonzeros, ListMat8** presult)
 {
   assert(cmr);
@@ -27,7 +149,9 @@ CMR_ERROR CMRlistmat8Alloc(CMR* cmr, size_t memRows, size_t memColumns, size_t m
   result->memNonzeros = memNonzeros;
   result->numNonzeros = 0;
   result->nonzeros = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &result->nonzeros, memNonzeros) );
+  CMR_CALL( CMRallocSlabArray(cmr, &result->nonzeros, memNonzeros) );
+  result->firstFreeNonzero = NULL;
+  result->moreNonzeros = NULL;
 
   return CMR_OKAY;
 }
@@ -53,7 +177,9 @@ CMR_ERROR CMRlistmat64Alloc(CMR* cmr, size_t memRows, size_t memColumns, size_t
   result->memNonzeros = memNonzeros;
   result->numNonzeros = 0;
   result->nonzeros = NULL;
-  CMR_CALL( CMRallocBlockArray(cmr, &result->nonzeros, memNonzeros) );
+  CMR_CALL( CMRallocSlabArray(cmr, &result->nonzeros, memNonzeros) );
+  result->firstFreeNonzero = NULL;
+  result->moreNonzeros = NULL;
 
   return CMR_OKAY;
 }
@@ -99,7 +225,8 @@ CMR_ERROR CMRlistmat8Free(CMR* cmr, ListMat8** plistmatrix)
   if (!listmatrix)
     return CMR_OKAY;
 
-  CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->nonzeros) );
+  CMR_CALL( listmat8ResetNonzeros(cmr, listmatrix, 0) );
+  CMR_CALL( CMRfreeSlabArray(cmr, &listmatrix->nonzeros) );
   CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->rowElements) );
   CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->columnElements) );
   CMR_CALL( CMRfreeBlock(cmr, plistmatrix) );
@@ -116,7 +243,8 @@ CMR_ERROR CMRlistmat64Free(CMR* cmr, ListMat64** plistmatrix)
   if (!listmatrix)
     return CMR_OKAY;
 
-  CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->nonzeros) );
+  CMR_CALL( listmat64ResetNonzeros(cmr, listmatrix, 0) );
+  CMR_CALL( CMRfreeSlabArray(cmr, &listmatrix->nonzeros) );
   CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->rowElements) );
   CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->columnElements) );
   CMR_CALL( CMRfreeBlock(cmr, plistmatrix) );
@@ -243,6 +371,8 @@ CMR_ERROR CMRlistmat8InitializeZero(CMR* cmr, ListMat8* listmatrix, size_t numRo
   }
 
   /* Initialize the free list. */
+  CMR_CALL( listmat8ResetNonzeros(cmr, listmatrix, 0) );
+  listmatrix->firstFreeNonzero = NULL;
   if (listmatrix->memNonzeros > 0)
   {
     listmatrix->firstFreeNonzero = &listmatrix->nonzeros[0];
@@ -353,6 +483,8 @@ CMR_ERROR CMRlistmat64InitializeZero(CMR* cmr, ListMat64* listmatrix, size_t num
   }
 
   /* Initialize the free list. */
+  CMR_CALL( listmat64ResetNonzeros(cmr, listmatrix, 0) );
+  listmatrix->firstFreeNonzero = NULL;
   if (listmatrix->memNonzeros > 0)
   {
     listmatrix->firstFreeNonzero = &listmatrix->nonzeros[0];
@@ -489,11 +621,7 @@ CMR_ERROR CMRlistmat8InitializeFromChrMatrix(CMR* cmr, ListMat8* listmatrix, CMR
   assert(matrix);
 
   /* Reallocate if necessary. */
-  if (listmatrix->memNonzeros < matrix->numNonzeros)
-  {
-    listmatrix->memNonzeros = matrix->numNonzeros;
-    CMR_CALL( CMRreallocBlockArray(cmr, &listmatrix->nonzeros, matrix->numNonzeros) );
-  }
+  CMR_CALL( listmat8ResetNonzeros(cmr, listmatrix, matrix->numNonzeros) );
   listmatrix->numNonzeros = matrix->numNonzeros;
 
   /* Initialze the zero matrix. */
@@ -559,11 +687,7 @@ CMR_ERROR CMRlistmat64InitializeFromIntMatrix(CMR* cmr, ListMat64* listmatrix, C
   assert(matrix);
 
   /* Reallocate if necessary. */
-  if (listmatrix->memNonzeros < matrix->numNonzeros)
-  {
-    listmatrix->memNonzeros = matrix->numNonzeros;
-    CMR_CALL( CMRreallocBlockArray(cmr, &listmatrix->nonzeros, matrix->numNonzeros) );
-  }
+  CMR_CALL( listmat64ResetNonzeros(cmr, listmatrix, matrix->numNonzeros) );
   listmatrix->numNonzeros = matrix->numNonzeros;
 
   /* Initialze the zero matrix. */
@@ -704,11 +828,7 @@ CMR_ERROR CMRlistmat8InitializeFromDoubleMatrix(CMR* cmr, ListMat8* listmatrix,
   assert(epsilon >= 0);
 
   /* Reallocate if necessary. */
-  if (listmatrix->memNonzeros < matrix->numNonzeros)
-  {
-    listmatrix->memNonzeros = matrix->numNonzeros;
-    CMR_CALL( CMRreallocBlockArray(cmr, &listmatrix->nonzeros, matrix->numNonzeros) );
-  }
+  CMR_CALL( listmat8ResetNonzeros(cmr, listmatrix, matrix->numNonzeros) );
   listmatrix->numNonzeros = matrix->numNonzeros;
 
   /* Initialze the zero matrix. */
@@ -782,11 +902,7 @@ CMR_ERROR CMRlistmat64InitializeFromDoubleMatrix(CMR* cmr, ListMat64* listmatrix
   assert(epsilon >= 0);
 
   /* Reallocate if necessary. */
-  if (listmatrix->memNonzeros < matrix->numNonzeros)
-  {
-    listmatrix->memNonzeros = matrix->numNonzeros;
-    CMR_CALL( CMRreallocBlockArray(cmr, &listmatrix->nonzeros, matrix->numNonzeros) );
-  }
+  CMR_CALL( listmat64ResetNonzeros(cmr, listmatrix, matrix->numNonzeros) );
   listmatrix->numNonzeros = matrix->numNonzeros;
 
   /* Initialze the zero matrix. */
@@ -1002,10 +1118,8 @@ CMR_ERROR CMRlistmat8InitializeFromChrSubmatrix(CMR* cmr, ListMat8* listmatrix,
   if (listmatrix->numNonzeros < listmatrix->memNonzeros)
   {
     listmatrix->firstFreeNonzero = &listmatrix->nonzeros[listmatrix->numNonzeros];
-    for (size_t i = listmatrix->numNonzeros; i < listmatrix->memNonzeros; ++i)
-    {
+    for (size_t i = listmatrix->numNonzeros; i < listmatrix->memNonzeros - 1; ++i)
       listmatrix->nonzeros[i].right = &listmatrix->nonzeros[i + 1];
-    }
     listmatrix->nonzeros[listmatrix->memNonzeros-1].right = NULL;
   }
   else
@@ -1518,67 +1632,10 @@ CMR_ERROR CMRlistmat8Insert(CMR* cmr, ListMat8* listmatrix, size_t row, size_t c
   assert(row < listmatrix->numRows);
   assert(column < listmatrix->numColumns);
 
+  /* Existing nonzeros never move since additional memory is taken from a new slab. */
   if (!listmatrix->firstFreeNonzero)
-  {
-    CMRdbgMsg(10, "Reallocating listmat8's nonzeros.\n");
-    assert(listmatrix->numNonzeros == listmatrix->memNonzeros);
-    size_t newSize = 2 * listmatrix->memNonzeros;
-    if (newSize < 256)
-      newSize = 256;
-    CMRdbgMsg(10, "New size is %zu.\n", newSize);
-    ListMat8Nonzero* newNonzeros = NULL;
-    CMR_CALL( CMRallocBlockArray(cmr, &newNonzeros, newSize) );
-    ptrdiff_t memoryShift = newNonzeros - listmatrix->nonzeros;
-
-    /* Shift all pointers to other nonzeros by difference between new and old nonzero memory. */
-    for (size_t i = 0; i < listmatrix->numNonzeros; ++i)
-    {
-      newNonzeros[i] = listmatrix->nonzeros[i];
-      newNonzeros[i].left += memoryShift;
-      newNonzeros[i].right += memoryShift;
-      newNonzeros[i].above += memoryShift;
-      newNonzeros[i].below += memoryShift;
-    }
-
-    /* Also do this for the heads, but repair it for their predecessors / successors. */
-    for (size_t row = 0; row < listmatrix->numRows; ++row)
-    {
-      ListMat8Element* element = &listmatrix->rowElements[row];
-      if (element->numNonzeros)
-      {
-        element->head.right += memoryShift;
-        element->head.left += memoryShift;
-        element->head.right->left -= memoryShift;
-        element->head.left->right -= memoryShift;
-      }
-    }
-    for (size_t column = 0; column < listmatrix->numColumns; ++column)
-    {
-      ListMat8Element* element = &listmatrix->columnElements[column];
-      if (element->numNonzeros)
-      {
-        element->head.below += memoryShift;
-        element->head.above += memoryShift;
-        element->head.below->above -= memoryShift;
-        element->head.above->below -= memoryShift;
-      }
-    }
-
-    /* Create free list. */
-    listmatrix->firstFreeNonzero = &newNonzeros[listmatrix->numNonzeros];
-    for (size_t i = listmatrix->numNonzeros; i < newSize - 1; ++i)
-      newNonzeros[i].right = &newNonzeros[i+1];
-    newNonzeros[newSize-1].right = NULL;
-
-    /* Move old nonzero array. */
-    listmatrix->memNonzeros = newSize;
-    CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->nonzeros) );
-    listmatrix->nonzeros = newNonzeros;
-
-    if (pmemoryShift)
-      *pmemoryShift = memoryShift;
-  }
-  else if (pmemoryShift)
+    CMR_CALL( listmat8AddNonzeros(cmr, listmatrix) );
+  if (pmemoryShift)
     *pmemoryShift = 0;
 
   /* Actually insert the element. */
@@ -1617,70 +1674,15 @@ CMR_ERROR CMRlistmat64Insert(CMR* cmr, ListMat64* listmatrix, size_t row, size_t
   assert(cmr);
   assert(listmatrix);
   assert(row < listmatrix->numRows);
-  assert(row < listmatrix->numColumns);
+  assert(column < listmatrix->numColumns);
 
   CMRdbgMsg(10, "CMRlistmat64Insert for %ld of %ld possible nonzeros.\n", listmatrix->numNonzeros,
     listmatrix->memNonzeros);
 
+  /* Existing nonzeros never move since additional memory is taken from a new slab. */
   if (!listmatrix->firstFreeNonzero)
-  {
-    assert(listmatrix->numNonzeros == listmatrix->memNonzeros);
-    size_t newSize = 2 * listmatrix->memNonzeros;
-    if (newSize < 256)
-      newSize = 256;
-    ListMat64Nonzero* newNonzeros = NULL;
-    CMR_CALL( CMRallocBlockArray(cmr, &newNonzeros, newSize) );
-    ptrdiff_t memoryShift = newNonzeros - listmatrix->nonzeros;
-
-    /* Shift all pointers to other nonzeros by difference between new and old nonzero memory. */
-    for (size_t i = 0; i < listmatrix->numNonzeros; ++i)
-    {
-      newNonzeros[i] = listmatrix->nonzeros[i];
-      newNonzeros[i].left += memoryShift;
-      newNonzeros[i].right += memoryShift;
-      newNonzeros[i].above += memoryShift;
-      newNonzeros[i].below += memoryShift;
-    }
-
-    /* Also do this for the heads, but repair it for their predecessors / successors. */
-    for (size_t row = 0; row < listmatrix->numRows; ++row)
-    {
-      ListMat64Element* element = &listmatrix->rowElements[row];
-      if (element->numNonzeros)
-      {
-        element->head.right += memoryShift;
-        element->head.left += memoryShift;
-        element->head.right->left -= memoryShift;
-        element->head.left->right -= memoryShift;
-      }
-    }
-    for (size_t column = 0; column < listmatrix->numColumns; ++column)
-    {
-      ListMat64Element* element = &listmatrix->columnElements[column];
-      if (element->numNonzeros)
-      {
-        element->head.below += memoryShift;
-        element->head.above += memoryShift;
-        element->head.below->above -= memoryShift;
-        element->head.above->below -= memoryShift;
-      }
-    }
-
-    /* Create free list. */
-    listmatrix->firstFreeNonzero = &newNonzeros[listmatrix->numNonzeros];
-    for (size_t i = listmatrix->numNonzeros; i < newSize - 1; ++i)
-      newNonzeros[i].right = &listmatrix->nonzeros[i+1];
-    newNonzeros[newSize-1].right = NULL;
-
-    /* Move old nonzero array. */
-    listmatrix->memNonzeros = newSize;
-    CMR_CALL( CMRfreeBlockArray(cmr, &listmatrix->nonzeros) );
-    listmatrix->nonzeros = newNonzeros;
-
-    if (pmemoryShift)
-      *pmemoryShift = memoryShift;
-  }
-  else if (pmemoryShift)
+    CMR_CALL( listmat64AddNonzeros(cmr, listmatrix) );
+  if (pmemoryShift)
     *pmemoryShift = 0;
 
   /* Actually insert the element. */
@@ -1852,7 +1854,6 @@ CMR_ERROR CMRlistmat8Delete(CMR* cmr, ListMat8* listmatrix, ListMat8Nonzero* nz)
   nz->below->above = nz->above;
   nz->right = listmatrix->firstFreeNonzero;
   listmatrix->firstFreeNonzero = nz;
-  listmatrix->numNonzeros--;
 
   return CMR_OKAY;
 }
@@ -49,9 +49,10 @@ typedef struct
  * The Each nonzero is part of two doubly-linked lists, one for all nonzeros in the same row and one for all the
  * nonzeros in the same column.
  *
- * \note If the allocated memory for the rows, columns or nonzeros does not suffice, it is automatically reallocated.
- *       However, this means that a pointer to a \ref ListMat8Nonzero struct is only valid if no reallocation occurs.
- *       Hence, the user must make sure that sufficient memory is allocated or that no such pointers are used.
+ * The nonzeros are taken from slabs of the environment's pool. If the allocated memory for the nonzeros does not
+ * suffice, another slab is added, so pointers to \ref ListMat8Nonzero structs remain valid.
+ *
+ * \note If the allocated memory for the rows or columns does not suffice, it is automatically reallocated.
  */
 
 typedef struct
@@ -65,9 +66,10 @@ typedef struct
 
   size_t numNonzeros;
   ListMat8Nonzero anchor;             /**< \brief Anchor for nonzeros. */
-  size_t memNonzeros;                 /**< \brief Amount of memory for nonzeros. */
+  size_t memNonzeros;                 /**< \brief Amount of memory for nonzeros in \ref nonzeros. */
   ListMat8Nonzero* nonzeros;          /**< \brief Raw nonzero data. */
   ListMat8Nonzero* firstFreeNonzero;  /**< \brief Beginning of free list; uses \c right pointers. */
+  ListMat8Nonzero* moreNonzeros;      /**< \brief Additional slabs of nonzeros; linked via their first entries. */
 } ListMat8;
 
 
@@ -103,9 +105,10 @@ typedef struct
  * The Each nonzero is part of two doubly-linked lists, one for all nonzeros in the same row and one for all the
  * nonzeros in the same column.
  *
- * \note If the allocated memory for the rows, columns or nonzeros does not suffice, it is automatically reallocated.
- *       However, this means that a pointer to a \ref ListMat64Nonzero struct is only valid if no reallocation occurs.
- *       Hence, the user must make sure that sufficient memory is allocated or that no such pointers are used.
+ * The nonzeros are taken from slabs of the environment's pool. If the allocated memory for the nonzeros does not
+ * suffice, another slab is added, so pointers to \ref ListMat64Nonzero structs remain valid.
+ *
+ * \note If the allocated memory for the rows or columns does not suffice, it is automatically reallocated.
  */
 
 typedef struct
@@ -119,9 +122,10 @@ typedef struct
 
   size_t numNonzeros;
   ListMat64Nonzero anchor;            /**< \brief Anchor for nonzeros. */
-  size_t memNonzeros;                 /**< \brief Amount of memory for nonzeros. */
+  size_t memNonzeros;                 /**< \brief Amount of memory for nonzeros in \ref nonzeros. */
   ListMat64Nonzero* nonzeros;         /**< \brief Raw nonzero data. */
   ListMat64Nonzero* firstFreeNonzero; /**< \brief Beginning of free list; uses \c right pointers. */
+  ListMat64Nonzero* moreNonzeros;     /**< \brief Additional slabs of nonzeros; linked via their first entries. */
 } ListMat64;
 
 #if defined(CMR_WITH_GMP)
@@ -471,7 +475,7 @@ CMR_ERROR CMRlistmatGMPPrintDense(
 /**
  * \brief Creates a new element and inserts it into the doubly-linked lists.
  *
- * The function may reallocate the array of nonzeros.
+ * The function may add a slab of nonzeros, but never moves existing ones.
  **/
 
 CMR_ERROR CMRlistmat8Insert(
@@ -481,13 +485,13 @@ CMR_ERROR CMRlistmat8Insert(
   size_t column,          /**< Column of new element. */
   int8_t value,           /**< Value of new element. */
   long special,           /**< Special entry of new element. */
-  ptrdiff_t* pmemoryShift /**< If not \c NULL, each nonzero's address is shifted by this value. */
+  ptrdiff_t* pmemoryShift /**< If not \c NULL, set to 0 since nonzeros never move. */
 );
 
 /**
  * \brief Creates a new element and inserts it into the doubly-linked lists.
  *
- * The function may reallocate the array of nonzeros.
+ * The function may add a slab of nonzeros, but never moves existing ones.
  **/
 
 CMR_ERROR CMRlistmat64Insert(
@@ -497,7 +501,7 @@ CMR_ERROR CMRlistmat64Insert(
   size_t column,          /**< Column of new element. */
   int64_t value,          /**< Value of new element. */
   long special,           /**< Special entry of new element. */
-  ptrdiff_t* pmemoryShift /**< If not \c NULL, each nonzero's address is shifted by this value. */
+  ptrdiff_t* pmemoryShift /**< If not \c NULL, set to 0 since nonzeros never move. */
 );
 
 #if defined(CMR_WITH_GMP)
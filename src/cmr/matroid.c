@@ -3,20 +3,388 @@
 #include <cmr/matroid.h>
 
 #include "env_internal.h"
+#include "bits.h"
 #include "seymour_internal.h"
 #include "matrix_internal.h"
 #include "listmatrix.h"
 #include "linear_algebra_internal.h"
 
 #include <assert.h>
+#include <stdint.h>
 #include <string.h>
 
+#define DENSE_PIVOTS_MIN_DENSITY 16 /**< Matrices with at least 1 in this many nonzero entries are pivoted densely. */
+#define DENSE_PIVOTS_MAX_GROUP 8    /**< Maximum number of binary pivots that are applied via one table. */
+
+/**
+ * \brief Adds \p sign times the GF(3) vector (\p sourcePlus, \p sourceMinus) to (\p targetPlus, \p targetMinus).
+ *
+ * An entry is encoded by two bits, one in the word of the entries equal to +1 and one in the word of those equal
+ * to -1.
+ */
+
+static inline
+void addTernaryWords(
+  uint64_t* targetPlus,   /**< Words of target's entries equal to +1. */
+  uint64_t* targetMinus,  /**< Words of target's entries equal to -1. */
+  const uint64_t* sourcePlus,   /**< Words of source's entries equal to +1. */
+  const uint64_t* sourceMinus,  /**< Words of source's entries equal to -1. */
+  int sign,               /**< Either +1 or -1. */
+  size_t numWords         /**< Number of words. */
+)
+{
+  if (sign < 0)
+  {
+    const uint64_t* swap = sourcePlus;
+    sourcePlus = sourceMinus;
+    sourceMinus = swap;
+  }
+  for (size_t w = 0; w < numWords; ++w)
+  {
+    uint64_t xp = targetPlus[w];
+    uint64_t xm = targetMinus[w];
+    uint64_t yp = sourcePlus[w];
+    uint64_t ym = sourceMinus[w];
+    uint64_t xz = ~(xp | xm);
+    uint64_t yz = ~(yp | ym);
+    targetPlus[w] = (xp & yz) | (xz & yp) | (xm & ym);
+    targetMinus[w] = (xm & yz) | (xz & ym) | (xp & yp);
+  }
+}
+
+/**
+ * \brief Applies up to \ref DENSE_PIVOTS_MAX_GROUP binary pivots on distinct rows and columns via the Method of Four
+ *        Russians.
+ *
+ * The pivots are first carried out on the pivot rows only, recording each pivot row \f$ r_t \f$ at the time of its
+ * pivot, without its pivot column \f$ c_t \f$. Every other row changes by a sum of these recorded rows that only
+ * depends on its entries in the pivot columns, and hence it is updated by one lookup in a table with all
+ * \f$ 2^g \f$ such sums.
+ */
+
+static
+CMR_ERROR applyDenseBinaryPivotGroup(
+  uint64_t* rows,         /**< Packed rows of the matrix. */
+  size_t numRows,         /**< Number of rows. */
+  size_t numWords,        /**< Number of words per row. */
+  size_t numGroupPivots,  /**< Number \f$ g \f$ of pivots. */
+  size_t* pivotRows,      /**< Rows of the pivots. */
+  size_t* pivotColumns,   /**< Columns of the pivots. */
+  uint64_t* group,        /**< Memory for \f$ g \f$ rows. */
+  uint64_t* table,        /**< Memory for \f$ 2^g \f$ rows. */
+  bool* isPivotRow        /**< Array that is \c true for exactly the pivot rows; is reset on success. */
+)
+{
+  size_t g = numGroupPivots;
+
+  /* Carry out the pivots on the pivot rows, storing the recorded rows in the table at the unit vectors. */
+  for (size_t t = 0; t < g; ++t)
+    memcpy(&group[t * numWords], &rows[pivotRows[t] * numWords], numWords * sizeof(uint64_t));
+  for (size_t t = 0; t < g; ++t)
+  {
+    size_t word = pivotColumns[t] >> 6;
+    uint64_t bit = UINT64_C(1) << (pivotColumns[t] & 63);
+    uint64_t* recorded = &table[((size_t) 1 << t) * numWords];
+    if (!(group[t * numWords + word] & bit))
+      return CMR_ERROR_INPUT;
+    memcpy(recorded, &group[t * numWords], numWords * sizeof(uint64_t));
+    recorded[word] &= ~bit;
+    for (size_t s = 0; s < g; ++s)
+    {
+      if (s != t && (group[s * numWords + word] & bit))
+      {
+        for (size_t w = 0; w < numWords; ++w)
+          group[s * numWords + w] ^= recorded[w];
+      }
+    }
+  }
+
+  /* For row i, the coefficient x_t of recorded row t is its current entry in column c_t, i.e., its original entry
+   * plus the sum of x_s times entry c_t of recorded row s over all s < t. We compute the coefficients for the unit
+   * vectors and replace the recorded rows by the corresponding sums. */
+  uint64_t coefficients[DENSE_PIVOTS_MAX_GROUP];
+  for (size_t u = 0; u < g; ++u)
+  {
+    coefficients[u] = 0;
+    for (size_t t = u; t < g; ++t)
+    {
+      bool x = (t == u);
+      for (size_t s = u; s < t; ++s)
+      {
+        if (((coefficients[u] >> s) & 1)
+          && ((table[((size_t) 1 << s) * numWords + (pivotColumns[t] >> 6)] >> (pivotColumns[t] & 63)) & 1))
+        {
+          x = !x;
+        }
+      }
+      if (x)
+        coefficients[u] |= UINT64_C(1) << t;
+    }
+  }
+  uint64_t* sums = &table[0];
+  for (size_t u = 0; u < g; ++u)
+  {
+    /* Use row 0 of the table as scratch memory since the zero pattern needs no update. */
+    for (size_t w = 0; w < numWords; ++w)
+      sums[w] = 0;
+    for (size_t t = u; t < g; ++t)
+    {
+      if ((coefficients[u] >> t) & 1)
+      {
+        for (size_t w = 0; w < numWords; ++w)
+          sums[w] ^= table[((size_t) 1 << t) * numWords + w];
+      }
+    }
+    memcpy(&group[(g + u) * numWords], sums, numWords * sizeof(uint64_t));
+  }
+  for (size_t u = 0; u < g; ++u)
+    memcpy(&table[((size_t) 1 << u) * numWords], &group[(g + u) * numWords], numWords * sizeof(uint64_t));
+
+  /* Each other pattern is the sum of its lowest unit vector and the pattern without it. */
+  for (size_t w = 0; w < numWords; ++w)
+    table[w] = 0;
+  for (size_t pattern = 1; pattern < ((size_t) 1 << g); ++pattern)
+  {
+    size_t rest = pattern & (pattern - 1);
+    if (!rest)
+      continue;
+    uint64_t* target = &table[pattern * numWords];
+    const uint64_t* first = &table[rest * numWords];
+    const uint64_t* second = &table[(pattern ^ rest) * numWords];
+    for (size_t w = 0; w < numWords; ++w)
+      target[w] = first[w] ^ second[w];
+  }
+
+  /* Update all other rows. */
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    if (isPivotRow[row])
+      continue;
+
+    uint64_t* rowWords = &rows[row * numWords];
+    size_t pattern = 0;
+    for (size_t t = 0; t < g; ++t)
+      pattern |= ((rowWords[pivotColumns[t] >> 6] >> (pivotColumns[t] & 63)) & 1) << t;
+    if (!pattern)
+      continue;
+
+    const uint64_t* sum = &table[pattern * numWords];
+    for (size_t w = 0; w < numWords; ++w)
+      rowWords[w] ^= sum[w];
+  }
+
+  for (size_t t = 0; t < g; ++t)
+  {
+    memcpy(&rows[pivotRows[t] * numWords], &group[t * numWords], numWords * sizeof(uint64_t));
+    isPivotRow[pivotRows[t]] = false;
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Carries out \p numPivots pivots on \p matrix over GF(2) or GF(3) using rows packed into 64-bit words.
+ *
+ * Binary pivots are applied in groups on distinct rows and columns via \ref applyDenseBinaryPivotGroup. Ternary
+ * pivots are applied one after another, each adding a multiple of the pivot row to the rows with a nonzero in the
+ * pivot column.
+ */
+
+static
+CMR_ERROR computePivotsDense(
+  CMR* cmr,               /**< \ref CMR environment . */
+  CMR_CHRMAT* matrix,     /**< Input matrix. */
+  size_t numPivots,       /**< Number of pivots. */
+  size_t* pivotRows,      /**< Row indices of pivots. */
+  size_t* pivotColumns,   /**< Column indices of pivots. */
+  int characteristic,     /**< Characteristic of field; either 2 or 3. */
+  CMR_CHRMAT** presult    /**< Pointer for storing the resulting matrix. */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(characteristic == 2 || characteristic == 3);
+
+  CMRdbgMsg(2, "Applying %zu pivot(s) to a %zux%zu matrix densely.\n", numPivots, matrix->numRows,
+    matrix->numColumns);
+
+  size_t numRows = matrix->numRows;
+  size_t numWords = (matrix->numColumns + 63) / 64;
+  size_t numPlanes = (characteristic == 3) ? 2 : 1;
+  CMR_ERROR error = CMR_OKAY;
+
+  /* Plane 0 contains the entries equal to +1 (all nonzeros in the binary case), plane 1 those equal to -1. */
+  uint64_t* planes = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &planes, numPlanes * numRows * numWords + 1) );
+  memset(planes, 0, (numPlanes * numRows * numWords + 1) * sizeof(uint64_t));
+  uint64_t* plus = planes;
+  uint64_t* minus = (characteristic == 3) ? &planes[numRows * numWords] : NULL;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+    {
+      size_t column = matrix->entryColumns[e];
+      int value = moduloTernary(matrix->entryValues[e], characteristic);
+      uint64_t bit = UINT64_C(1) << (column & 63);
+      if (value > 0)
+        plus[row * numWords + (column >> 6)] |= bit;
+      else if (value < 0)
+        minus[row * numWords + (column >> 6)] |= bit;
+    }
+  }
+
+  if (characteristic == 2)
+  {
+    /* Choose the group size such that the table is not larger than the matrix. */
+    size_t maxGroup = 1;
+    while (maxGroup < DENSE_PIVOTS_MAX_GROUP && ((size_t) 2 << maxGroup) <= numRows)
+      ++maxGroup;
+
+    uint64_t* group = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &group, 2 * maxGroup * numWords + 1) );
+    uint64_t* table = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &table, ((size_t) 1 << maxGroup) * numWords + 1) );
+    bool* isPivotRow = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &isPivotRow, numRows) );
+    for (size_t row = 0; row < numRows; ++row)
+      isPivotRow[row] = false;
+
+    for (size_t first = 0; first < numPivots; )
+    {
+      /* Extend the group as long as its rows and columns are distinct. */
+      size_t beyond = first;
+      while (beyond < numPivots && beyond - first < maxGroup && !isPivotRow[pivotRows[beyond]])
+      {
+        bool distinctColumn = true;
+        for (size_t p = first; p < beyond; ++p)
+        {
+          if (pivotColumns[p] == pivotColumns[beyond])
+            distinctColumn = false;
+        }
+        if (!distinctColumn)
+          break;
+        isPivotRow[pivotRows[beyond]] = true;
+        ++beyond;
+      }
+
+      CMRdbgMsg(4, "Applying binary pivots %zu to %zu via a table.\n", first, beyond - 1);
+      error = applyDenseBinaryPivotGroup(plus, numRows, numWords, beyond - first, &pivotRows[first],
+        &pivotColumns[first], group, table, isPivotRow);
+      if (error != CMR_OKAY)
+        break;
+      first = beyond;
+    }
+
+    CMR_CALL( CMRfreeStackArray(cmr, &isPivotRow) );
+    CMR_CALL( CMRfreeStackArray(cmr, &table) );
+    CMR_CALL( CMRfreeStackArray(cmr, &group) );
+  }
+  else
+  {
+    uint64_t* pivotPlus = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &pivotPlus, 2 * numWords + 1) );
+    uint64_t* pivotMinus = &pivotPlus[numWords];
+
+    for (size_t pivot = 0; pivot < numPivots; ++pivot)
+    {
+      size_t pivotRow = pivotRows[pivot];
+      size_t word = pivotColumns[pivot] >> 6;
+      uint64_t bit = UINT64_C(1) << (pivotColumns[pivot] & 63);
+      uint64_t* rowPlus = &plus[pivotRow * numWords];
+      uint64_t* rowMinus = &minus[pivotRow * numWords];
+      int pivotValue = (rowPlus[word] & bit) ? 1 : ((rowMinus[word] & bit) ? -1 : 0);
+      if (!pivotValue)
+      {
+        error = CMR_ERROR_INPUT;
+        break;
+      }
+
+      /* The pivot row without the pivot entry. */
+      memcpy(pivotPlus, rowPlus, numWords * sizeof(uint64_t));
+      memcpy(pivotMinus, rowMinus, numWords * sizeof(uint64_t));
+      pivotPlus[word] &= ~bit;
+      pivotMinus[word] &= ~bit;
+
+      /* Entry (i,j) becomes a_ij - a_ic * a_rj / p, and a_ic becomes a_ic / p, where 1/p = p. */
+      for (size_t row = 0; row < numRows; ++row)
+      {
+        if (row == pivotRow)
+          continue;
+        uint64_t* otherPlus = &plus[row * numWords];
+        uint64_t* otherMinus = &minus[row * numWords];
+        int value = (otherPlus[word] & bit) ? 1 : ((otherMinus[word] & bit) ? -1 : 0);
+        if (!value)
+          continue;
+
+        addTernaryWords(otherPlus, otherMinus, pivotPlus, pivotMinus, -value * pivotValue, numWords);
+        if (pivotValue < 0)
+        {
+          otherPlus[word] ^= bit;
+          otherMinus[word] ^= bit;
+        }
+      }
+
+      /* Entries a_rj become a_rj / p and the pivot entry becomes -1 / p = -p. */
+      if (pivotValue < 0)
+      {
+        for (size_t w = 0; w < numWords; ++w)
+        {
+          uint64_t swap = rowPlus[w];
+          rowPlus[w] = rowMinus[w];
+          rowMinus[w] = swap;
+        }
+      }
+      else
+      {
+        rowPlus[word] ^= bit;
+        rowMinus[word] ^= bit;
+      }
+    }
+
+    CMR_CALL( CMRfreeStackArray(cmr, &pivotPlus) );
+  }
+
+  if (error == CMR_OKAY)
+  {
+    /* Extract the nonzeros, which are already sorted. */
+    size_t numNonzeros = 0;
+    for (size_t i = 0; i < numPlanes * numRows * numWords; ++i)
+      numNonzeros += CMRcountBits(planes[i]);
+    CMR_CALL( CMRchrmatCreate(cmr, presult, numRows, matrix->numColumns, numNonzeros) );
+    CMR_CHRMAT* result = *presult;
+    size_t entry = 0;
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      result->rowSlice[row] = entry;
+      for (size_t w = 0; w < numWords; ++w)
+      {
+        uint64_t plusWord = plus[row * numWords + w];
+        uint64_t minusWord = minus ? minus[row * numWords + w] : 0;
+        for (uint64_t word = plusWord | minusWord; word; word &= word - 1)
+        {
+          size_t bit = CMRlowestBit(word);
+          result->entryColumns[entry] = 64 * w + bit;
+          result->entryValues[entry] = ((plusWord >> bit) & 1) ? 1 : -1;
+          ++entry;
+        }
+      }
+    }
+    result->rowSlice[numRows] = entry;
+    assert(entry == numNonzeros);
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &planes) );
+
+  return error;
+}
+
 /**
  * \brief Carries out \p numPivots pivots on \p matrix and stores the result in \p *presult.
  *
  * Calculations are done modulo \p characteristic. If that value is negative then the pivots must be regular, i.e.,
  * over every field. If the result would differ over fields, \p *presult will be \c NULL and, if given, \p *pviolator
- * will refer to the submatrix indexed by an affected entry as well as indices of all previous pivots.
+ * will refer to the submatrix indexed by an affected entry as well as indices of all previous pivots. Dense matrices
+ * are pivoted over GF(2) and GF(3) by \ref computePivotsDense.
  */
 
 static
@@ -37,6 +405,13 @@ CMR_ERROR computePivots(
   assert(!numPivots || pivotRows);
   assert(!numPivots || pivotColumns);
 
+  /* Over GF(2) and GF(3), sufficiently dense matrices are pivoted with packed rows. */
+  if (characteristic > 0 && matrix->numRows * matrix->numColumns <= DENSE_PIVOTS_MIN_DENSITY * matrix->numNonzeros)
+  {
+    CMR_CALL( computePivotsDense(cmr, matrix, numPivots, pivotRows, pivotColumns, characteristic, presult) );
+    return CMR_OKAY;
+  }
+
 #if defined(CMR_DEBUG)
   CMRdbgMsg(2, "Applying %zu pivot(s) to a %zux%zu matrix.\n", numPivots, matrix->numRows, matrix->numColumns);
   CMRchrmatPrintDense(cmr, matrix, stdout, '0', true);
@@ -32,6 +32,19 @@ CMR_ERROR CMRnetworkStatsInit(CMR_NETWORK_STATISTICS* stats)
   return CMR_OKAY;
 }
 
+CMR_ERROR CMRnetworkStatsAdd(CMR_NETWORK_STATISTICS* target, CMR_NETWORK_STATISTICS* source)
+{
+  assert(target);
+  assert(source);
+
+  target->totalCount += source->totalCount;
+  target->totalTime += source->totalTime;
+  CMR_CALL( CMRcamionStatsAdd(&target->camion, &source->camion) );
+  CMR_CALL( CMRgraphicStatsAdd(&target->graphic, &source->graphic) );
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRnetworkStatsPrint(FILE* stream, CMR_NETWORK_STATISTICS* stats, const char* prefix)
 {
   assert(stream);
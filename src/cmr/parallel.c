@@ -0,0 +1,241 @@
+// #define CMR_DEBUG /* Uncomment to debug this file. */
+
+#include "parallel.h"
+
+#include <assert.h>
+#include <stdint.h>
+
+#if defined(CMR_WITH_THREADS)
+#include <pthread.h>
+#endif /* CMR_WITH_THREADS */
+
+size_t CMRparallelNumWorkers(CMR* cmr)
+{
+  assert(cmr);
+
+#if defined(CMR_WITH_THREADS)
+  if (cmr->workersBusy)
+    return 1;
+  return (size_t) cmr->numThreads;
+#else
+  return 1;
+#endif /* CMR_WITH_THREADS */
+}
+
+size_t CMRparallelWorkerIndex(CMR* owner, CMR* cmr)
+{
+  assert(owner);
+  assert(cmr);
+
+  if (cmr == owner)
+    return 0;
+
+  assert(cmr->workerIndex < owner->numWorkers);
+  assert(owner->workers[cmr->workerIndex] == cmr);
+
+  return cmr->workerIndex;
+}
+
+/**
+ * \brief Processes the tasks sequentially using only \p cmr.
+ */
+
+static
+CMR_ERROR findFirstSequential(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  size_t numTasks,            /**< Number of tasks. */
+  CMR_PARALLEL_TASK function, /**< Function that processes a task. */
+  void* data,                 /**< Data to be forwarded to \p function. */
+  size_t* pfirst              /**< Pointer for storing the index of the first successful task. */
+)
+{
+  assert(cmr);
+  assert(pfirst);
+
+  *pfirst = SIZE_MAX;
+  for (size_t task = 0; task < numTasks; ++task)
+  {
+    bool found = false;
+    CMR_ERROR error = function(cmr, task, data, &found);
+    if (error != CMR_OKAY)
+      return error;
+    if (found)
+    {
+      *pfirst = task;
+      break;
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+#if defined(CMR_WITH_THREADS)
+
+/**
+ * \brief State of \ref CMRparallelFindFirst that is shared by all workers.
+ */
+
+typedef struct
+{
+  pthread_mutex_t mutex;      /**< \brief Mutex protecting all other members. */
+  CMR* owner;                 /**< \brief \ref CMR environment of the caller. */
+  CMR_PARALLEL_TASK function; /**< \brief Function that processes a task. */
+  void* data;                 /**< \brief Data to be forwarded to \ref function. */
+  size_t numTasks;            /**< \brief Number of tasks. */
+  size_t nextTask;            /**< \brief Next task to be handed out. */
+  size_t first;               /**< \brief Smallest successful task so far, or \c SIZE_MAX. */
+  CMR_ERROR error;            /**< \brief First error that occurred. */
+  CMR* errorWorker;           /**< \brief \ref CMR environment of the worker that reported \ref error. */
+} ParallelSearch;
+
+/**
+ * \brief Arguments of a worker thread.
+ */
+
+typedef struct
+{
+  CMR* cmr;                 /**< \brief \ref CMR environment of the worker. */
+  ParallelSearch* search;   /**< \brief Shared state. */
+} ParallelWorker;
+
+/**
+ * \brief Processes tasks until no more tasks are available.
+ */
+
+static
+void* runWorker(
+  void* argument  /**< Pointer to the \ref ParallelWorker. */
+)
+{
+  ParallelWorker* worker = (ParallelWorker*) argument;
+  ParallelSearch* search = worker->search;
+
+  while (true)
+  {
+    pthread_mutex_lock(&search->mutex);
+    if (search->error != CMR_OKAY || search->nextTask >= search->numTasks || search->nextTask > search->first)
+    {
+      pthread_mutex_unlock(&search->mutex);
+      break;
+    }
+    size_t task = search->nextTask++;
+    pthread_mutex_unlock(&search->mutex);
+
+    CMRdbgMsg(2, "Worker %zu processes task %zu.\n", worker->cmr->workerIndex, task);
+
+    bool found = false;
+    CMR_ERROR error = search->function(worker->cmr, task, search->data, &found);
+
+    pthread_mutex_lock(&search->mutex);
+    if (error != CMR_OKAY && search->error == CMR_OKAY)
+    {
+      search->error = error;
+      search->errorWorker = worker->cmr;
+    }
+    if (found && task < search->first)
+      search->first = task;
+    pthread_mutex_unlock(&search->mutex);
+  }
+
+  return NULL;
+}
+
+#endif /* CMR_WITH_THREADS */
+
+CMR_ERROR CMRparallelFindFirst(CMR* cmr, size_t numTasks, CMR_PARALLEL_TASK function, void* data, size_t* pfirst)
+{
+  assert(cmr);
+  assert(function);
+  assert(pfirst);
+
+  size_t numWorkers = CMRparallelNumWorkers(cmr);
+  if (numWorkers > numTasks)
+    numWorkers = numTasks;
+  if (numWorkers <= 1)
+    return findFirstSequential(cmr, numTasks, function, data, pfirst);
+
+#if defined(CMR_WITH_THREADS)
+
+  /* Create missing worker environments. */
+  if (cmr->numWorkers < numWorkers)
+  {
+    CMR_CALL( CMRreallocBlockArray(cmr, &cmr->workers, numWorkers) );
+    for (size_t w = cmr->numWorkers; w < numWorkers; ++w)
+    {
+      cmr->workers[w] = NULL;
+      if (w == 0)
+        continue;
+      CMR_CALL( CMRcreateEnvironment(&cmr->workers[w]) );
+      cmr->workers[w]->workerIndex = w;
+    }
+    cmr->numWorkers = numWorkers;
+  }
+
+  ParallelSearch search;
+  search.owner = cmr;
+  search.function = function;
+  search.data = data;
+  search.numTasks = numTasks;
+  search.nextTask = 0;
+  search.first = SIZE_MAX;
+  search.error = CMR_OKAY;
+  search.errorWorker = NULL;
+  if (pthread_mutex_init(&search.mutex, NULL))
+    return CMR_ERROR_MEMORY;
+
+  ParallelWorker* workers = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &workers, numWorkers) );
+  pthread_t* threads = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &threads, numWorkers) );
+
+  /* The caller acts as worker 0 while the others run in their own threads. If a thread cannot be created, no further
+   * ones are started, such that threads 1, ..., numStarted - 1 are exactly the running ones. */
+  cmr->workersBusy = true;
+  size_t numStarted = 1;
+  for (size_t w = 0; w < numWorkers; ++w)
+  {
+    workers[w].cmr = w ? cmr->workers[w] : cmr;
+    workers[w].search = &search;
+    if (w)
+      CMRclearErrorMessage(workers[w].cmr);
+  }
+  while (numStarted < numWorkers && !pthread_create(&threads[numStarted], NULL, runWorker, &workers[numStarted]))
+    ++numStarted;
+  CMRdbgMsg(0, "Started %zu of %zu workers for %zu tasks.\n", numStarted, numWorkers, numTasks);
+
+  runWorker(&workers[0]);
+  for (size_t w = 1; w < numStarted; ++w)
+    pthread_join(threads[w], NULL);
+  cmr->workersBusy = false;
+
+  pthread_mutex_destroy(&search.mutex);
+
+  /* The owner may itself be running as worker 0, so a worker's error message is only copied after all have joined. */
+  if (search.errorWorker && search.errorWorker != cmr && search.errorWorker->errorMessage)
+    CMRraiseErrorMessage(cmr, "%s", search.errorWorker->errorMessage);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &threads) );
+  CMR_CALL( CMRfreeStackArray(cmr, &workers) );
+
+  *pfirst = search.first;
+
+  return search.error;
+
+#else
+
+  return findFirstSequential(cmr, numTasks, function, data, pfirst);
+
+#endif /* CMR_WITH_THREADS */
+}
+
+CMR_ERROR CMRparallelFor(CMR* cmr, size_t numTasks, CMR_PARALLEL_TASK function, void* data)
+{
+  assert(cmr);
+  assert(function);
+
+  size_t first;
+  CMR_CALL( CMRparallelFindFirst(cmr, numTasks, function, data, &first) );
+  assert(first == SIZE_MAX);
+
+  return CMR_OKAY;
+}
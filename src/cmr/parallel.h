@@ -0,0 +1,84 @@
+#ifndef CMR_PARALLEL_INTERNAL_H
+#define CMR_PARALLEL_INTERNAL_H
+
+#include "env_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Function that processes a single task of a parallel loop.
+ *
+ * It is called with the \ref CMR environment of the executing worker, which must be used for all memory allocations
+ * and for all library calls. Apart from \p data, which is shared by all workers, it must not modify shared state.
+ */
+
+typedef CMR_ERROR (*CMR_PARALLEL_TASK)(
+  CMR* cmr,     /**< \ref CMR environment of the worker. */
+  size_t task,  /**< Index of the task to process. */
+  void* data,   /**< Data shared by all tasks. */
+  bool* pfound  /**< Pointer for storing whether the task was successful. */
+);
+
+/**
+ * \brief Returns the number of workers that \ref CMRparallelFindFirst will use.
+ *
+ * The environment \p cmr itself is the worker with index 0.
+ */
+
+size_t CMRparallelNumWorkers(
+  CMR* cmr  /**< \ref CMR environment. */
+);
+
+/**
+ * \brief Returns the index of the worker with environment \p cmr among the workers of \p owner.
+ *
+ * The index is 0 if \p cmr is \p owner itself, and otherwise less than \ref CMRparallelNumWorkers for \p owner.
+ * It can be used by task functions to select per-worker buffers that were allocated by the caller.
+ */
+
+size_t CMRparallelWorkerIndex(
+  CMR* owner, /**< \ref CMR environment that invoked \ref CMRparallelFindFirst. */
+  CMR* cmr    /**< \ref CMR environment passed to the task function. */
+);
+
+/**
+ * \brief Processes the tasks \f$ 0, 1, \dotsc, \f$ \p numTasks - 1 until the first successful one is found.
+ *
+ * The tasks are handed out to the workers in increasing order. Once a task was successful, no task with a larger
+ * index is started. Hence, all tasks with smaller index are processed and \p *pfirst is the smallest index of a
+ * successful task, independent of the number of workers. If no task is successful, \p *pfirst is set to
+ * \c SIZE_MAX.
+ *
+ * If an error occurs in any task, then no further tasks are started and the first error is returned.
+ */
+
+CMR_ERROR CMRparallelFindFirst(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  size_t numTasks,            /**< Number of tasks. */
+  CMR_PARALLEL_TASK function, /**< Function that processes a task. */
+  void* data,                 /**< Data to be forwarded to \p function. */
+  size_t* pfirst              /**< Pointer for storing the index of the first successful task. */
+);
+
+/**
+ * \brief Processes all tasks \f$ 0, 1, \dotsc, \f$ \p numTasks - 1.
+ *
+ * The tasks are distributed as in \ref CMRparallelFindFirst, but \p function must not report success. Hence, all
+ * tasks are processed unless an error occurs, in which case no further tasks are started and the first error is
+ * returned.
+ */
+
+CMR_ERROR CMRparallelFor(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  size_t numTasks,            /**< Number of tasks. */
+  CMR_PARALLEL_TASK function, /**< Function that processes a task. */
+  void* data                  /**< Data to be forwarded to \p function. */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMR_PARALLEL_INTERNAL_H */
@@ -65,7 +65,7 @@ CMR_ERROR CMRregularTest(CMR* cmr, CMR_CHRMAT* matrix, bool *pisRegular, CMR_SEY
   CMR_CALL( CMRseymourDecompose(cmr, matrix, false, &root, &(params->seymour), stats ? &(stats->seymour) : NULL,
     timeLimit) );
   int8_t regularity = CMRseymourRegularity(root);
-  if (regularity)
+  if (regularity && pisRegular)
     *pisRegular = regularity > 0;
   if (proot)
     *proot = root;
@@ -118,3 +118,41 @@ CMR_ERROR CMRregularRefineDecomposition(CMR* cmr, size_t numNodes, CMR_SEYMOUR_N
   return CMR_OKAY;
 }
 
+
+CMR_ERROR CMRregularUpdateDecomposition(CMR* cmr, CMR_SEYMOUR_NODE* previous, CMR_CHRMAT* matrix,
+  size_t* rowsToPrevious, size_t* columnsToPrevious, bool* pisRegular, CMR_SEYMOUR_NODE** proot,
+  CMR_REGULAR_PARAMS* params, CMR_REGULAR_STATS* stats, double timeLimit)
+{
+  assert(cmr);
+  assert(previous);
+  assert(matrix);
+
+  CMR_REGULAR_PARAMS defaultParams;
+  if (!params)
+  {
+    CMR_CALL( CMRregularParamsInit(&defaultParams) );
+    params = &defaultParams;
+  }
+
+  if (!CMRchrmatIsBinary(cmr, matrix, NULL))
+  {
+    if (pisRegular)
+      *pisRegular = false;
+    if (proot)
+      *proot = NULL;
+    return CMR_OKAY;
+  }
+
+  CMR_SEYMOUR_NODE* root = NULL;
+  CMR_CALL( CMRregularityUpdateDecomposition(cmr, previous, matrix, rowsToPrevious, columnsToPrevious, &root,
+    &(params->seymour), stats ? &(stats->seymour) : NULL, timeLimit) );
+  int8_t regularity = CMRseymourRegularity(root);
+  if (regularity && pisRegular)
+    *pisRegular = regularity > 0;
+  if (proot)
+    *proot = root;
+  else
+    CMR_CALL( CMRseymourRelease(cmr, &root) );
+
+  return CMR_OKAY;
+}
@@ -5,6 +5,7 @@
 
 #include "seymour_internal.h"
 #include "env_internal.h"
+#include "fingerprint.h"
 #include "hashtable.h"
 
 #include <stdint.h>
@@ -677,7 +678,7 @@ CMR_ELEMENT findParallel(
     size_t column = matrix->entryColumns[e];
     if (column < numColumns)
     {
-      hashValue = projectSignedHash(hashValue + hashVector[column]);
+      hashValue = CMRfingerprintUpdate(hashValue, hashVector[column], 1);
       ++countNonzeros;
     }
     else
@@ -720,31 +721,6 @@ CMR_ELEMENT findParallel(
 }
 
 
-/**
- * \brief Creates a hash vector to speed-up recognition of parallel vectors.
- */
-
-static
-CMR_ERROR createHashVector(
-  CMR* cmr,                 /**< \ref CMR environment. */
-  long long** phashVector,  /**< Pointer for storing the hash vector. */
-  size_t size               /**< Size of hash vector. */
-)
-{
-  assert(cmr);
-
-  CMR_CALL( CMRallocStackArray(cmr, phashVector, size) );
-  long long* hashVector = *phashVector;
-  size_t h = 1;
-  for (size_t e = 0; e < size; ++e)
-  {
-    hashVector[e] = h;
-    h = projectSignedHash(3 * h);
-  }
-
-  return CMR_OKAY;
-}
-
 /**
  * \brief Update the hash values of rows/column of submatrix that is grown by a number of rows.
  */
@@ -772,8 +748,8 @@ CMR_ERROR updateHashValues(
       size_t minor = matrix->entryColumns[e];
       if (minor < minorSize)
       {
-        majorHashValues[major] = projectSignedHash(majorHashValues[major] + hashVector[minor]);
-        minorHashValues[minor] = projectSignedHash(minorHashValues[minor] + hashVector[major]);
+        majorHashValues[major] = CMRfingerprintUpdate(majorHashValues[major], hashVector[minor], 1);
+        minorHashValues[minor] = CMRfingerprintUpdate(minorHashValues[minor], hashVector[major], 1);
       }
       else
         break;
@@ -1259,7 +1235,7 @@ CMR_ERROR createWheel(
 //   CMR_GRAPH* graph = *pgraph;
 //
 //   long long* hashVector = NULL;
-//   CMR_CALL( createHashVector(cmr, &hashVector,
+//   CMR_CALL( CMRfingerprintWeightsCreate(cmr, &hashVector,
 //     matrix->numRows > matrix->numColumns ? matrix->numRows : matrix->numColumns) );
 //   CMR_GRAPH_EDGE* rowEdges = NULL;
 //   CMR_CALL( CMRallocStackArray(cmr, &rowEdges, matrix->numRows) );
@@ -1453,7 +1429,7 @@ CMR_ERROR sequenceGraphicness(
   CMR_GRAPH* graph = *pgraph;
 
   long long* hashVector = NULL;
-  CMR_CALL( createHashVector(cmr, &hashVector,
+  CMR_CALL( CMRfingerprintWeightsCreate(cmr, &hashVector,
     matrix->numRows > matrix->numColumns ? matrix->numRows : matrix->numColumns) );
   CMR_GRAPH_EDGE* rowEdges = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &rowEdges, matrix->numRows) );
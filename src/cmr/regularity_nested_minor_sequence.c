@@ -2,8 +2,10 @@
 
 #include "seymour_internal.h"
 #include "env_internal.h"
+#include "bits.h"
 
 #include "densematrix.h"
+#include "fingerprint.h"
 #include "hashtable.h"
 
 #include <time.h>
@@ -88,27 +90,6 @@ CMR_ERROR dbgPrintDenseSequence(
   return CMR_OKAY;
 }
 
-static
-CMR_ERROR createHashVector(
-  CMR* cmr,                 /**< \ref CMR environment. */
-  long long** phashVector,  /**< Pointer for storing the hash vector. */
-  size_t size               /**< Size of hash vector. */
-)
-{
-  assert(cmr);
-
-  CMR_CALL( CMRallocStackArray(cmr, phashVector, size) );
-  long long* hashVector = *phashVector;
-  size_t h = 1;
-  for (size_t e = 0; e < size; ++e)
-  {
-    hashVector[e] = h;
-    h = projectSignedHash(3 * h);
-  }
-
-  return CMR_OKAY;
-}
-
 /**
  * \brief Initializes the hashtable \p majorHashtable for unprocessed rows/columns.
  *
@@ -146,7 +127,7 @@ CMR_ERROR initializeHashing(
       size_t minor = processedMinors[j];
       if (CMRdensebinmatrixGet(dense, isRow ? major : minor, isRow ? minor : major))
       {
-        majorData[major].hashValue = projectSignedHash( majorData[major].hashValue + hashVector[minor] );
+        majorData[major].hashValue = CMRfingerprintUpdate(majorData[major].hashValue, hashVector[minor], 1);
         majorData[major].numNonzeros++;
         majorData[major].representative = isRow ? CMRcolumnToElement(minor) : CMRrowToElement(minor);
       }
@@ -318,18 +299,20 @@ CMR_ERROR prepareSearch(
   if (CMRelementIsRow(*pstartElement))
   {
     size_t row = CMRelementToRowIndex(*pstartElement);
-    for (size_t column = 0; column < matrix->numColumns; ++column)
+    for (size_t column = CMRdensebinmatrixRowNext(matrix, row, 0); column < numColumns;
+      column = CMRdensebinmatrixRowNext(matrix, row, column + 1))
     {
-      if (CMRdensebinmatrixGet(matrix, row, column) && columnData[column].isTarget)
+      if (columnData[column].isTarget)
         columnData[column].isFlipped = true;
     }
   }
   else if (CMRelementIsColumn(*pstartElement))
   {
     size_t column = CMRelementToColumnIndex(*pstartElement);
-    for (size_t row = 0; row < matrix->numRows; ++row)
+    for (size_t row = CMRdensebinmatrixColumnNext(matrix, 0, column); row < numRows;
+      row = CMRdensebinmatrixColumnNext(matrix, row + 1, column))
     {
-      if (CMRdensebinmatrixGet(matrix, row, column) && rowData[row].isTarget)
+      if (rowData[row].isTarget)
         rowData[row].isFlipped = true;
     }
   }
@@ -356,23 +339,55 @@ CMR_ERROR searchShortestPath(
   CMRdbgMsg(6, "Searching for shortest path.\n");
   *preachedTarget = 0;
 
+  /* Bitsets of flipped rows/columns and of rows/columns that are in the queue or processed, with one word per tile. */
+  size_t numTileRows = dense->numTileRows;
+  size_t numTileColumns = dense->numTileColumns;
+  uint64_t* rowsFlipped = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowsFlipped, numTileRows + 1) );
+  uint64_t* rowsVisited = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowsVisited, numTileRows + 1) );
+  uint64_t* columnsFlipped = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnsFlipped, numTileColumns + 1) );
+  uint64_t* columnsVisited = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnsVisited, numTileColumns + 1) );
+  for (size_t t = 0; t < numTileRows; ++t)
+  {
+    rowsFlipped[t] = 0;
+    rowsVisited[t] = 0;
+  }
+  for (size_t t = 0; t < numTileColumns; ++t)
+  {
+    columnsFlipped[t] = 0;
+    columnsVisited[t] = 0;
+  }
+
   CMR_ELEMENT* queue = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &queue, dense->numRows + dense->numColumns) );
   size_t queueFirst = 0;
   size_t queueBeyond = 0;
   for (size_t row = 0; row < dense->numRows; ++row)
   {
+    uint64_t bit = UINT64_C(1) << (row & CMR_DENSEBINMATRIX_TILE_MASK);
     rowData[row].inQueue = rowData[row].isSource;
     if (rowData[row].isSource)
       queue[queueBeyond++] = CMRrowToElement(row);
     rowData[row].predecessor = 0;
+    if (rowData[row].isFlipped)
+      rowsFlipped[row >> CMR_DENSEBINMATRIX_TILE_SHIFT] |= bit;
+    if (rowData[row].inQueue || rowData[row].isProcessed)
+      rowsVisited[row >> CMR_DENSEBINMATRIX_TILE_SHIFT] |= bit;
   }
   for (size_t column = 0; column < dense->numColumns; ++column)
   {
+    uint64_t bit = UINT64_C(1) << (column & CMR_DENSEBINMATRIX_TILE_MASK);
     columnData[column].inQueue = columnData[column].isSource;
     if (columnData[column].isSource)
       queue[queueBeyond++] = CMRcolumnToElement(column);
     columnData[column].predecessor = 0;
+    if (columnData[column].isFlipped)
+      columnsFlipped[column >> CMR_DENSEBINMATRIX_TILE_SHIFT] |= bit;
+    if (columnData[column].inQueue || columnData[column].isProcessed)
+      columnsVisited[column >> CMR_DENSEBINMATRIX_TILE_SHIFT] |= bit;
   }
 
   while (queueFirst < queueBeyond)
@@ -389,17 +404,19 @@ CMR_ERROR searchShortestPath(
         *preachedTarget = CMRrowToElement(row);
         break;
       }
-      else
+
+      /* An entry is an edge if it differs from whether both row and column are flipped. */
+      bool rowFlipped = rowData[row].isFlipped;
+      for (size_t tileColumn = 0; tileColumn < numTileColumns; ++tileColumn)
       {
-        bool rowFlipped = rowData[row].isFlipped;
-        for (size_t column = 0; column < dense->numColumns; ++column)
+        uint64_t word = CMRdensebinmatrixRowWord(dense, row, tileColumn);
+        if (rowFlipped)
+          word ^= columnsFlipped[tileColumn];
+        word &= ~columnsVisited[tileColumn];
+        columnsVisited[tileColumn] |= word;
+        for (; word; word &= word - 1)
         {
-          bool flip = rowFlipped && columnData[column].isFlipped;
-          if (flip == CMRdensebinmatrixGet(dense, row, column))
-            continue;
-          if (columnData[column].inQueue || columnData[column].isProcessed)
-            continue;
-  
+          size_t column = (tileColumn << CMR_DENSEBINMATRIX_TILE_SHIFT) + CMRlowestBit(word);
           queue[queueBeyond++] = CMRcolumnToElement(column);
           columnData[column].inQueue = true;
           columnData[column].predecessor = CMRrowToElement(row);
@@ -414,17 +431,18 @@ CMR_ERROR searchShortestPath(
         *preachedTarget = CMRcolumnToElement(column);
         break;
       }
-      else
+
+      bool columnFlipped = columnData[column].isFlipped;
+      for (size_t tileRow = 0; tileRow < numTileRows; ++tileRow)
       {
-        bool columnFlipped = columnData[column].isFlipped;
-        for (size_t row = 0; row < dense->numRows; ++row)
+        uint64_t word = CMRdensebinmatrixColumnWord(dense, tileRow, column);
+        if (columnFlipped)
+          word ^= rowsFlipped[tileRow];
+        word &= ~rowsVisited[tileRow];
+        rowsVisited[tileRow] |= word;
+        for (; word; word &= word - 1)
         {
-          bool flip = columnFlipped && rowData[row].isFlipped;
-          if (flip == CMRdensebinmatrixGet(dense, row, column))
-            continue;
-          if (rowData[row].inQueue || rowData[row].isProcessed)
-            continue;
-  
+          size_t row = (tileRow << CMR_DENSEBINMATRIX_TILE_SHIFT) + CMRlowestBit(word);
           queue[queueBeyond++] = CMRrowToElement(row);
           rowData[row].inQueue = true;
           rowData[row].predecessor = CMRcolumnToElement(column);
@@ -434,6 +452,10 @@ CMR_ERROR searchShortestPath(
   }
 
   CMR_CALL( CMRfreeStackArray(cmr, &queue) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnsVisited) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnsFlipped) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowsVisited) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowsFlipped) );
 
   return CMR_OKAY;
 }
@@ -459,33 +481,21 @@ CMR_ERROR pivot(
   size_t* rows = NULL;
   CMR_CALL( CMRallocStackArray(cmr, &rows, dec->numRows) );
   size_t numRows = 0;
-  for (size_t row = 0; row < dec->numRows; ++row)
+  for (size_t row = CMRdensebinmatrixColumnNext(dec->denseMatrix, 0, pivotColumn); row < dec->numRows;
+    row = CMRdensebinmatrixColumnNext(dec->denseMatrix, row + 1, pivotColumn))
   {
-    if (row != pivotRow && CMRdensebinmatrixGet(dec->denseMatrix, row, pivotColumn))
+    if (row != pivotRow)
       rows[numRows++] = row;
   }
 
-  /* Collect rows to be modified. */
-  size_t* columns = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &columns, dec->numColumns) );
-  size_t numColumns = 0;
-  for (size_t column = 0; column < dec->numColumns; ++column)
-  {
-    if (column != pivotColumn && CMRdensebinmatrixGet(dec->denseMatrix, pivotRow, column))
-      columns[numColumns++] = column;
-  }
-
+  /* Adding the pivot row to each other row with a nonzero in the pivot column flips all entries outside the pivot
+   * row and column, but also clears the pivot column entries, which are restored afterwards. */
   for (size_t r = 0; r < numRows; ++r)
   {
-    size_t row = rows[r];
-    for (size_t c = 0; c < numColumns; ++c)
-    {
-      size_t column = columns[c];
-      CMRdensebinmatrixFlip(dec->denseMatrix, row, column);
-    }
+    CMR_CALL( CMRdensebinmatrixAddRow(cmr, dec->denseMatrix, pivotRow, rows[r]) );
+    CMR_CALL( CMRdensebinmatrixSet1(cmr, dec->denseMatrix, rows[r], pivotColumn) );
   }
-  
-  CMR_CALL( CMRfreeStackArray(cmr, &columns) );
+
   CMR_CALL( CMRfreeStackArray(cmr, &rows) );
 
   CMR_ELEMENT temp = dec->denseRowsOriginal[pivotRow];
@@ -591,28 +601,28 @@ CMR_ERROR addElement(
   processedMajors[*pnumProcessedMajors] = newMajor;
   (*pnumProcessedMajors)++;
 
-  for (size_t minor = 0; minor < numMinor; ++minor)
+  for (size_t minor = isRow ? CMRdensebinmatrixRowNext(dec->denseMatrix, newMajor, 0)
+    : CMRdensebinmatrixColumnNext(dec->denseMatrix, 0, newMajor); minor < numMinor;
+    minor = isRow ? CMRdensebinmatrixRowNext(dec->denseMatrix, newMajor, minor + 1)
+    : CMRdensebinmatrixColumnNext(dec->denseMatrix, minor + 1, newMajor))
   {
-    if (CMRdensebinmatrixGet(dec->denseMatrix, isRow ? newMajor : minor, isRow ? minor : newMajor))
+    if (minorData[minor].isProcessed)
     {
-      if (minorData[minor].isProcessed)
-      {
-        /* Remove minor from the hashtable (re-insertion after adding all elements). */
-        if (minorData[minor].hashEntry != SIZE_MAX)
-        {
-          CMR_CALL( CMRlisthashtableRemove(cmr, minorHashtable, minorData[minor].hashEntry) );
-          minorData[minor].hashEntry = SIZE_MAX;
-        }
-      }
-      else
+      /* Remove minor from the hashtable (re-insertion after adding all elements). */
+      if (minorData[minor].hashEntry != SIZE_MAX)
       {
-        /* Increment nonzero counter. Store major as representative to take care of unit vectors. */
-        minorData[minor].numNonzeros++;
-        minorData[minor].representative = isRow ? CMRrowToElement(newMajor) : CMRcolumnToElement(newMajor);
+        CMR_CALL( CMRlisthashtableRemove(cmr, minorHashtable, minorData[minor].hashEntry) );
+        minorData[minor].hashEntry = SIZE_MAX;
       }
-      /* In any case, update the hash value. */
-      minorData[minor].hashValue = projectSignedHash( minorData[minor].hashValue + hashVector[newMajor] );
     }
+    else
+    {
+      /* Increment nonzero counter. Store major as representative to take care of unit vectors. */
+      minorData[minor].numNonzeros++;
+      minorData[minor].representative = isRow ? CMRrowToElement(newMajor) : CMRcolumnToElement(newMajor);
+    }
+    /* In any case, update the hash value. */
+    minorData[minor].hashValue = CMRfingerprintUpdate(minorData[minor].hashValue, hashVector[newMajor], 1);
   }
 
   /* Add to nestedMinorsRows or nestedMinorsColumns. */
@@ -644,7 +654,7 @@ CMR_ERROR CMRregularityExtendNestedMinorSequence(CMR* cmr, DecompositionTask* ta
   size_t numRows = node->matrix->numRows;
   size_t numColumns = node->matrix->numColumns;
   long long* hashVector = NULL;
-  CMR_CALL( createHashVector(cmr, &hashVector, numRows > numColumns ? numRows : numColumns) );
+  CMR_CALL( CMRfingerprintWeightsCreate(cmr, &hashVector, numRows > numColumns ? numRows : numColumns) );
 
   /* Initialize row data. */
   ElementData* rowData = NULL;
@@ -974,34 +984,31 @@ CMR_ERROR CMRregularityExtendNestedMinorSequence(CMR* cmr, DecompositionTask* ta
     /* Count the nonzeros. */
     size_t entry = 0;
     for (size_t row = 0; row < numRows; ++row)
-    {
-      for (size_t column = 0; column < numColumns; ++column)
-      {
-        if (CMRdensebinmatrixGet(node->denseMatrix, row, column))
-          ++entry;
-      }
-    }
+      entry += CMRdensebinmatrixRowCount(node->denseMatrix, row);
 
     /* Create a sparse copy of dense, permuted such that the nested sequence is displayed from top-left on. */
+    size_t* denseColumnsNestedMinors = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &denseColumnsNestedMinors, numColumns) );
+    for (size_t column = 0; column < numColumns; ++column)
+      denseColumnsNestedMinors[node->nestedMinorsColumnsDense[column]] = column;
     CMR_CALL( CMRchrmatCreate(cmr, &node->nestedMinorsMatrix, numRows, numColumns, entry) );
     entry = 0;
     for (size_t row = 0; row < numRows; ++row)
     {
       size_t denseRow = node->nestedMinorsRowsDense[row];
       node->nestedMinorsMatrix->rowSlice[row] = entry;
-      for (size_t column = 0; column < numColumns; ++column)
+      for (size_t denseColumn = CMRdensebinmatrixRowNext(node->denseMatrix, denseRow, 0); denseColumn < numColumns;
+        denseColumn = CMRdensebinmatrixRowNext(node->denseMatrix, denseRow, denseColumn + 1))
       {
-        size_t denseColumn = node->nestedMinorsColumnsDense[column];
-        if (CMRdensebinmatrixGet(node->denseMatrix, denseRow, denseColumn))
-        {
-          node->nestedMinorsMatrix->entryColumns[entry] = column;
-          node->nestedMinorsMatrix->entryValues[entry] = 1;
-          ++entry;
-        }
+        node->nestedMinorsMatrix->entryColumns[entry] = denseColumnsNestedMinors[denseColumn];
+        node->nestedMinorsMatrix->entryValues[entry] = 1;
+        ++entry;
       }
     }
     node->nestedMinorsMatrix->rowSlice[numRows] = entry;
     assert(entry == node->nestedMinorsMatrix->numNonzeros);
+    CMR_CALL( CMRfreeStackArray(cmr, &denseColumnsNestedMinors) );
+    CMR_CALL( CMRchrmatSortNonzeros(cmr, node->nestedMinorsMatrix) );
 
     /* Create the transpose. */
     assert(node->nestedMinorsTranspose == NULL);
@@ -1090,7 +1097,7 @@ CMR_ERROR CMRregularityInitNestedMinorSequence(CMR* cmr, DecompositionTask* task
     size_t first = dec->matrix->rowSlice[row];
     size_t beyond = dec->matrix->rowSlice[row + 1];
     for (size_t e = first; e < beyond; ++e)
-      CMRdensebinmatrixSet1(dec->denseMatrix, row, dec->matrix->entryColumns[e]);
+      CMR_CALL( CMRdensebinmatrixSet1(cmr, dec->denseMatrix, row, dec->matrix->entryColumns[e]) );
   }
 
   /* Start keeping track of elements in order to trace back pivots. */
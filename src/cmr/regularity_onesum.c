@@ -16,6 +16,175 @@ int compareOneSumComponents(const void* a, const void* b)
     ((CMR_BLOCK*)a)->matrix->numNonzeros;
 }
 
+/**
+ * \brief Returns the representative of \p element in the union-find forest \p parents and compresses the path.
+ */
+
+static
+size_t findRepresentative(
+  size_t* parents,  /**< Array with the parent of each element; roots are their own parents. */
+  size_t element    /**< Element. */
+)
+{
+  size_t root = element;
+  while (parents[root] != root)
+    root = parents[root];
+  while (parents[element] != root)
+  {
+    size_t next = parents[element];
+    parents[element] = root;
+    element = next;
+  }
+
+  return root;
+}
+
+/**
+ * \brief Computes the 1-connected components of \p matrix.
+ *
+ * The components are found by a union-find pass over the nonzeros, i.e., without copying \p matrix or computing its
+ * transpose. Only if there are at least two components (or if \p copySingle is \c true), the component matrices are
+ * created in a single pass over the rows of \p matrix. Their \c transpose members are \c NULL since consumers
+ * compute them when needed. Rows and columns of a component are ordered as in \p matrix, which keeps its rows
+ * sorted. Components are ordered by their first row, followed by the zero columns.
+ */
+
+static
+CMR_ERROR decomposeOnesum(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,         /**< Matrix. */
+  bool copySingle,            /**< Whether to create the component if there is only one. */
+  size_t* pnumComponents,     /**< Pointer for storing the number of components. */
+  CMR_BLOCK** pcomponents     /**< Pointer for storing the components; set to \c NULL if they are not created. */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(pnumComponents);
+  assert(pcomponents);
+
+  size_t numRows = matrix->numRows;
+  size_t numElements = numRows + matrix->numColumns;
+  size_t* parents = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &parents, numElements) );
+  for (size_t element = 0; element < numElements; ++element)
+    parents[element] = element;
+
+  /* Columns are the elements numRows, ..., numElements - 1. */
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    size_t rowRoot = findRepresentative(parents, row);
+    for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+    {
+      size_t columnRoot = findRepresentative(parents, numRows + matrix->entryColumns[e]);
+      if (columnRoot != rowRoot)
+      {
+        /* Hanging the larger index below the smaller one keeps the first row as the root. */
+        if (columnRoot < rowRoot)
+        {
+          parents[rowRoot] = columnRoot;
+          rowRoot = columnRoot;
+        }
+        else
+          parents[columnRoot] = rowRoot;
+      }
+    }
+  }
+
+  /* Number the components and their rows and columns in increasing order of the elements. */
+  size_t* elementsToComponents = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &elementsToComponents, numElements) );
+  size_t* elementsToIndex = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &elementsToIndex, numElements) );
+  size_t numComponents = 0;
+  for (size_t element = 0; element < numElements; ++element)
+  {
+    size_t root = findRepresentative(parents, element);
+    if (root == element)
+      elementsToComponents[element] = numComponents++;
+    else
+      elementsToComponents[element] = elementsToComponents[root];
+  }
+  *pnumComponents = numComponents;
+  *pcomponents = NULL;
+
+  if (numComponents >= 2 || (copySingle && numComponents == 1))
+  {
+    CMR_CALL( CMRallocBlockArray(cmr, pcomponents, numComponents) );
+    CMR_BLOCK* components = *pcomponents;
+
+    /* Count rows, columns and nonzeros, using the matrices' members as counters. */
+    size_t* componentsNumRows = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &componentsNumRows, numComponents) );
+    size_t* componentsNumColumns = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &componentsNumColumns, numComponents) );
+    size_t* componentsNumNonzeros = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &componentsNumNonzeros, numComponents) );
+    for (size_t comp = 0; comp < numComponents; ++comp)
+    {
+      componentsNumRows[comp] = 0;
+      componentsNumColumns[comp] = 0;
+      componentsNumNonzeros[comp] = 0;
+    }
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      size_t comp = elementsToComponents[row];
+      elementsToIndex[row] = componentsNumRows[comp]++;
+      componentsNumNonzeros[comp] += matrix->rowSlice[row + 1] - matrix->rowSlice[row];
+    }
+    for (size_t element = numRows; element < numElements; ++element)
+      elementsToIndex[element] = componentsNumColumns[elementsToComponents[element]]++;
+
+    for (size_t comp = 0; comp < numComponents; ++comp)
+    {
+      components[comp].matrix = NULL;
+      components[comp].transpose = NULL;
+      components[comp].rowsToOriginal = NULL;
+      components[comp].columnsToOriginal = NULL;
+      CMR_CALL( CMRchrmatCreate(cmr, (CMR_CHRMAT**) &components[comp].matrix, componentsNumRows[comp],
+        componentsNumColumns[comp], componentsNumNonzeros[comp]) );
+      CMR_CALL( CMRallocBlockArray(cmr, &components[comp].rowsToOriginal, componentsNumRows[comp]) );
+      CMR_CALL( CMRallocBlockArray(cmr, &components[comp].columnsToOriginal, componentsNumColumns[comp]) );
+      componentsNumNonzeros[comp] = 0;
+    }
+
+    for (size_t element = numRows; element < numElements; ++element)
+    {
+      components[elementsToComponents[element]].columnsToOriginal[elementsToIndex[element]] = element - numRows;
+    }
+
+    /* Copy the rows; columns are renumbered monotonically, so the rows remain sorted. */
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      size_t comp = elementsToComponents[row];
+      CMR_CHRMAT* component = (CMR_CHRMAT*) components[comp].matrix;
+      size_t componentRow = elementsToIndex[row];
+      components[comp].rowsToOriginal[componentRow] = row;
+      component->rowSlice[componentRow] = componentsNumNonzeros[comp];
+      for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+      {
+        size_t componentEntry = componentsNumNonzeros[comp]++;
+        component->entryColumns[componentEntry] = elementsToIndex[numRows + matrix->entryColumns[e]];
+        component->entryValues[componentEntry] = matrix->entryValues[e];
+      }
+    }
+    for (size_t comp = 0; comp < numComponents; ++comp)
+    {
+      CMR_CHRMAT* component = (CMR_CHRMAT*) components[comp].matrix;
+      component->rowSlice[component->numRows] = componentsNumNonzeros[comp];
+    }
+
+    CMR_CALL( CMRfreeStackArray(cmr, &componentsNumNonzeros) );
+    CMR_CALL( CMRfreeStackArray(cmr, &componentsNumColumns) );
+    CMR_CALL( CMRfreeStackArray(cmr, &componentsNumRows) );
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &elementsToIndex) );
+  CMR_CALL( CMRfreeStackArray(cmr, &elementsToComponents) );
+  CMR_CALL( CMRfreeStackArray(cmr, &parents) );
+
+  return CMR_OKAY;
+}
 
 CMR_ERROR CMRregularitySearchOnesum(CMR* cmr, DecompositionTask* task, DecompositionQueue* queue)
 {
@@ -33,18 +202,12 @@ CMR_ERROR CMRregularitySearchOnesum(CMR* cmr, DecompositionTask* task, Decomposi
 
   size_t numComponents;
   CMR_BLOCK* components = NULL;
-  CMR_CALL( CMRdecomposeBlocks(cmr, (CMR_MATRIX*) task->node->matrix, sizeof(signed char), sizeof(signed char),
-    &numComponents, &components, NULL, NULL, NULL, NULL) );
+  CMR_CALL( decomposeOnesum(cmr, task->node->matrix, false, &numComponents, &components) );
 
   if (numComponents == 1)
   {
     CMRdbgMsg(6, "Matrix is 2-connected.\n", numComponents);
 
-    CMR_CALL( CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[0].matrix) );
-    CMR_CALL( CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[0].transpose) );
-    CMR_CALL( CMRfreeBlockArray(cmr, &components[0].rowsToOriginal) );
-    CMR_CALL( CMRfreeBlockArray(cmr, &components[0].columnsToOriginal) );
-
     /* Just mark it as 2-connected and add it back to the list of unprocessed tasks. */
     task->node->testedTwoConnected = true;
     CMRregularityQueueAdd(queue, task);
@@ -96,3 +259,260 @@ CMR_ERROR CMRregularitySearchOnesum(CMR* cmr, DecompositionTask* task, Decomposi
 
   return CMR_OKAY;
 }
+
+/**
+ * \brief Finds the previous decomposition node whose matrix is equal to \p component.
+ *
+ * The rows and columns of the node must correspond to those of \p component in the same order. The entries are
+ * compared to the matrix of \p previous, which is also available for inner nodes in low-memory mode. Only nodes whose
+ * regularity is known are returned.
+ */
+
+static
+CMR_ERROR findUnchangedComponent(
+  CMR_SEYMOUR_NODE* previous,     /**< Root of the previous decomposition. */
+  CMR_BLOCK* component,           /**< 1-connected component of the new matrix. */
+  size_t* rowsToPrevious,         /**< Array mapping rows of the new matrix to previous rows or \c SIZE_MAX. */
+  size_t* columnsToPrevious,      /**< Array mapping columns of the new matrix to previous columns or \c SIZE_MAX. */
+  CMR_SEYMOUR_NODE** punchanged   /**< Pointer for storing the unchanged node, or \c NULL if there is none. */
+)
+{
+  assert(previous);
+  assert(component);
+  assert(punchanged);
+
+  *punchanged = NULL;
+  CMR_CHRMAT* matrix = (CMR_CHRMAT*) component->matrix;
+  if (matrix->numRows + matrix->numColumns == 0 || !previous->matrix)
+    return CMR_OKAY;
+
+  /* The first row or column determines the candidate node. */
+  CMR_SEYMOUR_NODE* candidate = previous;
+  CMR_ELEMENT* candidateRowsToPrevious = NULL;
+  CMR_ELEMENT* candidateColumnsToPrevious = NULL;
+  if (previous->type == CMR_SEYMOUR_NODE_TYPE_ONESUM)
+  {
+    size_t child;
+    if (matrix->numRows)
+    {
+      size_t previousRow = rowsToPrevious[component->rowsToOriginal[0]];
+      child = (previousRow == SIZE_MAX) ? SIZE_MAX : previous->rowsToChild[previousRow];
+    }
+    else
+    {
+      size_t previousColumn = columnsToPrevious[component->columnsToOriginal[0]];
+      child = (previousColumn == SIZE_MAX) ? SIZE_MAX : previous->columnsToChild[previousColumn];
+    }
+    if (child >= previous->numChildren)
+      return CMR_OKAY;
+
+    candidate = previous->children[child];
+    candidateRowsToPrevious = previous->childRowsToParent[child];
+    candidateColumnsToPrevious = previous->childColumnsToParent[child];
+  }
+
+  /* A node whose regularity was not decided, e.g., due to stopping early, must be decomposed again. */
+  if (candidate->regularity == 0)
+    return CMR_OKAY;
+  if (candidate->numRows != matrix->numRows || candidate->numColumns != matrix->numColumns)
+    return CMR_OKAY;
+
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    size_t previousRow = rowsToPrevious[component->rowsToOriginal[row]];
+    if (candidateRowsToPrevious ? (candidateRowsToPrevious[row] != CMRrowToElement(previousRow))
+      : (previousRow != row))
+    {
+      return CMR_OKAY;
+    }
+  }
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+  {
+    size_t previousColumn = columnsToPrevious[component->columnsToOriginal[column]];
+    if (candidateColumnsToPrevious ? (candidateColumnsToPrevious[column] != CMRcolumnToElement(previousColumn))
+      : (previousColumn != column))
+    {
+      return CMR_OKAY;
+    }
+  }
+
+  /* All nonzeros of a previous row belong to the candidate, so equal counts and entries imply equal rows. */
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    size_t previousRow = rowsToPrevious[component->rowsToOriginal[row]];
+    size_t first = matrix->rowSlice[row];
+    size_t beyond = matrix->rowSlice[row + 1];
+    if (beyond - first != previous->matrix->rowSlice[previousRow + 1] - previous->matrix->rowSlice[previousRow])
+      return CMR_OKAY;
+    for (size_t e = first; e < beyond; ++e)
+    {
+      size_t previousEntry;
+      CMR_CALL( CMRchrmatFindEntry(previous->matrix, previousRow,
+        columnsToPrevious[component->columnsToOriginal[matrix->entryColumns[e]]], &previousEntry) );
+      if (previousEntry == SIZE_MAX || previous->matrix->entryValues[previousEntry] != matrix->entryValues[e])
+        return CMR_OKAY;
+    }
+  }
+
+  *punchanged = candidate;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRregularityUpdateDecomposition(CMR* cmr, CMR_SEYMOUR_NODE* previous, CMR_CHRMAT* matrix,
+  size_t* rowsToPrevious, size_t* columnsToPrevious, CMR_SEYMOUR_NODE** proot, CMR_SEYMOUR_PARAMS* params,
+  CMR_SEYMOUR_STATS* stats, double timeLimit)
+{
+  assert(cmr);
+  assert(previous);
+  assert(matrix);
+  assert(proot);
+  assert(params);
+
+  if (!previous->matrix || previous->isTernary)
+  {
+    CMRraiseErrorMessage(cmr, "Previous decomposition must be a binary one whose root has a matrix.");
+    return CMR_ERROR_INPUT;
+  }
+
+  /* Complete the maps to the previous matrix, where missing maps are the identity on the common part. */
+  size_t* rowsMap = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowsMap, matrix->numRows) );
+  size_t* columnsMap = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnsMap, matrix->numColumns) );
+  CMR_ERROR error = CMR_OKAY;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    rowsMap[row] = rowsToPrevious ? rowsToPrevious[row] : (row < previous->numRows ? row : SIZE_MAX);
+    if (rowsMap[row] != SIZE_MAX && rowsMap[row] >= previous->numRows)
+      error = CMR_ERROR_INPUT;
+  }
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+  {
+    columnsMap[column] = columnsToPrevious ? columnsToPrevious[column]
+      : (column < previous->numColumns ? column : SIZE_MAX);
+    if (columnsMap[column] != SIZE_MAX && columnsMap[column] >= previous->numColumns)
+      error = CMR_ERROR_INPUT;
+  }
+  if (error != CMR_OKAY)
+  {
+    CMRraiseErrorMessage(cmr, "Map to the previous matrix refers to a nonexistent row or column.");
+    CMR_CALL( CMRfreeStackArray(cmr, &columnsMap) );
+    CMR_CALL( CMRfreeStackArray(cmr, &rowsMap) );
+    return error;
+  }
+
+  size_t numComponents;
+  CMR_BLOCK* components = NULL;
+  CMR_CALL( decomposeOnesum(cmr, matrix, true, &numComponents, &components) );
+
+  *proot = NULL;
+  if (numComponents <= 1)
+  {
+    /* A single component is either reused completely or decomposed from scratch. */
+    CMR_SEYMOUR_NODE* unchanged = NULL;
+    if (numComponents)
+      CMR_CALL( findUnchangedComponent(previous, &components[0], rowsMap, columnsMap, &unchanged) );
+    if (unchanged && unchanged->matrix)
+    {
+      CMRdbgMsg(0, "Reusing the decomposition of the unchanged %zux%zu matrix.\n", matrix->numRows,
+        matrix->numColumns);
+      CMR_CALL( CMRseymourCapture(cmr, unchanged) );
+      *proot = unchanged;
+    }
+    else if (unchanged)
+    {
+      /* In low-memory mode, the matrix of an inner node may be missing, but a root needs it. Since the node still
+       * belongs to the previous decomposition, a clone sharing its children receives the matrix. */
+      CMRdbgMsg(0, "Reusing the children of the unchanged %zux%zu matrix.\n", matrix->numRows, matrix->numColumns);
+      CMR_CALL( CMRseymourCloneShallow(cmr, unchanged, proot) );
+      (*proot)->matrix = (CMR_CHRMAT*) components[0].matrix;
+      components[0].matrix = NULL;
+      if (!(*proot)->transpose)
+      {
+        (*proot)->transpose = (CMR_CHRMAT*) components[0].transpose;
+        components[0].transpose = NULL;
+      }
+    }
+    for (size_t comp = 0; comp < numComponents; ++comp)
+    {
+      CMR_CALL( CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[comp].matrix) );
+      CMR_CALL( CMRchrmatFree(cmr, (CMR_CHRMAT**) &components[comp].transpose) );
+      CMR_CALL( CMRfreeBlockArray(cmr, &components[comp].rowsToOriginal) );
+      CMR_CALL( CMRfreeBlockArray(cmr, &components[comp].columnsToOriginal) );
+    }
+    CMR_CALL( CMRfreeBlockArray(cmr, &components) );
+    CMR_CALL( CMRfreeStackArray(cmr, &columnsMap) );
+    CMR_CALL( CMRfreeStackArray(cmr, &rowsMap) );
+
+    if (!*proot)
+      return CMRseymourDecompose(cmr, matrix, false, proot, params, stats, timeLimit);
+    return CMR_OKAY;
+  }
+
+  CMRdbgMsg(0, "Updating a 1-sum with %zu components.\n", numComponents);
+
+  CMR_CALL( CMRseymourCreate(cmr, proot, false, matrix, true) );
+  CMR_SEYMOUR_NODE* root = *proot;
+  CMR_CALL( CMRseymourUpdateOnesum(cmr, root, numComponents) );
+  root->type = CMR_SEYMOUR_NODE_TYPE_ONESUM;
+  root->testedTwoConnected = true;
+
+  CMR_ELEMENT* rowsToParent = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowsToParent, matrix->numRows) );
+  CMR_ELEMENT* columnsToParent = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnsToParent, matrix->numColumns) );
+  CMR_SEYMOUR_NODE** changed = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &changed, numComponents) );
+  size_t numChanged = 0;
+
+  for (size_t comp = 0; comp < numComponents; ++comp)
+  {
+    CMR_BLOCK* component = &components[comp];
+    CMR_SEYMOUR_NODE* unchanged = NULL;
+    CMR_CALL( findUnchangedComponent(previous, component, rowsMap, columnsMap, &unchanged) );
+
+    for (size_t row = 0; row < component->matrix->numRows; ++row)
+      rowsToParent[row] = CMRrowToElement(component->rowsToOriginal[row]);
+    for (size_t column = 0; column < component->matrix->numColumns; ++column)
+      columnsToParent[column] = CMRcolumnToElement(component->columnsToOriginal[column]);
+    CMR_CALL( CMRseymourCreateChildFromMatrices(cmr, root, comp, (CMR_CHRMAT*) component->matrix,
+      (CMR_CHRMAT*) component->transpose, rowsToParent, columnsToParent) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &component->rowsToOriginal) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &component->columnsToOriginal) );
+
+    if (unchanged)
+    {
+      /* The new child owns the component's matrices, which are identical to those of the reused node. */
+      CMRdbgMsg(2, "Reusing the decomposition of unchanged component %zu.\n", comp);
+      CMR_CALL( CMRseymourRelease(cmr, &root->children[comp]) );
+      CMR_CALL( CMRseymourCapture(cmr, unchanged) );
+      root->children[comp] = unchanged;
+    }
+    else
+    {
+      root->children[comp]->testedTwoConnected = true;
+      changed[numChanged++] = root->children[comp];
+    }
+  }
+
+  CMR_CALL( CMRfreeBlockArray(cmr, &components) );
+
+  /* Only the changed components are decomposed. */
+  CMRdbgMsg(0, "Decomposing %zu of %zu components.\n", numChanged, numComponents);
+  if (numChanged)
+    error = CMRregularityRefineDecomposition(cmr, numChanged, changed, params, stats, timeLimit);
+  if (error == CMR_OKAY)
+    CMR_CALL( CMRseymourSetAttributes(root) );
+
+  CMR_CALL( CMRfreeStackArray(cmr, &changed) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnsToParent) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowsToParent) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnsMap) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowsMap) );
+
+  if (error != CMR_OKAY)
+    CMR_CALL( CMRseymourRelease(cmr, proot) );
+
+  return error;
+}
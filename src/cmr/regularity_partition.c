@@ -3,19 +3,42 @@
 // #define CMR_DEBUG_MATRICES /* Uncomment to print matrices. */
 
 #include "env_internal.h"
+#include "bits.h"
 #include "seymour_internal.h"
+#include "parallel.h"
+#include "regularity_partition.h"
 
 #include <time.h>
 
-/**
- * \brief Element specific data for the enumeration of 3-separations.
- */
-
-typedef struct
+CMR_ERROR CMRregularityPackedCreate(CMR* cmr, CMR_CHRMAT* matrix, size_t numColumns, PackedMatrix* packed)
 {
-  short part;       /**< \brief Part this element belongs to; -1 indicates being unassigned. */
-  short type[2];    /**< \brief Type of row/column for each part; element lies in span if and only if nonnegative. */
-} ElementData;
+  assert(cmr);
+  assert(matrix);
+  assert(packed);
+
+  packed->numRows = matrix->numRows;
+  packed->numColumns = numColumns;
+  packed->numWords = (numColumns + 63) / 64;
+  packed->words = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &packed->words, packed->numRows * packed->numWords) );
+  for (size_t w = 0; w < packed->numRows * packed->numWords; ++w)
+    packed->words[w] = 0;
+
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    uint64_t* rowWords = &packed->words[row * packed->numWords];
+    size_t beyond = matrix->rowSlice[row + 1];
+    for (size_t entry = matrix->rowSlice[row]; entry < beyond; ++entry)
+    {
+      size_t column = matrix->entryColumns[entry];
+      if (column >= numColumns)
+        break;
+      rowWords[column / 64] |= (uint64_t) 1 << (column % 64);
+    }
+  }
+
+  return CMR_OKAY;
+}
 
 /**
  * \brief Checks whether the submatrix with rows assigned to \p part and columns assigned to the other has at least
@@ -27,9 +50,10 @@ typedef struct
 
 static
 bool findRank1(
-  CMR_CHRMAT* matrix,                 /**< Matrix. */
+  PackedMatrix* matrix,               /**< Packed matrix. */
+  size_t numAssignedRows,             /**< Number of leading rows that may be assigned to a part. */
   ElementData* rowData,               /**< Row element data. */
-  ElementData* columnData,            /**< Column element data. */
+  uint64_t* otherColumnsMask,         /**< Mask of the columns assigned to the other part. */
   size_t rowRepresentative[2][2],     /**< Row representatives for each part. */
   size_t columnRepresentative[2][2],  /**< Column representatives for each part. */
   short part                          /**< Part to which the investigated rows belong. */
@@ -37,27 +61,27 @@ bool findRank1(
 {
   assert(matrix);
   assert(rowData);
+  assert(otherColumnsMask);
   assert(rowRepresentative);
   assert(columnRepresentative);
   assert(part >=0 && part < 2);
   assert(rowRepresentative[part][0] == SIZE_MAX);
   assert(columnRepresentative[1-part][0] == SIZE_MAX);
 
-  for (size_t row = 0; row < matrix->numRows; ++row)
+  for (size_t row = 0; row < numAssignedRows; ++row)
   {
-    if (rowData[row].part == part)
+    if (rowData[row].part != part)
+      continue;
+
+    uint64_t* rowWords = &matrix->words[row * matrix->numWords];
+    for (size_t w = 0; w < matrix->numWords; ++w)
     {
-      size_t first = matrix->rowSlice[row];
-      size_t beyond = matrix->rowSlice[row + 1];
-      for (size_t entry = first; entry < beyond; ++entry)
+      uint64_t word = rowWords[w] & otherColumnsMask[w];
+      if (word)
       {
-        size_t column = matrix->entryColumns[entry];
-        if (columnData[column].part == 1-part)
-        {
-          rowRepresentative[part][0] = row;
-          columnRepresentative[1-part][0] = column;
-          return true;
-        }
+        rowRepresentative[part][0] = row;
+        columnRepresentative[1-part][0] = 64 * w + CMRlowestBit(word);
+        return true;
       }
     }
   }
@@ -65,27 +89,12 @@ bool findRank1(
   return false;
 }
 
-/**
- * \brief Checks whether the submatrix with rows assigned to \p part and columns assigned to the other has at least
- *        rank 2.
- *
- * Assumes that \p rowRepresentative already contains the first nonzero row in that matrix.
- * If the rank is at least 2, \p rowRepresentative and \p columnRepresentative are extended as to indicate a rank-2
- * submatrix.
- */
-
-static
-bool findRank2(
-  CMR_CHRMAT* matrix,                 /**< Matrix. */
-  ElementData* rowData,               /**< Row element data. */
-  ElementData* columnData,            /**< Column element data. */
-  size_t rowRepresentative[2][2],     /**< Row representatives for each part. */
-  size_t columnRepresentative[2][2],  /**< Column representatives for each part. */
-  short part                          /**< Part to which the investigated rows belong. */
-)
+bool CMRregularityPackedFindRank2(PackedMatrix* matrix, size_t numAssignedRows, ElementData* rowData,
+  uint64_t* otherColumnsMask, size_t rowRepresentative[2][2], size_t columnRepresentative[2][2], short part)
 {
   assert(matrix);
   assert(rowData);
+  assert(otherColumnsMask);
   assert(rowRepresentative);
   assert(columnRepresentative);
   assert(part >=0 && part < 2);
@@ -94,279 +103,116 @@ bool findRank2(
   assert(columnRepresentative[1-part][0] < SIZE_MAX);
   assert(columnRepresentative[1-part][1] == SIZE_MAX);
 
-//   CMRdbgMsg(14, "findRank2(): first nonzero is in row r%ld.\n", rowRepresentative[part][0]+1);
-
-  for (size_t row = rowRepresentative[part][0] + 1; row < matrix->numRows; ++row)
+  uint64_t* representativeWords = &matrix->words[rowRepresentative[part][0] * matrix->numWords];
+  for (size_t row = rowRepresentative[part][0] + 1; row < numAssignedRows; ++row)
   {
-    if (rowData[row].part == part)
+    if (rowData[row].part != part)
+      continue;
+
+    uint64_t* rowWords = &matrix->words[row * matrix->numWords];
+    bool seenCommon = false;
+    bool seenRepresentativeOnly = false;
+    for (size_t w = 0; w < matrix->numWords; ++w)
     {
-//       CMRdbgMsg(14, "findRank2(): processing row r%ld.\n", row+1);
-      size_t entry = matrix->rowSlice[row];
-      size_t beyond = matrix->rowSlice[row + 1];
-      size_t column = (entry < beyond) ? matrix->entryColumns[entry] : SIZE_MAX;
-      size_t entryRep = matrix->rowSlice[rowRepresentative[part][0]];
-      size_t beyondRep = matrix->rowSlice[rowRepresentative[part][0] + 1];
-      size_t columnRep = (entryRep < beyondRep) ? matrix->entryColumns[entryRep] : SIZE_MAX;
-      bool isZero = true;
-      bool equalRep = true;
-      while (column != SIZE_MAX || columnRep != SIZE_MAX)
+      uint64_t current = rowWords[w] & otherColumnsMask[w];
+      uint64_t representative = representativeWords[w] & otherColumnsMask[w];
+      uint64_t common = current & representative;
+      uint64_t representativeOnly = representative & ~current;
+
+      /* Candidate columns: a nonzero of the current row only, a nonzero of the representative only after a common
+       * nonzero, and a common nonzero after a nonzero of the representative only. Shifting the lowest 1-bit by 1
+       * yields a mask of the strictly higher bits after negation. */
+      uint64_t candidates = current & ~representative;
+      if (seenCommon)
+        candidates |= representativeOnly;
+      else if (common)
+        candidates |= representativeOnly & ~(((common & (~common + 1)) << 1) - 1);
+      if (seenRepresentativeOnly)
+        candidates |= common;
+      else if (representativeOnly)
+        candidates |= common & ~(((representativeOnly & (~representativeOnly + 1)) << 1) - 1);
+
+      if (candidates)
       {
-//         CMRdbgMsg(14, "findRank2(): current row's column is c%ld, representative row's column is c%ld.\n", column+1,
-//           columnRep+1);
-        if (column < columnRep)
-        {
-//           CMRdbgMsg(14, "findRank2(): current row has a 1, representative row has a 0.\n");
-          if (columnData[column].part == 1-part)
-          {
-//             CMRdbgMsg(14, "findRank2(): inside submatrix!\n");
-            /* New row has a 1-entry but representative does not. */
-            rowRepresentative[part][1] = row;
-            columnRepresentative[1-part][1] = column;
-            return true;
-          }
-          else
-          {
-            /* We're outside of the submatrix. */
-            ++entry;
-            column = (entry < beyond) ? matrix->entryColumns[entry] : SIZE_MAX;
-          }
-        }
-        else if (columnRep < column)
-        {
-//           CMRdbgMsg(14, "findRank2(): current row has a 0, representative row has a 1.\n");
-          if (columnData[columnRep].part == 1-part)
-          {
-//             CMRdbgMsg(14, "findRank2(): inside submatrix!\n");
-            if (!isZero)
-            {
-              /* We had a common nonzero before, so the 0 here yields rank 2. */
-              rowRepresentative[part][1] = row;
-              columnRepresentative[1-part][1] = columnRep;
-              return true;
-            }
-            else
-              equalRep = false;
-          }
-
-          /* We're outside of the submatrix or still a zero vector. */
-          ++entryRep;
-          columnRep = (entryRep < beyondRep) ? matrix->entryColumns[entryRep] : SIZE_MAX;
-        }
-        else
-        {
-//           CMRdbgMsg(14, "findRank2(): current row has a 1, representative row has a 1.\n");
-          if (columnData[column].part == 1-part)
-          {
-//             CMRdbgMsg(14, "findRank2(): inside submatrix!\n");
-            if (!equalRep)
-            {
-              /* We had a 1 in rep with a 0 here before, so the two 1s here yield rank 2. */
-              rowRepresentative[part][1] = row;
-              columnRepresentative[1-part][1] = columnRep;
-              return true;
-            }
-            else
-              isZero = false;
-          }
-
-          /* We're outside of the submatrix. */
-          ++entry;
-          column = (entry < beyond) ? matrix->entryColumns[entry] : SIZE_MAX;
-          ++entryRep;
-          columnRep = (entryRep < beyondRep) ? matrix->entryColumns[entryRep] : SIZE_MAX;
-        }
+        rowRepresentative[part][1] = row;
+        columnRepresentative[1-part][1] = 64 * w + CMRlowestBit(candidates);
+        return true;
       }
+
+      seenCommon = seenCommon || common;
+      seenRepresentativeOnly = seenRepresentativeOnly || representativeOnly;
     }
   }
 
   return false;
 }
 
-/**
- * \brief Checks whether the submatrix with rows assigned to \p part and columns assigned to the other has at least
- *        rank 3.
- *
- * Assumes that \p rowRepresentative already contains two distinct nonzero rows in that submatrix.
- */
-
-static
-bool findRank3(
-  CMR_CHRMAT* matrix,                 /**< Matrix. */
-  ElementData* rowData,               /**< Row element data. */
-  ElementData* columnData,            /**< Column element data. */
-  size_t rowRepresentative[2][2],     /**< Row representatives for each part. */
-  short part                          /**< Part to which the investigated rows belong. */
-)
+short CMRregularityPackedType(PackedMatrix* matrix, uint64_t* mask, size_t representatives[2], size_t row)
 {
   assert(matrix);
-  assert(rowData);
-  assert(rowRepresentative);
-  assert(part >=0 && part < 2);
-  assert(rowRepresentative[part][0] < SIZE_MAX);
-  assert(rowRepresentative[part][1] < SIZE_MAX);
+  assert(mask);
 
-  for (size_t row = rowRepresentative[part][1] + 1; row < matrix->numRows; ++row)
+  uint64_t* rowWords = &matrix->words[row * matrix->numWords];
+  uint64_t* firstWords = representatives[0] < SIZE_MAX ? &matrix->words[representatives[0] * matrix->numWords]
+    : NULL;
+  uint64_t* secondWords = representatives[1] < SIZE_MAX ? &matrix->words[representatives[1] * matrix->numWords]
+    : NULL;
+
+  bool compatible[4] = { true, firstWords != NULL, secondWords != NULL, secondWords != NULL };
+  for (size_t w = 0; w < matrix->numWords; ++w)
   {
-    if (rowData[row].part == part)
-    {
-//       CMRdbgMsg(14, "findRank3(): inspecting row r%ld.\n", row+1);
-      size_t entry[3] = {
-        matrix->rowSlice[row],
-        matrix->rowSlice[rowRepresentative[part][0]],
-        matrix->rowSlice[rowRepresentative[part][1]]
-      };
-      size_t beyond[3] = {
-        matrix->rowSlice[row + 1],
-        matrix->rowSlice[rowRepresentative[part][0] + 1],
-        matrix->rowSlice[rowRepresentative[part][1] + 1]
-      };
-      size_t column[3];
-      for (short i = 0; i < 3; ++i)
-        column[i] = entry[i] < beyond[i] ? matrix->entryColumns[entry[i]] : SIZE_MAX;
-
-      bool compatible[4] = { true, true, true, true };
-      while (column[0] != SIZE_MAX || column[1] != SIZE_MAX || column[2] != SIZE_MAX)
-      {
-        size_t minColumn = (column[0] < column[1]) ? column[0] : column[1];
-//         CMRdbgMsg(14, "findRank3(): inspecting column c%ld.\n", minColumn+1);
-        if (column[2] < minColumn)
-          minColumn = column[2];
-        bool nonzero[3] = { column[0] == minColumn, column[1] == minColumn, column[2] == minColumn };
+    uint64_t current = rowWords[w] & mask[w];
+    uint64_t first = firstWords ? (firstWords[w] & mask[w]) : 0;
+    uint64_t second = secondWords ? (secondWords[w] & mask[w]) : 0;
+    compatible[0] = compatible[0] && !current;
+    compatible[1] = compatible[1] && !(current ^ first);
+    compatible[2] = compatible[2] && !(current ^ second);
+    compatible[3] = compatible[3] && !(current ^ first ^ second);
+  }
 
-        if (columnData[minColumn].part == 1-part)
-        {
-//           CMRdbgMsg(14, "findRank3(): nonzeros are (%d,%d,%d).\n", nonzero[0] ? 1 : 0, nonzero[1] ? 1 : 0,
-//             nonzero[2] ? 1 : 0);
-
-          if (nonzero[0])
-            compatible[0] = false;
-          if (nonzero[0] != nonzero[1])
-            compatible[1] = false;
-          if (nonzero[0] != nonzero[2])
-            compatible[2] = false;
-          if (((nonzero[0] ? 1 : 0) + (nonzero[1] ? 1 : 0) + (nonzero[2] ? 1 : 0)) % 2)
-            compatible[3] = false;
-
-//           CMRdbgMsg(14, "findRank3(): new compatibility is %d,%d,%d,%d.\n", compatible[0] ? 1 : 0, compatible[1] ? 1 : 0,
-//             compatible[2] ? 1 : 0, compatible[3] ? 1 : 0);
-        }
+  assert((compatible[0] ? 1 : 0) + (compatible[1] ? 1 : 0) + (compatible[2] ? 1 : 0) + (compatible[3] ? 1 : 0) <= 1);
 
-        /* Advance entries with a nonzero. */
-        for (short i = 0; i < 3; ++i)
-        {
-          if (nonzero[i])
-          {
-            entry[i]++;
-            column[i] = entry[i] < beyond[i] ? matrix->entryColumns[entry[i]] : SIZE_MAX;
-          }
-        }
-      }
-      if (!compatible[0] && !compatible[1] && !compatible[2] && !compatible[3])
-        return true;
-    }
+  for (short type = 3; type >= 0; --type)
+  {
+    if (compatible[type])
+      return type;
   }
 
-  return false;
+  return -1;
 }
 
-
 /**
- * \brief Checks whether the given \p row can be attached to \p part.
+ * \brief Checks whether the submatrix with rows assigned to \p part and columns assigned to the other has at least
+ *        rank 3.
+ *
+ * Assumes that \p rowRepresentative already contains two distinct nonzero rows in that submatrix.
  */
 
 static
-void determineType(
-  CMR_CHRMAT* matrix,                 /**< Matrix. */
+bool findRank3(
+  PackedMatrix* matrix,               /**< Packed matrix. */
+  size_t numAssignedRows,             /**< Number of leading rows that may be assigned to a part. */
   ElementData* rowData,               /**< Row element data. */
-  ElementData* columnData,            /**< Column element data. */
+  uint64_t* otherColumnsMask,         /**< Mask of the columns assigned to the other part. */
   size_t rowRepresentative[2][2],     /**< Row representatives for each part. */
-  size_t row,                         /**< Row index to check. */
-  short part,                         /**< Part to which the investigated rows belong. */
-  bool isRow                          /**< Whether we're actually dealing with rows. */
+  short part                          /**< Part to which the investigated rows belong. */
 )
 {
-  CMR_UNUSED(isRow);
-
   assert(matrix);
   assert(rowData);
   assert(rowRepresentative);
   assert(part >=0 && part < 2);
+  assert(rowRepresentative[part][0] < SIZE_MAX);
+  assert(rowRepresentative[part][1] < SIZE_MAX);
 
-  size_t entry[3] = {
-    matrix->rowSlice[row],
-    rowRepresentative[part][0] < SIZE_MAX ? matrix->rowSlice[rowRepresentative[part][0]] : SIZE_MAX,
-    rowRepresentative[part][1] < SIZE_MAX ? matrix->rowSlice[rowRepresentative[part][1]] : SIZE_MAX
-  };
-  size_t beyond[3] = {
-    matrix->rowSlice[row + 1],
-    rowRepresentative[part][0] < SIZE_MAX ? matrix->rowSlice[rowRepresentative[part][0] + 1] : SIZE_MAX,
-    rowRepresentative[part][1] < SIZE_MAX ? matrix->rowSlice[rowRepresentative[part][1] + 1] : SIZE_MAX
-  };
-  size_t column[3];
-  for (short i = 0; i < 3; ++i)
-    column[i] = entry[i] < beyond[i] ? matrix->entryColumns[entry[i]] : SIZE_MAX;
-
-  bool compatible[4] = {
-    true,
-    rowRepresentative[part][0] < SIZE_MAX,
-    rowRepresentative[part][1] < SIZE_MAX,
-    rowRepresentative[part][1] < SIZE_MAX
-  };
-
-  for (short r = 0; r < 4; ++r)
-  {
-    if (compatible[r])
-    {
-//       CMRdbgMsg(12, "Initially, %s %c%ld for part %d is compatible with %d.\n", isRow ? "Row" : "Column", isRow ? 'r' : 'c',
-//         row+1, part, r);
-      rowData[row].type[part] = r;
-    }
-  }
-
-  while (column[0] != SIZE_MAX || column[1] != SIZE_MAX || column[2] != SIZE_MAX)
-  {
-    size_t minColumn = (column[0] < column[1]) ? column[0] : column[1];
-    if (column[2] < minColumn)
-      minColumn = column[2];
-    bool nonzero[3] = { column[0] == minColumn, column[1] == minColumn, column[2] == minColumn };
-
-    if (columnData[minColumn].part == 1-part)
-    {
-//       CMRdbgMsg(14, "column is c%ld. nonzeros are %d,%d,%d\n", minColumn+1, nonzero[0], nonzero[1], nonzero[2]);
-
-      if (nonzero[0])
-        compatible[0] = false;
-      if (nonzero[0] != nonzero[1])
-        compatible[1] = false;
-      if (nonzero[0] != nonzero[2])
-        compatible[2] = false;
-      if (((nonzero[0] ? 1 : 0) + (nonzero[1] ? 1 : 0) + (nonzero[2] ? 1 : 0)) % 2)
-        compatible[3] = false;
-    }
-
-    /* Advance entries with a nonzero. */
-    for (short i = 0; i < 3; ++i)
-    {
-      if (nonzero[i])
-      {
-        entry[i]++;
-        column[i] = entry[i] < beyond[i] ? matrix->entryColumns[entry[i]] : SIZE_MAX;
-      }
-    }
-  }
-
-  rowData[row].type[part] = -1;
-  for (short r = 0; r < 4; ++r)
+  for (size_t row = rowRepresentative[part][1] + 1; row < numAssignedRows; ++row)
   {
-    if (compatible[r])
-    {
-//       CMRdbgMsg(12, "%s %c%ld for part %d is compatible with %d.\n", isRow ? "Row" : "Column", isRow ? 'r' : 'c',
-//         row+1, part, r);
-      rowData[row].type[part] = r;
-    }
+    if (rowData[row].part == part
+      && CMRregularityPackedType(matrix, otherColumnsMask, rowRepresentative[part], row) < 0)
+      return true;
   }
 
-  assert((compatible[0] ? 1 : 0) + (compatible[1] ? 1 : 0) + (compatible[2] ? 1 : 0) + (compatible[3] ? 1 : 0) <= 1);
+  return false;
 }
 
 
@@ -458,6 +304,10 @@ CMR_ERROR extendMinorSeparation(
   CMR_CHRMAT* transpose,    /**< Transpose of \p matrix. */
   ElementData* rowData,     /**< Row element data. */
   ElementData* columnData,  /**< Column element data. */
+  PackedMatrix* packedRows,     /**< Rows of \p matrix restricted to the columns that may be assigned. */
+  PackedMatrix* packedColumns,  /**< Rows of \p transpose restricted to the rows that may be assigned. */
+  uint64_t* rowsMask[2],    /**< For each part, memory for the mask of its rows. */
+  uint64_t* columnsMask[2], /**< For each part, memory for the mask of its columns. */
   size_t* partRows[2],      /**< For each part, an array with its already assigned rows. */
   size_t partNumRows[2],    /**< For each part, the number of already assigned rows. */
   size_t* partColumns[2],   /**< For each part, an array with its already assigned columns. */
@@ -468,6 +318,10 @@ CMR_ERROR extendMinorSeparation(
 {
   assert(matrix);
   assert(transpose);
+  assert(packedRows);
+  assert(packedColumns);
+  assert(rowsMask);
+  assert(columnsMask);
   assert(partRows);
   assert(partRows[0]);
   assert(partRows[1]);
@@ -488,14 +342,29 @@ CMR_ERROR extendMinorSeparation(
   for (size_t column = 0; column < numColumns; ++column)
     columnData[column].part = -1;
 
-  /* Set already asigned rows and columns.. */
+  /* Set already asigned rows and columns and their masks. */
   for (short part = 0; part < 2; ++part)
   {
+    for (size_t w = 0; w < packedColumns->numWords; ++w)
+      rowsMask[part][w] = 0;
+    for (size_t w = 0; w < packedRows->numWords; ++w)
+      columnsMask[part][w] = 0;
     for (size_t r = 0; r < partNumRows[part]; ++r)
-      rowData[partRows[part][r]].part = part;
+    {
+      size_t row = partRows[part][r];
+      assert(row < packedColumns->numColumns);
+      rowData[row].part = part;
+      rowsMask[part][row / 64] |= (uint64_t) 1 << (row % 64);
+    }
     for (size_t c = 0; c < partNumColumns[part]; ++c)
-      columnData[partColumns[part][c]].part = part;
+    {
+      size_t column = partColumns[part][c];
+      assert(column < packedRows->numColumns);
+      columnData[column].part = part;
+      columnsMask[part][column / 64] |= (uint64_t) 1 << (column % 64);
+    }
   }
+  size_t numAssignedRows = packedColumns->numColumns;
 
   size_t rowRepresentative[2][2] = { {SIZE_MAX, SIZE_MAX}, {SIZE_MAX, SIZE_MAX} };
   size_t columnRepresentative[2][2] = { {SIZE_MAX, SIZE_MAX}, {SIZE_MAX, SIZE_MAX} };
@@ -510,13 +379,14 @@ CMR_ERROR extendMinorSeparation(
 #endif /* CMR_DEBUG_MATRICES */
 
   size_t totalRank = 0;
-  if (findRank1(matrix, rowData, columnData, rowRepresentative, columnRepresentative, 0))
+  if (findRank1(packedRows, numAssignedRows, rowData, columnsMask[1], rowRepresentative, columnRepresentative, 0))
   {
     CMRdbgMsg(12, "Top-right part has rank at least 1.\n");
-    if (findRank2(matrix, rowData, columnData, rowRepresentative, columnRepresentative, 0))
+    if (CMRregularityPackedFindRank2(packedRows, numAssignedRows, rowData, columnsMask[1], rowRepresentative,
+      columnRepresentative, 0))
     {
       CMRdbgMsg(12, "Top-right part has rank at least 2.\n");
-      if (findRank3(matrix, rowData, columnData, rowRepresentative, 0))
+      if (findRank3(packedRows, numAssignedRows, rowData, columnsMask[1], rowRepresentative, 0))
       {
         CMRdbgMsg(12, "Top-right part has rank at least 3.\n");
         return CMR_OKAY;
@@ -534,19 +404,20 @@ CMR_ERROR extendMinorSeparation(
     CMRdbgMsg(12, "Top-right part has rank 0.\n");
   }
 
-  if (findRank1(matrix, rowData, columnData, rowRepresentative, columnRepresentative, 1))
+  if (findRank1(packedRows, numAssignedRows, rowData, columnsMask[0], rowRepresentative, columnRepresentative, 1))
   {
     CMRdbgMsg(12, "Bottom-left part has rank at least 1.\n");
     ++totalRank;
     if (totalRank >= 3)
       return CMR_OKAY;
-    if (findRank2(matrix, rowData, columnData, rowRepresentative, columnRepresentative, 1))
+    if (CMRregularityPackedFindRank2(packedRows, numAssignedRows, rowData, columnsMask[0], rowRepresentative,
+      columnRepresentative, 1))
     {
       CMRdbgMsg(12, "Bottom-left part has rank at least 2.\n");
       ++totalRank;
       if (totalRank >= 3)
         return CMR_OKAY;
-      if (findRank3(matrix, rowData, columnData, rowRepresentative, 1))
+      if (findRank3(packedRows, numAssignedRows, rowData, columnsMask[0], rowRepresentative, 1))
       {
         CMRdbgMsg(12, "Bottom-left part has rank at least 3.\n");
         return CMR_OKAY;
@@ -580,8 +451,8 @@ CMR_ERROR extendMinorSeparation(
   {
     if (rowData[row].part == -1)
     {
-      determineType(matrix, rowData, columnData, rowRepresentative, row, 0, true);
-      determineType(matrix, rowData, columnData, rowRepresentative, row, 1, true);
+      rowData[row].type[0] = CMRregularityPackedType(packedRows, columnsMask[1], rowRepresentative[0], row);
+      rowData[row].type[1] = CMRregularityPackedType(packedRows, columnsMask[0], rowRepresentative[1], row);
 //       CMRdbgMsg(12, "Row r%ld has type %d for part 0 and type %d for part 1.\n", row+1, rowData[row].type[0],
 //         rowData[row].type[1]);
       if (rowData[row].type[0] < 0 && rowData[row].type[1] < 0)
@@ -596,8 +467,10 @@ CMR_ERROR extendMinorSeparation(
   {
     if (columnData[column].part == -1)
     {
-      determineType(transpose, columnData, rowData, columnRepresentative, column, 0, false);
-      determineType(transpose, columnData, rowData, columnRepresentative, column, 1, false);
+      columnData[column].type[0] = CMRregularityPackedType(packedColumns, rowsMask[1], columnRepresentative[0],
+        column);
+      columnData[column].type[1] = CMRregularityPackedType(packedColumns, rowsMask[0], columnRepresentative[1],
+        column);
 //       CMRdbgMsg(12, "Column c%ld has type %d for part 0 and type %d for part 1.\n", column+1,
 //         columnData[column].type[0], columnData[column].type[1]);
       if (columnData[column].type[0] < 0 && columnData[column].type[1] < 0)
@@ -730,6 +603,184 @@ CMR_ERROR extendMinorSeparation(
   return CMR_OKAY;
 }
 
+/**
+ * \brief Working storage of a single worker of \ref CMRregularityNestedMinorSequenceSearchThreeSeparation.
+ */
+
+typedef struct
+{
+  ElementData* rowData;       /**< \brief Row element data. */
+  ElementData* columnData;    /**< \brief Column element data. */
+  size_t* partRows[2];        /**< \brief For each part, an array with its already assigned rows. */
+  size_t* partColumns[2];     /**< \brief For each part, an array with its already assigned columns. */
+  uint64_t* rowsMask[2];      /**< \brief For each part, the mask of its rows. */
+  uint64_t* columnsMask[2];   /**< \brief For each part, the mask of its columns. */
+  CMR_ELEMENT* queue;         /**< \brief Memory for a queue of elements. */
+  uint32_t numCandidates;     /**< \brief Number of candidates this worker extended. */
+} ThreeSeparationWorker;
+
+/**
+ * \brief Data shared by all tasks of \ref CMRregularityNestedMinorSequenceSearchThreeSeparation.
+ *
+ * Each task is one candidate partition of the elements of a minor, and the candidates are numbered in the order in
+ * which a sequential enumeration would consider them: first all partitions of the first minor, and then, for each
+ * minor from the first non-(co)graphic one down to the second, the partitions in which at most one element of the
+ * previous minor and at least one new element is in part 0.
+ */
+
+typedef struct
+{
+  CMR* owner;                         /**< \brief \ref CMR environment that owns the buffers. */
+  CMR_SEYMOUR_NODE* dec;              /**< \brief Node whose nested minor sequence is searched. */
+  size_t firstMinor;                  /**< \brief Index of the first minor with at least 8 elements. */
+  size_t firstNonCoGraphicMinor;      /**< \brief Index of the first minor that is neither graphic nor cographic. */
+  PackedMatrix packedRows;            /**< \brief Rows of the nested minors matrix, packed. */
+  PackedMatrix packedColumns;         /**< \brief Columns of the nested minors matrix, packed. */
+  size_t numInitialCandidates;        /**< \brief Number of candidates for the first minor. */
+  size_t* minorsFirstCandidate;       /**< \brief Number of preceding candidates of later minors, in decreasing order
+                                       *          of the minor index, followed by the total number of them. */
+  ThreeSeparationWorker* workers;     /**< \brief Working storage for each worker. */
+  double startTime;                   /**< \brief Wall clock time at which the search was started. */
+  double timeLimit;                   /**< \brief Time limit to impose on the search. */
+} ThreeSeparationSearch;
+
+/**
+ * \brief Distributes the elements according to \p candidate and extends the partition to a 3-separation.
+ */
+
+static
+CMR_ERROR extendCandidate(
+  CMR* cmr,                         /**< \ref CMR environment. */
+  ThreeSeparationSearch* search,    /**< Search data. */
+  ThreeSeparationWorker* worker,    /**< Working storage. */
+  size_t candidate,                 /**< Index of the candidate. */
+  CMR_SEPA** pseparation            /**< Pointer for storing the 3-separation or \c NULL if none was found. */
+)
+{
+  assert(cmr);
+  assert(search);
+  assert(worker);
+  assert(pseparation);
+
+  CMR_SEYMOUR_NODE* dec = search->dec;
+  size_t partNumRows[2] = { 0, 0 };
+  size_t partNumColumns[2] = { 0, 0 };
+
+  if (candidate < search->numInitialCandidates)
+  {
+    /* Arbitrary partition of the first minor. */
+    size_t firstMinorNumRows = dec->nestedMinorsSequenceNumRows[search->firstMinor];
+    size_t firstMinorNumColumns = dec->nestedMinorsSequenceNumColumns[search->firstMinor];
+    for (size_t row = 0; row < firstMinorNumRows; ++row)
+    {
+      short part = (candidate & ((size_t) 1 << row)) ? 1 : 0;
+      worker->partRows[part][partNumRows[part]++] = row;
+    }
+    for (size_t column = 0; column < firstMinorNumColumns; ++column)
+    {
+      short part = (candidate & ((size_t) 1 << (firstMinorNumRows + column))) ? 1 : 0;
+      worker->partColumns[part][partNumColumns[part]++] = column;
+    }
+
+    CMRdbgMsg(10, "Considering initial minor partition in which the first part has %zu rows and %zu columns.\n",
+      partNumRows[0], partNumColumns[0]);
+  }
+  else
+  {
+    /* Find the minor by a binary search over the numbers of candidates before each minor. */
+    candidate -= search->numInitialCandidates;
+    size_t lower = 0;
+    size_t upper = search->firstNonCoGraphicMinor - search->firstMinor;
+    while (upper - lower > 1)
+    {
+      size_t middle = (lower + upper) / 2;
+      if (search->minorsFirstCandidate[middle] <= candidate)
+        lower = middle;
+      else
+        upper = middle;
+    }
+    size_t minor = search->firstNonCoGraphicMinor - lower;
+    candidate -= search->minorsFirstCandidate[lower];
+
+    size_t numOldRows = dec->nestedMinorsSequenceNumRows[minor-1];
+    size_t numOldColumns = dec->nestedMinorsSequenceNumColumns[minor-1];
+    size_t numNewRows = dec->nestedMinorsSequenceNumRows[minor] - numOldRows;
+    size_t numNewColumns = dec->nestedMinorsSequenceNumColumns[minor] - numOldColumns;
+    size_t beyondBits = ((size_t) 1 << (numNewRows + numNewColumns)) - 1; /* Ensures that part 0 is non-empty. */
+    size_t old = candidate / beyondBits;
+    size_t bits = candidate % beyondBits;
+
+    CMRdbgMsg(8, "Considering minor with %zu rows and %zu columns.\n", dec->nestedMinorsSequenceNumRows[minor],
+      dec->nestedMinorsSequenceNumColumns[minor]);
+
+    /* Distribute previous minors' rows and columns to part 1 unless equal to the old element. */
+    for (size_t row = 0; row < numOldRows; ++row)
+    {
+      short part = (row == old) ? 0 : 1;
+      worker->partRows[part][partNumRows[part]++] = row;
+    }
+    for (size_t column = 0; column < numOldColumns; ++column)
+    {
+      short part = (numOldRows + column == old) ? 0 : 1;
+      worker->partColumns[part][partNumColumns[part]++] = column;
+    }
+
+    /* Distribute the new rows and columns. */
+    for (size_t newRow = 0; newRow < numNewRows; ++newRow)
+    {
+      short part = (bits & ((size_t) 1 << newRow)) ? 1 : 0;
+      worker->partRows[part][partNumRows[part]++] = numOldRows + newRow;
+    }
+    for (size_t newColumn = 0; newColumn < numNewColumns; ++newColumn)
+    {
+      short part = (bits & ((size_t) 1 << (numNewRows + newColumn))) ? 1 : 0;
+      worker->partColumns[part][partNumColumns[part]++] = numOldColumns + newColumn;
+    }
+
+    CMRdbgMsg(12, "Considering partition in which the first part has %zu rows and %zu columns.\n", partNumRows[0],
+      partNumColumns[0]);
+  }
+
+  CMR_CALL( extendMinorSeparation(cmr, dec->nestedMinorsMatrix, dec->nestedMinorsTranspose, worker->rowData,
+    worker->columnData, &search->packedRows, &search->packedColumns, worker->rowsMask, worker->columnsMask,
+    worker->partRows, partNumRows, worker->partColumns, partNumColumns, worker->queue, pseparation) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Extends a single candidate partition; to be called by \ref CMRparallelFindFirst.
+ */
+
+static
+CMR_ERROR threeSeparationTask(
+  CMR* cmr,     /**< \ref CMR environment of the worker. */
+  size_t task,  /**< Index of the candidate. */
+  void* data,   /**< Pointer to the \ref ThreeSeparationSearch. */
+  bool* pfound  /**< Pointer for storing whether the candidate extends to a 3-separation. */
+)
+{
+  ThreeSeparationSearch* search = (ThreeSeparationSearch*) data;
+  ThreeSeparationWorker* worker = &search->workers[CMRparallelWorkerIndex(search->owner, cmr)];
+
+  double remainingTime = search->timeLimit - (CMRwallClock() - search->startTime);
+  if (remainingTime <= 0)
+    return CMR_ERROR_TIMEOUT;
+
+  worker->numCandidates++;
+
+  /* The separation is recomputed by the caller for the first successful candidate. */
+  CMR_SEPA* separation = NULL;
+  CMR_CALL( extendCandidate(cmr, search, worker, task, &separation) );
+  if (separation)
+  {
+    *pfound = true;
+    CMR_CALL( CMRsepaFree(cmr, &separation) );
+  }
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRregularityNestedMinorSequenceSearchThreeSeparation(CMR* cmr, DecompositionTask* task,
   DecompositionQueue* queue)
 {
@@ -745,7 +796,7 @@ CMR_ERROR CMRregularityNestedMinorSequenceSearchThreeSeparation(CMR* cmr, Decomp
   assert(dec->nestedMinorsTranspose);
   assert(dec->nestedMinorsLength >= 2);
 
-  clock_t startClock = clock();
+  double startTime = CMRwallClock();
 
   CMRdbgMsg(6, "Searching for 3-separations along the sequence of nested minors for the following matrix:\n");
 #if defined(CMR_DEBUG_MATRICES)
@@ -797,25 +848,8 @@ CMR_ERROR CMRregularityNestedMinorSequenceSearchThreeSeparation(CMR* cmr, Decomp
   CMRdbgMsg(8, "-> searching for induced 3-separations for minor indices in [%zu,%zu].\n", firstMinor,
     firstNonCoGraphicMinor);
 
-  /* Prepare calls to the separation-extension algorithm. */
-  ElementData* rowData = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &rowData, dec->matrix->numRows) );
-  ElementData* columnData = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &columnData, dec->matrix->numColumns) );
-
   assert(firstMinor <= firstNonCoGraphicMinor);
 
-  size_t* partRows[2] = { NULL, NULL };
-  size_t partNumRows[2];
-  size_t* partColumns[2] = { NULL, NULL };;
-  size_t partNumColumns[2];
-  CMR_ELEMENT* queueMemory = NULL;
-  CMR_CALL( CMRallocStackArray(cmr, &partRows[0], dec->nestedMinorsSequenceNumRows[firstNonCoGraphicMinor]) );
-  CMR_CALL( CMRallocStackArray(cmr, &partRows[1], dec->nestedMinorsSequenceNumRows[firstNonCoGraphicMinor]) );
-  CMR_CALL( CMRallocStackArray(cmr, &partColumns[0], dec->nestedMinorsSequenceNumColumns[firstNonCoGraphicMinor]) );
-  CMR_CALL( CMRallocStackArray(cmr, &partColumns[1], dec->nestedMinorsSequenceNumColumns[firstNonCoGraphicMinor]) );
-  CMR_CALL( CMRallocStackArray(cmr, &queueMemory, dec->matrix->numRows + dec->matrix->numColumns) );
-
   size_t firstMinorNumRows = dec->nestedMinorsSequenceNumRows[firstMinor];
   size_t firstMinorNumColumns = dec->nestedMinorsSequenceNumColumns[firstMinor];
 
@@ -827,146 +861,97 @@ CMR_ERROR CMRregularityNestedMinorSequenceSearchThreeSeparation(CMR* cmr, Decomp
   if (task->stats)
     task->stats->enumerationCount++;
 
-  /* Enumerate all cardinality-at-most-half subsets of the element set of the first minor. */
-  short beyondBits = 1 << (firstMinorNumRows + firstMinorNumColumns);
-  CMR_SEPA* separation = NULL;
-  double remainingTime = task->timeLimit - (clock() - task->startClock) * 1.0 / CLOCKS_PER_SEC;
-  for (short bits = 0; bits < beyondBits && !separation && remainingTime > 0.0; ++bits)
+  /* Count the candidates: all subsets of the element set of the first minor, and for each later minor all subsets
+   * that have at most 1 element from the previous minor and at least one new. */
+
+  ThreeSeparationSearch search;
+  search.owner = cmr;
+  search.dec = dec;
+  search.firstMinor = firstMinor;
+  search.firstNonCoGraphicMinor = firstNonCoGraphicMinor;
+
+  /* Only elements of the first non-(co)graphic minor are assigned to a part before the types of the remaining ones
+   * are determined. We pack the entries in these rows and columns. */
+
+  size_t lastMinorNumRows = dec->nestedMinorsSequenceNumRows[firstNonCoGraphicMinor];
+  size_t lastMinorNumColumns = dec->nestedMinorsSequenceNumColumns[firstNonCoGraphicMinor];
+  CMR_STACKMARK stackMark;
+  CMR_CALL( CMRstackMark(cmr, &stackMark) );
+  CMR_CALL( CMRregularityPackedCreate(cmr, dec->nestedMinorsMatrix, lastMinorNumColumns, &search.packedRows) );
+  CMR_CALL( CMRregularityPackedCreate(cmr, dec->nestedMinorsTranspose, lastMinorNumRows, &search.packedColumns) );
+  search.numInitialCandidates = (size_t) 1 << (firstMinorNumRows + firstMinorNumColumns);
+  /* The candidates are tested in parallel, so the remaining time is measured by wall clock time. */
+  search.startTime = CMRwallClock();
+  search.timeLimit = task->timeLimit - (clock() - task->startClock) * 1.0 / CLOCKS_PER_SEC;
+  search.minorsFirstCandidate = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.minorsFirstCandidate, firstNonCoGraphicMinor - firstMinor + 1) );
+  size_t numCandidates = 0;
+  for (size_t minor = firstNonCoGraphicMinor; minor >= firstMinor+1; --minor)
   {
-    partNumRows[0] = 0;
-    partNumRows[1] = 0;
-    for (size_t row = 0; row < firstMinorNumRows; ++row)
-    {
-      short part = (bits & (1 << row)) ? 1 : 0;
-      partRows[part][partNumRows[part]++] = row;
-    }
+    search.minorsFirstCandidate[firstNonCoGraphicMinor - minor] = numCandidates;
+    size_t numOld = dec->nestedMinorsSequenceNumRows[minor-1] + dec->nestedMinorsSequenceNumColumns[minor-1];
+    size_t numNew = dec->nestedMinorsSequenceNumRows[minor] + dec->nestedMinorsSequenceNumColumns[minor] - numOld;
+    numCandidates += (numOld + 1) * (((size_t) 1 << numNew) - 1);
+  }
+  search.minorsFirstCandidate[firstNonCoGraphicMinor - firstMinor] = numCandidates;
+  numCandidates += search.numInitialCandidates;
 
-    partNumColumns[0] = 0;
-    partNumColumns[1] = 0;
-    for (size_t column = 0; column < firstMinorNumColumns; ++column)
+  /* Each worker gets its own working storage. */
+
+  size_t numWorkers = CMRparallelNumWorkers(cmr);
+  search.workers = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &search.workers, numWorkers) );
+  for (size_t w = 0; w < numWorkers; ++w)
+  {
+    ThreeSeparationWorker* worker = &search.workers[w];
+    worker->rowData = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &worker->rowData, dec->matrix->numRows) );
+    worker->columnData = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &worker->columnData, dec->matrix->numColumns) );
+    for (short part = 0; part < 2; ++part)
     {
-      short part = (bits & (1 << (firstMinorNumRows + column))) ? 1 : 0;
-      partColumns[part][partNumColumns[part]++] = column;
+      worker->partRows[part] = NULL;
+      CMR_CALL( CMRallocStackArray(cmr, &worker->partRows[part], lastMinorNumRows) );
+      worker->partColumns[part] = NULL;
+      CMR_CALL( CMRallocStackArray(cmr, &worker->partColumns[part], lastMinorNumColumns) );
+      worker->rowsMask[part] = NULL;
+      CMR_CALL( CMRallocStackArray(cmr, &worker->rowsMask[part], search.packedColumns.numWords) );
+      worker->columnsMask[part] = NULL;
+      CMR_CALL( CMRallocStackArray(cmr, &worker->columnsMask[part], search.packedRows.numWords) );
     }
+    worker->queue = NULL;
+    CMR_CALL( CMRallocStackArray(cmr, &worker->queue, dec->matrix->numRows + dec->matrix->numColumns) );
+    worker->numCandidates = 0;
+  }
 
-    CMRdbgMsg(10, "Considering initial minor partition in which the first part has %zu rows and %zu columns.\n",
-      partNumRows[0], partNumColumns[0]);
-
-    if (task->stats)
-      task->stats->enumerationCandidatesCount++;
-
-    CMR_CALL( extendMinorSeparation(cmr, dec->nestedMinorsMatrix, dec->nestedMinorsTranspose, rowData, columnData,
-      partRows, partNumRows, partColumns, partNumColumns, queueMemory, &separation) );
+  /* The first successful candidate is the one the sequential enumeration would find. */
 
-    remainingTime = task->timeLimit - (clock() - task->startClock) * 1.0 / CLOCKS_PER_SEC;
+  CMR_SEPA* separation = NULL;
+  double remainingTime = 1.0;
+  size_t firstCandidate;
+  error = CMRparallelFindFirst(cmr, numCandidates, threeSeparationTask, &search, &firstCandidate);
+  if (error == CMR_ERROR_TIMEOUT)
+  {
+    remainingTime = 0.0;
+    error = CMR_OKAY;
   }
+  CMR_CALL( error );
 
-  if (!separation)
+  if (firstCandidate < SIZE_MAX)
   {
-    /* Enumerate all subsets of elements of later minors that have at most 1 element from the previous minor and
-    * at least one new. */
-
-    for (size_t minor = firstNonCoGraphicMinor; minor >= firstMinor+1 && !separation && remainingTime > 0; --minor)
-    {
-//       double remainingTime = timeLimit - (clock() - time) * 1.0 / CLOCKS_PER_SEC;
-//       if (remainingTime < 0)
-//       {
-//         CMR_CALL( CMRfreeStackArray(cmr, &queueMemory) );
-//         CMR_CALL( CMRfreeStackArray(cmr, &partColumns[1]) );
-//         CMR_CALL( CMRfreeStackArray(cmr, &partColumns[0]) );
-//         CMR_CALL( CMRfreeStackArray(cmr, &partRows[1]) );
-//         CMR_CALL( CMRfreeStackArray(cmr, &partRows[0]) );
-//         CMR_CALL( CMRfreeStackArray(cmr, &columnData) );
-//         CMR_CALL( CMRfreeStackArray(cmr, &rowData) );
-//         return CMR_ERROR_TIMEOUT;
-//       }
-
-      CMRdbgMsg(8, "Considering minor with %zu rows and %zu columns.\n", dec->nestedMinorsSequenceNumRows[minor],
-        dec->nestedMinorsSequenceNumColumns[minor]);
-
-      size_t numOldRows = dec->nestedMinorsSequenceNumRows[minor-1];
-      size_t numOldColumns = dec->nestedMinorsSequenceNumColumns[minor-1];
-      for (size_t old = 0; (old <= numOldRows + numOldColumns) && !separation; ++old)
-      {
-        partNumRows[0] = 0;
-        partNumRows[1] = 0;
-        partNumColumns[0] = 0;
-        partNumColumns[1] = 0;
-
-        CMR_ELEMENT oldElement = (old < numOldRows) ? CMRrowToElement(old) :
-          ((old < numOldRows + numOldColumns) ? CMRcolumnToElement(old - numOldRows) : 0 );
-
-        /* Distribute previous minors' rows to part 1 unless equal to oldElement. */
-        for (size_t row = 0; row < numOldRows; ++row)
-        {
-          if (CMRrowToElement(row) == oldElement)
-            partRows[0][partNumRows[0]++] = row;
-          else
-            partRows[1][partNumRows[1]++] = row;
-        }
-
-        /* Distribute previous minors' columns to part 1 unless equal to oldElement. */
-        for (size_t column = 0; column < numOldColumns; ++column)
-        {
-          if (CMRcolumnToElement(column) == oldElement)
-            partColumns[0][partNumColumns[0]++] = column;
-          else
-            partColumns[1][partNumColumns[1]++] = column;
-        }
-
-        CMRdbgMsg(10, "Created partition of previous minors in which the first part has %zu rows and %zu columns.\n",
-          partNumRows[0], partNumColumns[0]);
-
-        /* Enumerate distribution of new elements.
-         * We store the numbers of rows and columns of the old one to skip recalculation. */
-
-        size_t savedPartNumRows[2] = { partNumRows[0], partNumRows[1] };
-        size_t savedPartNumColumns[2] = { partNumColumns[0], partNumColumns[1] };
-        size_t numNewRows = dec->nestedMinorsSequenceNumRows[minor] - dec->nestedMinorsSequenceNumRows[minor-1];
-        size_t numNewColumns = dec->nestedMinorsSequenceNumColumns[minor] - dec->nestedMinorsSequenceNumColumns[minor-1];
-        short beyondBits = (1 << (numNewRows + numNewColumns)) - 1; /* Subtracting 1 ensures that part 0 is non-empty. */
-        for (short bits = 0; bits < beyondBits && !separation; ++bits)
-        {
-          for (size_t newRow = 0; newRow < numNewRows; ++newRow)
-          {
-            size_t row = dec->nestedMinorsSequenceNumRows[minor-1] + newRow;
-            short part = (bits & (1 << newRow)) ? 1 : 0;
-            partRows[part][partNumRows[part]++] = row;
-          }
-
-          for (size_t newColumn = 0; newColumn < numNewColumns; ++newColumn)
-          {
-            size_t column = dec->nestedMinorsSequenceNumColumns[minor-1] + newColumn;
-            short part = (bits & (1 << (numNewRows + newColumn))) ? 1 : 0;
-            partColumns[part][partNumColumns[part]++] = column;
-          }
-
-          /* Skip this distribution if no new element chosen. */
-          CMRdbgMsg(12, "Considering partition in which the first part has %zu rows and %zu columns.\n", partNumRows[0],
-            partNumColumns[0]);
-
-          if (task->stats)
-            task->stats->enumerationCandidatesCount++;
-
-          CMR_CALL( extendMinorSeparation(cmr, dec->nestedMinorsMatrix, dec->nestedMinorsTranspose, rowData, columnData,
-            partRows, partNumRows, partColumns, partNumColumns, queueMemory, &separation) );
-
-          /* Restore distribution of previous minors. */
-          partNumRows[0] = savedPartNumRows[0];
-          partNumRows[1] = savedPartNumRows[1];
-          partNumColumns[0] = savedPartNumColumns[0];
-          partNumColumns[1] = savedPartNumColumns[1];
-        }
-      }
+    CMR_CALL( extendCandidate(cmr, &search, &search.workers[0], firstCandidate, &separation) );
+    assert(separation);
+  }
 
-      remainingTime = task->timeLimit - (clock() - task->startClock) * 1.0 / CLOCKS_PER_SEC;
-    }
+  if (task->stats)
+  {
+    for (size_t w = 0; w < numWorkers; ++w)
+      task->stats->enumerationCandidatesCount += search.workers[w].numCandidates;
   }
 
   if (task->stats)
   {
-    clock_t endClock = clock();
-    task->stats->enumerationTime += (endClock - startClock) * 1.0 / CLOCKS_PER_SEC;
+    task->stats->enumerationTime += CMRwallClock() - startTime;
   }
 
   if (separation)
@@ -1040,14 +1025,8 @@ CMR_ERROR CMRregularityNestedMinorSequenceSearchThreeSeparation(CMR* cmr, Decomp
 
 cleanupSearch:
 
-  /* Free working storage. */
-  CMR_CALL( CMRfreeStackArray(cmr, &queueMemory) );
-  CMR_CALL( CMRfreeStackArray(cmr, &partColumns[1]) );
-  CMR_CALL( CMRfreeStackArray(cmr, &partColumns[0]) );
-  CMR_CALL( CMRfreeStackArray(cmr, &partRows[1]) );
-  CMR_CALL( CMRfreeStackArray(cmr, &partRows[0]) );
-  CMR_CALL( CMRfreeStackArray(cmr, &columnData) );
-  CMR_CALL( CMRfreeStackArray(cmr, &rowData) );
+  /* Free all working storage at once. */
+  CMR_CALL( CMRstackRelease(cmr, &stackMark, NULL) );
 
 cleanupSequence:
 
@@ -1058,6 +1037,7 @@ cleanupSequence:
   CMR_CALL( CMRfreeBlockArray(cmr, &dec->nestedMinorsSequenceNumColumns) );
   CMR_CALL( CMRfreeBlockArray(cmr, &dec->nestedMinorsRowsOriginal) );
   CMR_CALL( CMRfreeBlockArray(cmr, &dec->nestedMinorsColumnsOriginal) );
+  dec->nestedMinorsLength = 0;
 
   return error;
 }
@@ -0,0 +1,90 @@
+#ifndef CMR_REGULARITY_PARTITION_INTERNAL_H
+#define CMR_REGULARITY_PARTITION_INTERNAL_H
+
+#include "env_internal.h"
+
+#include <cmr/matrix.h>
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Element specific data for the enumeration of 3-separations.
+ */
+
+typedef struct
+{
+  short part;       /**< \brief Part this element belongs to; -1 indicates being unassigned. */
+  short type[2];    /**< \brief Type of row/column for each part; element lies in span if and only if nonnegative. */
+} ElementData;
+
+/**
+ * \brief Binary matrix whose rows are restricted to the leading columns and packed into 64-bit words.
+ *
+ * Only the leading columns can be assigned to a part before the types of the remaining elements are determined.
+ * Hence, the restriction of a row to the columns of a part can be obtained by a bitwise \e and with a mask of that
+ * part, and comparisons of such restrictions are word-wise comparisons.
+ */
+
+typedef struct
+{
+  size_t numRows;     /**< \brief Number of rows. */
+  size_t numColumns;  /**< \brief Number of leading columns whose entries are stored. */
+  size_t numWords;    /**< \brief Number of words per row. */
+  uint64_t* words;    /**< \brief Array with \ref numWords words for each row. */
+} PackedMatrix;
+
+/**
+ * \brief Packs the entries of \p matrix in its first \p numColumns columns.
+ */
+
+CMR_ERROR CMRregularityPackedCreate(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,     /**< Matrix. */
+  size_t numColumns,      /**< Number of leading columns to consider. */
+  PackedMatrix* packed    /**< Packed matrix to be initialized. */
+);
+
+/**
+ * \brief Checks whether the submatrix with rows assigned to \p part and columns assigned to the other has at least
+ *        rank 2.
+ *
+ * Assumes that \p rowRepresentative already contains the first nonzero row in that matrix.
+ * If the rank is at least 2, \p rowRepresentative and \p columnRepresentative are extended as to indicate a rank-2
+ * submatrix. The column is the first one at which a difference between the row and the representative row as well
+ * as a common nonzero (or a nonzero of the row only) are known.
+ */
+
+bool CMRregularityPackedFindRank2(
+  PackedMatrix* matrix,               /**< Packed matrix. */
+  size_t numAssignedRows,             /**< Number of leading rows that may be assigned to a part. */
+  ElementData* rowData,               /**< Row element data. */
+  uint64_t* otherColumnsMask,         /**< Mask of the columns assigned to the other part. */
+  size_t rowRepresentative[2][2],     /**< Row representatives for each part. */
+  size_t columnRepresentative[2][2],  /**< Column representatives for each part. */
+  short part                          /**< Part to which the investigated rows belong. */
+);
+
+/**
+ * \brief Returns the type of the restriction of \p row to the columns in \p mask with respect to the
+ *        representatives.
+ *
+ * The type is 0 for a zero vector, 1 and 2 for the first and second representative, respectively, and 3 for their
+ * sum, provided that the representatives exist. Otherwise, -1 is returned.
+ */
+
+short CMRregularityPackedType(
+  PackedMatrix* matrix,       /**< Packed matrix. */
+  uint64_t* mask,             /**< Mask of the considered columns. */
+  size_t representatives[2],  /**< Representative rows (\c SIZE_MAX if not existing). */
+  size_t row                  /**< Row index. */
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMR_REGULARITY_PARTITION_INTERNAL_H */
@@ -41,7 +41,7 @@ CMR_ERROR CMRregularityDecomposeSeriesParallel(CMR* cmr, DecompositionTask* task
     {
       CMR_CALL( CMRspDecomposeTernary(cmr, dec->matrix, &isSeriesParallel, reductions,
         task->params->seriesParallel ? SIZE_MAX : 1, &numReductions, &reducedSubmatrix, &violatorSubmatrix, &separation,
-        task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
+        &task->params->seriesParallelParams, task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
 
       assert(violatorSubmatrix || separation || (numReductions == dec->numRows + dec->numColumns));
     }
@@ -49,7 +49,7 @@ CMR_ERROR CMRregularityDecomposeSeriesParallel(CMR* cmr, DecompositionTask* task
     {
       CMR_CALL( CMRspDecomposeBinary(cmr, dec->matrix, &isSeriesParallel, reductions,
         task->params->seriesParallel ? SIZE_MAX : 1,  &numReductions, &reducedSubmatrix, &violatorSubmatrix, &separation,
-        task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
+        &task->params->seriesParallelParams, task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
     }
   }
   else
@@ -57,12 +57,14 @@ CMR_ERROR CMRregularityDecomposeSeriesParallel(CMR* cmr, DecompositionTask* task
     if (dec->isTernary)
     {
       CMR_CALL( CMRspTestTernary(cmr, dec->matrix, &isSeriesParallel, reductions,
-        &numReductions, &reducedSubmatrix, NULL, task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
+        &numReductions, &reducedSubmatrix, NULL, &task->params->seriesParallelParams,
+        task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
     }
     else
     {
       CMR_CALL( CMRspTestBinary(cmr, dec->matrix, &isSeriesParallel, reductions,
-        &numReductions, &reducedSubmatrix, NULL, task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
+        &numReductions, &reducedSubmatrix, NULL, &task->params->seriesParallelParams,
+        task->stats ? &task->stats->seriesParallel : NULL, remainingTime) );
     }
   }
 
@@ -152,6 +154,8 @@ CMR_ERROR CMRregularityDecomposeSeriesParallel(CMR* cmr, DecompositionTask* task
         separation->columnsFlags[CMRelementToColumnIndex(reductions[0].mate)] = CMR_SEPA_FIRST;
       }
 
+      if (!dec->transpose)
+        CMR_CALL( CMRchrmatTranspose(cmr, dec->matrix, &dec->transpose) );
       CMR_CALL( CMRsepaFindBinaryRepresentatives(cmr, separation, dec->matrix, dec->transpose, NULL, NULL) );
       assert(separation->type == CMR_SEPA_TYPE_TWO);
     }
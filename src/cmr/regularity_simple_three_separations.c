@@ -3,6 +3,7 @@
 
 #include "env_internal.h"
 #include "seymour_internal.h"
+#include "fingerprint.h"
 #include "hashtable.h"
 #include "listmatrix.h"
 
@@ -10,7 +11,6 @@
 
 typedef struct
 {
-  long long hashValue;                /**< \brief Hash value of this element. */
   CMR_LISTHASHTABLE_ENTRY hashEntry;  /**< \brief Entry in row or column hashtable. */
 } ElementData;
 
@@ -32,78 +32,12 @@ CMR_ERROR createElementData(
   ElementData* elementData = *pelementData;
   for (size_t e = 0; e < size; ++e)
   {
-    elementData[e].hashValue = 0;
     elementData[e].hashEntry = SIZE_MAX;
   }
 
   return CMR_OKAY;
 }
 
-static
-CMR_ERROR createHashVector(
-  CMR* cmr,                 /**< \ref CMR environment. */
-  long long** phashVector,  /**< Pointer for storing the hash vector. */
-  size_t size               /**< Size of hash vector. */
-)
-{
-  assert(cmr);
-
-  CMR_CALL( CMRallocStackArray(cmr, phashVector, size) );
-  long long* hashVector = *phashVector;
-  size_t h = 1;
-  for (size_t e = 0; e < size; ++e)
-  {
-    hashVector[e] = h;
-#if defined(CMR_DEBUG_REDUCTION)
-    CMRdbgMsg(2, "Entry %d has hash %ld.\n", e, h);
-#endif /* CMR_DEBUG_REDUCTION */
-    h = projectSignedHash(3 * h);
-  }
-
-  return CMR_OKAY;
-}
-
-/**
- * \brief Scan the matrix to compute the number of nonzeros and the hash of each row and each column.
- */
-
-static
-CMR_ERROR calcHashFromMatrix(
-  CMR* cmr,                 /**< \ref CMR environment. */
-  CMR_CHRMAT* matrix,       /**< Matrix. */
-  ElementData* rowData,     /**< Row element data. */
-  ElementData* columnData,  /**< Column element data. */
-  long long* hashVector     /**< Hash vector. */
-)
-{
-  CMR_UNUSED(cmr);
-
-  assert(cmr);
-  assert(matrix);
-  assert(rowData);
-  assert(columnData);
-
-  for (size_t row = 0; row < matrix->numRows; ++row)
-  {
-    size_t first = matrix->rowSlice[row];
-    size_t beyond = matrix->rowSlice[row + 1];
-    for (size_t e = first; e < beyond; ++e)
-    {
-      size_t column = matrix->entryColumns[e];
-
-      /* Update row data. */
-      long long newHash = projectSignedHash(rowData[row].hashValue + hashVector[column]);
-      rowData[row].hashValue  = newHash;
-
-      /* Update column data. */
-      newHash = projectSignedHash(columnData[column].hashValue + hashVector[row]);
-      columnData[column].hashValue = newHash;
-    }
-  }
-
-  return CMR_OKAY;
-}
-
 CMR_ERROR CMRregularitySimpleSearchThreeSeparation(CMR* cmr, DecompositionTask* task, DecompositionQueue* queue)
 {
   assert(cmr);
@@ -113,9 +47,10 @@ CMR_ERROR CMRregularitySimpleSearchThreeSeparation(CMR* cmr, DecompositionTask*
   CMR_SEYMOUR_STATS* stats = task->stats;
   ElementData* rowData = NULL;
   ElementData* columnData = NULL;
-  long long* hashVector = NULL;
+  Fingerprints* fingerprints = NULL;
   CMR_LISTHASHTABLE* rowHashtable = NULL;
   CMR_LISTHASHTABLE* columnHashtable = NULL;
+  CMR_STACKMARK stackMark;
 
   CMRdbgMsg(6, "Starting search for simple 3-separations for %zux%zu-matrix.\n", task->node->matrix->numRows,
     task->node->matrix->numColumns);
@@ -228,14 +163,15 @@ CMR_ERROR CMRregularitySimpleSearchThreeSeparation(CMR* cmr, DecompositionTask*
   CMR_CALL( CMRchrmatPrintDense(cmr, matrix, stdout, '0', true) );
 #endif /* CMR_DEBUG_MATRICES */
 
-  /* Initialize element data and hash vector. */
+  /* Initialize element data and compute the fingerprint of each row and column. The element data is released at once
+   * via the stack mark. */
+  CMR_CALL( CMRstackMark(cmr, &stackMark) );
   CMR_CALL( createElementData(cmr, &rowData, matrix->numRows) );
   CMR_CALL( createElementData(cmr, &columnData, matrix->numColumns) );
-  CMR_CALL( createHashVector(cmr, &hashVector,
-    matrix->numRows > matrix->numColumns ? matrix->numRows : matrix->numColumns) );
-
-  /* Compute hash values for each row and column. */
-  CMR_CALL( calcHashFromMatrix(cmr, matrix, rowData, columnData, hashVector) );
+  CMR_CALL( CMRfingerprintsCreate(cmr, matrix, transpose, false, &fingerprints) );
+  long long* rowHashes = fingerprints->rowFingerprints;
+  long long* columnHashes = fingerprints->columnFingerprints;
+  long long* hashVector = fingerprints->weights;
 
   /* Initialize the hashtables. */
   CMR_CALL( CMRlisthashtableCreate(cmr, &rowHashtable, nextPower2(matrix->numRows), matrix->numRows) );
@@ -243,15 +179,15 @@ CMR_ERROR CMRregularitySimpleSearchThreeSeparation(CMR* cmr, DecompositionTask*
 
   for (size_t row = 0; row < matrix->numRows; ++row)
   {
-    CMRdbgMsg(2, "Row r%zu has hash %ld and %zu nonzeros.\n", row+1, rowData[row].hashValue,
+    CMRdbgMsg(2, "Row r%zu has hash %ld and %zu nonzeros.\n", row+1, rowHashes[row],
       matrix->rowSlice[row+1] - matrix->rowSlice[row]);
-    CMR_CALL( CMRlisthashtableInsert(cmr, rowHashtable, llabs(rowData[row].hashValue), row, &rowData[row].hashEntry) );
+    CMR_CALL( CMRlisthashtableInsert(cmr, rowHashtable, llabs(rowHashes[row]), row, &rowData[row].hashEntry) );
   }
   for (size_t column = 0; column < matrix->numColumns; ++column)
   {
-    CMRdbgMsg(2, "Column c%zu has hash %ld and %zu nonzeros.\n", column+1, columnData[column].hashValue,
+    CMRdbgMsg(2, "Column c%zu has hash %ld and %zu nonzeros.\n", column+1, columnHashes[column],
       transpose->rowSlice[column+1] - transpose->rowSlice[column]);
-    CMR_CALL( CMRlisthashtableInsert(cmr, columnHashtable, llabs(columnData[column].hashValue), column,
+    CMR_CALL( CMRlisthashtableInsert(cmr, columnHashtable, llabs(columnHashes[column]), column,
       &columnData[column].hashEntry) );
   }
 
@@ -269,7 +205,7 @@ CMR_ERROR CMRregularitySimpleSearchThreeSeparation(CMR* cmr, DecompositionTask*
         CMRdbgMsg(4, "Considering removal of entry r%zu,c%zu since r%zu has only 2 nonzeros.\n", row+1, column+1,
           row+1);
 
-        long long newHash = projectSignedHash(columnData[column].hashValue - 1 * hashVector[row]);
+        long long newHash = CMRfingerprintUpdate(columnHashes[column], hashVector[row], -1);
         CMRdbgMsg(6, "New hash: %ld\n", newHash);
         for (CMR_LISTHASHTABLE_ENTRY entry = CMRlisthashtableFindFirst(columnHashtable, newHash); entry != SIZE_MAX;
           entry = CMRlisthashtableFindNext(columnHashtable, newHash, entry))
@@ -391,7 +327,7 @@ CMR_ERROR CMRregularitySimpleSearchThreeSeparation(CMR* cmr, DecompositionTask*
         CMRdbgMsg(4, "Considering removal of entry r%zu,c%zu since c%zu has only 2 nonzeros.\n", row+1, column+1,
           column+1);
 
-        long long newHash = projectSignedHash(rowData[row].hashValue - 1 * hashVector[column]);
+        long long newHash = CMRfingerprintUpdate(rowHashes[row], hashVector[column], -1);
         CMRdbgMsg(6, "New hash: %ld\n", newHash);
         for (CMR_LISTHASHTABLE_ENTRY entry = CMRlisthashtableFindFirst(rowHashtable, newHash); entry != SIZE_MAX;
           entry = CMRlisthashtableFindNext(rowHashtable, newHash, entry))
@@ -514,10 +450,9 @@ cleanup:
     CMR_CALL( CMRlisthashtableFree(cmr, &columnHashtable) );
     CMR_CALL( CMRlisthashtableFree(cmr, &rowHashtable) );
 
-    CMR_CALL( CMRfreeStackArray(cmr, &hashVector) );
-    CMR_CALL( CMRfreeStackArray(cmr, &columnData) );
-    CMR_CALL( CMRfreeStackArray(cmr, &rowData) );
+    CMR_CALL( CMRstackRelease(cmr, &stackMark, NULL) );
   }
+  CMR_CALL( CMRfingerprintsFree(cmr, &fingerprints) );
 
   if (stats)
     stats->simpleThreeSeparationsTime += (clock() - startTime) * 1.0 / CLOCKS_PER_SEC;
@@ -7,13 +7,21 @@
 #include <cmr/series_parallel.h>
 
 #include "env_internal.h"
+#include "bits.h"
+#include "fingerprint.h"
 #include "hashtable.h"
 #include "sort.h"
 #include "listmatrix.h"
+#include "parallel.h"
 
+#include <limits.h>
 #include <stdint.h>
+#include <string.h>
 #include <time.h>
 
+#define PARALLEL_MIN_NONZEROS 65536 /**< Minimum number of nonzeros for scanning the matrix in parallel. */
+#define PARALLEL_MIN_ELEMENTS 16384 /**< Minimum number of rows (resp. columns) for grouping them in parallel. */
+
 typedef enum
 {
   REMOVED = 0,
@@ -35,6 +43,15 @@ typedef struct
   bool specialBFS;                    /**< \brief Whether this is a special node in breadth-first search. */
 } ElementData;
 
+CMR_ERROR CMRspParamsInit(CMR_SP_PARAMS* params)
+{
+  assert(params);
+
+  params->engine = CMR_SP_ENGINE_COMPACT;
+  params->wheelSearch = CMR_SP_WHEEL_SEARCH_AUTO;
+
+  return CMR_OKAY;
+}
 
 CMR_ERROR CMRspStatsInit(CMR_SP_STATISTICS* stats)
 {
@@ -48,6 +65,29 @@ CMR_ERROR CMRspStatsInit(CMR_SP_STATISTICS* stats)
   stats->nonbinaryTime = 0.0;
   stats->wheelCount = 0;
   stats->wheelTime = 0.0;
+  stats->bitsetWheelCount = 0;
+  stats->bitsetWheelTime = 0.0;
+  stats->compactionCount = 0;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRspStatsAdd(CMR_SP_STATISTICS* target, CMR_SP_STATISTICS* source)
+{
+  assert(target);
+  assert(source);
+
+  target->totalCount += source->totalCount;
+  target->totalTime += source->totalTime;
+  target->reduceCount += source->reduceCount;
+  target->reduceTime += source->reduceTime;
+  target->nonbinaryCount += source->nonbinaryCount;
+  target->nonbinaryTime += source->nonbinaryTime;
+  target->wheelCount += source->wheelCount;
+  target->wheelTime += source->wheelTime;
+  target->bitsetWheelCount += source->bitsetWheelCount;
+  target->bitsetWheelTime += source->bitsetWheelTime;
+  target->compactionCount += source->compactionCount;
 
   return CMR_OKAY;
 }
@@ -64,7 +104,10 @@ CMR_ERROR CMRspStatsPrint(FILE* stream, CMR_SP_STATISTICS* stats, const char* pr
   }
   fprintf(stream, "%sreduction calls: %ld in %f seconds\n", prefix, (unsigned long)stats->reduceCount, stats->reduceTime);
   fprintf(stream, "%swheel searches: %ld in %f seconds\n", prefix, (unsigned long)stats->wheelCount, stats->wheelTime);
+  fprintf(stream, "%sbitset wheel searches: %lu in %f seconds\n", prefix, (unsigned long)stats->bitsetWheelCount,
+    stats->bitsetWheelTime);
   fprintf(stream, "%sternary certificates: %ld in %f seconds\n", prefix, (unsigned long)stats->nonbinaryCount, stats->nonbinaryTime);
+  fprintf(stream, "%scompactions: %lu\n", prefix, (unsigned long)stats->compactionCount);
   fprintf(stream, "%stotal: %lu in %f seconds\n", prefix, (unsigned long)stats->totalCount, stats->totalTime);
 
   return CMR_OKAY;
@@ -101,6 +144,91 @@ char* CMRspReductionString(CMR_SP_REDUCTION reduction, char* buffer)
     return "<invalid series-parallel reduction>";
 }
 
+CMR_ERROR CMRspWriteReductions(CMR* cmr, CMR_SP_REDUCTION* reductions, size_t numReductions, FILE* stream)
+{
+  CMR_UNUSED(cmr);
+
+  assert(cmr);
+  assert(reductions || numReductions == 0);
+  assert(stream);
+
+  fprintf(stream, "%zu\n", numReductions);
+  for (size_t i = 0; i < numReductions; ++i)
+    fprintf(stream, "%s\n", CMRspReductionString(reductions[i], NULL));
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads a row or column such as \c r3 or \c c5 from \p stream.
+ */
+
+static
+bool readElement(
+  FILE* stream,         /**< Stream to read from. */
+  CMR_ELEMENT* pelement /**< Pointer for storing the element. */
+)
+{
+  char type;
+  size_t index;
+  if (fscanf(stream, " %c%zu", &type, &index) != 2 || index == 0 || index > INT_MAX)
+    return false;
+
+  if (type == 'r')
+    *pelement = CMRrowToElement(index - 1);
+  else if (type == 'c')
+    *pelement = CMRcolumnToElement(index - 1);
+  else
+    return false;
+
+  return true;
+}
+
+CMR_ERROR CMRspReadReductions(CMR* cmr, FILE* stream, CMR_SP_REDUCTION** preductions, size_t* pnumReductions)
+{
+  assert(cmr);
+  assert(stream);
+  assert(preductions);
+  assert(!*preductions);
+  assert(pnumReductions);
+
+  size_t numReductions;
+  if (fscanf(stream, "%zu", &numReductions) != 1)
+  {
+    CMRraiseErrorMessage(cmr, "Could not read number of series-parallel reductions.");
+    return CMR_ERROR_INPUT;
+  }
+
+  CMR_CALL( CMRallocBlockArray(cmr, preductions, numReductions > 0 ? numReductions : 1) );
+  CMR_SP_REDUCTION* reductions = *preductions;
+  for (size_t i = 0; i < numReductions; ++i)
+  {
+    char word[8];
+    bool valid = readElement(stream, &reductions[i].element) && fscanf(stream, "%7s", word) == 1;
+    if (valid && !strcmp(word, "zero"))
+      reductions[i].mate = 0;
+    else if (valid && (!strcmp(word, "copy") || !strcmp(word, "unit")))
+    {
+      bool isCopy = !strcmp(word, "copy");
+      valid = fscanf(stream, "%7s", word) == 1 && !strcmp(word, isCopy ? "of" : "at")
+        && readElement(stream, &reductions[i].mate)
+        && (CMRelementIsRow(reductions[i].element) == CMRelementIsRow(reductions[i].mate)) == isCopy;
+    }
+    else
+      valid = false;
+
+    if (!valid)
+    {
+      CMR_CALL( CMRfreeBlockArray(cmr, preductions) );
+      CMRraiseErrorMessage(cmr, "Could not read series-parallel reduction #%zu.", i + 1);
+      return CMR_ERROR_INPUT;
+    }
+  }
+  *pnumReductions = numReductions;
+
+  return CMR_OKAY;
+}
+
 /**
  * \brief Removes the given nonzero from the linked-list representation.
  */
@@ -148,25 +276,94 @@ CMR_ERROR createElementData(
   return CMR_OKAY;
 }
 
+/**
+ * \brief Data shared by the tasks of \ref calcNonzeroCountHashFromMatrix.
+ */
+
+typedef struct
+{
+  CMR_CHRMAT* matrix;         /**< \brief Matrix. */
+  size_t* rowNumNonzeros;     /**< \brief Array for storing the number of nonzeros of each row. */
+  size_t* columnNumNonzeros;  /**< \brief Array for storing the number of nonzeros of each column. */
+  ElementData* rowData;       /**< \brief Other row element data. */
+  ElementData* columnData;    /**< \brief Other column element data. */
+  long long* hashVector;      /**< \brief Hash vector. */
+  size_t numRowTasks;         /**< \brief Number of tasks for ranges of rows. */
+  size_t numColumnTasks;      /**< \brief Number of tasks for ranges of columns. */
+} HashScan;
+
+/**
+ * \brief Computes the number of nonzeros and the hash values of a range of rows or of a range of columns.
+ *
+ * The first \ref HashScan.numRowTasks tasks process ranges of rows, the remaining ones process ranges of columns.
+ * Since the rows are sorted, a column range is processed by a binary search in each row. In both cases the entries
+ * of each row or column are processed in the same order as in a sequential scan, which yields the same hash values.
+ */
+
 static
-CMR_ERROR createHashVector(
-  CMR* cmr,                 /**< \ref CMR environment. */
-  long long** phashVector,  /**< Pointer for storing the hash vector. */
-  size_t size               /**< Size of hash vector. */
+CMR_ERROR hashScanTask(
+  CMR* cmr,     /**< \ref CMR environment of the worker. */
+  size_t task,  /**< Index of the task. */
+  void* data,   /**< Pointer to the \ref HashScan. */
+  bool* pfound  /**< Pointer for storing whether the task was successful; unused. */
 )
 {
-  assert(cmr);
+  CMR_UNUSED(cmr);
+  CMR_UNUSED(pfound);
 
-  CMR_CALL( CMRallocStackArray(cmr, phashVector, size) );
-  long long* hashVector = *phashVector;
-  size_t h = 1;
-  for (size_t e = 0; e < size; ++e)
+  HashScan* scan = (HashScan*) data;
+  CMR_CHRMAT* matrix = scan->matrix;
+  long long* hashVector = scan->hashVector;
+
+  if (task < scan->numRowTasks)
   {
-    hashVector[e] = h;
-#if defined(CMR_DEBUG_REDUCTION)
-    CMRdbgMsg(2, "Entry %d has hash %ld.\n", e, h);
-#endif /* CMR_DEBUG_REDUCTION */
-    h = projectSignedHash(3 * h);
+    size_t beginRow = matrix->numRows * task / scan->numRowTasks;
+    size_t endRow = matrix->numRows * (task + 1) / scan->numRowTasks;
+    for (size_t row = beginRow; row < endRow; ++row)
+    {
+      size_t first = matrix->rowSlice[row];
+      size_t beyond = matrix->rowSlice[row + 1];
+      long long hash = 0;
+      for (size_t e = first; e < beyond; ++e)
+        hash = CMRfingerprintUpdate(hash, hashVector[matrix->entryColumns[e]], matrix->entryValues[e]);
+      scan->rowNumNonzeros[row] = beyond - first;
+      scan->rowData[row].hashValue = hash;
+    }
+  }
+  else
+  {
+    task -= scan->numRowTasks;
+    size_t beginColumn = matrix->numColumns * task / scan->numColumnTasks;
+    size_t endColumn = matrix->numColumns * (task + 1) / scan->numColumnTasks;
+    for (size_t column = beginColumn; column < endColumn; ++column)
+    {
+      scan->columnNumNonzeros[column] = 0;
+      scan->columnData[column].hashValue = 0;
+    }
+
+    for (size_t row = 0; row < matrix->numRows; ++row)
+    {
+      /* Find the first entry with column at least beginColumn. */
+      size_t lower = matrix->rowSlice[row];
+      size_t upper = matrix->rowSlice[row + 1];
+      while (lower < upper)
+      {
+        size_t middle = (lower + upper) / 2;
+        if (matrix->entryColumns[middle] < beginColumn)
+          lower = middle + 1;
+        else
+          upper = middle;
+      }
+
+      long long rowHash = hashVector[row];
+      for (size_t e = lower; e < matrix->rowSlice[row + 1] && matrix->entryColumns[e] < endColumn; ++e)
+      {
+        size_t column = matrix->entryColumns[e];
+        scan->columnNumNonzeros[column]++;
+        scan->columnData[column].hashValue = CMRfingerprintUpdate(scan->columnData[column].hashValue,
+          rowHash, matrix->entryValues[e]);
+      }
+    }
   }
 
   return CMR_OKAY;
@@ -174,25 +371,48 @@ CMR_ERROR createHashVector(
 
 /**
  * \brief Scan the matrix to compute the number of nonzeros and the hash of each row and each column.
+ *
+ * For large matrices, ranges of rows and ranges of columns are processed in parallel.
  */
 
 static
 CMR_ERROR calcNonzeroCountHashFromMatrix(
-  CMR* cmr,                 /**< \ref CMR environment. */
-  CMR_CHRMAT* matrix,       /**< Matrix. */
-  ListMat8* listmatrix,     /**< List matrix representation. */
-  ElementData* rowData,     /**< Other row element data. */
-  ElementData* columnData,  /**< Other column element data. */
-  long long* hashVector     /**< Hash vector. */
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,         /**< Matrix. */
+  size_t* rowNumNonzeros,     /**< Array for storing the number of nonzeros of each row. */
+  size_t* columnNumNonzeros,  /**< Array for storing the number of nonzeros of each column. */
+  ElementData* rowData,       /**< Other row element data. */
+  ElementData* columnData,    /**< Other column element data. */
+  long long* hashVector       /**< Hash vector. */
 )
 {
-  CMR_UNUSED(cmr);
-
   assert(cmr);
   assert(matrix);
   assert(rowData);
   assert(columnData);
 
+  size_t numWorkers = CMRparallelNumWorkers(cmr);
+  if (numWorkers > 1 && matrix->numNonzeros >= PARALLEL_MIN_NONZEROS)
+  {
+    HashScan scan;
+    scan.matrix = matrix;
+    scan.rowNumNonzeros = rowNumNonzeros;
+    scan.columnNumNonzeros = columnNumNonzeros;
+    scan.rowData = rowData;
+    scan.columnData = columnData;
+    scan.hashVector = hashVector;
+    scan.numRowTasks = 4 * numWorkers;
+    scan.numColumnTasks = numWorkers;
+    CMR_CALL( CMRparallelFor(cmr, scan.numRowTasks + scan.numColumnTasks, hashScanTask, &scan) );
+
+    return CMR_OKAY;
+  }
+
+  for (size_t row = 0; row < matrix->numRows; ++row)
+    rowNumNonzeros[row] = 0;
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+    columnNumNonzeros[column] = 0;
+
   for (size_t row = 0; row < matrix->numRows; ++row)
   {
     size_t first = matrix->rowSlice[row];
@@ -204,13 +424,13 @@ CMR_ERROR calcNonzeroCountHashFromMatrix(
       assert(value == 1 || value == -1);
 
       /* Update row data. */
-      listmatrix->rowElements[row].numNonzeros++;
-      long long newHash = projectSignedHash(rowData[row].hashValue + value * hashVector[column]);
+      rowNumNonzeros[row]++;
+      long long newHash = CMRfingerprintUpdate(rowData[row].hashValue, hashVector[column], value);
       rowData[row].hashValue  = newHash;
 
       /* Update column data. */
-      listmatrix->columnElements[column].numNonzeros++;
-      newHash = projectSignedHash(columnData[column].hashValue + value * hashVector[row]);
+      columnNumNonzeros[column]++;
+      newHash = CMRfingerprintUpdate(columnData[column].hashValue, hashVector[row], value);
       columnData[column].hashValue = newHash;
     }
   }
@@ -252,11 +472,11 @@ CMR_ERROR calcBinaryHashFromListMatrix(
     for (ListMat8Nonzero* nz = rowHead->right; nz != rowHead; nz = nz->right)
     {
       /* Update row data. */
-      long long newHash = projectSignedHash(rowData[nz->row].hashValue + hashVector[nz->column]);
+      long long newHash = CMRfingerprintUpdate(rowData[nz->row].hashValue, hashVector[nz->column], 1);
       rowData[nz->row].hashValue  = newHash;
 
       /* Update column data. */
-      newHash = projectSignedHash(columnData[nz->column].hashValue + hashVector[nz->row]);
+      newHash = CMRfingerprintUpdate(columnData[nz->column].hashValue, hashVector[nz->row], 1);
       columnData[nz->column].hashValue = newHash;
     }
   }
@@ -264,17 +484,155 @@ CMR_ERROR calcBinaryHashFromListMatrix(
   return CMR_OKAY;
 }
 
+/**
+ * \brief Hash value of a row or column, used by \ref markHashDuplicates.
+ */
+
+typedef struct
+{
+  CMR_LISTHASHTABLE_HASH hash;  /**< \brief Absolute hash value. */
+  size_t index;                 /**< \brief Index of the row or column. */
+} HashedElement;
+
+/**
+ * \brief Data shared by the tasks of \ref markHashDuplicates.
+ */
+
+typedef struct
+{
+  HashedElement* elements;  /**< \brief Rows or columns, grouped into buckets. */
+  size_t* bucketStart;      /**< \brief Index of the first element of each bucket and of the end. */
+  ElementData* data;        /**< \brief Row/column data. */
+} HashGrouping;
+
+/**
+ * \brief Compares two \ref HashedElement by hash value and then by index.
+ */
+
+static
+int compareHashedElements(
+  const void* a,  /**< First element. */
+  const void* b   /**< Second element. */
+)
+{
+  const HashedElement* first = (const HashedElement*) a;
+  const HashedElement* second = (const HashedElement*) b;
+  if (first->hash != second->hash)
+    return first->hash < second->hash ? -1 : 1;
+  if (first->index != second->index)
+    return first->index < second->index ? -1 : 1;
+  return 0;
+}
+
+/**
+ * \brief Sorts a bucket of \ref HashGrouping and marks all but the first element of each group of equal hash values.
+ */
+
+static
+CMR_ERROR hashGroupingTask(
+  CMR* cmr,     /**< \ref CMR environment of the worker. */
+  size_t task,  /**< Index of the bucket. */
+  void* data,   /**< Pointer to the \ref HashGrouping. */
+  bool* pfound  /**< Pointer for storing whether the task was successful; unused. */
+)
+{
+  CMR_UNUSED(pfound);
+
+  HashGrouping* grouping = (HashGrouping*) data;
+  size_t first = grouping->bucketStart[task];
+  size_t beyond = grouping->bucketStart[task + 1];
+  HashedElement* elements = grouping->elements;
+
+  CMR_CALL( CMRsort(cmr, beyond - first, &elements[first], sizeof(HashedElement), compareHashedElements) );
+  for (size_t e = first + 1; e < beyond; ++e)
+  {
+    if (elements[e].hash == elements[e-1].hash)
+      grouping->data[elements[e].index].inQueue = true;
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Marks all remaining rows (resp. columns) with more than one nonzero whose hash value is not new.
+ *
+ * The rows (resp. columns) are distributed into one bucket per worker according to their hash values, and each
+ * bucket is sorted by hash value in parallel. Marked rows (resp. columns) have \ref ElementData.inQueue set.
+ */
+
+static
+CMR_ERROR markHashDuplicates(
+  CMR* cmr,             /**< \ref CMR environment. */
+  size_t* numNonzeros,  /**< Number of nonzeros of each row or column. */
+  ElementData* data,    /**< Other row/column data. */
+  size_t sizeData,      /**< Length of \p numNonzeros and \p data. */
+  size_t numBuckets     /**< Number of buckets. */
+)
+{
+  assert(cmr);
+  assert(numBuckets > 0);
+
+  HashGrouping grouping;
+  grouping.data = data;
+  grouping.bucketStart = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &grouping.bucketStart, numBuckets + 1) );
+  for (size_t b = 0; b <= numBuckets; ++b)
+    grouping.bucketStart[b] = 0;
+
+  /* Count the elements per bucket. */
+  for (size_t i = 0; i < sizeData; ++i)
+  {
+    if (numNonzeros[i] > 1 && data[i].lastBFS != -2)
+    {
+      CMR_LISTHASHTABLE_HASH hash = llabs(data[i].hashValue);
+      grouping.bucketStart[(hash * 0x9E3779B97F4A7C15ULL >> 32) % numBuckets + 1]++;
+    }
+  }
+  for (size_t b = 0; b < numBuckets; ++b)
+    grouping.bucketStart[b + 1] += grouping.bucketStart[b];
+
+  /* Distribute the elements. */
+  size_t numElements = grouping.bucketStart[numBuckets];
+  grouping.elements = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &grouping.elements, numElements) );
+  size_t* bucketEnd = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bucketEnd, numBuckets) );
+  for (size_t b = 0; b < numBuckets; ++b)
+    bucketEnd[b] = grouping.bucketStart[b];
+  for (size_t i = 0; i < sizeData; ++i)
+  {
+    if (numNonzeros[i] > 1 && data[i].lastBFS != -2)
+    {
+      CMR_LISTHASHTABLE_HASH hash = llabs(data[i].hashValue);
+      size_t e = bucketEnd[(hash * 0x9E3779B97F4A7C15ULL >> 32) % numBuckets]++;
+      grouping.elements[e].hash = hash;
+      grouping.elements[e].index = i;
+    }
+  }
+  CMR_CALL( CMRfreeStackArray(cmr, &bucketEnd) );
+
+  CMR_CALL( CMRparallelFor(cmr, numBuckets, hashGroupingTask, &grouping) );
+
+  CMR_CALL( CMRfreeStackArray(cmr, &grouping.elements) );
+  CMR_CALL( CMRfreeStackArray(cmr, &grouping.bucketStart) );
+
+  return CMR_OKAY;
+}
+
 /**
  * \brief Scans the matrix initially in order to add all rows or columns either to the queue or to the hashtable.
+ *
+ * For many rows (resp. columns), the duplicate hash values are found in parallel by \ref markHashDuplicates, and only
+ * the remaining ones are inserted into the hashtable. The resulting queue and hashtable are the same.
  */
 
 static
 CMR_ERROR initializeQueueHashtableFromMatrix(
   CMR* cmr,                             /**< \ref CMR environment. */
   CMR_LISTHASHTABLE* hashtable,         /**< Row or column hashtable. */
-  ListMat8Element* listmatrixElements,  /**< Row or column list matrix elements. */
+  size_t* numNonzeros,                  /**< Number of nonzeros of each row or column. */
   ElementData* data,                    /**< Other row/column data. */
-  size_t sizeData,                      /**< Length of \p ListMatrixElements and \p data. */
+  size_t sizeData,                      /**< Length of \p numNonzeros and \p data. */
   CMR_ELEMENT* queue,                   /**< Queue. */
   size_t* pqueueEnd,                    /**< Pointer to end of queue. */
   bool isRow                            /**< Whether we are deadling with rows. */
@@ -283,14 +641,40 @@ CMR_ERROR initializeQueueHashtableFromMatrix(
   assert(cmr);
   assert(hashtable || sizeData == 0);
 
+  size_t numWorkers = CMRparallelNumWorkers(cmr);
+  if (numWorkers > 1 && sizeData >= PARALLEL_MIN_ELEMENTS)
+  {
+    CMR_CALL( markHashDuplicates(cmr, numNonzeros, data, sizeData, numWorkers) );
+    for (size_t i = 0; i < sizeData; ++i)
+    {
+      if (data[i].lastBFS == -2)
+        continue;
+      if (numNonzeros[i] > 1 && !data[i].inQueue)
+        CMR_CALL( CMRlisthashtableInsert(cmr, hashtable, llabs(data[i].hashValue), i, &data[i].hashEntry) );
+      else
+      {
+        queue[*pqueueEnd] = isRow ? CMRrowToElement(i) : CMRcolumnToElement(i);
+        data[i].hashEntry = SIZE_MAX;
+        data[i].inQueue = true;
+        (*pqueueEnd)++;
+      }
+    }
+
+    return CMR_OKAY;
+  }
+
   for (size_t i = 0; i < sizeData; ++i)
   {
+    /* Skip replayed reductions. */
+    if (data[i].lastBFS == -2)
+      continue;
+
 #if defined(CMR_DEBUG_REDUCTION)
-    CMRdbgMsg(2, "%s %d has %d nonzeros.\n", isRow ? "Row" : "Column", i, listmatrixElements[i].numNonzeros);
+    CMRdbgMsg(2, "%s %d has %d nonzeros.\n", isRow ? "Row" : "Column", i, numNonzeros[i]);
 #endif /* CMR_DEBUG_REDUCTION */
 
     /* Check if it qualifies for addition to the hashtable. */
-    if (listmatrixElements[i].numNonzeros > 1)
+    if (numNonzeros[i] > 1)
     {
       CMR_LISTHASHTABLE_ENTRY entry = CMRlisthashtableFindFirst(hashtable, llabs(data[i].hashValue));
 #if defined(CMR_DEBUG_REDUCTION)
@@ -461,9 +845,10 @@ static
 CMR_ERROR processNonzero(
   CMR* cmr,                       /**< \ref CMR environment. */
   CMR_LISTHASHTABLE* hashtable,   /**< Row/column hashtable. */
-  long long hashChange,           /**< Modification of the hash value. */
+  long long weight,               /**< Weight of the other index of the nonzero. */
+  long long multiplier,           /**< Multiplier of \p weight for updating the hash value. */
   size_t index,                   /**< Index of row/column. */
-  ListMat8Element* indexListData, /**< Row/column list data. */
+  size_t* pnumNonzeros,           /**< Pointer to the number of nonzeros of the row/column. */
   ElementData* indexData,         /**< Other row/column data. */
   CMR_ELEMENT* queue,             /**< Queue. */
   size_t* pqueueEnd,              /**< Pointer to end of queue. */
@@ -476,11 +861,11 @@ CMR_ERROR processNonzero(
   assert(hashtable);
   assert(queue);
 
-  indexListData->numNonzeros--;
-  long long newHash = projectSignedHash(indexData->hashValue + hashChange);
+  (*pnumNonzeros)--;
+  long long newHash = CMRfingerprintUpdate(indexData->hashValue, weight, multiplier);
 #if defined(CMR_DEBUG_REDUCTION)
-  CMRdbgMsg(4, "Processing nonzero. Old hash is %ld, change is %ld, new hash is %ld.\n", indexData->hashValue,
-    hashChange, newHash);
+  CMRdbgMsg(4, "Processing nonzero. Old hash is %ld, change is %ld times %ld, new hash is %ld.\n",
+    indexData->hashValue, multiplier, weight, newHash);
 #endif /* CMR_DEBUG_REDUCTION */
   indexData->hashValue = newHash;
 
@@ -624,8 +1009,9 @@ CMR_ERROR reduceListMatrix(
 #endif /* CMR_DEBUG_REDUCTION */
 
             unlinkNonzero(entry);
-            CMR_CALL( processNonzero(cmr, columnHashtable, -entryToHash[entry->row] * entry->value, entry->column,
-              &listmatrix->columnElements[entry->column], &columnData[entry->column], queue, pqueueEnd, queueMemory, false) );
+            CMR_CALL( processNonzero(cmr, columnHashtable, entryToHash[entry->row], -entry->value, entry->column,
+              &listmatrix->columnElements[entry->column].numNonzeros, &columnData[entry->column], queue, pqueueEnd,
+              queueMemory, false) );
           }
           listmatrix->rowElements[row1].numNonzeros = 0;
           rowData[row1].lastBFS = -2;
@@ -661,8 +1047,9 @@ CMR_ERROR reduceListMatrix(
 
           unlinkNonzero(entry);
           listmatrix->rowElements[row1].numNonzeros--;
-          CMR_CALL( processNonzero(cmr, columnHashtable, -entryToHash[entry->row] * entry->value, column,
-            &listmatrix->columnElements[column], &columnData[column], queue, pqueueEnd, queueMemory, false) );
+          CMR_CALL( processNonzero(cmr, columnHashtable, entryToHash[entry->row], -entry->value, column,
+            &listmatrix->columnElements[column].numNonzeros, &columnData[column], queue, pqueueEnd, queueMemory,
+            false) );
           reductions[*pnumReductions].mate = CMRcolumnToElement(column);
         }
         else
@@ -720,8 +1107,9 @@ CMR_ERROR reduceListMatrix(
 #endif /* CMR_DEBUG_REDUCTION */
 
             unlinkNonzero(entry);
-            CMR_CALL( processNonzero(cmr, rowHashtable, -entryToHash[entry->column] * entry->value, entry->row,
-              &listmatrix->rowElements[entry->row], &rowData[entry->row], queue, pqueueEnd, queueMemory, true) );
+            CMR_CALL( processNonzero(cmr, rowHashtable, entryToHash[entry->column], -entry->value, entry->row,
+              &listmatrix->rowElements[entry->row].numNonzeros, &rowData[entry->row], queue, pqueueEnd, queueMemory,
+              true) );
           }
           listmatrix->columnElements[column1].numNonzeros = 0;
           listmatrix->columnElements[column1].head.left->right = listmatrix->columnElements[column1].head.right;
@@ -757,8 +1145,8 @@ CMR_ERROR reduceListMatrix(
 
           unlinkNonzero(entry);
           listmatrix->columnElements[column1].numNonzeros--;
-          CMR_CALL( processNonzero(cmr, rowHashtable, -entryToHash[entry->column] * entry->value, row,
-            &listmatrix->rowElements[row], &rowData[row], queue, pqueueEnd, queueMemory, true) );
+          CMR_CALL( processNonzero(cmr, rowHashtable, entryToHash[entry->column], -entry->value, row,
+            &listmatrix->rowElements[row].numNonzeros, &rowData[row], queue, pqueueEnd, queueMemory, true) );
           reductions[*pnumReductions].mate = CMRrowToElement(row);
         }
         else
@@ -778,75 +1166,652 @@ CMR_ERROR reduceListMatrix(
 
 
 /**
- * \brief Try to find an \f$ M_2 \f$-submatrix for a ternary SP-reduced matrix in list representation.
+ * \brief Rows or columns of a matrix in compressed storage with lazy removal, used by \ref CMR_SP_ENGINE_COMPACT.
+ *
+ * The stored entries of a row (resp. column) are those of the original matrix, except for entries whose column
+ * (resp. row) was removed and that were already dropped by a compaction.
+ */
+
+typedef struct
+{
+  size_t* first;          /**< \brief Index of the first stored entry of each vector. */
+  size_t* beyond;         /**< \brief Index beyond the last stored entry of each vector. */
+  size_t* entries;        /**< \brief Index of the column (resp. row) of each stored entry. */
+  signed char* values;    /**< \brief Value of each stored entry. */
+  size_t* numNonzeros;    /**< \brief Number of entries of each vector whose column (resp. row) is not removed. */
+  bool* removed;          /**< \brief Whether each vector was removed. */
+} CompactVectors;
+
+/**
+ * \brief Creates the compressed row and column storage of \p matrix for \ref CMR_SP_ENGINE_COMPACT.
+ *
+ * Rows and columns whose \ref ElementData.lastBFS is -2 are marked as removed. The numbers of nonzeros are not copied,
+ * i.e., the arrays \p rowNumNonzeros and \p columnNumNonzeros are used and must count the nonzeros in rows and columns
+ * that are not removed.
  */
 
 static
-CMR_ERROR extractNonbinarySubmatrix(
-  CMR* cmr,                           /**< \ref CMR environment. */
-  ListMat8* listmatrix,             /**< List matrix. */
-  ElementData* rowData,               /**< Row data. */
-  ElementData* columnData,            /**< Column data. */
-  CMR_LISTHASHTABLE* rowHashtable,    /**< Row hashtable. */
-  CMR_LISTHASHTABLE* columnHashtable, /**< Column hashtable. */
-  CMR_ELEMENT* queue,                 /**< Queue. */
-  size_t* pqueueStart,                /**< Pointer to start of queue. */
-  size_t* pqueueEnd,                  /**< Pointer to end of queue. */
-  size_t queueMemory,                 /**< Memory allocated for queue. */
-  CMR_SUBMAT** pviolatorSubmatrix     /**< Pointer for storing the submatrix if an \f$ M_2 \f$-submatrix is found. */
+CMR_ERROR createCompactVectors(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,         /**< Matrix. */
+  size_t* rowNumNonzeros,     /**< Number of nonzeros of each row. */
+  size_t* columnNumNonzeros,  /**< Number of nonzeros of each column. */
+  ElementData* rowData,       /**< Row data. */
+  ElementData* columnData,    /**< Column data. */
+  CompactVectors* rows,       /**< Pointer for storing the rows. */
+  CompactVectors* columns     /**< Pointer for storing the columns. */
 )
 {
   assert(cmr);
-  assert(listmatrix);
-  assert(rowData);
-  assert(columnData);
-  assert(rowHashtable);
-  assert(columnHashtable);
-  assert(queue);
-  assert(pviolatorSubmatrix);
-
-  CMRdbgMsg(2, "Searching for M_2-submatrix.\n");
+  assert(matrix);
 
-  *pviolatorSubmatrix = NULL;
-  while (*pqueueEnd > *pqueueStart)
+  size_t numRows = matrix->numRows;
+  size_t numColumns = matrix->numColumns;
+  size_t numNonzeros = matrix->numNonzeros;
+
+  /* Rows are copied since compaction modifies them. */
+  rows->numNonzeros = rowNumNonzeros;
+  rows->first = matrix->rowSlice;
+  rows->beyond = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows->beyond, numRows) );
+  rows->entries = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows->entries, numNonzeros) );
+  rows->values = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows->values, numNonzeros) );
+  rows->removed = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows->removed, numRows) );
+  for (size_t row = 0; row < numRows; ++row)
   {
-#if defined(CMR_DEBUG)
-    CMRdbgMsg(0, "\n");
-    for (size_t q = *pqueueStart; q < *pqueueEnd; ++q)
+    rows->beyond[row] = matrix->rowSlice[row + 1];
+    rows->removed[row] = rowData[row].lastBFS == -2;
+  }
+  memcpy(rows->entries, matrix->entryColumns, numNonzeros * sizeof(size_t));
+  memcpy(rows->values, matrix->entryValues, numNonzeros * sizeof(signed char));
+
+  /* Columns are filled in increasing order of rows, like the linked lists. */
+  columns->numNonzeros = columnNumNonzeros;
+  columns->first = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns->first, numColumns + 1) );
+  columns->beyond = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns->beyond, numColumns) );
+  columns->entries = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns->entries, numNonzeros) );
+  columns->values = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns->values, numNonzeros) );
+  columns->removed = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columns->removed, numColumns) );
+  for (size_t column = 0; column < numColumns; ++column)
+  {
+    columns->beyond[column] = 0;
+    columns->removed[column] = columnData[column].lastBFS == -2;
+  }
+  for (size_t e = 0; e < numNonzeros; ++e)
+    columns->beyond[matrix->entryColumns[e]]++;
+  size_t start = 0;
+  for (size_t column = 0; column < numColumns; ++column)
+  {
+    size_t count = columns->beyond[column];
+    columns->first[column] = start;
+    columns->beyond[column] = start;
+    start += count;
+  }
+  columns->first[numColumns] = start;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
     {
-      CMR_ELEMENT e = queue[q % queueMemory];
-      CMRdbgMsg(6, "Queue #%d @ %d: %s\n", q, q % queueMemory, CMRelementString(e, NULL));
+      size_t f = columns->beyond[matrix->entryColumns[e]]++;
+      columns->entries[f] = row;
+      columns->values[f] = matrix->entryValues[e];
     }
-    CMRdbgMsg(0, "\n");
-#endif /* CMR_DEBUG */
+  }
 
-    CMR_ELEMENT element = queue[(*pqueueStart) % queueMemory];
-    ++(*pqueueStart);
+  return CMR_OKAY;
+}
 
-    if (CMRelementIsRow(element))
-    {
-      /* We consider a row. */
+/**
+ * \brief Frees the compressed row and column storage created by \ref createCompactVectors.
+ */
 
-      size_t row1 = CMRelementToRowIndex(element);
-      assert(listmatrix->rowElements[row1].numNonzeros > 1);
-      rowData[row1].inQueue = false;
-      size_t row2 = findCopy(listmatrix->rowElements, rowData, rowHashtable, row1, true, true);
+static
+CMR_ERROR freeCompactVectors(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CompactVectors* rows,     /**< Rows. */
+  CompactVectors* columns   /**< Columns. */
+)
+{
+  assert(cmr);
 
-      if (row2 == SIZE_MAX)
-      {
-        CMRdbgMsg(6, "No parallel row found. Inserting row %d.\n", row1);
-        CMR_CALL( CMRlisthashtableInsert(cmr, rowHashtable, llabs(rowData[row1].hashValue), row1, &rowData[row1].hashEntry) );
-      }
-      else
-      {
-        CMRdbgMsg(6, "Row %d is parallel.\n", row2);
+  CMR_CALL( CMRfreeStackArray(cmr, &columns->removed) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columns->values) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columns->entries) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columns->beyond) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columns->first) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows->removed) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows->values) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows->entries) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rows->beyond) );
 
-        /* We found a row copy. */
-        size_t column1 = SIZE_MAX;
-        size_t column2 = SIZE_MAX;
-        ListMat8Nonzero* nz1 = listmatrix->rowElements[row1].head.right;
-        ListMat8Nonzero* nz2 = listmatrix->rowElements[row2].head.right;
-        while (column1 == SIZE_MAX || column2 == SIZE_MAX)
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Drops the stored entries of vector \p index whose counterpart was removed if these are the majority.
+ */
+
+static inline
+void compactVector(
+  CompactVectors* vectors,  /**< Rows or columns. */
+  CompactVectors* others,   /**< Columns or rows. */
+  size_t index,             /**< Index of the vector. */
+  uint32_t* pnumCompactions /**< Pointer for counting the compactions. */
+)
+{
+  size_t first = vectors->first[index];
+  size_t beyond = vectors->beyond[index];
+  if (beyond - first <= 2 * vectors->numNonzeros[index])
+    return;
+
+  size_t target = first;
+  for (size_t e = first; e < beyond; ++e)
+  {
+    size_t other = vectors->entries[e];
+    if (!others->removed[other])
+    {
+      vectors->entries[target] = other;
+      vectors->values[target] = vectors->values[e];
+      ++target;
+    }
+  }
+  assert(target - first == vectors->numNonzeros[index]);
+  vectors->beyond[index] = target;
+  (*pnumCompactions)++;
+}
+
+/**
+ * \brief Checks whether vector \p index is a (negated) copy of a vector stored in the hashtable.
+ *
+ * Equivalent of \ref findCopy for \ref CMR_SP_ENGINE_COMPACT.
+ */
+
+static
+size_t findCompactCopy(
+  CompactVectors* vectors,      /**< Rows or columns. */
+  CompactVectors* others,       /**< Columns or rows. */
+  ElementData* data,            /**< Other row/column data. */
+  CMR_LISTHASHTABLE* hashtable, /**< Row/column hashtable. */
+  size_t index,                 /**< Index of the vector. */
+  uint32_t* pnumCompactions     /**< Pointer for counting the compactions. */
+)
+{
+  CMR_LISTHASHTABLE_HASH hash = llabs(data[index].hashValue);
+
+  compactVector(vectors, others, index, pnumCompactions);
+  for (CMR_LISTHASHTABLE_ENTRY entry = CMRlisthashtableFindFirst(hashtable, hash);
+    entry != SIZE_MAX; entry = CMRlisthashtableFindNext(hashtable, hash, entry))
+  {
+    size_t collisionIndex = CMRlisthashtableValue(hashtable, entry);
+    if (vectors->numNonzeros[collisionIndex] != vectors->numNonzeros[index])
+      continue;
+
+    compactVector(vectors, others, collisionIndex, pnumCompactions);
+    bool equal = true;
+    bool negated = true;
+    size_t e1 = vectors->first[index];
+    size_t beyond1 = vectors->beyond[index];
+    size_t e2 = vectors->first[collisionIndex];
+    size_t beyond2 = vectors->beyond[collisionIndex];
+    while (equal || negated)
+    {
+      while (e1 < beyond1 && others->removed[vectors->entries[e1]])
+        ++e1;
+      while (e2 < beyond2 && others->removed[vectors->entries[e2]])
+        ++e2;
+      if (e1 == beyond1 || e2 == beyond2)
+        break;
+      if (vectors->entries[e1] != vectors->entries[e2])
+      {
+        equal = false;
+        negated = false;
+        break;
+      }
+      if (vectors->values[e1] == vectors->values[e2])
+        negated = false;
+      else
+        equal = false;
+      ++e1;
+      ++e2;
+    }
+
+    if (equal || negated)
+      return collisionIndex;
+  }
+
+  return SIZE_MAX;
+}
+
+/**
+ * \brief Removes vector \p index and updates the counterparts of its remaining entries.
+ *
+ * Returns the counterpart of the last remaining entry, or \c SIZE_MAX if there was none.
+ */
+
+static
+CMR_ERROR removeCompactVector(
+  CMR* cmr,                         /**< \ref CMR environment. */
+  CompactVectors* vectors,          /**< Rows or columns. */
+  CompactVectors* others,           /**< Columns or rows. */
+  ElementData* data,                /**< Row/column data. */
+  ElementData* otherData,           /**< Column/row data. */
+  CMR_LISTHASHTABLE* otherHashtable,/**< Column/row hashtable. */
+  long long* entryToHash,           /**< Pre-computed hash values of vector entries. */
+  size_t index,                     /**< Index of the vector. */
+  bool isRow,                       /**< Whether \p vectors are the rows. */
+  CMR_ELEMENT* queue,               /**< Queue. */
+  size_t* pqueueEnd,                /**< Pointer to end of queue. */
+  size_t queueMemory,               /**< Memory allocated for queue. */
+  size_t* plastOther                /**< Pointer for storing the counterpart of the last remaining entry. */
+)
+{
+  assert(cmr);
+
+  *plastOther = SIZE_MAX;
+  for (size_t e = vectors->first[index]; e < vectors->beyond[index]; ++e)
+  {
+    size_t other = vectors->entries[e];
+    if (others->removed[other])
+      continue;
+
+    CMR_CALL( processNonzero(cmr, otherHashtable, entryToHash[index], -vectors->values[e], other,
+      &others->numNonzeros[other], &otherData[other], queue, pqueueEnd, queueMemory, !isRow) );
+    *plastOther = other;
+  }
+
+  vectors->numNonzeros[index] = 0;
+  vectors->removed[index] = true;
+  data[index].lastBFS = -2;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Carries out the reduction algorithm on compressed row and column storage.
+ *
+ * Equivalent of \ref reduceListMatrix for \ref CMR_SP_ENGINE_COMPACT, which finds the same reductions in the same
+ * order. The numbers of nonzeros are updated accordingly.
+ */
+
+static
+CMR_ERROR reduceCompactMatrix(
+  CMR* cmr,                           /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,                 /**< Matrix. */
+  size_t* rowNumNonzeros,             /**< Number of nonzeros of each row. */
+  size_t* columnNumNonzeros,          /**< Number of nonzeros of each column. */
+  ElementData* rowData,               /**< Row data. */
+  ElementData* columnData,            /**< Column data. */
+  CMR_LISTHASHTABLE* rowHashtable,    /**< Row hashtable. */
+  CMR_LISTHASHTABLE* columnHashtable, /**< Column hashtable. */
+  long long* entryToHash,             /**< Pre-computed hash values of vector entries. */
+  CMR_ELEMENT* queue,                 /**< Queue. */
+  size_t* pqueueStart,                /**< Pointer to start of queue. */
+  size_t* pqueueEnd,                  /**< Pointer to end of queue. */
+  size_t queueMemory,                 /**< Memory allocated for queue. */
+  CMR_SP_REDUCTION* reductions,       /**< Array for storing the SP-reductions. */
+  size_t maxNumReductions,            /**< Maximum number of SP-reductions. Stops when this would be exceeded. */
+  size_t* pnumReductions,             /**< Pointer for storing the number of SP-reductions; stores \c SIZE_MAX if
+                                       **< \p maxNumReductions was exceeded.  */
+  size_t* pnumRowReductions,          /**< Pointer for storing the number of row reductions. */
+  size_t* pnumColumnReductions,       /**< Pointer for storing the number of column reductions. */
+  CMR_SP_STATISTICS* stats            /**< Pointer to statistics (may be \c NULL). */
+)
+{
+  assert(cmr);
+  assert(matrix);
+
+  CompactVectors rows;
+  CompactVectors columns;
+  CMR_CALL( createCompactVectors(cmr, matrix, rowNumNonzeros, columnNumNonzeros, rowData, columnData, &rows,
+    &columns) );
+
+  uint32_t numCompactions = 0;
+  while (*pqueueEnd > *pqueueStart)
+  {
+    CMR_ELEMENT element = queue[(*pqueueStart) % queueMemory];
+    ++(*pqueueStart);
+
+    bool isRow = CMRelementIsRow(element);
+    size_t index = isRow ? CMRelementToRowIndex(element) : CMRelementToColumnIndex(element);
+    CompactVectors* vectors = isRow ? &rows : &columns;
+    CompactVectors* others = isRow ? &columns : &rows;
+    ElementData* data = isRow ? rowData : columnData;
+    ElementData* otherData = isRow ? columnData : rowData;
+    CMR_LISTHASHTABLE* hashtable = isRow ? rowHashtable : columnHashtable;
+    CMR_LISTHASHTABLE* otherHashtable = isRow ? columnHashtable : rowHashtable;
+
+#if defined(CMR_DEBUG_REDUCTION)
+    CMRdbgMsg(2, "Top element is %s %zu with %zu nonzeros.\n", isRow ? "row" : "column", index,
+      vectors->numNonzeros[index]);
+#endif /* CMR_DEBUG_REDUCTION */
+
+    data[index].inQueue = false;
+    CMR_ELEMENT mate;
+    if (vectors->numNonzeros[index] > 1)
+    {
+      size_t copy = findCompactCopy(vectors, others, data, hashtable, index, &numCompactions);
+      if (copy == SIZE_MAX)
+      {
+        CMR_CALL( CMRlisthashtableInsert(cmr, hashtable, llabs(data[index].hashValue), index,
+          &data[index].hashEntry) );
+        continue;
+      }
+      mate = isRow ? CMRrowToElement(copy) : CMRcolumnToElement(copy);
+    }
+    else
+      mate = 0;
+
+    if (*pnumReductions == maxNumReductions)
+    {
+      *pnumReductions = SIZE_MAX;
+      break;
+    }
+
+    size_t lastOther;
+    CMR_CALL( removeCompactVector(cmr, vectors, others, data, otherData, otherHashtable, entryToHash, index, isRow,
+      queue, pqueueEnd, queueMemory, &lastOther) );
+    if (!mate && lastOther != SIZE_MAX)
+      mate = isRow ? CMRcolumnToElement(lastOther) : CMRrowToElement(lastOther);
+
+    reductions[*pnumReductions].element = element;
+    reductions[*pnumReductions].mate = mate;
+    (*pnumReductions)++;
+    if (isRow)
+      (*pnumRowReductions)++;
+    else
+      (*pnumColumnReductions)++;
+  }
+
+  if (stats)
+    stats->compactionCount += numCompactions;
+
+  CMR_CALL( freeCompactVectors(cmr, &rows, &columns) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Checks whether vectors \p index and \p mate agree on the rows (resp. columns) that are not removed.
+ *
+ * In the binary case only the supports are compared, and otherwise the vectors may also be negated copies.
+ */
+
+static
+bool isCompactCopy(
+  CompactVectors* vectors,  /**< Rows or columns. */
+  CompactVectors* others,   /**< Columns or rows. */
+  size_t index,             /**< Index of the first vector. */
+  size_t mate,              /**< Index of the second vector. */
+  bool ternary              /**< Whether to compare the signs. */
+)
+{
+  if (vectors->numNonzeros[index] != vectors->numNonzeros[mate])
+    return false;
+
+  bool equal = true;
+  bool negated = true;
+  size_t e1 = vectors->first[index];
+  size_t e2 = vectors->first[mate];
+  while (true)
+  {
+    while (e1 < vectors->beyond[index] && others->removed[vectors->entries[e1]])
+      ++e1;
+    while (e2 < vectors->beyond[mate] && others->removed[vectors->entries[e2]])
+      ++e2;
+    if (e1 == vectors->beyond[index] || e2 == vectors->beyond[mate])
+      return true;
+    if (vectors->entries[e1] != vectors->entries[e2])
+      return false;
+    if (vectors->values[e1] == vectors->values[e2])
+      negated = false;
+    else
+      equal = false;
+    if (ternary && !equal && !negated)
+      return false;
+    ++e1;
+    ++e2;
+  }
+}
+
+/**
+ * \brief Carries out the reductions of \p script as long as they are valid for \p matrix.
+ *
+ * Stops at the first reduction that is not valid for the matrix that remains after the previous ones. The applied
+ * reductions are stored in \p reductions, their rows and columns are marked as removed, and the numbers of nonzeros
+ * and hash values of the remaining ones are updated as in \ref reduceCompactMatrix.
+ */
+
+static
+CMR_ERROR replayReductions(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,             /**< Matrix. */
+  CMR_SP_REDUCTION* script,       /**< Reductions to replay. */
+  size_t numScript,               /**< Number of reductions to replay. */
+  bool ternary,                   /**< Whether copies must agree in their signs. */
+  size_t* rowNumNonzeros,         /**< Number of nonzeros of each row. */
+  size_t* columnNumNonzeros,      /**< Number of nonzeros of each column. */
+  ElementData* rowData,           /**< Row data. */
+  ElementData* columnData,        /**< Column data. */
+  long long* entryToHash,         /**< Pre-computed hash values of vector entries. */
+  CMR_SP_REDUCTION* reductions,   /**< Array for storing the SP-reductions. */
+  size_t maxNumReductions,        /**< Maximum number of SP-reductions. */
+  size_t* pnumReductions,         /**< Pointer for storing the number of SP-reductions. */
+  size_t* pnumRowReductions,      /**< Pointer for storing the number of row reductions. */
+  size_t* pnumColumnReductions    /**< Pointer for storing the number of column reductions. */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(script || numScript == 0);
+
+  CompactVectors rows;
+  CompactVectors columns;
+  CMR_CALL( createCompactVectors(cmr, matrix, rowNumNonzeros, columnNumNonzeros, rowData, columnData, &rows,
+    &columns) );
+
+  for (size_t s = 0; s < numScript && *pnumReductions < maxNumReductions; ++s)
+  {
+    CMR_SP_REDUCTION reduction = script[s];
+    if (!CMRspIsValid(reduction))
+      break;
+    bool isRow = CMRelementIsRow(reduction.element);
+    size_t index = isRow ? CMRelementToRowIndex(reduction.element) : CMRelementToColumnIndex(reduction.element);
+    CompactVectors* vectors = isRow ? &rows : &columns;
+    CompactVectors* others = isRow ? &columns : &rows;
+    if (index >= (isRow ? matrix->numRows : matrix->numColumns) || vectors->removed[index])
+      break;
+
+    /* Check whether the reduction is valid for the remaining matrix. */
+    bool valid;
+    if (reduction.mate == 0)
+      valid = vectors->numNonzeros[index] == 0;
+    else if (CMRelementIsRow(reduction.mate) == isRow)
+    {
+      size_t mate = isRow ? CMRelementToRowIndex(reduction.mate) : CMRelementToColumnIndex(reduction.mate);
+      valid = mate < (isRow ? matrix->numRows : matrix->numColumns) && mate != index && !vectors->removed[mate]
+        && isCompactCopy(vectors, others, index, mate, ternary);
+    }
+    else
+    {
+      size_t mate = isRow ? CMRelementToColumnIndex(reduction.mate) : CMRelementToRowIndex(reduction.mate);
+      valid = false;
+      if (vectors->numNonzeros[index] == 1)
+      {
+        for (size_t e = vectors->first[index]; e < vectors->beyond[index]; ++e)
+        {
+          if (!others->removed[vectors->entries[e]])
+          {
+            valid = vectors->entries[e] == mate;
+            break;
+          }
+        }
+      }
+    }
+    if (!valid)
+    {
+      CMRdbgMsg(2, "Replay stops at invalid reduction %s.\n", CMRspReductionString(reduction, NULL));
+      break;
+    }
+
+    /* Remove the row or column. */
+    ElementData* data = isRow ? rowData : columnData;
+    ElementData* otherData = isRow ? columnData : rowData;
+    for (size_t e = vectors->first[index]; e < vectors->beyond[index]; ++e)
+    {
+      size_t other = vectors->entries[e];
+      if (others->removed[other])
+        continue;
+
+      others->numNonzeros[other]--;
+      otherData[other].hashValue = CMRfingerprintUpdate(otherData[other].hashValue,
+        entryToHash[index], -vectors->values[e]);
+    }
+    vectors->numNonzeros[index] = 0;
+    vectors->removed[index] = true;
+    data[index].lastBFS = -2;
+
+    reductions[*pnumReductions] = reduction;
+    (*pnumReductions)++;
+    if (isRow)
+      (*pnumRowReductions)++;
+    else
+      (*pnumColumnReductions)++;
+  }
+
+  CMR_CALL( freeCompactVectors(cmr, &rows, &columns) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Creates the linked-list representation of the SP-reduced submatrix after \ref reduceCompactMatrix.
+ *
+ * The result is the same as after \ref reduceListMatrix, i.e., the lists of all nonzeros of removed rows and columns
+ * are empty and removed rows and columns are unlinked.
+ */
+
+static
+CMR_ERROR createReducedListMatrix(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,           /**< Matrix. */
+  CMR_SUBMAT* reducedSubmatrix, /**< SP-reduced submatrix. */
+  size_t* rowNumNonzeros,       /**< Number of nonzeros of each row of the SP-reduced submatrix. */
+  ElementData* rowData,         /**< Row data. */
+  ElementData* columnData,      /**< Column data. */
+  ListMat8** plistmatrix        /**< Pointer for storing the list matrix. */
+)
+{
+  assert(cmr);
+  assert(reducedSubmatrix);
+  assert(plistmatrix);
+
+  size_t numNonzeros = 0;
+  for (size_t r = 0; r < reducedSubmatrix->numRows; ++r)
+    numNonzeros += rowNumNonzeros[reducedSubmatrix->rows[r]];
+
+  CMR_CALL( CMRlistmat8Alloc(cmr, matrix->numRows, matrix->numColumns, numNonzeros, plistmatrix) );
+  ListMat8* listmatrix = *plistmatrix;
+  CMR_CALL( CMRlistmat8InitializeFromChrSubmatrix(cmr, listmatrix, matrix, reducedSubmatrix) );
+  assert(listmatrix->numNonzeros == numNonzeros);
+
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    if (rowData[row].lastBFS == -2)
+    {
+      listmatrix->rowElements[row].head.above->below = listmatrix->rowElements[row].head.below;
+      listmatrix->rowElements[row].head.below->above = listmatrix->rowElements[row].head.above;
+    }
+  }
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+  {
+    if (columnData[column].lastBFS == -2)
+    {
+      listmatrix->columnElements[column].head.left->right = listmatrix->columnElements[column].head.right;
+      listmatrix->columnElements[column].head.right->left = listmatrix->columnElements[column].head.left;
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Try to find an \f$ M_2 \f$-submatrix for a ternary SP-reduced matrix in list representation.
+ */
+
+static
+CMR_ERROR extractNonbinarySubmatrix(
+  CMR* cmr,                           /**< \ref CMR environment. */
+  ListMat8* listmatrix,             /**< List matrix. */
+  ElementData* rowData,               /**< Row data. */
+  ElementData* columnData,            /**< Column data. */
+  CMR_LISTHASHTABLE* rowHashtable,    /**< Row hashtable. */
+  CMR_LISTHASHTABLE* columnHashtable, /**< Column hashtable. */
+  CMR_ELEMENT* queue,                 /**< Queue. */
+  size_t* pqueueStart,                /**< Pointer to start of queue. */
+  size_t* pqueueEnd,                  /**< Pointer to end of queue. */
+  size_t queueMemory,                 /**< Memory allocated for queue. */
+  CMR_SUBMAT** pviolatorSubmatrix     /**< Pointer for storing the submatrix if an \f$ M_2 \f$-submatrix is found. */
+)
+{
+  assert(cmr);
+  assert(listmatrix);
+  assert(rowData);
+  assert(columnData);
+  assert(rowHashtable);
+  assert(columnHashtable);
+  assert(queue);
+  assert(pviolatorSubmatrix);
+
+  CMRdbgMsg(2, "Searching for M_2-submatrix.\n");
+
+  *pviolatorSubmatrix = NULL;
+  while (*pqueueEnd > *pqueueStart)
+  {
+#if defined(CMR_DEBUG)
+    CMRdbgMsg(0, "\n");
+    for (size_t q = *pqueueStart; q < *pqueueEnd; ++q)
+    {
+      CMR_ELEMENT e = queue[q % queueMemory];
+      CMRdbgMsg(6, "Queue #%d @ %d: %s\n", q, q % queueMemory, CMRelementString(e, NULL));
+    }
+    CMRdbgMsg(0, "\n");
+#endif /* CMR_DEBUG */
+
+    CMR_ELEMENT element = queue[(*pqueueStart) % queueMemory];
+    ++(*pqueueStart);
+
+    if (CMRelementIsRow(element))
+    {
+      /* We consider a row. */
+
+      size_t row1 = CMRelementToRowIndex(element);
+      assert(listmatrix->rowElements[row1].numNonzeros > 1);
+      rowData[row1].inQueue = false;
+      size_t row2 = findCopy(listmatrix->rowElements, rowData, rowHashtable, row1, true, true);
+
+      if (row2 == SIZE_MAX)
+      {
+        CMRdbgMsg(6, "No parallel row found. Inserting row %d.\n", row1);
+        CMR_CALL( CMRlisthashtableInsert(cmr, rowHashtable, llabs(rowData[row1].hashValue), row1, &rowData[row1].hashEntry) );
+      }
+      else
+      {
+        CMRdbgMsg(6, "Row %d is parallel.\n", row2);
+
+        /* We found a row copy. */
+        size_t column1 = SIZE_MAX;
+        size_t column2 = SIZE_MAX;
+        ListMat8Nonzero* nz1 = listmatrix->rowElements[row1].head.right;
+        ListMat8Nonzero* nz2 = listmatrix->rowElements[row2].head.right;
+        while (column1 == SIZE_MAX || column2 == SIZE_MAX)
         {
           if (nz1->value == nz2->value)
           {
@@ -1070,24 +2035,388 @@ CMR_ERROR breadthFirstSearch(
         size_t row = nz->row;
         if (rowData[row].lastBFS != currentBFS)
         {
-          /* We found a new row node. */
-#if defined(CMR_DEBUG_WHEEL)
-          CMRdbgMsg(10, "Node r%d receives distance %d (last BFS #%d)\n", row+1, columnData[column].distance + 1,
-            rowData[row].lastBFS);
-#endif /* CMR_DEBUG_WHEEL */
+          /* We found a new row node. */
+#if defined(CMR_DEBUG_WHEEL)
+          CMRdbgMsg(10, "Node r%d receives distance %d (last BFS #%d)\n", row+1, columnData[column].distance + 1,
+            rowData[row].lastBFS);
+#endif /* CMR_DEBUG_WHEEL */
+
+          rowData[row].distance = columnData[column].distance + 1;
+          rowData[row].predecessor = column;
+          queue[queueEnd % queueMemory] = CMRrowToElement(row);
+          queueEnd++;
+          if (rowData[row].lastBFS == currentBFS+1)
+          {
+            queueStart = queueEnd;
+            if (pfoundTarget)
+            {
+              for (size_t t = 0; t < numTargets; ++t)
+              {
+                if (targets[t] == CMRrowToElement(row))
+                {
+                  *pfoundTarget = t;
+                  break;
+                }
+              }
+            }
+            break;
+          }
+          else
+            rowData[row].lastBFS = currentBFS;
+        }
+        else
+        {
+#if defined(CMR_DEBUG_WHEEL)
+          CMRdbgMsg(10, "Node r%d already known.\n", row+1);
+#endif /* CMR_DEBUG_WHEEL */
+        }
+      }
+    }
+  }
+
+  /* Reset lastBFS for targets. */
+  for (size_t t = 0; t < numTargets; ++t)
+  {
+    CMR_ELEMENT element = targets[t];
+    if (CMRelementIsRow(element))
+      rowData[CMRelementToRowIndex(element)].lastBFS = 0;
+    else
+      columnData[CMRelementToColumnIndex(element)].lastBFS = 0;
+  }
+  if (pnumEdges)
+    (*pnumEdges) /= 2;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Extract remaining submatrix.
+ */
+
+static
+CMR_ERROR extractRemainingSubmatrix(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,             /**< Matrix. */
+  size_t numRowReductions,        /**< Number of row SP reductions. */
+  size_t numColumnReductions,     /**< Number of column SP reductions. */
+  ElementData* rowData,           /**< Row data. */
+  ElementData* columnData,        /**< Column data. */
+  CMR_SUBMAT** preducedSubmatrix  /**< Pointer for storing the reduced submatrix. */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(rowData);
+  assert(columnData);
+  assert(preducedSubmatrix);
+
+  CMR_CALL( CMRsubmatCreate(cmr, matrix->numRows - numRowReductions, matrix->numColumns - numColumnReductions,
+    preducedSubmatrix) );
+  CMR_SUBMAT* remainingSubmatrix = *preducedSubmatrix;
+  size_t rowSubmatrix = 0;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    if (rowData[row].lastBFS != -2)
+      remainingSubmatrix->rows[rowSubmatrix++] = row;
+  }
+  assert(rowSubmatrix + numRowReductions == matrix->numRows);
+
+  size_t columnSubmatrix = 0;
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+  {
+    if (columnData[column].lastBFS != -2)
+      remainingSubmatrix->columns[columnSubmatrix++] = column;
+  }
+  assert(columnSubmatrix + numColumnReductions == matrix->numColumns);
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Create full matrix as remaining submatrix.
+ */
+
+static
+CMR_ERROR createFullRemainingMatrix(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,             /**< Matrix. */
+  CMR_SUBMAT** preducedSubmatrix  /**< Pointer for storing the reduced submatrix. */
+)
+{
+  CMR_CALL( CMRsubmatCreate(cmr, matrix->numRows, matrix->numColumns, preducedSubmatrix) );
+  CMR_SUBMAT* remainingSubmatrix = *preducedSubmatrix;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+    remainingSubmatrix->rows[row] = row;
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+    remainingSubmatrix->columns[column] = column;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Rows and columns of the SP-reduced submatrix packed into 64-bit words for \ref bitsetBreadthFirstSearch.
+ *
+ * The reduced rows (resp. columns) are those rows (resp. columns) of the list matrix that have nonzeros when the wheel
+ * search starts, in increasing order. Nonzeros that are later removed from the list matrix are also removed here via
+ * \ref removeWheelBitsetNonzero, such that the packed matrix is reused by all searches.
+ */
+
+typedef struct
+{
+  size_t numRowWords;         /**< \brief Number of words of a set of reduced rows. */
+  size_t numColumnWords;      /**< \brief Number of words of a set of reduced columns. */
+  size_t* rowToReduced;       /**< \brief Reduced index of each row or \c SIZE_MAX. */
+  size_t* columnToReduced;    /**< \brief Reduced index of each column or \c SIZE_MAX. */
+  size_t* reducedToRow;       /**< \brief Row of each reduced row. */
+  size_t* reducedToColumn;    /**< \brief Column of each reduced column. */
+  uint64_t* rows;             /**< \brief Set of reduced columns of each reduced row. */
+  uint64_t* columns;          /**< \brief Set of reduced rows of each reduced column. */
+  uint64_t* visitedRows;      /**< \brief Set of reduced rows visited by the current search. */
+  uint64_t* visitedColumns;   /**< \brief Set of reduced columns visited by the current search. */
+  uint64_t* targetColumns;    /**< \brief Set of reduced target columns of the current search. */
+} WheelBitset;
+
+/**
+ * \brief Packs the rows and columns of \p listmatrix into \p bitset.
+ */
+
+static
+CMR_ERROR createWheelBitset(
+  CMR* cmr,             /**< \ref CMR environment. */
+  ListMat8* listmatrix, /**< List matrix. */
+  WheelBitset* bitset   /**< Bitset structure to be filled. */
+)
+{
+  assert(cmr);
+  assert(listmatrix);
+  assert(bitset);
+
+  size_t numRows = listmatrix->numRows;
+  size_t numColumns = listmatrix->numColumns;
+
+  bitset->rowToReduced = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->rowToReduced, numRows) );
+  bitset->columnToReduced = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->columnToReduced, numColumns) );
+  bitset->reducedToRow = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->reducedToRow, numRows) );
+  bitset->reducedToColumn = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->reducedToColumn, numColumns) );
+
+  size_t numReducedRows = 0;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    if (listmatrix->rowElements[row].numNonzeros > 0)
+    {
+      bitset->rowToReduced[row] = numReducedRows;
+      bitset->reducedToRow[numReducedRows++] = row;
+    }
+    else
+      bitset->rowToReduced[row] = SIZE_MAX;
+  }
+  size_t numReducedColumns = 0;
+  for (size_t column = 0; column < numColumns; ++column)
+  {
+    if (listmatrix->columnElements[column].numNonzeros > 0)
+    {
+      bitset->columnToReduced[column] = numReducedColumns;
+      bitset->reducedToColumn[numReducedColumns++] = column;
+    }
+    else
+      bitset->columnToReduced[column] = SIZE_MAX;
+  }
+
+  size_t numRowWords = (numReducedRows + 63) / 64;
+  size_t numColumnWords = (numReducedColumns + 63) / 64;
+  bitset->numRowWords = numRowWords;
+  bitset->numColumnWords = numColumnWords;
+  bitset->rows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->rows, numReducedRows * numColumnWords) );
+  bitset->columns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->columns, numReducedColumns * numRowWords) );
+  bitset->visitedRows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->visitedRows, numRowWords) );
+  bitset->visitedColumns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->visitedColumns, numColumnWords) );
+  bitset->targetColumns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &bitset->targetColumns, numColumnWords) );
+
+  memset(bitset->rows, 0, numReducedRows * numColumnWords * sizeof(uint64_t));
+  memset(bitset->columns, 0, numReducedColumns * numRowWords * sizeof(uint64_t));
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (ListMat8Nonzero* nz = listmatrix->rowElements[row].head.right; nz->column != SIZE_MAX; nz = nz->right)
+    {
+      size_t reducedRow = bitset->rowToReduced[nz->row];
+      size_t reducedColumn = bitset->columnToReduced[nz->column];
+      bitset->rows[reducedRow * numColumnWords + reducedColumn / 64] |= (uint64_t) 1 << (reducedColumn % 64);
+      bitset->columns[reducedColumn * numRowWords + reducedRow / 64] |= (uint64_t) 1 << (reducedRow % 64);
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Frees the arrays of \p bitset.
+ */
+
+static
+CMR_ERROR freeWheelBitset(
+  CMR* cmr,           /**< \ref CMR environment. */
+  WheelBitset* bitset /**< Bitset structure. */
+)
+{
+  assert(cmr);
+  assert(bitset);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->targetColumns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->visitedColumns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->visitedRows) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->columns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->rows) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->reducedToColumn) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->reducedToRow) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->columnToReduced) );
+  CMR_CALL( CMRfreeStackArray(cmr, &bitset->rowToReduced) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Removes the nonzero at (\p row, \p column) from \p bitset.
+ */
+
+static inline
+void removeWheelBitsetNonzero(
+  WheelBitset* bitset,  /**< Bitset structure. */
+  size_t row,           /**< Row of the nonzero. */
+  size_t column         /**< Column of the nonzero. */
+)
+{
+  assert(bitset);
+
+  size_t reducedRow = bitset->rowToReduced[row];
+  size_t reducedColumn = bitset->columnToReduced[column];
+  assert(reducedRow != SIZE_MAX);
+  assert(reducedColumn != SIZE_MAX);
+
+  bitset->rows[reducedRow * bitset->numColumnWords + reducedColumn / 64] &= ~((uint64_t) 1 << (reducedColumn % 64));
+  bitset->columns[reducedColumn * bitset->numRowWords + reducedRow / 64] &= ~((uint64_t) 1 << (reducedRow % 64));
+}
+
+/**
+ * \brief Carries out the same breadth-first search as \ref breadthFirstSearch on \p bitset.
+ *
+ * The sources must be rows and the targets must be columns. The edges between sources and targets are disabled, which
+ * matches the nonzeros marked as special by \ref extractWheelSubmatrix. Each search layer is obtained by masking the
+ * packed row (resp. column) with the visited columns (resp. rows) word by word. Since the 1-bits are processed in
+ * increasing order, the distances and predecessors agree with those of \ref breadthFirstSearch.
+ */
+
+static
+CMR_ERROR bitsetBreadthFirstSearch(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  int currentBFS,           /**< Number of this execution of breadth-first search. */
+  WheelBitset* bitset,      /**< Packed SP-reduced submatrix. */
+  ElementData* rowData,     /**< Row data. */
+  ElementData* columnData,  /**< Column data. */
+  CMR_ELEMENT* queue,       /**< Queue. */
+  size_t queueMemory,       /**< Memory for queue. */
+  CMR_ELEMENT* sources,     /**< Array of source rows. */
+  size_t numSources,        /**< Number of source rows. */
+  CMR_ELEMENT* targets,     /**< Array of target columns. */
+  size_t numTargets,        /**< Number of target columns. */
+  size_t* pfoundTarget,     /**< Pointer for storing the index of the target node found. */
+  size_t* pnumEdges         /**< Pointer for storing the number of traversed edges. */
+)
+{
+  CMR_UNUSED(cmr);
+
+  assert(cmr);
+  assert(bitset);
+  assert(rowData);
+  assert(columnData);
+  assert(queue);
+  assert(queueMemory > 0);
+
+#if defined(CMR_DEBUG_WHEEL)
+  CMRdbgMsg(6, "Bitset BFS #%d for %d sources and %d targets.\n", currentBFS, numSources, numTargets);
+#endif /* CMR_DEBUG_WHEEL */
+
+  size_t numRowWords = bitset->numRowWords;
+  size_t numColumnWords = bitset->numColumnWords;
+  uint64_t* visitedRows = bitset->visitedRows;
+  uint64_t* visitedColumns = bitset->visitedColumns;
+  uint64_t* targetColumns = bitset->targetColumns;
+  for (size_t w = 0; w < numRowWords; ++w)
+    visitedRows[w] = 0;
+  for (size_t w = 0; w < numColumnWords; ++w)
+  {
+    visitedColumns[w] = 0;
+    targetColumns[w] = 0;
+  }
+
+  size_t queueStart = 0;
+  size_t queueEnd = numSources;
+  for (size_t s = 0; s < numSources; ++s)
+  {
+    assert(CMRelementIsRow(sources[s]));
+    size_t row = CMRelementToRowIndex(sources[s]);
+    queue[s] = sources[s];
+    rowData[row].distance = 0;
+    rowData[row].lastBFS = currentBFS;
+    size_t reducedRow = bitset->rowToReduced[row];
+    visitedRows[reducedRow / 64] |= (uint64_t) 1 << (reducedRow % 64);
+  }
+  for (size_t t = 0; t < numTargets; ++t)
+  {
+    assert(CMRelementIsColumn(targets[t]));
+    size_t column = CMRelementToColumnIndex(targets[t]);
+    columnData[column].lastBFS = currentBFS+1;
+    size_t reducedColumn = bitset->columnToReduced[column];
+    targetColumns[reducedColumn / 64] |= (uint64_t) 1 << (reducedColumn % 64);
+  }
+
+  size_t numEdges = 0;
+  bool found = false;
+  while (queueEnd > queueStart && !found)
+  {
+    CMR_ELEMENT element = queue[queueStart % queueMemory];
+    queueStart++;
+
+    if (CMRelementIsRow(element))
+    {
+      size_t row = CMRelementToRowIndex(element);
+      uint64_t* rowWords = &bitset->rows[bitset->rowToReduced[row] * numColumnWords];
+      bool isSource = rowData[row].distance == 0;
+      for (size_t w = 0; w < numColumnWords && !found; ++w)
+      {
+        uint64_t word = rowWords[w];
+        if (isSource)
+          word &= ~targetColumns[w];
+        numEdges += CMRcountBits(word);
+        word &= ~visitedColumns[w];
+        visitedColumns[w] |= word;
+        while (word)
+        {
+          size_t bit = CMRlowestBit(word);
+          word &= word - 1;
 
-          rowData[row].distance = columnData[column].distance + 1;
-          rowData[row].predecessor = column;
-          queue[queueEnd % queueMemory] = CMRrowToElement(row);
+          /* We found a new column node. */
+          size_t column = bitset->reducedToColumn[64 * w + bit];
+          columnData[column].distance = rowData[row].distance + 1;
+          columnData[column].predecessor = row;
+          queue[queueEnd % queueMemory] = CMRcolumnToElement(column);
           queueEnd++;
-          if (rowData[row].lastBFS == currentBFS+1)
+          if (targetColumns[w] & ((uint64_t) 1 << bit))
           {
-            queueStart = queueEnd;
+            found = true;
             if (pfoundTarget)
             {
               for (size_t t = 0; t < numTargets; ++t)
               {
-                if (targets[t] == CMRrowToElement(row))
+                if (targets[t] == CMRcolumnToElement(column))
                 {
                   *pfoundTarget = t;
                   break;
@@ -1097,13 +2426,32 @@ CMR_ERROR breadthFirstSearch(
             break;
           }
           else
-            rowData[row].lastBFS = currentBFS;
+            columnData[column].lastBFS = currentBFS;
         }
-        else
+      }
+    }
+    else
+    {
+      size_t column = CMRelementToColumnIndex(element);
+      uint64_t* columnWords = &bitset->columns[bitset->columnToReduced[column] * numRowWords];
+      for (size_t w = 0; w < numRowWords; ++w)
+      {
+        uint64_t word = columnWords[w];
+        numEdges += CMRcountBits(word);
+        word &= ~visitedRows[w];
+        visitedRows[w] |= word;
+        while (word)
         {
-#if defined(CMR_DEBUG_WHEEL)
-          CMRdbgMsg(10, "Node r%d already known.\n", row+1);
-#endif /* CMR_DEBUG_WHEEL */
+          size_t bit = CMRlowestBit(word);
+          word &= word - 1;
+
+          /* We found a new row node. */
+          size_t row = bitset->reducedToRow[64 * w + bit];
+          rowData[row].distance = columnData[column].distance + 1;
+          rowData[row].predecessor = column;
+          rowData[row].lastBFS = currentBFS;
+          queue[queueEnd % queueMemory] = CMRrowToElement(row);
+          queueEnd++;
         }
       }
     }
@@ -1111,77 +2459,9 @@ CMR_ERROR breadthFirstSearch(
 
   /* Reset lastBFS for targets. */
   for (size_t t = 0; t < numTargets; ++t)
-  {
-    CMR_ELEMENT element = targets[t];
-    if (CMRelementIsRow(element))
-      rowData[CMRelementToRowIndex(element)].lastBFS = 0;
-    else
-      columnData[CMRelementToColumnIndex(element)].lastBFS = 0;
-  }
+    columnData[CMRelementToColumnIndex(targets[t])].lastBFS = 0;
   if (pnumEdges)
-    (*pnumEdges) /= 2;
-
-  return CMR_OKAY;
-}
-
-/**
- * \brief Extract remaining submatrix.
- */
-
-static
-CMR_ERROR extractRemainingSubmatrix(
-  CMR* cmr,                       /**< \ref CMR environment. */
-  CMR_CHRMAT* matrix,             /**< Matrix. */
-  size_t numRowReductions,        /**< Number of row SP reductions. */
-  size_t numColumnReductions,     /**< Number of column SP reductions. */
-  ListMat8* listmatrix,           /**< List matrix. */
-  CMR_SUBMAT** preducedSubmatrix  /**< Pointer for storing the reduced submatrix. */
-)
-{
-  assert(cmr);
-  assert(matrix);
-  assert(listmatrix);
-  assert(preducedSubmatrix);
-
-  CMR_CALL( CMRsubmatCreate(cmr, matrix->numRows - numRowReductions, matrix->numColumns - numColumnReductions,
-    preducedSubmatrix) );
-  CMR_SUBMAT* remainingSubmatrix = *preducedSubmatrix;
-  size_t rowSubmatrix = 0;
-  for (size_t row = 0; row < matrix->numRows; ++row)
-  {
-    if (listmatrix->rowElements[row].numNonzeros > 0)
-      remainingSubmatrix->rows[rowSubmatrix++] = row;
-  }
-  assert(rowSubmatrix + numRowReductions == matrix->numRows);
-
-  size_t columnSubmatrix = 0;
-  for (size_t column = 0; column < matrix->numColumns; ++column)
-  {
-    if (listmatrix->columnElements[column].numNonzeros > 0)
-      remainingSubmatrix->columns[columnSubmatrix++] = column;
-  }
-  assert(columnSubmatrix + numColumnReductions == matrix->numColumns);
-
-  return CMR_OKAY;
-}
-
-/**
- * \brief Create full matrix as remaining submatrix.
- */
-
-static
-CMR_ERROR createFullRemainingMatrix(
-  CMR* cmr,                       /**< \ref CMR environment. */
-  CMR_CHRMAT* matrix,             /**< Matrix. */
-  CMR_SUBMAT** preducedSubmatrix  /**< Pointer for storing the reduced submatrix. */
-)
-{
-  CMR_CALL( CMRsubmatCreate(cmr, matrix->numRows, matrix->numColumns, preducedSubmatrix) );
-  CMR_SUBMAT* remainingSubmatrix = *preducedSubmatrix;
-  for (size_t row = 0; row < matrix->numRows; ++row)
-    remainingSubmatrix->rows[row] = row;
-  for (size_t column = 0; column < matrix->numColumns; ++column)
-    remainingSubmatrix->columns[column] = column;
+    *pnumEdges = numEdges / 2;
 
   return CMR_OKAY;
 }
@@ -1201,11 +2481,14 @@ CMR_ERROR extractWheelSubmatrix(
   size_t numReducedRows,        /**< Number of rows in reduced matrix. */
   size_t numReducedColumns,     /**< Number of columns in reduced matrix. */
   CMR_SUBMAT** pwheelSubmatrix, /**< Pointer for storing the wheel submatrix (may be \c NULL). */
-  CMR_SEPA** pseparation        /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SEPA** pseparation,       /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SP_WHEEL_SEARCH search,   /**< Data structure for the breadth-first searches. */
+  bool* pusedBitset             /**< Pointer for storing whether the searches were carried out on bitsets. */
 )
 {
   assert(cmr);
   assert(listmatrix);
+  assert(pusedBitset);
 
   CMRdbgMsg(2, "Searching for wheel graph representation submatrix.\n");
 
@@ -1226,6 +2509,15 @@ CMR_ERROR extractWheelSubmatrix(
   size_t numEdges = 0;
   for (size_t row = 0; row < numRows; ++row)
     numEdges += listmatrix->rowElements[row].numNonzeros;
+
+  /* The bitsets pay off if a packed row is not longer than the list of its nonzeros on average. */
+  bool useBitset = (search == CMR_SP_WHEEL_SEARCH_BITSET) || (search == CMR_SP_WHEEL_SEARCH_AUTO
+    && 64 * numEdges >= numReducedRows * numReducedColumns);
+  WheelBitset bitset;
+  if (useBitset)
+    CMR_CALL( createWheelBitset(cmr, listmatrix, &bitset) );
+  *pusedBitset = useBitset;
+
   while (true)
   {
     size_t sourceRow = listmatrix->anchor.below->row;
@@ -1243,8 +2535,16 @@ CMR_ERROR extractWheelSubmatrix(
     targets[0] = CMRcolumnToElement(targetColumn);
     size_t foundTarget = SIZE_MAX;
     currentBFS++;
-    CMR_CALL( breadthFirstSearch(cmr, currentBFS, listmatrix->rowElements, listmatrix->columnElements, rowData,
-      columnData, queue, queueMemory, sources, 1, targets, 1, &foundTarget, 0) );
+    if (useBitset)
+    {
+      CMR_CALL( bitsetBreadthFirstSearch(cmr, currentBFS, &bitset, rowData, columnData, queue, queueMemory, sources, 1,
+        targets, 1, &foundTarget, 0) );
+    }
+    else
+    {
+      CMR_CALL( breadthFirstSearch(cmr, currentBFS, listmatrix->rowElements, listmatrix->columnElements, rowData,
+        columnData, queue, queueMemory, sources, 1, targets, 1, &foundTarget, 0) );
+    }
     listmatrix->rowElements[sourceRow].head.right->special = 0;
     size_t length = (foundTarget == SIZE_MAX) ? SIZE_MAX : columnData[targetColumn].distance + 1;
 
@@ -1353,8 +2653,16 @@ CMR_ERROR extractWheelSubmatrix(
       currentBFS++;
       foundTarget = SIZE_MAX;
       numTraversedEdges = 0;
-      CMR_CALL( breadthFirstSearch(cmr, currentBFS, listmatrix->rowElements, listmatrix->columnElements, rowData,
-        columnData, queue, queueMemory, sources, numSources, targets, numTargets, &foundTarget, &numTraversedEdges) );
+      if (useBitset)
+      {
+        CMR_CALL( bitsetBreadthFirstSearch(cmr, currentBFS, &bitset, rowData, columnData, queue, queueMemory, sources,
+          numSources, targets, numTargets, &foundTarget, &numTraversedEdges) );
+      }
+      else
+      {
+        CMR_CALL( breadthFirstSearch(cmr, currentBFS, listmatrix->rowElements, listmatrix->columnElements, rowData,
+          columnData, queue, queueMemory, sources, numSources, targets, numTargets, &foundTarget, &numTraversedEdges) );
+      }
     }
 
     if (foundTarget < SIZE_MAX && pwheelSubmatrix)
@@ -1524,6 +2832,8 @@ CMR_ERROR extractWheelSubmatrix(
           {
             listmatrix->rowElements[nz->row].numNonzeros--;
             unlinkNonzero(nz);
+            if (useBitset)
+              removeWheelBitsetNonzero(&bitset, nz->row, nz->column);
           }
           else
             nz->special = 0;
@@ -1557,6 +2867,8 @@ CMR_ERROR extractWheelSubmatrix(
           {
             listmatrix->columnElements[nz->column].numNonzeros--;
             unlinkNonzero(nz);
+            if (useBitset)
+              removeWheelBitsetNonzero(&bitset, nz->row, nz->column);
           }
           else
             nz->special = 0;
@@ -1566,8 +2878,8 @@ CMR_ERROR extractWheelSubmatrix(
         else
         {
           listmatrix->rowElements[row].numNonzeros = 0;
-          listmatrix->rowElements[row].head.left->right = listmatrix->rowElements[row].head.right;
-          listmatrix->rowElements[row].head.right->left = listmatrix->rowElements[row].head.left;
+          listmatrix->rowElements[row].head.above->below = listmatrix->rowElements[row].head.below;
+          listmatrix->rowElements[row].head.below->above = listmatrix->rowElements[row].head.above;
         }
       }
 
@@ -1581,6 +2893,8 @@ CMR_ERROR extractWheelSubmatrix(
     CMRdbgMsg(0, "!!! Recursing.\n");
 #endif /* CMR_DEBUG_WHEEL */
   }
+  if (useBitset)
+    CMR_CALL( freeWheelBitset(cmr, &bitset) );
   CMR_CALL( CMRfreeStackArray(cmr, &targets) );
   CMR_CALL( CMRfreeStackArray(cmr, &sources) );
   CMR_CALL( CMRfreeStackArray(cmr, &nzBlock) );
@@ -1588,10 +2902,82 @@ CMR_ERROR extractWheelSubmatrix(
   return CMR_OKAY;
 }
 
+/**
+ * \brief Carries out the SP-reductions with the engine selected in \p params.
+ *
+ * For \ref CMR_SP_ENGINE_LIST, the list matrix is created and stored in \p *plistmatrix. Otherwise, \p *plistmatrix
+ * is set to \c NULL and can be created by \ref createReducedListMatrix if necessary.
+ */
+
+static
+CMR_ERROR reduceMatrix(
+  CMR* cmr,                           /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,                 /**< Matrix. */
+  size_t* rowNumNonzeros,             /**< Number of nonzeros of each row. */
+  size_t* columnNumNonzeros,          /**< Number of nonzeros of each column. */
+  ElementData* rowData,               /**< Row data. */
+  ElementData* columnData,            /**< Column data. */
+  CMR_LISTHASHTABLE* rowHashtable,    /**< Row hashtable. */
+  CMR_LISTHASHTABLE* columnHashtable, /**< Column hashtable. */
+  long long* hashVector,              /**< Pre-computed hash values of vector entries. */
+  CMR_ELEMENT* queue,                 /**< Queue. */
+  size_t* pqueueStart,                /**< Pointer to start of queue. */
+  size_t* pqueueEnd,                  /**< Pointer to end of queue. */
+  size_t queueMemory,                 /**< Memory allocated for queue. */
+  CMR_SP_REDUCTION* reductions,       /**< Array for storing the SP-reductions. */
+  size_t maxNumReductions,            /**< Maximum number of SP-reductions. Stops when this would be exceeded. */
+  size_t* pnumReductions,             /**< Pointer for storing the number of SP-reductions. */
+  size_t* pnumRowReductions,          /**< Pointer for storing the number of row reductions. */
+  size_t* pnumColumnReductions,       /**< Pointer for storing the number of column reductions. */
+  ListMat8** plistmatrix,             /**< Pointer for storing the list matrix (may be set to \c NULL). */
+  CMR_SP_PARAMS* params,              /**< Parameters for the computation. */
+  CMR_SP_STATISTICS* stats            /**< Pointer to statistics (may be \c NULL). */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(plistmatrix);
+  assert(params);
+
+  *plistmatrix = NULL;
+  if (params->engine == CMR_SP_ENGINE_LIST)
+  {
+    if (*pnumReductions > 0)
+    {
+      /* Some reductions were replayed. */
+      CMR_SUBMAT* remainingSubmatrix = NULL;
+      CMR_CALL( extractRemainingSubmatrix(cmr, matrix, *pnumRowReductions, *pnumColumnReductions, rowData,
+        columnData, &remainingSubmatrix) );
+      CMR_CALL( createReducedListMatrix(cmr, matrix, remainingSubmatrix, rowNumNonzeros, rowData, columnData,
+        plistmatrix) );
+      CMR_CALL( CMRsubmatFree(cmr, &remainingSubmatrix) );
+    }
+    else
+    {
+      CMR_CALL( CMRlistmat8Alloc(cmr, matrix->numRows, matrix->numColumns, matrix->numNonzeros, plistmatrix) );
+      CMR_CALL( CMRlistmat8InitializeFromChrMatrix(cmr, *plistmatrix, matrix) );
+    }
+    CMR_CALL( reduceListMatrix(cmr, *plistmatrix, rowData, columnData, rowHashtable, columnHashtable, hashVector,
+      queue, pqueueStart, pqueueEnd, queueMemory, reductions, maxNumReductions, pnumReductions, pnumRowReductions,
+      pnumColumnReductions) );
+  }
+  else
+  {
+    CMR_CALL( reduceCompactMatrix(cmr, matrix, rowNumNonzeros, columnNumNonzeros, rowData, columnData, rowHashtable,
+      columnHashtable, hashVector, queue, pqueueStart, pqueueEnd, queueMemory, reductions, maxNumReductions,
+      pnumReductions, pnumRowReductions, pnumColumnReductions, stats) );
+  }
+
+  return CMR_OKAY;
+}
+
 static
 CMR_ERROR decomposeBinarySeriesParallel(
   CMR* cmr,                         /**< \ref CMR environment. */
   CMR_CHRMAT* matrix,               /**< Sparse char matrix. */
+  CMR_SP_REDUCTION* script,         /**< Reductions to replay first (may be \c NULL). */
+  size_t numScript,                 /**< Number of reductions to replay. */
+  size_t* pnumReplayed,             /**< Pointer for storing the number of replayed reductions (may be \c NULL). */
   CMR_SP_REDUCTION* reductions,     /**< Array for storing the SP-reductions. Must have capacity at least number of
                                      **< rows + number of columns. */
   size_t maxNumReductions,          /**< Maximum number of SP-reductions. Stops when this would be exceeded. */
@@ -1599,6 +2985,7 @@ CMR_ERROR decomposeBinarySeriesParallel(
   CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a wheel-submatrix (may be \c NULL). */
   CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation. */
   CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
   double timeLimit                  /**< Time limit to impose. */
 )
@@ -1606,6 +2993,7 @@ CMR_ERROR decomposeBinarySeriesParallel(
   assert(cmr);
   assert(matrix);
   assert(reductions && pnumReductions);
+  assert(params);
 
   CMRdbgMsg(0, "decomposeBinarySeriesParallel for a %dx%d matrix with %d nonzeros; max #reductions: %zu; "
     "reduced submatrix: %s; wheel: %s; separation: %s; time limit: %f\n", matrix->numRows,
@@ -1617,14 +3005,6 @@ CMR_ERROR decomposeBinarySeriesParallel(
 
   size_t numRows = matrix->numRows;
   size_t numColumns = matrix->numColumns;
-  
-  /* Create list matrix to use numNonzeros. */
-  ListMat8* listmatrix = NULL;
-  CMR_CALL( CMRlistmat8Alloc(cmr, numRows, numColumns, matrix->numNonzeros, &listmatrix) );
-  for (size_t row = 0; row < numRows; ++row)
-    listmatrix->rowElements[row].numNonzeros = 0;
-  for (size_t column = 0; column < numColumns; ++column)
-    listmatrix->columnElements[column].numNonzeros = 0;
 
   /* Initialize element data and hash vector. */
   ElementData* rowData = NULL;
@@ -1632,11 +3012,31 @@ CMR_ERROR decomposeBinarySeriesParallel(
   ElementData* columnData = NULL;
   CMR_CALL( createElementData(cmr, &columnData, matrix->numColumns) );
   long long* hashVector = NULL;
-  CMR_CALL( createHashVector(cmr, &hashVector,
+  CMR_CALL( CMRfingerprintWeightsCreate(cmr, &hashVector,
     matrix->numRows > matrix->numColumns ? matrix->numRows : matrix->numColumns) );
 
+  size_t* rowNumNonzeros = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowNumNonzeros, numRows) );
+  size_t* columnNumNonzeros = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnNumNonzeros, numColumns) );
+
   /* Scan the matrix to initialize the element data. */
-  CMR_CALL( calcNonzeroCountHashFromMatrix(cmr, matrix, listmatrix, rowData, columnData, hashVector) );
+  CMR_CALL( calcNonzeroCountHashFromMatrix(cmr, matrix, rowNumNonzeros, columnNumNonzeros, rowData, columnData,
+    hashVector) );
+
+  /* Replay the given reductions as long as they are valid. */
+  *pnumReductions = 0;
+  size_t numRowReductions = 0;
+  size_t numColumnReductions = 0;
+  if (numScript > 0)
+  {
+    CMR_CALL( replayReductions(cmr, matrix, script, numScript, false, rowNumNonzeros, columnNumNonzeros, rowData,
+      columnData, hashVector, reductions, maxNumReductions, pnumReductions, &numRowReductions,
+      &numColumnReductions) );
+  }
+  size_t numReplayed = *pnumReductions;
+  if (pnumReplayed)
+    *pnumReplayed = numReplayed;
 
   /* Initialize the queue. */
   CMR_ELEMENT* queue = NULL;
@@ -1650,14 +3050,14 @@ CMR_ERROR decomposeBinarySeriesParallel(
   if (numRows > 0)
   {
     CMR_CALL( CMRlisthashtableCreate(cmr, &rowHashtable, nextPower2(numRows), numRows) );
-    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, rowHashtable, listmatrix->rowElements, rowData, numRows, queue,
+    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, rowHashtable, rowNumNonzeros, rowData, numRows, queue,
       &queueEnd, true) );
   }
   CMR_LISTHASHTABLE* columnHashtable = NULL;
   if (numColumns > 0)
   {
     CMR_CALL( CMRlisthashtableCreate(cmr, &columnHashtable, nextPower2(numColumns), numColumns) );
-    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, columnHashtable, listmatrix->columnElements, columnData,
+    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, columnHashtable, columnNumNonzeros, columnData,
       numColumns, queue, &queueEnd, false) );
   }
 
@@ -1667,18 +3067,13 @@ CMR_ERROR decomposeBinarySeriesParallel(
     stats->reduceTime += (clock() - time) * 1.0 / CLOCKS_PER_SEC;
   }
 
-  *pnumReductions = 0;
-  if (queueEnd > queueStart || (pviolatorSubmatrix && (numRows + numColumns > 0)))
+  if (queueEnd > queueStart || numReplayed > 0 || (pviolatorSubmatrix && (numRows + numColumns > 0)))
   {
-    /* Initialize list matrix representation. */
-    CMR_CALL( CMRlistmat8InitializeFromChrMatrix(cmr, listmatrix, matrix) );
-
     /* We now start main loop. */
-    size_t numRowReductions = 0;
-    size_t numColumnReductions = 0;
-    CMR_CALL( reduceListMatrix(cmr, listmatrix, rowData, columnData, rowHashtable, columnHashtable, hashVector,
-      queue, &queueStart, &queueEnd, queueMemory, reductions, maxNumReductions, pnumReductions, &numRowReductions,
-      &numColumnReductions) );
+    ListMat8* listmatrix = NULL;
+    CMR_CALL( reduceMatrix(cmr, matrix, rowNumNonzeros, columnNumNonzeros, rowData, columnData, rowHashtable,
+      columnHashtable, hashVector, queue, &queueStart, &queueEnd, queueMemory, reductions, maxNumReductions,
+      pnumReductions, &numRowReductions, &numColumnReductions, &listmatrix, params, stats) );
 
     clock_t now = clock();
     double remainingTime = timeLimit - (now - time) * 1.0 / CLOCKS_PER_SEC;
@@ -1688,10 +3083,12 @@ CMR_ERROR decomposeBinarySeriesParallel(
       CMR_CALL( CMRlisthashtableFree(cmr, &rowHashtable) );
 
       CMR_CALL( CMRfreeStackArray(cmr, &queue) );
+      CMR_CALL( CMRfreeStackArray(cmr, &columnNumNonzeros) );
+      CMR_CALL( CMRfreeStackArray(cmr, &rowNumNonzeros) );
       CMR_CALL( CMRfreeStackArray(cmr, &hashVector) );
       CMR_CALL( CMRfreeStackArray(cmr, &columnData) );
       CMR_CALL( CMRfreeStackArray(cmr, &rowData) );
-      
+
       CMR_CALL( CMRlistmat8Free(cmr, &listmatrix) );
       return CMR_ERROR_TIMEOUT;
     }
@@ -1703,7 +3100,7 @@ CMR_ERROR decomposeBinarySeriesParallel(
     if (preducedSubmatrix || ((pviolatorSubmatrix || pseparation) && (*pnumReductions != SIZE_MAX)
       && (*pnumReductions != (matrix->numRows + matrix->numColumns))))
     {
-      CMR_CALL( extractRemainingSubmatrix(cmr, matrix, numRowReductions, numColumnReductions, listmatrix,
+      CMR_CALL( extractRemainingSubmatrix(cmr, matrix, numRowReductions, numColumnReductions, rowData, columnData,
         &reducedSubmatrix) );
     }
     if (preducedSubmatrix)
@@ -1716,8 +3113,16 @@ CMR_ERROR decomposeBinarySeriesParallel(
       if (stats)
         wheelClock = clock();
 
+      if (!listmatrix)
+      {
+        CMR_CALL( createReducedListMatrix(cmr, matrix, reducedSubmatrix, rowNumNonzeros, rowData, columnData,
+          &listmatrix) );
+      }
+
+      bool usedBitset;
       CMR_CALL( extractWheelSubmatrix(cmr, listmatrix, rowData, columnData, queue, queueMemory,
-        numRows - numRowReductions, numColumns - numColumnReductions, pviolatorSubmatrix, pseparation) );
+        numRows - numRowReductions, numColumns - numColumnReductions, pviolatorSubmatrix, pseparation,
+        params->wheelSearch, &usedBitset) );
 
       if (pseparation && *pseparation)
       {
@@ -1730,7 +3135,12 @@ CMR_ERROR decomposeBinarySeriesParallel(
         assert((*pseparation)->type == CMR_SEPA_TYPE_TWO);
       }
 
-      if (stats)
+      if (stats && usedBitset)
+      {
+        stats->bitsetWheelCount++;
+        stats->bitsetWheelTime += (clock() - wheelClock) * 1.0 / CLOCKS_PER_SEC;
+      }
+      else if (stats)
       {
         stats->wheelCount++;
         stats->wheelTime += (clock() - wheelClock) * 1.0 / CLOCKS_PER_SEC;
@@ -1739,6 +3149,8 @@ CMR_ERROR decomposeBinarySeriesParallel(
 
     if (reducedSubmatrix && !preducedSubmatrix)
       CMR_CALL( CMRsubmatFree(cmr, &reducedSubmatrix) );
+
+    CMR_CALL( CMRlistmat8Free(cmr, &listmatrix) );
   }
   else
   {
@@ -1752,11 +3164,11 @@ CMR_ERROR decomposeBinarySeriesParallel(
   CMR_CALL( CMRlisthashtableFree(cmr, &rowHashtable) );
 
   CMR_CALL( CMRfreeStackArray(cmr, &queue) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnNumNonzeros) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowNumNonzeros) );
   CMR_CALL( CMRfreeStackArray(cmr, &hashVector) );
   CMR_CALL( CMRfreeStackArray(cmr, &columnData) );
   CMR_CALL( CMRfreeStackArray(cmr, &rowData) );
-  
-  CMR_CALL( CMRlistmat8Free(cmr, &listmatrix) );
 
   if (stats)
   {
@@ -1769,20 +3181,27 @@ CMR_ERROR decomposeBinarySeriesParallel(
 
 CMR_ERROR CMRspTestBinary(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSeriesParallel,
   CMR_SP_REDUCTION* reductions, size_t* pnumReductions, CMR_SUBMAT** preducedSubmatrix, CMR_SUBMAT** pviolatorSubmatrix,
-  CMR_SP_STATISTICS* stats, double timeLimit)
+  CMR_SP_PARAMS* params, CMR_SP_STATISTICS* stats, double timeLimit)
 {
   assert(cmr);
   assert(matrix);
   assert(reductions || !pnumReductions);
   assert(!reductions || pnumReductions);
 
+  CMR_SP_PARAMS defaultParams;
+  if (!params)
+  {
+    CMR_CALL( CMRspParamsInit(&defaultParams) );
+    params = &defaultParams;
+  }
+
   CMR_SP_REDUCTION* localReductions = NULL;
   size_t localNumReductions = 0;
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeBinarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, SIZE_MAX,
-    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, stats, timeLimit) );
+  CMR_CALL( decomposeBinarySeriesParallel(cmr, matrix, NULL, 0, NULL, reductions ? reductions : localReductions,
+    SIZE_MAX, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, params, stats, timeLimit) );
 
   if (reductions)
     *pnumReductions = localNumReductions;
@@ -1798,20 +3217,29 @@ CMR_ERROR CMRspTestBinary(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSeriesParallel,
 
 CMR_ERROR CMRspDecomposeBinary(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSeriesParallel,
   CMR_SP_REDUCTION* reductions, size_t maxNumReductions, size_t* pnumReductions, CMR_SUBMAT** preducedSubmatrix,
-  CMR_SUBMAT** pviolatorSubmatrix, CMR_SEPA** pseparation, CMR_SP_STATISTICS* stats, double timeLimit)
+  CMR_SUBMAT** pviolatorSubmatrix, CMR_SEPA** pseparation, CMR_SP_PARAMS* params, CMR_SP_STATISTICS* stats,
+  double timeLimit)
 {
   assert(cmr);
   assert(matrix);
   assert(reductions || !pnumReductions);
   assert(!reductions || pnumReductions);
 
+  CMR_SP_PARAMS defaultParams;
+  if (!params)
+  {
+    CMR_CALL( CMRspParamsInit(&defaultParams) );
+    params = &defaultParams;
+  }
+
   CMR_SP_REDUCTION* localReductions = NULL;
   size_t localNumReductions = 0;
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeBinarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, maxNumReductions,
-    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, stats, timeLimit) );
+  CMR_CALL( decomposeBinarySeriesParallel(cmr, matrix, NULL, 0, NULL, reductions ? reductions : localReductions,
+    maxNumReductions, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, params, stats,
+    timeLimit) );
 
   if (pisSeriesParallel)
     *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
@@ -1827,6 +3255,9 @@ static
 CMR_ERROR decomposeTernarySeriesParallel(
   CMR* cmr,                         /**< \ref CMR environment. */
   CMR_CHRMAT* matrix,               /**< Sparse char matrix. */
+  CMR_SP_REDUCTION* script,         /**< Reductions to replay first (may be \c NULL). */
+  size_t numScript,                 /**< Number of reductions to replay. */
+  size_t* pnumReplayed,             /**< Pointer for storing the number of replayed reductions (may be \c NULL). */
   CMR_SP_REDUCTION* reductions,     /**< Array for storing the SP-reductions. Must have capacity at least number of
                                      **< rows + number of columns. */
   size_t maxNumReductions,          /**< Maximum number of SP-reductions. Stops when this would be exceeded. */
@@ -1834,6 +3265,7 @@ CMR_ERROR decomposeTernarySeriesParallel(
   CMR_SUBMAT** preducedSubmatrix,   /**< Pointer for storing the SP-reduced submatrix (may be \c NULL). */
   CMR_SUBMAT** pviolatorSubmatrix,  /**< Pointer for storing a wheel-submatrix (may be \c NULL). */
   CMR_SEPA** pseparation,           /**< Pointer for storing a 2-separation (may be \c NULL). */
+  CMR_SP_PARAMS* params,            /**< Parameters for the computation. */
   CMR_SP_STATISTICS* stats,         /**< Pointer to statistics (may be \c NULL). */
   double timeLimit                  /**< Time limit to impose. */
 )
@@ -1841,6 +3273,7 @@ CMR_ERROR decomposeTernarySeriesParallel(
   assert(cmr);
   assert(matrix);
   assert(reductions && pnumReductions);
+  assert(params);
 
   CMRdbgMsg(0, "decomposeTernarySeriesParallel for a %dx%d matrix with %d nonzeros.\n", matrix->numRows,
     matrix->numColumns, matrix->numNonzeros);
@@ -1851,25 +3284,37 @@ CMR_ERROR decomposeTernarySeriesParallel(
   size_t numRows = matrix->numRows;
   size_t numColumns = matrix->numColumns;
 
-  /* Create list matrix to use numNonzeros. */
-  ListMat8* listmatrix = NULL;
-  CMR_CALL( CMRlistmat8Alloc(cmr, numRows, numColumns, matrix->numNonzeros, &listmatrix) );
-  for (size_t row = 0; row < numRows; ++row)
-    listmatrix->rowElements[row].numNonzeros = 0;
-  for (size_t column = 0; column < numColumns; ++column)
-    listmatrix->columnElements[column].numNonzeros = 0;
-
   /* Initialize element data and hash vector. */
   ElementData* rowData = NULL;
   CMR_CALL( createElementData(cmr, &rowData, matrix->numRows) );
   ElementData* columnData = NULL;
   CMR_CALL( createElementData(cmr, &columnData, matrix->numColumns) );
   long long* hashVector = NULL;
-  CMR_CALL( createHashVector(cmr, &hashVector,
+  CMR_CALL( CMRfingerprintWeightsCreate(cmr, &hashVector,
     matrix->numRows > matrix->numColumns ? matrix->numRows : matrix->numColumns) );
 
+  size_t* rowNumNonzeros = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowNumNonzeros, numRows) );
+  size_t* columnNumNonzeros = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnNumNonzeros, numColumns) );
+
   /* Scan the matrix to initialize the element data. */
-  CMR_CALL( calcNonzeroCountHashFromMatrix(cmr, matrix, listmatrix, rowData, columnData, hashVector) );
+  CMR_CALL( calcNonzeroCountHashFromMatrix(cmr, matrix, rowNumNonzeros, columnNumNonzeros, rowData, columnData,
+    hashVector) );
+
+  /* Replay the given reductions as long as they are valid. */
+  *pnumReductions = 0;
+  size_t numRowReductions = 0;
+  size_t numColumnReductions = 0;
+  if (numScript > 0)
+  {
+    CMR_CALL( replayReductions(cmr, matrix, script, numScript, true, rowNumNonzeros, columnNumNonzeros, rowData,
+      columnData, hashVector, reductions, maxNumReductions, pnumReductions, &numRowReductions,
+      &numColumnReductions) );
+  }
+  size_t numReplayed = *pnumReductions;
+  if (pnumReplayed)
+    *pnumReplayed = numReplayed;
 
   /* Initialize the queue. */
   CMR_ELEMENT* queue = NULL;
@@ -1883,27 +3328,24 @@ CMR_ERROR decomposeTernarySeriesParallel(
   if (numRows > 0)
   {
     CMR_CALL( CMRlisthashtableCreate(cmr, &rowHashtable, nextPower2(numRows), numRows) );
-    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, rowHashtable, listmatrix->rowElements, rowData, numRows, queue, &queueEnd, true) );
+    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, rowHashtable, rowNumNonzeros, rowData, numRows, queue,
+      &queueEnd, true) );
   }
   CMR_LISTHASHTABLE* columnHashtable = NULL;
   if (numColumns > 0)
   {
     CMR_CALL( CMRlisthashtableCreate(cmr, &columnHashtable, nextPower2(numColumns), numColumns) );
-    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, columnHashtable, listmatrix->columnElements, columnData, numColumns, queue, &queueEnd, false) );
+    CMR_CALL( initializeQueueHashtableFromMatrix(cmr, columnHashtable, columnNumNonzeros, columnData, numColumns,
+      queue, &queueEnd, false) );
   }
 
-  *pnumReductions = 0;
-  if (queueEnd > queueStart || (pviolatorSubmatrix && (numRows + numColumns > 0)))
+  if (queueEnd > queueStart || numReplayed > 0 || (pviolatorSubmatrix && (numRows + numColumns > 0)))
   {
-    /* Create list matrix representation. */
-    CMR_CALL( CMRlistmat8InitializeFromChrMatrix(cmr, listmatrix, matrix) );
-
     /* We now start main loop. */
-    size_t numRowReductions = 0;
-    size_t numColumnReductions = 0;
-    CMR_CALL( reduceListMatrix(cmr, listmatrix, rowData, columnData, rowHashtable, columnHashtable, hashVector, queue,
-      &queueStart, &queueEnd, queueMemory, reductions, maxNumReductions, pnumReductions, &numRowReductions,
-      &numColumnReductions) );
+    ListMat8* listmatrix = NULL;
+    CMR_CALL( reduceMatrix(cmr, matrix, rowNumNonzeros, columnNumNonzeros, rowData, columnData, rowHashtable,
+      columnHashtable, hashVector, queue, &queueStart, &queueEnd, queueMemory, reductions, maxNumReductions,
+      pnumReductions, &numRowReductions, &numColumnReductions, &listmatrix, params, stats) );
 
     clock_t now = clock();
     double remainingTime = timeLimit - (now - time) * 1.0 / CLOCKS_PER_SEC;
@@ -1920,6 +3362,8 @@ CMR_ERROR decomposeTernarySeriesParallel(
       CMR_CALL( CMRlisthashtableFree(cmr, &rowHashtable) );
 
       CMR_CALL( CMRfreeStackArray(cmr, &queue) );
+      CMR_CALL( CMRfreeStackArray(cmr, &columnNumNonzeros) );
+      CMR_CALL( CMRfreeStackArray(cmr, &rowNumNonzeros) );
       CMR_CALL( CMRfreeStackArray(cmr, &hashVector) );
       CMR_CALL( CMRfreeStackArray(cmr, &columnData) );
       CMR_CALL( CMRfreeStackArray(cmr, &rowData) );
@@ -1933,7 +3377,7 @@ CMR_ERROR decomposeTernarySeriesParallel(
     if (preducedSubmatrix || ((pviolatorSubmatrix || pseparation) && (*pnumReductions != SIZE_MAX)
       && (*pnumReductions != (matrix->numRows + matrix->numColumns))))
     {
-      CMR_CALL( extractRemainingSubmatrix(cmr, matrix, numRowReductions, numColumnReductions, listmatrix,
+      CMR_CALL( extractRemainingSubmatrix(cmr, matrix, numRowReductions, numColumnReductions, rowData, columnData,
         &reducedSubmatrix) );
     }
     if (preducedSubmatrix)
@@ -1946,6 +3390,12 @@ CMR_ERROR decomposeTernarySeriesParallel(
       if (stats)
         nonbinaryClock = clock();
 
+      if (!listmatrix)
+      {
+        CMR_CALL( createReducedListMatrix(cmr, matrix, reducedSubmatrix, rowNumNonzeros, rowData, columnData,
+          &listmatrix) );
+      }
+
       CMR_CALL( calcBinaryHashFromListMatrix(cmr, listmatrix, rowData, columnData, hashVector) );
 
       queueStart = 0;
@@ -1982,8 +3432,10 @@ CMR_ERROR decomposeTernarySeriesParallel(
         if (stats)
           wheelClock = clock();
 
+        bool usedBitset;
         CMR_CALL( extractWheelSubmatrix(cmr, listmatrix, rowData, columnData, queue, queueMemory,
-          numRows - numRowReductions, numColumns - numColumnReductions, &violatorSubmatrix, pseparation) );
+          numRows - numRowReductions, numColumns - numColumnReductions, &violatorSubmatrix, pseparation,
+          params->wheelSearch, &usedBitset) );
 
         if (pseparation && *pseparation)
         {
@@ -2012,7 +3464,12 @@ CMR_ERROR decomposeTernarySeriesParallel(
         if (violatorSubmatrix && pviolatorSubmatrix)
           *pviolatorSubmatrix = violatorSubmatrix;
 
-        if (stats)
+        if (stats && usedBitset)
+        {
+          stats->bitsetWheelCount++;
+          stats->bitsetWheelTime += (clock() - wheelClock) * 1.0 / CLOCKS_PER_SEC;
+        }
+        else if (stats)
         {
           stats->wheelCount++;
           stats->wheelTime += (clock() - wheelClock) * 1.0 / CLOCKS_PER_SEC;
@@ -2028,6 +3485,8 @@ CMR_ERROR decomposeTernarySeriesParallel(
 
     if (reducedSubmatrix && !preducedSubmatrix)
       CMR_CALL( CMRsubmatFree(cmr, &reducedSubmatrix) );
+
+    CMR_CALL( CMRlistmat8Free(cmr, &listmatrix) );
   }
   else
   {
@@ -2041,12 +3500,12 @@ CMR_ERROR decomposeTernarySeriesParallel(
   CMR_CALL( CMRlisthashtableFree(cmr, &rowHashtable) );
 
   CMR_CALL( CMRfreeStackArray(cmr, &queue) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnNumNonzeros) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowNumNonzeros) );
   CMR_CALL( CMRfreeStackArray(cmr, &hashVector) );
   CMR_CALL( CMRfreeStackArray(cmr, &columnData) );
   CMR_CALL( CMRfreeStackArray(cmr, &rowData) );
 
-  CMR_CALL( CMRlistmat8Free(cmr, &listmatrix) );
-
   if (stats)
   {
     stats->totalCount++;
@@ -2058,20 +3517,27 @@ CMR_ERROR decomposeTernarySeriesParallel(
 
 CMR_ERROR CMRspTestTernary(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSeriesParallel,
   CMR_SP_REDUCTION* reductions, size_t* pnumReductions, CMR_SUBMAT** preducedSubmatrix, CMR_SUBMAT** pviolatorSubmatrix,
-  CMR_SP_STATISTICS* stats, double timeLimit)
+  CMR_SP_PARAMS* params, CMR_SP_STATISTICS* stats, double timeLimit)
 {
   assert(cmr);
   assert(matrix);
   assert(reductions || !pnumReductions);
   assert(!reductions || pnumReductions);
 
+  CMR_SP_PARAMS defaultParams;
+  if (!params)
+  {
+    CMR_CALL( CMRspParamsInit(&defaultParams) );
+    params = &defaultParams;
+  }
+
   CMR_SP_REDUCTION* localReductions = NULL;
   size_t localNumReductions = 0;
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeTernarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions, SIZE_MAX,
-    &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, stats, timeLimit) );
+  CMR_CALL( decomposeTernarySeriesParallel(cmr, matrix, NULL, 0, NULL, reductions ? reductions : localReductions,
+    SIZE_MAX, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, NULL, params, stats, timeLimit) );
 
   if (pisSeriesParallel)
     *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
@@ -2085,24 +3551,107 @@ CMR_ERROR CMRspTestTernary(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSeriesParallel
 
 CMR_ERROR CMRspDecomposeTernary(CMR* cmr, CMR_CHRMAT* matrix, bool* pisSeriesParallel,
   CMR_SP_REDUCTION* reductions, size_t maxNumReductions, size_t* pnumReductions, CMR_SUBMAT** preducedSubmatrix,
-  CMR_SUBMAT** pviolatorSubmatrix, CMR_SEPA** pseparation, CMR_SP_STATISTICS* stats, double timeLimit)
+  CMR_SUBMAT** pviolatorSubmatrix, CMR_SEPA** pseparation, CMR_SP_PARAMS* params, CMR_SP_STATISTICS* stats,
+  double timeLimit)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(reductions || !pnumReductions);
+  assert(!reductions || pnumReductions);
+
+  CMR_SP_PARAMS defaultParams;
+  if (!params)
+  {
+    CMR_CALL( CMRspParamsInit(&defaultParams) );
+    params = &defaultParams;
+  }
+
+  CMR_SP_REDUCTION* localReductions = NULL;
+  size_t localNumReductions = 0;
+  if (!reductions)
+    CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
+
+  CMR_CALL( decomposeTernarySeriesParallel(cmr, matrix, NULL, 0, NULL, reductions ? reductions : localReductions,
+    maxNumReductions, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, params, stats,
+    timeLimit) );
+
+  if (pisSeriesParallel)
+    *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
+
+  if (reductions)
+    *pnumReductions = localNumReductions;
+  else
+    CMR_CALL( CMRfreeStackArray(cmr, &localReductions) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRspReplayBinary(CMR* cmr, CMR_CHRMAT* matrix, CMR_SP_REDUCTION* script, size_t numScript,
+  size_t* pnumReplayed, bool* pisSeriesParallel, CMR_SP_REDUCTION* reductions, size_t maxNumReductions,
+  size_t* pnumReductions, CMR_SUBMAT** preducedSubmatrix, CMR_SUBMAT** pviolatorSubmatrix, CMR_SEPA** pseparation,
+  CMR_SP_PARAMS* params, CMR_SP_STATISTICS* stats, double timeLimit)
 {
   assert(cmr);
   assert(matrix);
+  assert(script || numScript == 0);
   assert(reductions || !pnumReductions);
   assert(!reductions || pnumReductions);
 
+  CMR_SP_PARAMS defaultParams;
+  if (!params)
+  {
+    CMR_CALL( CMRspParamsInit(&defaultParams) );
+    params = &defaultParams;
+  }
+
   CMR_SP_REDUCTION* localReductions = NULL;
   size_t localNumReductions = 0;
   if (!reductions)
     CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
 
-  CMR_CALL( decomposeTernarySeriesParallel(cmr, matrix, reductions ? reductions : localReductions,
-    maxNumReductions, &localNumReductions, preducedSubmatrix, pviolatorSubmatrix, pseparation, stats, timeLimit) );
+  CMR_CALL( decomposeBinarySeriesParallel(cmr, matrix, script, numScript, pnumReplayed,
+    reductions ? reductions : localReductions, maxNumReductions, &localNumReductions, preducedSubmatrix,
+    pviolatorSubmatrix, pseparation, params, stats, timeLimit) );
 
   if (pisSeriesParallel)
     *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
+  if (reductions)
+    *pnumReductions = localNumReductions;
+  else
+    CMR_CALL( CMRfreeStackArray(cmr, &localReductions) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRspReplayTernary(CMR* cmr, CMR_CHRMAT* matrix, CMR_SP_REDUCTION* script, size_t numScript,
+  size_t* pnumReplayed, bool* pisSeriesParallel, CMR_SP_REDUCTION* reductions, size_t maxNumReductions,
+  size_t* pnumReductions, CMR_SUBMAT** preducedSubmatrix, CMR_SUBMAT** pviolatorSubmatrix, CMR_SEPA** pseparation,
+  CMR_SP_PARAMS* params, CMR_SP_STATISTICS* stats, double timeLimit)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(script || numScript == 0);
+  assert(reductions || !pnumReductions);
+  assert(!reductions || pnumReductions);
+
+  CMR_SP_PARAMS defaultParams;
+  if (!params)
+  {
+    CMR_CALL( CMRspParamsInit(&defaultParams) );
+    params = &defaultParams;
+  }
 
+  CMR_SP_REDUCTION* localReductions = NULL;
+  size_t localNumReductions = 0;
+  if (!reductions)
+    CMR_CALL( CMRallocStackArray(cmr, &localReductions, matrix->numRows + matrix->numColumns) );
+
+  CMR_CALL( decomposeTernarySeriesParallel(cmr, matrix, script, numScript, pnumReplayed,
+    reductions ? reductions : localReductions, maxNumReductions, &localNumReductions, preducedSubmatrix,
+    pviolatorSubmatrix, pseparation, params, stats, timeLimit) );
+
+  if (pisSeriesParallel)
+    *pisSeriesParallel = (localNumReductions == matrix->numRows + matrix->numColumns);
   if (reductions)
     *pnumReductions = localNumReductions;
   else
@@ -7,8 +7,11 @@
 #include "seymour_internal.h"
 #include "matrix_internal.h"
 #include "listmatrix.h"
+#include "sort.h"
 
 #include <assert.h>
+#include <limits.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
 
@@ -29,10 +32,176 @@ CMR_ERROR CMRseymourParamsInit(CMR_SEYMOUR_PARAMS* params)
     | CMR_SEYMOUR_DECOMPOSE_FLAG_CONCENTRATED_THREESUM;
   params->constructLeafGraphs = false;
   params->constructAllGraphs = false;
+  params->schedule = CMR_SEYMOUR_SCHEDULE_LIFO;
+  params->lowMemory = false;
+  CMRspParamsInit(&params->seriesParallelParams);
+  params->trace = NULL;
 
   return CMR_OKAY;
 }
 
+/**
+ * \brief Returns the wall clock time in microseconds.
+ */
+
+static
+double traceTime(void)
+{
+  return CMRwallClock() * 1.0e6;
+}
+
+CMR_ERROR CMRseymourTraceCreate(CMR* cmr, FILE* stream, CMR_SEYMOUR_TRACE** ptrace)
+{
+  assert(cmr);
+  assert(stream);
+  assert(ptrace);
+
+  CMR_CALL( CMRallocBlock(cmr, ptrace) );
+  CMR_SEYMOUR_TRACE* trace = *ptrace;
+  trace->stream = stream;
+  trace->startTime = traceTime();
+  trace->numEvents = 0;
+  trace->numNodes = 0;
+#if defined(CMR_WITH_THREADS)
+  if (pthread_mutex_init(&trace->mutex, NULL))
+  {
+    CMR_CALL( CMRfreeBlock(cmr, ptrace) );
+    return CMR_ERROR_MEMORY;
+  }
+#endif /* CMR_WITH_THREADS */
+
+  fputs("[", stream);
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRseymourTraceFree(CMR* cmr, CMR_SEYMOUR_TRACE** ptrace)
+{
+  assert(cmr);
+  assert(ptrace);
+
+  CMR_SEYMOUR_TRACE* trace = *ptrace;
+  if (!trace)
+    return CMR_OKAY;
+
+  fputs("\n]\n", trace->stream);
+  fflush(trace->stream);
+#if defined(CMR_WITH_THREADS)
+  pthread_mutex_destroy(&trace->mutex);
+#endif /* CMR_WITH_THREADS */
+
+  CMR_CALL( CMRfreeBlock(cmr, ptrace) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Returns the identifier of \p node in traces, assigning a new one if necessary.
+ *
+ * The caller must hold the mutex of \p trace.
+ */
+
+static
+size_t traceNodeId(
+  CMR_SEYMOUR_TRACE* trace, /**< Trace. */
+  CMR_SEYMOUR_NODE* node    /**< Seymour decomposition node. */
+)
+{
+  assert(trace);
+  assert(node);
+
+  if (!node->traceId)
+    node->traceId = ++trace->numNodes;
+
+  return node->traceId;
+}
+
+/**
+ * \brief Returns a short name of the type of \p node for traces.
+ */
+
+static
+const char* traceNodeType(
+  CMR_SEYMOUR_NODE* node  /**< Seymour decomposition node. */
+)
+{
+  assert(node);
+
+  switch (node->type)
+  {
+  case CMR_SEYMOUR_NODE_TYPE_IRREGULAR:
+    return "irregular";
+  case CMR_SEYMOUR_NODE_TYPE_UNKNOWN:
+    return "unknown";
+  case CMR_SEYMOUR_NODE_TYPE_ONESUM:
+    return "1-sum";
+  case CMR_SEYMOUR_NODE_TYPE_TWOSUM:
+    return "2-sum";
+  case CMR_SEYMOUR_NODE_TYPE_DELTASUM:
+    return "delta-sum";
+  case CMR_SEYMOUR_NODE_TYPE_THREESUM:
+    return "3-sum";
+  case CMR_SEYMOUR_NODE_TYPE_YSUM:
+    return "Y-sum";
+  case CMR_SEYMOUR_NODE_TYPE_GRAPH:
+    return "graphic";
+  case CMR_SEYMOUR_NODE_TYPE_COGRAPH:
+    return "cographic";
+  case CMR_SEYMOUR_NODE_TYPE_PLANAR:
+    return "planar";
+  case CMR_SEYMOUR_NODE_TYPE_SERIES_PARALLEL:
+    return "series-parallel";
+  case CMR_SEYMOUR_NODE_TYPE_R10:
+    return "R10";
+  case CMR_SEYMOUR_NODE_TYPE_PIVOTS:
+    return "pivots";
+  default:
+    return "invalid";
+  }
+}
+
+/**
+ * \brief Writes a complete event for a span from \p startTime until now to \p trace.
+ *
+ * The thread identifier of the event is the worker index of \p cmr plus 1, such that spans of different workers appear
+ * on different tracks.
+ */
+
+static
+void traceWriteSpan(
+  CMR* cmr,                 /**< \ref CMR environment that processed the node. */
+  CMR_SEYMOUR_TRACE* trace, /**< Trace. */
+  const char* name,         /**< Name of the span. */
+  double startTime,         /**< Wall clock time in microseconds at the start of the span. */
+  CMR_SEYMOUR_NODE* node,   /**< Processed node. */
+  size_t startMemory,       /**< Block memory at the start of the span. */
+  size_t endMemory,         /**< Block memory at the end of the span. */
+  size_t peakMemory,        /**< Peak block memory during the span. */
+  const char* outcome       /**< Outcome of the span. */
+)
+{
+  assert(trace);
+  assert(name);
+  assert(node);
+  assert(outcome);
+
+  double endTime = traceTime();
+#if defined(CMR_WITH_THREADS)
+  pthread_mutex_lock(&trace->mutex);
+#endif /* CMR_WITH_THREADS */
+  fprintf(trace->stream, "%s\n{\"name\": \"%s\", \"cat\": \"seymour\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+    "\"pid\": 1, \"tid\": %zu, \"args\": {\"node\": %zu, \"rows\": %zu, \"columns\": %zu, \"ternary\": %s, "
+    "\"bytes\": %s%zu, \"peakBytes\": %zu, \"outcome\": \"%s\"}}", trace->numEvents ? "," : "", name,
+    startTime - trace->startTime, endTime - startTime, cmr->workerIndex + 1, traceNodeId(trace, node), node->numRows,
+    node->numColumns, node->isTernary ? "true" : "false", endMemory < startMemory ? "-" : "",
+    endMemory < startMemory ? startMemory - endMemory : endMemory - startMemory,
+    peakMemory > startMemory ? peakMemory - startMemory : 0, outcome);
+  trace->numEvents++;
+#if defined(CMR_WITH_THREADS)
+  pthread_mutex_unlock(&trace->mutex);
+#endif /* CMR_WITH_THREADS */
+}
+
 CMR_ERROR CMRseymourStatsInit(CMR_SEYMOUR_STATS* stats)
 {
   assert(stats);
@@ -52,6 +221,38 @@ CMR_ERROR CMRseymourStatsInit(CMR_SEYMOUR_STATS* stats)
   stats->simpleThreeSeparationsCount = 0;
   stats->simpleThreeSeparationsSuccess = 0;
   stats->simpleThreeSeparationsTime = 0.0;
+  stats->peakBytes = 0;
+  stats->retainedBytes = 0;
+  stats->peakStackBytes = 0;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRseymourStatsAdd(CMR_SEYMOUR_STATS* target, CMR_SEYMOUR_STATS* source)
+{
+  assert(target);
+  assert(source);
+
+  target->totalCount += source->totalCount;
+  target->totalTime += source->totalTime;
+  CMR_CALL( CMRspStatsAdd(&target->seriesParallel, &source->seriesParallel) );
+  CMR_CALL( CMRgraphicStatsAdd(&target->graphic, &source->graphic) );
+  CMR_CALL( CMRnetworkStatsAdd(&target->network, &source->network) );
+  target->sequenceExtensionCount += source->sequenceExtensionCount;
+  target->sequenceExtensionTime += source->sequenceExtensionTime;
+  target->sequenceGraphicCount += source->sequenceGraphicCount;
+  target->sequenceGraphicTime += source->sequenceGraphicTime;
+  target->enumerationCount += source->enumerationCount;
+  target->enumerationTime += source->enumerationTime;
+  target->enumerationCandidatesCount += source->enumerationCandidatesCount;
+  target->simpleThreeSeparationsCount += source->simpleThreeSeparationsCount;
+  target->simpleThreeSeparationsSuccess += source->simpleThreeSeparationsSuccess;
+  target->simpleThreeSeparationsTime += source->simpleThreeSeparationsTime;
+  if (source->peakBytes > target->peakBytes)
+    target->peakBytes = source->peakBytes;
+  target->retainedBytes += source->retainedBytes;
+  if (source->peakStackBytes > target->peakStackBytes)
+    target->peakStackBytes = source->peakStackBytes;
 
   return CMR_OKAY;
 }
@@ -87,6 +288,8 @@ CMR_ERROR CMRseymourStatsPrint(FILE* stream, CMR_SEYMOUR_STATS* stats, const cha
   fprintf(stream, "%senum 3-separation candidates: %lu (%.1fk per second)\n", prefix,
     (unsigned long)stats->enumerationCandidatesCount,
     stats->enumerationTime > 0.0 ? (stats->enumerationCandidatesCount / 1000.0 / stats->enumerationTime) : 0.0);
+  fprintf(stream, "%smemory: %lu bytes peak, %lu bytes retained, %lu stack bytes peak\n", prefix,
+    (unsigned long)stats->peakBytes, (unsigned long)stats->retainedBytes, (unsigned long)stats->peakStackBytes);
   fprintf(stream, "%stotal: %lu in %f seconds\n", prefix, (unsigned long)stats->totalCount, stats->totalTime);
 
   return CMR_OKAY;
@@ -809,6 +1012,8 @@ CMR_ERROR createNode(
 
   node->testedSimpleThreeSeparations = false;
 
+  node->traceId = 0;
+
   return CMR_OKAY;
 }
 
@@ -826,6 +1031,165 @@ CMR_ERROR CMRseymourCloneUnknown(CMR* cmr, CMR_SEYMOUR_NODE* node, CMR_SEYMOUR_N
   return CMR_OKAY;
 }
 
+/**
+ * \brief Determines the numbers of special rows and columns of child \p childIndex of \p node, which depend on the type
+ *        of 3-sum.
+ */
+
+static
+void countChildSpecialElements(
+  CMR_SEYMOUR_NODE* node,     /**< Seymour decomposition node. */
+  size_t childIndex,          /**< Child index. */
+  size_t* pnumSpecialRows,    /**< Pointer for storing the number of special rows. */
+  size_t* pnumSpecialColumns  /**< Pointer for storing the number of special columns. */
+)
+{
+  assert(node);
+  assert(childIndex < node->numChildren);
+  assert(pnumSpecialRows);
+  assert(pnumSpecialColumns);
+
+  *pnumSpecialRows = 0;
+  *pnumSpecialColumns = 0;
+  if (node->childSpecialRows[childIndex])
+  {
+    if (node->type == CMR_SEYMOUR_NODE_TYPE_DELTASUM)
+      *pnumSpecialRows = 1;
+    else if (node->type == CMR_SEYMOUR_NODE_TYPE_YSUM || node->type == CMR_SEYMOUR_NODE_TYPE_THREESUM)
+      *pnumSpecialRows = 2 + (node->type == CMR_SEYMOUR_NODE_TYPE_THREESUM && childIndex == 1 ? 1 : 0);
+  }
+  if (node->childSpecialColumns[childIndex])
+  {
+    if (node->type == CMR_SEYMOUR_NODE_TYPE_YSUM)
+      *pnumSpecialColumns = 1;
+    else if (node->type == CMR_SEYMOUR_NODE_TYPE_DELTASUM || node->type == CMR_SEYMOUR_NODE_TYPE_THREESUM)
+      *pnumSpecialColumns = 2 + (node->type == CMR_SEYMOUR_NODE_TYPE_THREESUM && childIndex == 0 ? 1 : 0);
+  }
+}
+
+CMR_ERROR CMRseymourCloneShallow(CMR* cmr, CMR_SEYMOUR_NODE* node, CMR_SEYMOUR_NODE** pclone)
+{
+  assert(cmr);
+  assert(node);
+  assert(pclone);
+
+  CMR_CALL( createNode(cmr, pclone, node->isTernary, node->type, node->numRows, node->numColumns) );
+  CMR_SEYMOUR_NODE* clone = *pclone;
+  clone->testedTwoConnected = node->testedTwoConnected;
+  clone->testedR10 = node->testedR10;
+  clone->testedSeriesParallel = node->testedSeriesParallel;
+  clone->searchedForWheel = node->searchedForWheel;
+  clone->testedSimpleThreeSeparations = node->testedSimpleThreeSeparations;
+  clone->regularity = node->regularity;
+  clone->graphicness = node->graphicness;
+  clone->cographicness = node->cographicness;
+  clone->threesumFlags = node->threesumFlags;
+
+  if (node->matrix)
+    CMR_CALL( CMRchrmatCopy(cmr, node->matrix, &clone->matrix) );
+  if (node->transpose)
+    CMR_CALL( CMRchrmatCopy(cmr, node->transpose, &clone->transpose) );
+
+  /* The children are shared, while the maps belong to the clone. */
+  if (node->numChildren)
+    CMR_CALL( CMRseymourSetNumChildren(cmr, clone, node->numChildren) );
+  for (size_t c = 0; c < node->numChildren; ++c)
+  {
+    CMR_SEYMOUR_NODE* child = node->children[c];
+    CMR_CALL( CMRseymourCapture(cmr, child) );
+    clone->children[c] = child;
+    if (node->childRowsToParent[c])
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->childRowsToParent[c], child->numRows,
+        node->childRowsToParent[c]) );
+    }
+    if (node->childColumnsToParent[c])
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->childColumnsToParent[c], child->numColumns,
+        node->childColumnsToParent[c]) );
+    }
+    size_t numSpecialRows, numSpecialColumns;
+    countChildSpecialElements(node, c, &numSpecialRows, &numSpecialColumns);
+    if (numSpecialRows)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->childSpecialRows[c], numSpecialRows,
+        node->childSpecialRows[c]) );
+    }
+    if (numSpecialColumns)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->childSpecialColumns[c], numSpecialColumns,
+        node->childSpecialColumns[c]) );
+    }
+  }
+  for (size_t row = 0; row < node->numRows; ++row)
+    clone->rowsToChild[row] = node->rowsToChild[row];
+  for (size_t column = 0; column < node->numColumns; ++column)
+    clone->columnsToChild[column] = node->columnsToChild[column];
+
+  for (size_t m = 0; m < node->numMinors; ++m)
+  {
+    CMR_MINOR* minor = node->minors[m];
+    CMR_MINOR* cloneMinor = NULL;
+    CMR_CALL( CMRminorCreate(cmr, &cloneMinor, minor->numPivots, NULL, minor->type) );
+    CMR_CALL( CMRseymourAddMinor(cmr, clone, cloneMinor) );
+    for (size_t p = 0; p < minor->numPivots; ++p)
+    {
+      cloneMinor->pivotRows[p] = minor->pivotRows[p];
+      cloneMinor->pivotColumns[p] = minor->pivotColumns[p];
+    }
+    CMR_SUBMAT* submatrix = minor->remainingSubmatrix;
+    if (submatrix)
+    {
+      CMR_CALL( CMRsubmatCreate(cmr, submatrix->numRows, submatrix->numColumns, &cloneMinor->remainingSubmatrix) );
+      for (size_t row = 0; row < submatrix->numRows; ++row)
+        cloneMinor->remainingSubmatrix->rows[row] = submatrix->rows[row];
+      for (size_t column = 0; column < submatrix->numColumns; ++column)
+        cloneMinor->remainingSubmatrix->columns[column] = submatrix->columns[column];
+    }
+  }
+
+  if (node->graph)
+  {
+    CMR_CALL( CMRgraphCopy(cmr, node->graph, &clone->graph) );
+    if (node->graphForest)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->graphForest, CMRseymourGraphSizeForest(node),
+        node->graphForest) );
+    }
+    if (node->graphCoforest)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->graphCoforest, CMRseymourGraphSizeCoforest(node),
+        node->graphCoforest) );
+    }
+    if (node->graphArcsReversed)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->graphArcsReversed, CMRgraphMemEdges(node->graph),
+        node->graphArcsReversed) );
+    }
+  }
+  if (node->cograph)
+  {
+    CMR_CALL( CMRgraphCopy(cmr, node->cograph, &clone->cograph) );
+    if (node->cographForest)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->cographForest, CMRseymourCographSizeForest(node),
+        node->cographForest) );
+    }
+    if (node->cographCoforest)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->cographCoforest, CMRseymourCographSizeCoforest(node),
+        node->cographCoforest) );
+    }
+    if (node->cographArcsReversed)
+    {
+      CMR_CALL( CMRduplicateBlockArray(cmr, &clone->cographArcsReversed, CMRgraphMemEdges(node->cograph),
+        node->cographArcsReversed) );
+    }
+  }
+
+  return CMR_OKAY;
+}
+
 /**
  * \brief Allocates and sets childRowsToParent and childColumnsToParent of the child of \p parent indicated by
  *        \p childIndex.
@@ -1002,6 +1366,151 @@ CMR_MINOR* CMRseymourMinor(CMR_SEYMOUR_NODE* node, size_t minorIndex)
   return node->minors[minorIndex];
 }
 
+/**
+ * \brief Maps a violating submatrix of a child to its parent if the submatrix appears there unchanged.
+ *
+ * Sets \p *pparentViolator to \c NULL if some row (resp. column) is not mapped to a parent row (resp. column) or if
+ * some entry differs.
+ */
+
+static
+CMR_ERROR mapViolatorToParent(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* node,         /**< Seymour decomposition node. */
+  size_t childIndex,              /**< Index of child. */
+  CMR_SUBMAT* childViolator,      /**< Violating submatrix of the child. */
+  CMR_SUBMAT** pparentViolator    /**< Pointer for storing the violating submatrix of \p node. */
+)
+{
+  assert(cmr);
+  assert(node);
+  assert(childViolator);
+  assert(pparentViolator);
+
+  CMR_SEYMOUR_NODE* child = node->children[childIndex];
+  CMR_ELEMENT* rowsToParent = node->childRowsToParent[childIndex];
+  CMR_ELEMENT* columnsToParent = node->childColumnsToParent[childIndex];
+  *pparentViolator = NULL;
+  if (!child->matrix || !node->matrix || !rowsToParent || !columnsToParent)
+    return CMR_OKAY;
+
+  for (size_t r = 0; r < childViolator->numRows; ++r)
+  {
+    if (!CMRelementIsRow(rowsToParent[childViolator->rows[r]]))
+      return CMR_OKAY;
+  }
+  for (size_t c = 0; c < childViolator->numColumns; ++c)
+  {
+    if (!CMRelementIsColumn(columnsToParent[childViolator->columns[c]]))
+      return CMR_OKAY;
+  }
+
+  for (size_t r = 0; r < childViolator->numRows; ++r)
+  {
+    size_t childRow = childViolator->rows[r];
+    size_t parentRow = CMRelementToRowIndex(rowsToParent[childRow]);
+    for (size_t c = 0; c < childViolator->numColumns; ++c)
+    {
+      size_t childColumn = childViolator->columns[c];
+      size_t parentColumn = CMRelementToColumnIndex(columnsToParent[childColumn]);
+      size_t childEntry, parentEntry;
+      CMR_CALL( CMRchrmatFindEntry(child->matrix, childRow, childColumn, &childEntry) );
+      CMR_CALL( CMRchrmatFindEntry(node->matrix, parentRow, parentColumn, &parentEntry) );
+      char childValue = childEntry < SIZE_MAX ? child->matrix->entryValues[childEntry] : 0;
+      char parentValue = parentEntry < SIZE_MAX ? node->matrix->entryValues[parentEntry] : 0;
+      if (childValue != parentValue)
+      {
+        CMRdbgMsg(2, "Violator of child %zu differs from parent at r%zu,c%zu.\n", childIndex, parentRow + 1,
+          parentColumn + 1);
+        return CMR_OKAY;
+      }
+    }
+  }
+
+  CMR_CALL( CMRsubmatCreate(cmr, childViolator->numRows, childViolator->numColumns, pparentViolator) );
+  CMR_SUBMAT* parentViolator = *pparentViolator;
+  for (size_t r = 0; r < childViolator->numRows; ++r)
+    parentViolator->rows[r] = CMRelementToRowIndex(rowsToParent[childViolator->rows[r]]);
+  for (size_t c = 0; c < childViolator->numColumns; ++c)
+    parentViolator->columns[c] = CMRelementToColumnIndex(columnsToParent[childViolator->columns[c]]);
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Recursive function for \ref CMRseymourExtractViolator.
+ */
+
+static
+CMR_ERROR extractViolator(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* node, /**< Seymour decomposition node. */
+  CMR_SUBMAT** pviolator  /**< Pointer for storing the violating submatrix of the matrix of \p node. */
+)
+{
+  assert(cmr);
+  assert(node);
+  assert(pviolator);
+
+  *pviolator = NULL;
+  if (node->regularity > 0)
+    return CMR_OKAY;
+
+  for (size_t m = 0; m < node->numMinors; ++m)
+  {
+    CMR_MINOR* minor = node->minors[m];
+    if (minor->numPivots == 0 && minor->remainingSubmatrix
+      && (minor->type == CMR_MINOR_TYPE_DETERMINANT || minor->type == CMR_MINOR_TYPE_ENTRY))
+    {
+      CMR_SUBMAT* violator = minor->remainingSubmatrix;
+      CMRdbgMsg(2, "Found %zux%zu violator at node of type %d.\n", violator->numRows, violator->numColumns,
+        node->type);
+      CMR_CALL( CMRsubmatCreate(cmr, violator->numRows, violator->numColumns, pviolator) );
+      for (size_t r = 0; r < violator->numRows; ++r)
+        (*pviolator)->rows[r] = violator->rows[r];
+      for (size_t c = 0; c < violator->numColumns; ++c)
+        (*pviolator)->columns[c] = violator->columns[c];
+      return CMR_OKAY;
+    }
+  }
+
+  for (size_t childIndex = 0; childIndex < node->numChildren; ++childIndex)
+  {
+    if (!node->children[childIndex])
+      continue;
+
+    CMR_SUBMAT* childViolator = NULL;
+    CMR_CALL( extractViolator(cmr, node->children[childIndex], &childViolator) );
+    if (!childViolator)
+      continue;
+
+    CMR_CALL( mapViolatorToParent(cmr, node, childIndex, childViolator, pviolator) );
+    CMR_CALL( CMRsubmatFree(cmr, &childViolator) );
+    if (*pviolator)
+      return CMR_OKAY;
+  }
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRseymourExtractViolator(CMR* cmr, CMR_SEYMOUR_NODE* node, CMR_SUBMAT** pviolator)
+{
+  assert(cmr);
+  assert(node);
+  assert(pviolator);
+
+  CMR_CALL( extractViolator(cmr, node, pviolator) );
+
+  CMR_SUBMAT* violator = *pviolator;
+  if (violator)
+  {
+    CMR_CALL( CMRsort(cmr, violator->numRows, violator->rows, sizeof(size_t), CMRsortCompareIndices) );
+    CMR_CALL( CMRsort(cmr, violator->numColumns, violator->columns, sizeof(size_t), CMRsortCompareIndices) );
+  }
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRseymourSetNumChildren(CMR* cmr, CMR_SEYMOUR_NODE* node, size_t numChildren)
 {
   assert(cmr);
@@ -1498,7 +2007,8 @@ CMR_ERROR cloneRecursively(
   /* It was not, so we create a clone. */
   CMR_SEYMOUR_NODE* clone = NULL;
   CMR_CALL( createNode(cmr, &clone, node->isTernary, node->type, node->numRows, node->numColumns) );
-  CMR_CALL( CMRchrmatCopy(cmr, node->matrix, &clone->matrix) );
+  if (node->matrix)
+    CMR_CALL( CMRchrmatCopy(cmr, node->matrix, &clone->matrix) );
   if (node->graph)
     CMR_CALL( CMRgraphCopy(cmr, node->graph, &clone->graph) );
   if (node->graphForest)
@@ -1590,36 +2100,1192 @@ CMR_ERROR CMRseymourCloneSubtrees(CMR* cmr, size_t numSubtrees, CMR_SEYMOUR_NODE
   return CMR_OKAY;
 }
 
+/**
+ * \brief Magic bytes at the beginning of a serialized Seymour decomposition; the last one is the format version.
+ */
 
-CMR_ERROR CMRregularityTaskCreateRoot(CMR* cmr, CMR_SEYMOUR_NODE* node, DecompositionTask** ptask,
-  CMR_SEYMOUR_PARAMS* params, CMR_SEYMOUR_STATS* stats, clock_t startClock, double timeLimit)
-{
-  assert(cmr);
-  assert(node);
-  assert(ptask);
-  assert(params);
+static const unsigned char serializationMagic[8] = { 'C', 'M', 'R', 'S', 'E', 'Y', 'M', 1 };
 
-  CMR_CALL( CMRallocBlock(cmr, ptask) );
-  DecompositionTask* task = *ptask;
+/**
+ * \brief Writes the unsigned \p value to \p stream as a sequence of 7-bit groups, least significant first.
+ */
 
-  task->node = node;
-  task->next = NULL;
+static
+CMR_ERROR writeNumber(
+  FILE* stream,   /**< Stream to write to. */
+  uint64_t value  /**< Value to write. */
+)
+{
+  assert(stream);
 
-  task->params = params;
-  task->stats = stats;
-  task->startClock = startClock;
-  task->timeLimit = timeLimit;
+  do
+  {
+    unsigned char byte = value & 0x7f;
+    value >>= 7;
+    if (value)
+      byte |= 0x80;
+    if (fputc(byte, stream) == EOF)
+      return CMR_ERROR_OUTPUT;
+  }
+  while (value);
 
   return CMR_OKAY;
 }
 
-CMR_ERROR CMRregularityTaskFree(CMR* cmr, DecompositionTask** ptask)
+/**
+ * \brief Writes the signed \p value to \p stream such that small absolute values need few bytes.
+ */
+
+static
+CMR_ERROR writeSigned(
+  FILE* stream,   /**< Stream to write to. */
+  int64_t value   /**< Value to write. */
+)
 {
-  assert(cmr);
-  assert(ptask);
+  return writeNumber(stream, value < 0 ? 2 * (uint64_t)(-(value + 1)) + 1 : 2 * (uint64_t) value);
+}
 
-  if (*ptask == NULL)
-    return CMR_OKAY;
+/**
+ * \brief Writes the index \p value to \p stream, which may be \c SIZE_MAX.
+ */
+
+static
+CMR_ERROR writeIndex(
+  FILE* stream, /**< Stream to write to. */
+  size_t value  /**< Index to write. */
+)
+{
+  return writeNumber(stream, value == SIZE_MAX ? 0 : (uint64_t) value + 1);
+}
+
+/**
+ * \brief Reads an unsigned value that was written by \ref writeNumber and checks that it is at most \p maximum.
+ */
+
+static
+CMR_ERROR readNumber(
+  CMR* cmr,           /**< \ref CMR environment. */
+  FILE* stream,       /**< Stream to read from. */
+  uint64_t maximum,   /**< Maximum allowed value. */
+  uint64_t* pvalue    /**< Pointer for storing the value. */
+)
+{
+  assert(cmr);
+  assert(stream);
+  assert(pvalue);
+
+  uint64_t value = 0;
+  for (unsigned int shift = 0; true; shift += 7)
+  {
+    int byte = fgetc(stream);
+    if (byte == EOF || shift > 63)
+    {
+      CMRraiseErrorMessage(cmr, "Truncated or corrupted Seymour decomposition.");
+      return CMR_ERROR_INPUT;
+    }
+    value |= (uint64_t)(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      break;
+  }
+
+  if (value > maximum)
+  {
+    CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: value %llu exceeds %llu.", (unsigned long long) value,
+      (unsigned long long) maximum);
+    return CMR_ERROR_INPUT;
+  }
+
+  *pvalue = value;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads a size that was written by \ref writeNumber and checks that it is at most \p maximum.
+ */
+
+static
+CMR_ERROR readSize(
+  CMR* cmr,       /**< \ref CMR environment. */
+  FILE* stream,   /**< Stream to read from. */
+  size_t maximum, /**< Maximum allowed value. */
+  size_t* pvalue  /**< Pointer for storing the value. */
+)
+{
+  uint64_t value;
+  CMR_CALL( readNumber(cmr, stream, maximum, &value) );
+  *pvalue = (size_t) value;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads a signed value that was written by \ref writeSigned and checks that it lies in
+ *        [\p minimum, \p maximum].
+ */
+
+static
+CMR_ERROR readSigned(
+  CMR* cmr,         /**< \ref CMR environment. */
+  FILE* stream,     /**< Stream to read from. */
+  int64_t minimum,  /**< Minimum allowed value. */
+  int64_t maximum,  /**< Maximum allowed value. */
+  int64_t* pvalue   /**< Pointer for storing the value. */
+)
+{
+  uint64_t encoded;
+  CMR_CALL( readNumber(cmr, stream, UINT64_MAX, &encoded) );
+  int64_t value = (encoded & 1) ? -(int64_t)(encoded / 2) - 1 : (int64_t)(encoded / 2);
+  if (value < minimum || value > maximum)
+  {
+    CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: value %lld is not in [%lld,%lld].", (long long) value,
+      (long long) minimum, (long long) maximum);
+    return CMR_ERROR_INPUT;
+  }
+  *pvalue = value;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads an index that was written by \ref writeIndex, which must be less than \p beyond or \c SIZE_MAX.
+ */
+
+static
+CMR_ERROR readIndex(
+  CMR* cmr,       /**< \ref CMR environment. */
+  FILE* stream,   /**< Stream to read from. */
+  size_t beyond,  /**< Upper bound on valid indices. */
+  size_t* pvalue  /**< Pointer for storing the index. */
+)
+{
+  uint64_t value;
+  CMR_CALL( readNumber(cmr, stream, beyond, &value) );
+  *pvalue = value ? (size_t)(value - 1) : SIZE_MAX;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads a flag, i.e., a value that is 0 or 1.
+ */
+
+static
+CMR_ERROR readFlag(
+  CMR* cmr,     /**< \ref CMR environment. */
+  FILE* stream, /**< Stream to read from. */
+  bool* pflag   /**< Pointer for storing the flag. */
+)
+{
+  uint64_t value;
+  CMR_CALL( readNumber(cmr, stream, 1, &value) );
+  *pflag = value;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads an element that was written by \ref writeSigned, which must be 0 or refer to one of \p numRows rows or
+ *        \p numColumns columns.
+ */
+
+static
+CMR_ERROR readElement(
+  CMR* cmr,             /**< \ref CMR environment. */
+  FILE* stream,         /**< Stream to read from. */
+  size_t numRows,       /**< Number of rows. */
+  size_t numColumns,    /**< Number of columns. */
+  CMR_ELEMENT* pelement /**< Pointer for storing the element. */
+)
+{
+  int64_t value;
+  CMR_CALL( readSigned(cmr, stream, -(int64_t) numRows, (int64_t) numColumns, &value) );
+  *pelement = (CMR_ELEMENT) value;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Writes \p matrix to \p stream.
+ */
+
+static
+CMR_ERROR writeMatrix(
+  FILE* stream,       /**< Stream to write to. */
+  CMR_CHRMAT* matrix  /**< Matrix to write. */
+)
+{
+  assert(stream);
+  assert(matrix);
+
+  CMR_CALL( writeNumber(stream, matrix->numRows) );
+  CMR_CALL( writeNumber(stream, matrix->numColumns) );
+  CMR_CALL( writeNumber(stream, matrix->numNonzeros) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    size_t first = matrix->rowSlice[row];
+    size_t beyond = matrix->rowSlice[row + 1];
+    CMR_CALL( writeNumber(stream, beyond - first) );
+    for (size_t e = first; e < beyond; ++e)
+    {
+      CMR_CALL( writeNumber(stream, matrix->entryColumns[e]) );
+      CMR_CALL( writeSigned(stream, matrix->entryValues[e]) );
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads a matrix that was written by \ref writeMatrix.
+ */
+
+static
+CMR_ERROR readMatrix(
+  CMR* cmr,             /**< \ref CMR environment. */
+  FILE* stream,         /**< Stream to read from. */
+  CMR_CHRMAT** pmatrix  /**< Pointer for storing the matrix. */
+)
+{
+  assert(cmr);
+  assert(pmatrix);
+
+  size_t numRows, numColumns, numNonzeros;
+  CMR_CALL( readSize(cmr, stream, INT_MAX, &numRows) );
+  CMR_CALL( readSize(cmr, stream, INT_MAX, &numColumns) );
+  uint64_t maxNonzeros = (uint64_t) numRows * numColumns;
+  CMR_CALL( readSize(cmr, stream, maxNonzeros < INT_MAX ? maxNonzeros : INT_MAX, &numNonzeros) );
+
+  /* The counts are only verified by reading the rows, so the arrays grow with the input instead of trusting them. */
+  CMR_CALL( CMRchrmatCreate(cmr, pmatrix, 0, numColumns, 0) );
+  CMR_CHRMAT* matrix = *pmatrix;
+  size_t memRows = 0;
+  size_t memNonzeros = 0;
+  size_t entry = 0;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    if (row == memRows)
+    {
+      memRows = (2 * memRows < 256) ? 256 : 2 * memRows;
+      if (memRows > numRows)
+        memRows = numRows;
+      CMR_CALL( CMRreallocBlockArray(cmr, &matrix->rowSlice, memRows + 1) );
+    }
+
+    size_t rowNonzeros;
+    CMR_CALL( readSize(cmr, stream, numNonzeros - entry, &rowNonzeros) );
+    matrix->rowSlice[row] = entry;
+    for (size_t beyond = entry + rowNonzeros; entry < beyond; ++entry)
+    {
+      if (entry == memNonzeros)
+      {
+        memNonzeros = (2 * memNonzeros < 1024) ? 1024 : 2 * memNonzeros;
+        if (memNonzeros > numNonzeros)
+          memNonzeros = numNonzeros;
+        CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryColumns, memNonzeros) );
+        CMR_CALL( CMRreallocBlockArray(cmr, &matrix->entryValues, memNonzeros) );
+      }
+
+      int64_t value;
+      CMR_CALL( readSize(cmr, stream, numColumns - 1, &matrix->entryColumns[entry]) );
+      CMR_CALL( readSigned(cmr, stream, CHAR_MIN, CHAR_MAX, &value) );
+      matrix->entryValues[entry] = (char) value;
+    }
+  }
+  matrix->numRows = numRows;
+  matrix->numNonzeros = entry;
+  matrix->rowSlice[numRows] = entry;
+  if (entry != numNonzeros)
+  {
+    CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: matrix has %zu instead of %zu nonzeros.", entry,
+      numNonzeros);
+    return CMR_ERROR_INPUT;
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Writes \p graph to \p stream together with its forest, coforest and arc directions.
+ *
+ * Nodes and edges are renumbered consecutively in the order of their identifiers. Nodes without incident edges are
+ * listed after the edges.
+ */
+
+static
+CMR_ERROR writeGraph(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  FILE* stream,             /**< Stream to write to. */
+  CMR_GRAPH* graph,         /**< Graph to write. */
+  CMR_GRAPH_EDGE* forest,   /**< Forest edges (may be \c NULL). */
+  size_t sizeForest,        /**< Length of \p forest. */
+  CMR_GRAPH_EDGE* coforest, /**< Coforest edges (may be \c NULL). */
+  size_t sizeCoforest,      /**< Length of \p coforest. */
+  bool* arcsReversed        /**< Indicates reversed arcs (may be \c NULL). */
+)
+{
+  assert(cmr);
+  assert(graph);
+
+  /* Mark existing nodes and edges first in order to number them by increasing identifier. */
+  size_t memNodes = CMRgraphMemNodes(graph);
+  size_t memEdges = CMRgraphMemEdges(graph);
+  size_t* nodeIndices = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &nodeIndices, memNodes + 1) );
+  size_t* edgeIndices = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &edgeIndices, memEdges + 1) );
+  for (size_t v = 0; v < memNodes; ++v)
+    nodeIndices[v] = SIZE_MAX;
+  for (size_t e = 0; e < memEdges; ++e)
+    edgeIndices[e] = SIZE_MAX;
+  for (CMR_GRAPH_NODE v = CMRgraphNodesFirst(graph); CMRgraphNodesValid(graph, v); v = CMRgraphNodesNext(graph, v))
+    nodeIndices[v] = 0;
+  for (CMR_GRAPH_ITER i = CMRgraphEdgesFirst(graph); CMRgraphEdgesValid(graph, i); i = CMRgraphEdgesNext(graph, i))
+    edgeIndices[CMRgraphEdgesEdge(graph, i)] = 0;
+
+  size_t numNodes = 0;
+  for (size_t v = 0; v < memNodes; ++v)
+  {
+    if (nodeIndices[v] != SIZE_MAX)
+      nodeIndices[v] = numNodes++;
+  }
+
+  CMR_CALL( writeNumber(stream, numNodes) );
+  CMR_CALL( writeNumber(stream, CMRgraphNumEdges(graph)) );
+  size_t numEdges = 0;
+  for (size_t e = 0; e < memEdges; ++e)
+  {
+    if (edgeIndices[e] == SIZE_MAX)
+      continue;
+    edgeIndices[e] = numEdges++;
+    CMR_CALL( writeNumber(stream, nodeIndices[CMRgraphEdgeU(graph, (CMR_GRAPH_EDGE) e)]) );
+    CMR_CALL( writeNumber(stream, nodeIndices[CMRgraphEdgeV(graph, (CMR_GRAPH_EDGE) e)]) );
+  }
+
+  /* Isolated nodes are listed explicitly, such that the reader can bound the number of nodes by the input size. */
+  size_t numIsolated = 0;
+  for (CMR_GRAPH_NODE v = CMRgraphNodesFirst(graph); CMRgraphNodesValid(graph, v); v = CMRgraphNodesNext(graph, v))
+  {
+    if (!CMRgraphIncValid(graph, CMRgraphIncFirst(graph, v)))
+      ++numIsolated;
+  }
+  CMR_CALL( writeNumber(stream, numIsolated) );
+  for (size_t v = 0; v < memNodes; ++v)
+  {
+    if (nodeIndices[v] != SIZE_MAX && !CMRgraphIncValid(graph, CMRgraphIncFirst(graph, (CMR_GRAPH_NODE) v)))
+      CMR_CALL( writeNumber(stream, nodeIndices[v]) );
+  }
+
+  CMR_CALL( writeNumber(stream, forest ? 1 : 0) );
+  if (forest)
+  {
+    CMR_CALL( writeNumber(stream, sizeForest) );
+    for (size_t i = 0; i < sizeForest; ++i)
+      CMR_CALL( writeNumber(stream, edgeIndices[forest[i]]) );
+  }
+
+  CMR_CALL( writeNumber(stream, coforest ? 1 : 0) );
+  if (coforest)
+  {
+    CMR_CALL( writeNumber(stream, sizeCoforest) );
+    for (size_t i = 0; i < sizeCoforest; ++i)
+      CMR_CALL( writeNumber(stream, edgeIndices[coforest[i]]) );
+  }
+
+  CMR_CALL( writeNumber(stream, arcsReversed ? 1 : 0) );
+  if (arcsReversed)
+  {
+    for (size_t e = 0; e < memEdges; ++e)
+    {
+      if (edgeIndices[e] != SIZE_MAX)
+        CMR_CALL( writeNumber(stream, arcsReversed[e] ? 1 : 0) );
+    }
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &edgeIndices) );
+  CMR_CALL( CMRfreeStackArray(cmr, &nodeIndices) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Appends \p count indices less than \p beyond that were written by \ref writeNumber to \p *pindices, which
+ *        grows as they are read.
+ */
+
+static
+CMR_ERROR readIndices(
+  CMR* cmr,             /**< \ref CMR environment. */
+  FILE* stream,         /**< Stream to read from. */
+  size_t count,         /**< Number of indices to read. */
+  size_t beyond,        /**< Upper bound (exclusive) on the indices. */
+  size_t** pindices,    /**< Pointer to the block array of indices. */
+  size_t* pmemIndices,  /**< Pointer to the memory allocated for \p *pindices. */
+  size_t* pnumIndices   /**< Pointer to the number of indices in \p *pindices. */
+)
+{
+  assert(cmr);
+  assert(pindices);
+  assert(count == 0 || beyond > 0);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (*pnumIndices == *pmemIndices)
+    {
+      *pmemIndices = (2 * *pmemIndices < 256) ? 256 : 2 * *pmemIndices;
+      CMR_CALL( CMRreallocBlockArray(cmr, pindices, *pmemIndices) );
+    }
+    CMR_CALL( readSize(cmr, stream, beyond - 1, &(*pindices)[(*pnumIndices)++]) );
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Reads a graph that was written by \ref writeGraph.
+ */
+
+static
+CMR_ERROR readGraph(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  FILE* stream,               /**< Stream to read from. */
+  CMR_GRAPH** pgraph,         /**< Pointer for storing the graph. */
+  CMR_GRAPH_EDGE** pforest,   /**< Pointer for storing the forest. */
+  CMR_GRAPH_EDGE** pcoforest, /**< Pointer for storing the coforest. */
+  bool** parcsReversed        /**< Pointer for storing the arc directions. */
+)
+{
+  assert(cmr);
+  assert(pgraph);
+
+  size_t numNodes, numEdges;
+  CMR_CALL( readSize(cmr, stream, INT_MAX, &numNodes) );
+  CMR_CALL( readSize(cmr, stream, INT_MAX / 2, &numEdges) );
+  if (numEdges && !numNodes)
+  {
+    CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: graph has edges but no nodes.");
+    return CMR_ERROR_INPUT;
+  }
+
+  /* The endpoints and isolated nodes are read before the graph is created, such that memory grows with the input
+   * instead of trusting the counts. Each node is incident to an edge or listed as isolated, which bounds the number of
+   * nodes. */
+  size_t* indices = NULL;
+  size_t memIndices = 0;
+  size_t numIndices = 0;
+  size_t numIsolated = 0;
+  CMR_ERROR error = readIndices(cmr, stream, 2 * numEdges, numNodes, &indices, &memIndices, &numIndices);
+  if (!error)
+    error = readSize(cmr, stream, numNodes, &numIsolated);
+  if (!error)
+    error = readIndices(cmr, stream, numIsolated, numNodes, &indices, &memIndices, &numIndices);
+  if (!error && numNodes > 2 * numEdges + numIsolated)
+  {
+    CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: graph has %zu nodes but only %zu edges and %zu "
+      "isolated nodes.", numNodes, numEdges, numIsolated);
+    error = CMR_ERROR_INPUT;
+  }
+  if (error)
+  {
+    CMR_CALL( CMRfreeBlockArray(cmr, &indices) );
+    return error;
+  }
+
+  CMR_CALL( CMRgraphCreateEmpty(cmr, pgraph, (int) numNodes, (int) numEdges) );
+  CMR_GRAPH* graph = *pgraph;
+
+  CMR_GRAPH_NODE* nodes = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &nodes, numNodes + 1) );
+  CMR_GRAPH_EDGE* edges = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &edges, numEdges + 1) );
+
+  for (size_t v = 0; v < numNodes && !error; ++v)
+    error = CMRgraphAddNode(cmr, graph, &nodes[v]);
+  for (size_t e = 0; e < numEdges && !error; ++e)
+    error = CMRgraphAddEdge(cmr, graph, nodes[indices[2*e]], nodes[indices[2*e+1]], &edges[e]);
+  for (size_t i = 2 * numEdges; i < numIndices && !error; ++i)
+  {
+    if (CMRgraphIncValid(graph, CMRgraphIncFirst(graph, nodes[indices[i]])))
+    {
+      CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: isolated node %zu has an incident edge.", indices[i]);
+      error = CMR_ERROR_INPUT;
+    }
+  }
+
+  bool hasArray = false;
+  size_t size = 0;
+  if (!error)
+    error = readFlag(cmr, stream, &hasArray);
+  if (!error && hasArray)
+  {
+    error = readSize(cmr, stream, numEdges, &size);
+    if (!error)
+      error = CMRallocBlockArray(cmr, pforest, size + 1);
+    for (size_t i = 0; i < size && !error; ++i)
+    {
+      size_t e;
+      error = readSize(cmr, stream, numEdges - 1, &e);
+      if (!error)
+        (*pforest)[i] = edges[e];
+    }
+  }
+
+  if (!error)
+    error = readFlag(cmr, stream, &hasArray);
+  if (!error && hasArray)
+  {
+    error = readSize(cmr, stream, numEdges, &size);
+    if (!error)
+      error = CMRallocBlockArray(cmr, pcoforest, size + 1);
+    for (size_t i = 0; i < size && !error; ++i)
+    {
+      size_t e;
+      error = readSize(cmr, stream, numEdges - 1, &e);
+      if (!error)
+        (*pcoforest)[i] = edges[e];
+    }
+  }
+
+  if (!error)
+    error = readFlag(cmr, stream, &hasArray);
+  if (!error && hasArray)
+  {
+    error = CMRallocBlockArray(cmr, parcsReversed, CMRgraphMemEdges(graph) + 1);
+    for (size_t e = 0; e < numEdges && !error; ++e)
+      error = readFlag(cmr, stream, &(*parcsReversed)[edges[e]]);
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &edges) );
+  CMR_CALL( CMRfreeStackArray(cmr, &nodes) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &indices) );
+
+  return error;
+}
+
+/**
+ * \brief Returns the index of \p node in \p nodes, which is sorted by address, or \c SIZE_MAX.
+ */
+
+static
+size_t findSerializedNode(
+  CMR_SEYMOUR_NODE** sortedNodes, /**< Nodes sorted by address. */
+  size_t* sortedIndices,          /**< Serialization index of each node in \p sortedNodes. */
+  size_t numNodes,                /**< Number of nodes. */
+  CMR_SEYMOUR_NODE* node          /**< Node to find. */
+)
+{
+  size_t first = 0;
+  size_t beyond = numNodes;
+  while (first < beyond)
+  {
+    size_t middle = first + (beyond - first) / 2;
+    if (sortedNodes[middle] == node)
+      return sortedIndices[middle];
+    else if ((uintptr_t) sortedNodes[middle] < (uintptr_t) node)
+      first = middle + 1;
+    else
+      beyond = middle;
+  }
+
+  return SIZE_MAX;
+}
+
+/**
+ * \brief Appends all nodes of the subtree rooted at \p node to \p *pnodes in post-order, visiting each node once.
+ */
+
+static
+CMR_ERROR collectNodesPostOrder(
+  CMR* cmr,                           /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* node,             /**< Root of the subtree. */
+  CMR_LISTHASHTABLE* visited,         /**< Hashtable containing the visited nodes. */
+  CMR_SEYMOUR_NODE*** pnodes,         /**< Pointer to array of nodes. */
+  size_t* pmemNodes,                  /**< Pointer to allocated length of \p *pnodes. */
+  size_t* pnumNodes                   /**< Pointer to length of \p *pnodes. */
+)
+{
+  assert(cmr);
+  assert(node);
+
+  CMR_LISTHASHTABLE_HASH hash = (CMR_LISTHASHTABLE_HASH) node;
+  for (CMR_LISTHASHTABLE_ENTRY entry = CMRlisthashtableFindFirst(visited, hash); entry != SIZE_MAX;
+    entry = CMRlisthashtableFindNext(visited, hash, entry))
+  {
+    if ((*pnodes)[CMRlisthashtableValue(visited, entry)] == node)
+      return CMR_OKAY;
+  }
+
+  for (size_t c = 0; c < node->numChildren; ++c)
+    CMR_CALL( collectNodesPostOrder(cmr, node->children[c], visited, pnodes, pmemNodes, pnumNodes) );
+
+  if (*pnumNodes == *pmemNodes)
+  {
+    *pmemNodes *= 2;
+    CMR_CALL( CMRreallocBlockArray(cmr, pnodes, *pmemNodes) );
+  }
+  CMR_CALL( CMRlisthashtableInsert(cmr, visited, hash, *pnumNodes, NULL) );
+  (*pnodes)[(*pnumNodes)++] = node;
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Writes a single node to \p stream, referring to its children by their serialization indices.
+ */
+
+static
+CMR_ERROR writeNode(
+  CMR* cmr,                       /**< \ref CMR environment. */
+  FILE* stream,                   /**< Stream to write to. */
+  CMR_SEYMOUR_NODE* node,         /**< Node to write. */
+  CMR_SEYMOUR_NODE** sortedNodes, /**< Nodes sorted by address. */
+  size_t* sortedIndices,          /**< Serialization index of each node in \p sortedNodes. */
+  size_t numNodes                 /**< Number of nodes. */
+)
+{
+  assert(cmr);
+  assert(node);
+
+  CMR_CALL( writeSigned(stream, node->type) );
+  CMR_CALL( writeNumber(stream, node->numRows) );
+  CMR_CALL( writeNumber(stream, node->numColumns) );
+  CMR_CALL( writeNumber(stream, (node->isTernary ? 1 : 0) | (node->testedTwoConnected ? 2 : 0)
+    | (node->testedR10 ? 4 : 0) | (node->testedSeriesParallel ? 8 : 0) | (node->searchedForWheel ? 16 : 0)
+    | (node->testedSimpleThreeSeparations ? 32 : 0) | (node->matrix ? 64 : 0) | (node->transpose ? 128 : 0)) );
+  CMR_CALL( writeSigned(stream, node->regularity) );
+  CMR_CALL( writeSigned(stream, node->graphicness) );
+  CMR_CALL( writeSigned(stream, node->cographicness) );
+
+  /* Transposes are recomputed when reading, unless only the transpose is known. */
+  if (node->matrix)
+    CMR_CALL( writeMatrix(stream, node->matrix) );
+  else if (node->transpose)
+    CMR_CALL( writeMatrix(stream, node->transpose) );
+
+  CMR_CALL( writeNumber(stream, node->numChildren) );
+  for (size_t c = 0; c < node->numChildren; ++c)
+  {
+    CMR_SEYMOUR_NODE* child = node->children[c];
+    CMR_CALL( writeNumber(stream, findSerializedNode(sortedNodes, sortedIndices, numNodes, child)) );
+    CMR_CALL( writeNumber(stream, (node->childRowsToParent[c] ? 1 : 0) | (node->childColumnsToParent[c] ? 2 : 0)) );
+    if (node->childRowsToParent[c])
+    {
+      for (size_t row = 0; row < child->numRows; ++row)
+        CMR_CALL( writeSigned(stream, node->childRowsToParent[c][row]) );
+    }
+    if (node->childColumnsToParent[c])
+    {
+      for (size_t column = 0; column < child->numColumns; ++column)
+        CMR_CALL( writeSigned(stream, node->childColumnsToParent[c][column]) );
+    }
+
+    size_t numSpecialRows, numSpecialColumns;
+    countChildSpecialElements(node, c, &numSpecialRows, &numSpecialColumns);
+    CMR_CALL( writeNumber(stream, numSpecialRows) );
+    for (size_t i = 0; i < numSpecialRows; ++i)
+      CMR_CALL( writeNumber(stream, node->childSpecialRows[c][i]) );
+    CMR_CALL( writeNumber(stream, numSpecialColumns) );
+    for (size_t i = 0; i < numSpecialColumns; ++i)
+      CMR_CALL( writeNumber(stream, node->childSpecialColumns[c][i]) );
+  }
+  for (size_t row = 0; row < node->numRows; ++row)
+    CMR_CALL( writeIndex(stream, node->rowsToChild[row]) );
+  for (size_t column = 0; column < node->numColumns; ++column)
+    CMR_CALL( writeIndex(stream, node->columnsToChild[column]) );
+
+  CMR_CALL( writeNumber(stream, node->numMinors) );
+  for (size_t m = 0; m < node->numMinors; ++m)
+  {
+    CMR_MINOR* minor = node->minors[m];
+    CMR_CALL( writeSigned(stream, minor->type) );
+    CMR_CALL( writeNumber(stream, minor->numPivots) );
+    for (size_t p = 0; p < minor->numPivots; ++p)
+    {
+      CMR_CALL( writeNumber(stream, minor->pivotRows[p]) );
+      CMR_CALL( writeNumber(stream, minor->pivotColumns[p]) );
+    }
+    CMR_SUBMAT* submatrix = minor->remainingSubmatrix;
+    CMR_CALL( writeNumber(stream, submatrix ? 1 : 0) );
+    if (submatrix)
+    {
+      CMR_CALL( writeNumber(stream, submatrix->numRows) );
+      CMR_CALL( writeNumber(stream, submatrix->numColumns) );
+      for (size_t row = 0; row < submatrix->numRows; ++row)
+        CMR_CALL( writeNumber(stream, submatrix->rows[row]) );
+      for (size_t column = 0; column < submatrix->numColumns; ++column)
+        CMR_CALL( writeNumber(stream, submatrix->columns[column]) );
+    }
+  }
+
+  CMR_CALL( writeNumber(stream, node->graph ? 1 : 0) );
+  if (node->graph)
+  {
+    CMR_CALL( writeGraph(cmr, stream, node->graph, node->graphForest, CMRseymourGraphSizeForest(node),
+      node->graphCoforest, CMRseymourGraphSizeCoforest(node), node->graphArcsReversed) );
+  }
+  CMR_CALL( writeNumber(stream, node->cograph ? 1 : 0) );
+  if (node->cograph)
+  {
+    CMR_CALL( writeGraph(cmr, stream, node->cograph, node->cographForest, CMRseymourCographSizeForest(node),
+      node->cographCoforest, CMRseymourCographSizeCoforest(node), node->cographArcsReversed) );
+  }
+
+  CMR_CALL( writeNumber(stream, node->numSeriesParallelReductions) );
+  for (size_t r = 0; r < node->numSeriesParallelReductions; ++r)
+  {
+    CMR_CALL( writeSigned(stream, node->seriesParallelReductions[r].element) );
+    CMR_CALL( writeSigned(stream, node->seriesParallelReductions[r].mate) );
+  }
+
+  CMR_CALL( writeNumber(stream, node->numPivots) );
+  for (size_t p = 0; p < node->numPivots; ++p)
+  {
+    CMR_CALL( writeNumber(stream, node->pivotRows[p]) );
+    CMR_CALL( writeNumber(stream, node->pivotColumns[p]) );
+  }
+
+  /* Sequence of nested minors, possibly still under construction. Its length is stale once it was freed. */
+  size_t nestedMinorsLength = node->nestedMinorsSequenceNumRows ? node->nestedMinorsLength : 0;
+  CMR_CALL( writeNumber(stream, nestedMinorsLength) );
+  for (size_t i = 0; i < nestedMinorsLength; ++i)
+  {
+    CMR_CALL( writeNumber(stream, node->nestedMinorsSequenceNumRows[i]) );
+    CMR_CALL( writeNumber(stream, node->nestedMinorsSequenceNumColumns[i]) );
+  }
+  CMR_CALL( writeNumber(stream, node->denseMatrix ? 1 : 0) );
+  if (node->denseMatrix)
+  {
+    for (size_t row = 0; row < node->numRows; ++row)
+    {
+      CMR_CALL( writeNumber(stream, CMRdensebinmatrixRowCount(node->denseMatrix, row)) );
+      for (size_t column = CMRdensebinmatrixRowNext(node->denseMatrix, row, 0); column < node->numColumns;
+        column = CMRdensebinmatrixRowNext(node->denseMatrix, row, column + 1))
+      {
+        CMR_CALL( writeNumber(stream, column) );
+      }
+    }
+    for (size_t row = 0; row < node->numRows; ++row)
+      CMR_CALL( writeSigned(stream, node->denseRowsOriginal[row]) );
+    for (size_t column = 0; column < node->numColumns; ++column)
+      CMR_CALL( writeSigned(stream, node->denseColumnsOriginal[column]) );
+
+    /* Only the rows and columns of the largest minor so far are defined. */
+    assert(nestedMinorsLength > 0);
+    size_t numMinorRows = node->nestedMinorsSequenceNumRows[nestedMinorsLength - 1];
+    size_t numMinorColumns = node->nestedMinorsSequenceNumColumns[nestedMinorsLength - 1];
+    for (size_t row = 0; row < numMinorRows; ++row)
+      CMR_CALL( writeNumber(stream, node->nestedMinorsRowsDense[row]) );
+    for (size_t column = 0; column < numMinorColumns; ++column)
+      CMR_CALL( writeNumber(stream, node->nestedMinorsColumnsDense[column]) );
+  }
+  CMR_CALL( writeNumber(stream, node->nestedMinorsMatrix ? 1 : 0) );
+  if (node->nestedMinorsMatrix)
+  {
+    CMR_CALL( writeMatrix(stream, node->nestedMinorsMatrix) );
+    for (size_t row = 0; row < node->numRows; ++row)
+      CMR_CALL( writeSigned(stream, node->nestedMinorsRowsOriginal[row]) );
+    for (size_t column = 0; column < node->numColumns; ++column)
+      CMR_CALL( writeSigned(stream, node->nestedMinorsColumnsOriginal[column]) );
+  }
+  CMR_CALL( writeIndex(stream, node->nestedMinorsLastGraphic < nestedMinorsLength ? node->nestedMinorsLastGraphic
+    : SIZE_MAX) );
+  CMR_CALL( writeIndex(stream, node->nestedMinorsLastCographic < nestedMinorsLength ? node->nestedMinorsLastCographic
+    : SIZE_MAX) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRseymourWrite(CMR* cmr, CMR_SEYMOUR_NODE* node, FILE* stream)
+{
+  assert(cmr);
+  assert(node);
+  assert(stream);
+
+  /* Children are written before their parents such that a reader can resolve them immediately. */
+  CMR_LISTHASHTABLE* visited = NULL;
+  CMR_CALL( CMRlisthashtableCreate(cmr, &visited, 1024, 256) );
+  size_t memNodes = 32;
+  size_t numNodes = 0;
+  CMR_SEYMOUR_NODE** nodes = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &nodes, memNodes) );
+  CMR_CALL( collectNodesPostOrder(cmr, node, visited, &nodes, &memNodes, &numNodes) );
+  CMR_CALL( CMRlisthashtableFree(cmr, &visited) );
+
+  /* Sort the nodes by address for looking up the indices of children. */
+  CMR_SEYMOUR_NODE** sortedNodes = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &sortedNodes, numNodes) );
+  size_t* sortedIndices = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &sortedIndices, numNodes) );
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    size_t j = i;
+    for (; j > 0 && (uintptr_t) sortedNodes[j-1] > (uintptr_t) nodes[i]; --j)
+    {
+      sortedNodes[j] = sortedNodes[j-1];
+      sortedIndices[j] = sortedIndices[j-1];
+    }
+    sortedNodes[j] = nodes[i];
+    sortedIndices[j] = i;
+  }
+
+  CMR_ERROR error = CMR_OKAY;
+  if (fwrite(serializationMagic, 1, sizeof(serializationMagic), stream) != sizeof(serializationMagic))
+    error = CMR_ERROR_OUTPUT;
+  if (!error)
+    error = writeNumber(stream, numNodes);
+  for (size_t i = 0; i < numNodes && !error; ++i)
+    error = writeNode(cmr, stream, nodes[i], sortedNodes, sortedIndices, numNodes);
+
+  CMR_CALL( CMRfreeStackArray(cmr, &sortedIndices) );
+  CMR_CALL( CMRfreeStackArray(cmr, &sortedNodes) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &nodes) );
+
+  if (error == CMR_ERROR_OUTPUT)
+    CMRraiseErrorMessage(cmr, "Could not write Seymour decomposition.");
+
+  return error;
+}
+
+/**
+ * \brief Reads a single node that was written by \ref writeNode and stores it in \p *pnode.
+ *
+ * All memory is attached to \p *pnode as soon as it is allocated, such that releasing \p *pnode cleans up in case of
+ * an error.
+ */
+
+static
+CMR_ERROR readNode(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  FILE* stream,             /**< Stream to read from. */
+  CMR_SEYMOUR_NODE** nodes, /**< Nodes read so far. */
+  size_t numNodes,          /**< Number of nodes read so far. */
+  CMR_SEYMOUR_NODE** pnode  /**< Pointer for storing the node. */
+)
+{
+  assert(cmr);
+  assert(pnode);
+
+  int64_t value;
+  size_t numRows, numColumns, flags;
+  CMR_CALL( readSigned(cmr, stream, CMR_SEYMOUR_NODE_TYPE_IRREGULAR, CMR_SEYMOUR_NODE_TYPE_YSUM, &value) );
+  CMR_CALL( readSize(cmr, stream, INT_MAX, &numRows) );
+  CMR_CALL( readSize(cmr, stream, INT_MAX, &numColumns) );
+  CMR_CALL( readSize(cmr, stream, 255, &flags) );
+  CMR_CALL( createNode(cmr, pnode, flags & 1, (CMR_SEYMOUR_NODE_TYPE) value, numRows, numColumns) );
+  CMR_SEYMOUR_NODE* node = *pnode;
+  node->testedTwoConnected = flags & 2;
+  node->testedR10 = flags & 4;
+  node->testedSeriesParallel = flags & 8;
+  node->searchedForWheel = flags & 16;
+  node->testedSimpleThreeSeparations = flags & 32;
+  CMR_CALL( readSigned(cmr, stream, -1, 1, &value) );
+  node->regularity = (int8_t) value;
+  CMR_CALL( readSigned(cmr, stream, -1, 1, &value) );
+  node->graphicness = (int8_t) value;
+  CMR_CALL( readSigned(cmr, stream, -1, 1, &value) );
+  node->cographicness = (int8_t) value;
+
+  if (flags & (64 | 128))
+  {
+    CMR_CHRMAT** pmatrix = (flags & 64) ? &node->matrix : &node->transpose;
+    CMR_CALL( readMatrix(cmr, stream, pmatrix) );
+    CMR_CHRMAT* matrix = *pmatrix;
+    if ((flags & 64) ? (matrix->numRows != numRows || matrix->numColumns != numColumns)
+      : (matrix->numRows != numColumns || matrix->numColumns != numRows))
+    {
+      CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: matrix does not match node dimensions.");
+      return CMR_ERROR_INPUT;
+    }
+    if ((flags & 64) && (flags & 128))
+      CMR_CALL( CMRchrmatTranspose(cmr, node->matrix, &node->transpose) );
+  }
+
+  size_t numChildren;
+  CMR_CALL( readSize(cmr, stream, numNodes, &numChildren) );
+  if (numChildren)
+    CMR_CALL( CMRseymourSetNumChildren(cmr, node, numChildren) );
+  for (size_t c = 0; c < numChildren; ++c)
+  {
+    size_t childIndex;
+    CMR_CALL( readSize(cmr, stream, numNodes - 1, &childIndex) );
+    CMR_SEYMOUR_NODE* child = nodes[childIndex];
+    CMR_CALL( CMRseymourCapture(cmr, child) );
+    node->children[c] = child;
+
+    size_t hasMaps;
+    CMR_CALL( readSize(cmr, stream, 3, &hasMaps) );
+    if (hasMaps & 1)
+    {
+      CMR_CALL( CMRallocBlockArray(cmr, &node->childRowsToParent[c], child->numRows + 1) );
+      for (size_t row = 0; row < child->numRows; ++row)
+        CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->childRowsToParent[c][row]) );
+    }
+    if (hasMaps & 2)
+    {
+      CMR_CALL( CMRallocBlockArray(cmr, &node->childColumnsToParent[c], child->numColumns + 1) );
+      for (size_t column = 0; column < child->numColumns; ++column)
+        CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->childColumnsToParent[c][column]) );
+    }
+
+    size_t numSpecial;
+    CMR_CALL( readSize(cmr, stream, 3, &numSpecial) );
+    if (numSpecial)
+    {
+      CMR_CALL( CMRallocBlockArray(cmr, &node->childSpecialRows[c], numSpecial) );
+      for (size_t i = 0; i < numSpecial; ++i)
+        CMR_CALL( readSize(cmr, stream, child->numRows - 1, &node->childSpecialRows[c][i]) );
+    }
+    CMR_CALL( readSize(cmr, stream, 3, &numSpecial) );
+    if (numSpecial)
+    {
+      CMR_CALL( CMRallocBlockArray(cmr, &node->childSpecialColumns[c], numSpecial) );
+      for (size_t i = 0; i < numSpecial; ++i)
+        CMR_CALL( readSize(cmr, stream, child->numColumns - 1, &node->childSpecialColumns[c][i]) );
+    }
+  }
+  /* Depending on the node type, these map to a child or to a row/column of a child. */
+  size_t beyondToChild = numChildren;
+  for (size_t c = 0; c < numChildren; ++c)
+  {
+    if (node->children[c]->numRows > beyondToChild)
+      beyondToChild = node->children[c]->numRows;
+    if (node->children[c]->numColumns > beyondToChild)
+      beyondToChild = node->children[c]->numColumns;
+  }
+  for (size_t row = 0; row < numRows; ++row)
+    CMR_CALL( readIndex(cmr, stream, beyondToChild, &node->rowsToChild[row]) );
+  for (size_t column = 0; column < numColumns; ++column)
+    CMR_CALL( readIndex(cmr, stream, beyondToChild, &node->columnsToChild[column]) );
+
+  size_t numMinors;
+  CMR_CALL( readSize(cmr, stream, INT_MAX, &numMinors) );
+  for (size_t m = 0; m < numMinors; ++m)
+  {
+    size_t numPivots;
+    CMR_CALL( readSigned(cmr, stream, INT_MIN, INT_MAX, &value) );
+    CMR_CALL( readSize(cmr, stream, numRows < numColumns ? numRows : numColumns, &numPivots) );
+    CMR_MINOR* minor = NULL;
+    CMR_CALL( CMRminorCreate(cmr, &minor, numPivots, NULL, (CMR_MINOR_TYPE) value) );
+    CMR_CALL( CMRseymourAddMinor(cmr, node, minor) );
+    for (size_t p = 0; p < numPivots; ++p)
+    {
+      CMR_CALL( readSize(cmr, stream, numRows - 1, &minor->pivotRows[p]) );
+      CMR_CALL( readSize(cmr, stream, numColumns - 1, &minor->pivotColumns[p]) );
+    }
+    bool hasSubmatrix;
+    CMR_CALL( readFlag(cmr, stream, &hasSubmatrix) );
+    if (hasSubmatrix)
+    {
+      size_t numSubmatrixRows, numSubmatrixColumns;
+      CMR_CALL( readSize(cmr, stream, numRows, &numSubmatrixRows) );
+      CMR_CALL( readSize(cmr, stream, numColumns, &numSubmatrixColumns) );
+      CMR_CALL( CMRsubmatCreate(cmr, numSubmatrixRows, numSubmatrixColumns, &minor->remainingSubmatrix) );
+      for (size_t row = 0; row < numSubmatrixRows; ++row)
+        CMR_CALL( readSize(cmr, stream, numRows - 1, &minor->remainingSubmatrix->rows[row]) );
+      for (size_t column = 0; column < numSubmatrixColumns; ++column)
+        CMR_CALL( readSize(cmr, stream, numColumns - 1, &minor->remainingSubmatrix->columns[column]) );
+    }
+  }
+
+  bool hasGraph;
+  CMR_CALL( readFlag(cmr, stream, &hasGraph) );
+  if (hasGraph)
+  {
+    CMR_CALL( readGraph(cmr, stream, &node->graph, &node->graphForest, &node->graphCoforest,
+      &node->graphArcsReversed) );
+  }
+  CMR_CALL( readFlag(cmr, stream, &hasGraph) );
+  if (hasGraph)
+  {
+    CMR_CALL( readGraph(cmr, stream, &node->cograph, &node->cographForest, &node->cographCoforest,
+      &node->cographArcsReversed) );
+  }
+
+  size_t numReductions;
+  CMR_CALL( readSize(cmr, stream, numRows + numColumns, &numReductions) );
+  if (numReductions)
+  {
+    CMR_CALL( CMRallocBlockArray(cmr, &node->seriesParallelReductions, numReductions) );
+    node->numSeriesParallelReductions = numReductions;
+    for (size_t r = 0; r < numReductions; ++r)
+    {
+      CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->seriesParallelReductions[r].element) );
+      CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->seriesParallelReductions[r].mate) );
+    }
+  }
+
+  size_t numPivots;
+  CMR_CALL( readSize(cmr, stream, numRows < numColumns ? numRows : numColumns, &numPivots) );
+  if (numPivots)
+  {
+    CMR_CALL( CMRallocBlockArray(cmr, &node->pivotRows, numPivots) );
+    CMR_CALL( CMRallocBlockArray(cmr, &node->pivotColumns, numPivots) );
+    node->numPivots = numPivots;
+    for (size_t p = 0; p < numPivots; ++p)
+    {
+      CMR_CALL( readSize(cmr, stream, numRows - 1, &node->pivotRows[p]) );
+      CMR_CALL( readSize(cmr, stream, numColumns - 1, &node->pivotColumns[p]) );
+    }
+  }
+
+  size_t nestedMinorsLength;
+  CMR_CALL( readSize(cmr, stream, numRows + numColumns, &nestedMinorsLength) );
+  if (nestedMinorsLength)
+  {
+    CMR_CALL( CMRallocBlockArray(cmr, &node->nestedMinorsSequenceNumRows, numRows + numColumns) );
+    CMR_CALL( CMRallocBlockArray(cmr, &node->nestedMinorsSequenceNumColumns, numRows + numColumns) );
+    node->nestedMinorsLength = nestedMinorsLength;
+    for (size_t i = 0; i < nestedMinorsLength; ++i)
+    {
+      CMR_CALL( readSize(cmr, stream, numRows, &node->nestedMinorsSequenceNumRows[i]) );
+      CMR_CALL( readSize(cmr, stream, numColumns, &node->nestedMinorsSequenceNumColumns[i]) );
+    }
+  }
+  bool hasDense;
+  CMR_CALL( readFlag(cmr, stream, &hasDense) );
+  if (hasDense)
+  {
+    if (!nestedMinorsLength)
+    {
+      CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: dense matrix without nested minors.");
+      return CMR_ERROR_INPUT;
+    }
+    CMR_CALL( CMRdensebinmatrixCreate(cmr, numRows, numColumns, &node->denseMatrix) );
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      size_t rowNonzeros;
+      CMR_CALL( readSize(cmr, stream, numColumns, &rowNonzeros) );
+      for (size_t i = 0; i < rowNonzeros; ++i)
+      {
+        size_t column;
+        CMR_CALL( readSize(cmr, stream, numColumns - 1, &column) );
+        CMR_CALL( CMRdensebinmatrixSet1(cmr, node->denseMatrix, row, column) );
+      }
+    }
+    CMR_CALL( CMRallocBlockArray(cmr, &node->denseRowsOriginal, numRows) );
+    for (size_t row = 0; row < numRows; ++row)
+      CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->denseRowsOriginal[row]) );
+    CMR_CALL( CMRallocBlockArray(cmr, &node->denseColumnsOriginal, numColumns) );
+    for (size_t column = 0; column < numColumns; ++column)
+      CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->denseColumnsOriginal[column]) );
+
+    size_t numMinorRows = node->nestedMinorsSequenceNumRows[nestedMinorsLength - 1];
+    size_t numMinorColumns = node->nestedMinorsSequenceNumColumns[nestedMinorsLength - 1];
+    CMR_CALL( CMRallocBlockArray(cmr, &node->nestedMinorsRowsDense, numRows) );
+    for (size_t row = 0; row < numMinorRows; ++row)
+      CMR_CALL( readSize(cmr, stream, numRows - 1, &node->nestedMinorsRowsDense[row]) );
+    CMR_CALL( CMRallocBlockArray(cmr, &node->nestedMinorsColumnsDense, numColumns) );
+    for (size_t column = 0; column < numMinorColumns; ++column)
+      CMR_CALL( readSize(cmr, stream, numColumns - 1, &node->nestedMinorsColumnsDense[column]) );
+  }
+  bool hasNestedMinorsMatrix;
+  CMR_CALL( readFlag(cmr, stream, &hasNestedMinorsMatrix) );
+  if (hasNestedMinorsMatrix)
+  {
+    CMR_CALL( readMatrix(cmr, stream, &node->nestedMinorsMatrix) );
+    if (node->nestedMinorsMatrix->numRows != numRows || node->nestedMinorsMatrix->numColumns != numColumns)
+    {
+      CMRraiseErrorMessage(cmr, "Corrupted Seymour decomposition: nested minors matrix does not match node.");
+      return CMR_ERROR_INPUT;
+    }
+    CMR_CALL( CMRchrmatTranspose(cmr, node->nestedMinorsMatrix, &node->nestedMinorsTranspose) );
+    CMR_CALL( CMRallocBlockArray(cmr, &node->nestedMinorsRowsOriginal, numRows) );
+    for (size_t row = 0; row < numRows; ++row)
+      CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->nestedMinorsRowsOriginal[row]) );
+    CMR_CALL( CMRallocBlockArray(cmr, &node->nestedMinorsColumnsOriginal, numColumns) );
+    for (size_t column = 0; column < numColumns; ++column)
+      CMR_CALL( readElement(cmr, stream, numRows, numColumns, &node->nestedMinorsColumnsOriginal[column]) );
+  }
+  CMR_CALL( readIndex(cmr, stream, nestedMinorsLength, &node->nestedMinorsLastGraphic) );
+  CMR_CALL( readIndex(cmr, stream, nestedMinorsLength, &node->nestedMinorsLastCographic) );
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRseymourCreateFromStream(CMR* cmr, FILE* stream, CMR_SEYMOUR_NODE** proot)
+{
+  assert(cmr);
+  assert(stream);
+  assert(proot);
+
+  *proot = NULL;
+
+  unsigned char magic[sizeof(serializationMagic)];
+  if (fread(magic, 1, sizeof(magic), stream) != sizeof(magic) || memcmp(magic, serializationMagic, sizeof(magic)))
+  {
+    CMRraiseErrorMessage(cmr, "Stream does not contain a Seymour decomposition of a supported format version.");
+    return CMR_ERROR_INPUT;
+  }
+
+  size_t numNodes;
+  CMR_CALL( readSize(cmr, stream, INT_MAX, &numNodes) );
+  if (!numNodes)
+  {
+    CMRraiseErrorMessage(cmr, "Seymour decomposition without nodes.");
+    return CMR_ERROR_INPUT;
+  }
+
+  CMR_SEYMOUR_NODE** nodes = NULL;
+  CMR_CALL( CMRallocBlockArray(cmr, &nodes, numNodes) );
+  size_t numRead = 0;
+  CMR_ERROR error = CMR_OKAY;
+  while (numRead < numNodes)
+  {
+    nodes[numRead] = NULL;
+    error = readNode(cmr, stream, nodes, numRead, &nodes[numRead]);
+    if (nodes[numRead])
+      ++numRead;
+    if (error)
+      break;
+  }
+
+  /* Each node holds a reference to its children, so releasing all except the root frees only non-root nodes. */
+  if (!error)
+    *proot = nodes[numNodes - 1];
+  for (size_t i = 0; i < numRead; ++i)
+  {
+    if (error || i + 1 < numNodes)
+      CMR_CALL( CMRseymourRelease(cmr, &nodes[i]) );
+  }
+  CMR_CALL( CMRfreeBlockArray(cmr, &nodes) );
+
+  return error;
+}
+
+
+CMR_ERROR CMRregularityTaskCreateRoot(CMR* cmr, CMR_SEYMOUR_NODE* node, DecompositionTask** ptask,
+  CMR_SEYMOUR_PARAMS* params, CMR_SEYMOUR_STATS* stats, clock_t startClock, double timeLimit)
+{
+  assert(cmr);
+  assert(node);
+  assert(ptask);
+  assert(params);
+
+  CMR_CALL( CMRallocBlock(cmr, ptask) );
+  DecompositionTask* task = *ptask;
+
+  task->node = node;
+  task->left = NULL;
+  task->right = NULL;
+  task->rank = 0;
+  task->priority = 0;
+  task->sequence = 0;
+
+  task->params = params;
+  task->stats = stats;
+  task->startClock = startClock;
+  task->timeLimit = timeLimit;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRregularityTaskFree(CMR* cmr, DecompositionTask** ptask)
+{
+  assert(cmr);
+  assert(ptask);
+
+  if (*ptask == NULL)
+    return CMR_OKAY;
 
   CMR_CALL( CMRfreeBlock(cmr, ptask) );
 
@@ -1633,7 +3299,8 @@ CMR_ERROR CMRregularityQueueCreate(CMR* cmr, DecompositionQueue** pqueue)
 
   CMR_CALL( CMRallocBlock(cmr, pqueue) );
   DecompositionQueue* queue = *pqueue;
-  queue->head = NULL;
+  queue->root = NULL;
+  queue->numAdded = 0;
   queue->foundIrregularity = false;
   queue->foundNongraphicness = false;
   queue->foundNoncographicness = false;
@@ -1650,10 +3317,9 @@ CMR_ERROR CMRregularityQueueFree(CMR* cmr, DecompositionQueue** pqueue)
   if (queue == NULL)
     return CMR_OKAY;
 
-  while (queue->head)
+  while (queue->root)
   {
-    DecompositionTask* task = queue->head;
-    queue->head = task->next;
+    DecompositionTask* task = CMRregularityQueueRemove(queue);
     CMR_CALL( CMRregularityTaskFree(cmr, &task) );
   }
 
@@ -1666,25 +3332,193 @@ bool CMRregularityQueueEmpty(DecompositionQueue* queue)
 {
   assert(queue);
 
-  return queue->head == NULL;
+  return queue->root == NULL;
+}
+
+/**
+ * \brief Returns \c true if and only if task \p a shall be processed before task \p b.
+ *
+ * Ties in the priority are broken in favor of the more recently added task.
+ */
+
+static
+bool taskPrecedes(
+  DecompositionTask* a, /**< First task. */
+  DecompositionTask* b  /**< Second task. */
+)
+{
+  if (a->priority != b->priority)
+    return a->priority < b->priority;
+  return a->sequence > b->sequence;
+}
+
+/**
+ * \brief Merges the two leftist heaps rooted at \p a and \p b and returns the new root.
+ *
+ * The recursion depth is bounded by the lengths of the right spines, which are logarithmic in the heap sizes.
+ */
+
+static
+DecompositionTask* mergeTasks(
+  DecompositionTask* a, /**< Root of first heap (may be \c NULL). */
+  DecompositionTask* b  /**< Root of second heap (may be \c NULL). */
+)
+{
+  if (!a)
+    return b;
+  if (!b)
+    return a;
+
+  if (taskPrecedes(b, a))
+  {
+    DecompositionTask* swap = a;
+    a = b;
+    b = swap;
+  }
+
+  a->right = mergeTasks(a->right, b);
+  size_t leftRank = a->left ? a->left->rank : 0;
+  if (leftRank < a->right->rank)
+  {
+    DecompositionTask* swap = a->left;
+    a->left = a->right;
+    a->right = swap;
+  }
+  a->rank = (a->right ? a->right->rank : 0) + 1;
+
+  return a;
 }
 
 DecompositionTask* CMRregularityQueueRemove(DecompositionQueue* queue)
 {
   assert(queue);
+  assert(queue->root);
 
-  DecompositionTask* task = queue->head;
-  queue->head = task->next;
-  task->next = NULL;
+  DecompositionTask* task = queue->root;
+  queue->root = mergeTasks(task->left, task->right);
+  task->left = NULL;
+  task->right = NULL;
+  task->rank = 0;
   return task;
 }
 
+/**
+ * \brief Computes the priority of \p task according to the scheduling policy; smaller values are processed first.
+ */
+
+static
+uint64_t taskPriority(
+  DecompositionTask* task,  /**< Task. */
+  uint64_t sequence         /**< Sequence number of the task in its queue. */
+)
+{
+  assert(task);
+
+  CMR_SEYMOUR_SCHEDULE schedule = task->params ? task->params->schedule : CMR_SEYMOUR_SCHEDULE_LIFO;
+  CMR_CHRMAT* matrix = task->node->matrix;
+  uint64_t size = matrix ? matrix->numRows + matrix->numColumns : 0;
+
+  switch (schedule)
+  {
+  case CMR_SEYMOUR_SCHEDULE_FIFO:
+    return sequence;
+  case CMR_SEYMOUR_SCHEDULE_SMALLEST:
+    return size;
+  case CMR_SEYMOUR_SCHEDULE_IRREGULAR:
+  {
+    /* Class 0 is neither (co)graphic nor (co)network, class 1 has one failed test and class 2 has none. */
+    uint64_t class = 2;
+    if (task->node->graphicness < 0)
+      --class;
+    if (task->node->cographicness < 0)
+      --class;
+
+    /* Within a class, the number of zeros per row and column is a density measure that favors dense matrices. */
+    uint64_t sparsity = 0;
+    if (matrix && matrix->numRows > 0 && matrix->numColumns > 0)
+    {
+      uint64_t numEntries = (uint64_t) matrix->numRows * matrix->numColumns;
+      sparsity = (numEntries - matrix->numNonzeros) / size;
+    }
+    if (size > (UINT64_C(1) << 30) - 1)
+      size = (UINT64_C(1) << 30) - 1;
+    if (sparsity > (UINT64_C(1) << 30) - 1)
+      sparsity = (UINT64_C(1) << 30) - 1;
+    return (class << 60) | (size << 30) | sparsity;
+  }
+  default:
+    return 0;
+  }
+}
+
 void CMRregularityQueueAdd(DecompositionQueue* queue, DecompositionTask* task)
 {
   assert(queue);
+  assert(task);
+
+  task->sequence = queue->numAdded++;
+  task->priority = taskPriority(task, task->sequence);
+  task->left = NULL;
+  task->right = NULL;
+  task->rank = 1;
+  queue->root = mergeTasks(queue->root, task);
+}
+
+/**
+ * \brief Starts to measure the memory consumption of a decomposition.
+ *
+ * Returns the current amount of block memory and stores the previous peak in \p *ppreviousPeak. The stack memory is
+ * marked in \p *pstackMark.
+ */
+
+static
+size_t startMemoryMeasurement(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  size_t* ppreviousPeak,    /**< Pointer for storing the peak to be restored by \ref stopMemoryMeasurement. */
+  CMR_STACKMARK* pstackMark /**< Pointer for storing the mark to be released by \ref stopMemoryMeasurement. */
+)
+{
+  *ppreviousPeak = cmr->peakBlockMemory;
+  cmr->peakBlockMemory = cmr->blockMemory;
+  CMRstackMark(cmr, pstackMark);
+
+  return cmr->blockMemory;
+}
+
+/**
+ * \brief Stops to measure the memory consumption of a decomposition and records it in \p stats.
+ *
+ * If the computation failed, e.g., due to a timeout, then stack memory that was not freed since the start is released.
+ * Otherwise, all stack memory must have been freed already.
+ */
+
+static
+void stopMemoryMeasurement(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  size_t start,             /**< Block memory at the start of the measurement. */
+  size_t previousPeak,      /**< Peak that was stored by \ref startMemoryMeasurement. */
+  CMR_STACKMARK* stackMark, /**< Stack mark that was stored by \ref startMemoryMeasurement. */
+  CMR_ERROR error,          /**< Result of the computation. */
+  CMR_SEYMOUR_STATS* stats  /**< Statistics for the computation (may be \c NULL). */
+)
+{
+  CMR_UNUSED(error);
+  assert(error != CMR_OKAY || CMRgetStackUsage(cmr) == stackMark->usage);
+
+  size_t peakStack;
+  CMRstackRelease(cmr, stackMark, &peakStack);
+  if (stats)
+  {
+    if (peakStack > stats->peakStackBytes)
+      stats->peakStackBytes = peakStack;
+    size_t peak = cmr->peakBlockMemory > start ? cmr->peakBlockMemory - start : 0;
+    if (peak > stats->peakBytes)
+      stats->peakBytes = peak;
+    stats->retainedBytes += cmr->blockMemory > start ? cmr->blockMemory - start : 0;
+  }
 
-  task->next = queue->head;
-  queue->head = task;
+  if (previousPeak > cmr->peakBlockMemory)
+    cmr->peakBlockMemory = previousPeak;
 }
 
 /**
@@ -1703,92 +3537,167 @@ CMR_ERROR CMRregularityTaskRun(
   assert(queue);
 
   CMR_ERROR error;
+  const char* phase = NULL;
+
+  /* The task may be freed while processing it. */
+  CMR_SEYMOUR_NODE* node = task->node;
+  CMR_SEYMOUR_TRACE* trace = task->params->trace;
+  double traceStartTime = trace ? traceTime() : 0.0;
+  size_t previousPeak;
+  CMR_STACKMARK stackMark;
+  size_t startMemory = startMemoryMeasurement(cmr, &previousPeak, &stackMark);
 
   CMRdbgMsg(2, "Processing task %p.\n", task);
 
   if (!task->node->testedTwoConnected)
   {
     CMRdbgMsg(4, "Searching for 1-separations.\n");
+    phase = "1-sum";
     error = CMRregularitySearchOnesum(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (!task->node->graphicness
     && (task->params->directGraphicness || task->node->matrix->numRows <= 3 || task->node->matrix->numColumns <= 3))
   {
     CMRdbgMsg(4, "Testing directly for %s.\n", task->node->isTernary ? "being network" : "graphicness");
+    phase = "graphicness";
     error = CMRregularityTestGraphicness(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (!task->node->cographicness
     && (task->params->directGraphicness || task->node->matrix->numRows <= 3 || task->node->matrix->numColumns <= 3))
   {
     CMRdbgMsg(4, "Testing directly for %s.\n", task->node->isTernary ? "being conetwork" : "cographicness");
+    phase = "cographicness";
     error = CMRregularityTestCographicness(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (!task->node->testedR10)
   {
     CMRdbgMsg(4, "Testing for being R_10.\n");
+    phase = "R10";
     error = CMRregularityTestR10(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (!task->node->testedSeriesParallel && task->params->simpleThreeSeparations)
   {
     CMRdbgMsg(4, "Testing for series-parallel reductions.\n");
+    phase = "series-parallel";
     error = CMRregularityDecomposeSeriesParallel(cmr, task, queue, false);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (!task->node->testedSimpleThreeSeparations && task->params->simpleThreeSeparations)
   {
     CMRdbgMsg(4, "Searching for simple 3-separations.\n");
+    phase = "simple 3-separations";
     error = CMRregularitySimpleSearchThreeSeparation(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (!task->node->searchedForWheel)
   {
     CMRdbgMsg(4, "Searching for wheel minor.\n");
+    phase = "wheel search";
     error = CMRregularityDecomposeSeriesParallel(cmr, task, queue, true);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (task->node->denseMatrix)
   {
     CMRdbgMsg(4, "Attempting to construct a sequence of nested minors.\n");
+    phase = "nested minors";
     error = CMRregularityExtendNestedMinorSequence(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (task->node->nestedMinorsMatrix && (task->node->nestedMinorsLastGraphic == SIZE_MAX))
   {
     CMRdbgMsg(4, "Testing along the sequence for %s.\n", task->node->isTernary ? "being network" : "graphicness");
+    phase = "sequence graphicness";
     error = CMRregularityNestedMinorSequenceGraphicness(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else if (task->node->nestedMinorsMatrix && (task->node->nestedMinorsLastCographic == SIZE_MAX))
   {
     CMRdbgMsg(4, "Testing along the sequence for %s.\n", task->node->isTernary ? "being conetwork" : "cographicness");
+    phase = "sequence cographicness";
     error = CMRregularityNestedMinorSequenceCographicness(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
   else
   {
     CMRdbgMsg(4, "Searching for 3-separations along the sequence.\n");
+    phase = "3-separation search";
     error = CMRregularityNestedMinorSequenceSearchThreeSeparation(cmr, task, queue);
-    if (error != CMR_OKAY && error != CMR_ERROR_TIMEOUT)
-      CMR_CALL( error );
   }
 
+  /* Also on errors, the span is closed and the memory measurement is stopped before the error is returned. */
+  if (trace)
+  {
+    const char* outcome = traceNodeType(node);
+    if (error == CMR_ERROR_TIMEOUT)
+      outcome = "timeout";
+    else if (error != CMR_OKAY)
+      outcome = "error";
+    traceWriteSpan(cmr, trace, phase, traceStartTime, node, startMemory, cmr->blockMemory, cmr->peakBlockMemory,
+      outcome);
+  }
+  stopMemoryMeasurement(cmr, startMemory, previousPeak, &stackMark, error, NULL);
+
   return error;
 }
 
+/**
+ * \brief Frees data of \p node that is no longer needed once its type is determined.
+ *
+ * Used if \ref CMR_SEYMOUR_PARAMS.lowMemory is set.
+ */
+
+static
+CMR_ERROR releaseIntermediateData(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* node,     /**< Seymour decomposition node. */
+  bool isRoot,                /**< Whether \p node is the root of the computed decomposition. */
+  CMR_SEYMOUR_PARAMS* params  /**< Parameters for the computation. */
+)
+{
+  assert(cmr);
+  assert(node);
+  assert(params);
+
+  if (node->type == CMR_SEYMOUR_NODE_TYPE_UNKNOWN)
+    return CMR_OKAY;
+
+  CMRdbgMsg(2, "Releasing intermediate data of a node of type %d.\n", node->type);
+
+  /* Transposes are recomputed when needed. */
+  if (node->matrix)
+    CMR_CALL( CMRchrmatFree(cmr, &node->transpose) );
+
+  CMR_CALL( CMRdensebinmatrixFree(cmr, &node->denseMatrix) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->denseRowsOriginal) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->denseColumnsOriginal) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->nestedMinorsRowsDense) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->nestedMinorsColumnsDense) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->nestedMinorsSequenceNumRows) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->nestedMinorsSequenceNumColumns) );
+  CMR_CALL( CMRchrmatFree(cmr, &node->nestedMinorsMatrix) );
+  CMR_CALL( CMRchrmatFree(cmr, &node->nestedMinorsTranspose) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->nestedMinorsRowsOriginal) );
+  CMR_CALL( CMRfreeBlockArray(cmr, &node->nestedMinorsColumnsOriginal) );
+  node->nestedMinorsLength = 0;
+  node->nestedMinorsLastGraphic = SIZE_MAX;
+  node->nestedMinorsLastCographic = SIZE_MAX;
+
+  if (!node->numChildren)
+    return CMR_OKAY;
+
+  /* The children carry all information about the inner node's matrix. */
+  if (!isRoot)
+    CMR_CALL( CMRchrmatFree(cmr, &node->matrix) );
+
+  if (!params->constructAllGraphs)
+  {
+    CMR_CALL( CMRgraphFree(cmr, &node->graph) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &node->graphForest) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &node->graphCoforest) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &node->graphArcsReversed) );
+    CMR_CALL( CMRgraphFree(cmr, &node->cograph) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &node->cographForest) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &node->cographCoforest) );
+    CMR_CALL( CMRfreeBlockArray(cmr, &node->cographArcsReversed) );
+  }
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRseymourDecompose(CMR* cmr, CMR_CHRMAT* matrix, bool ternary, CMR_SEYMOUR_NODE** proot,
   CMR_SEYMOUR_PARAMS* params, CMR_SEYMOUR_STATS* stats, double timeLimit)
 {
@@ -1856,6 +3765,11 @@ CMR_ERROR CMRregularityCompleteDecomposition(CMR* cmr, CMR_SEYMOUR_NODE* subtree
 
   subtree->type = CMR_SEYMOUR_NODE_TYPE_UNKNOWN;
 
+  double traceStartTime = params->trace ? traceTime() : 0.0;
+  size_t previousPeakMemory;
+  CMR_STACKMARK stackMark;
+  size_t startMemory = startMemoryMeasurement(cmr, &previousPeakMemory, &stackMark);
+
   DecompositionQueue* queue = NULL;
   CMR_CALL( CMRregularityQueueCreate(cmr, &queue) );
   DecompositionTask* decTask = NULL;
@@ -1896,6 +3810,7 @@ CMR_ERROR CMRregularityCompleteDecomposition(CMR* cmr, CMR_SEYMOUR_NODE* subtree
       continue;
     }
 
+    CMR_SEYMOUR_NODE* node = task->node;
     error = CMRregularityTaskRun(cmr, task, queue);
     if (error == CMR_ERROR_TIMEOUT)
     {
@@ -1904,12 +3819,23 @@ CMR_ERROR CMRregularityCompleteDecomposition(CMR* cmr, CMR_SEYMOUR_NODE* subtree
       break;
     }
     CMR_CALL( error );
+
+    if (params->lowMemory)
+      CMR_CALL( releaseIntermediateData(cmr, node, node == subtree, params) );
   }
 
   CMR_CALL( CMRregularityQueueFree(cmr, &queue) );
 
   CMR_CALL( CMRseymourSetAttributes(subtree) );
 
+  if (params->trace)
+  {
+    traceWriteSpan(cmr, params->trace, "decomposition", traceStartTime, subtree, startMemory, cmr->blockMemory,
+      cmr->peakBlockMemory, error == CMR_ERROR_TIMEOUT ? "timeout" : traceNodeType(subtree));
+  }
+
+  stopMemoryMeasurement(cmr, startMemory, previousPeakMemory, &stackMark, error, stats);
+
   if (stats)
     stats->totalTime += (clock() - time) * 1.0 / CLOCKS_PER_SEC;
 
@@ -1930,6 +3856,11 @@ CMR_ERROR CMRregularityRefineDecomposition(CMR* cmr, size_t numNodes, CMR_SEYMOU
   if (stats)
     stats->totalCount++;
 
+  double traceStartTime = params->trace ? traceTime() : 0.0;
+  size_t previousPeakMemory;
+  CMR_STACKMARK stackMark;
+  size_t startMemory = startMemoryMeasurement(cmr, &previousPeakMemory, &stackMark);
+
   DecompositionQueue* queue = NULL;
   CMR_CALL( CMRregularityQueueCreate(cmr, &queue) );
   DecompositionTask* decTask = NULL;
@@ -1981,7 +3912,16 @@ CMR_ERROR CMRregularityRefineDecomposition(CMR* cmr, size_t numNodes, CMR_SEYMOU
       continue;
     }
 
+    CMR_SEYMOUR_NODE* node = task->node;
     CMR_CALL( CMRregularityTaskRun(cmr, task, queue) );
+
+    if (params->lowMemory)
+    {
+      bool isRoot = false;
+      for (size_t i = 0; i < numNodes && !isRoot; ++i)
+        isRoot = nodes[i] == node;
+      CMR_CALL( releaseIntermediateData(cmr, node, isRoot, params) );
+    }
   }
 
   CMR_CALL( CMRregularityQueueFree(cmr, &queue) );
@@ -1989,6 +3929,15 @@ CMR_ERROR CMRregularityRefineDecomposition(CMR* cmr, size_t numNodes, CMR_SEYMOU
   for (size_t i = 0; i < numNodes; ++i)
     CMR_CALL( CMRseymourSetAttributes(nodes[i]) );
 
+  /* The refinement is shared by all roots, which is why each of them gets the same span. */
+  for (size_t i = 0; i < numNodes && params->trace; ++i)
+  {
+    traceWriteSpan(cmr, params->trace, "refinement", traceStartTime, nodes[i], startMemory, cmr->blockMemory,
+      cmr->peakBlockMemory, traceNodeType(nodes[i]));
+  }
+
+  stopMemoryMeasurement(cmr, startMemory, previousPeakMemory, &stackMark, CMR_OKAY, stats);
+
   if (stats)
     stats->totalTime += (clock() - time) * 1.0 / CLOCKS_PER_SEC;
 
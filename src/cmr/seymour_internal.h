@@ -9,6 +9,10 @@
 #include <cmr/seymour.h>
 #include <cmr/series_parallel.h>
 
+#if defined(CMR_WITH_THREADS)
+#include <pthread.h>
+#endif /* CMR_WITH_THREADS */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -97,16 +101,34 @@ struct _CMR_SEYMOUR_NODE
   size_t nestedMinorsLastCographic;           /**< \brief Last minor in sequence of nested minors that is cographic. */
 
   bool testedSimpleThreeSeparations;          /**< \brief Already searched for simple 3-separations. */
+
+  size_t traceId;                             /**< \brief Identifier of this node in traces, or 0 if not assigned
+                                               **         yet. */
+};
+
+struct _CMR_SEYMOUR_TRACE
+{
+  FILE* stream;       /**< \brief File stream the events are written to. */
+  double startTime;   /**< \brief Wall clock time in microseconds at creation of the trace. */
+  size_t numEvents;   /**< \brief Number of events written so far. */
+  size_t numNodes;    /**< \brief Number of nodes that were assigned an identifier so far. */
+#if defined(CMR_WITH_THREADS)
+  pthread_mutex_t mutex;  /**< \brief Mutex protecting all other members, since workers may write events. */
+#endif /* CMR_WITH_THREADS */
 };
 
 typedef struct DecompositionTask
 {
-  CMR_SEYMOUR_NODE* node;         /**< \brief Decomposition node that shall be processed. */
-  struct DecompositionTask* next; /**< \brief Next task in queue. */
-  CMR_SEYMOUR_PARAMS* params;     /**< \brief Parameters for the computation. */
-  CMR_SEYMOUR_STATS* stats;       /**< \brief Statistics for the computation (may be \c NULL). */
-  clock_t startClock;             /**< \brief Clock for the start time. */
-  double timeLimit;               /**< \brief Time limit to impose. */
+  CMR_SEYMOUR_NODE* node;          /**< \brief Decomposition node that shall be processed. */
+  struct DecompositionTask* left;  /**< \brief Left child in the heap of the queue. */
+  struct DecompositionTask* right; /**< \brief Right child in the heap of the queue. */
+  size_t rank;                     /**< \brief Length of the right spine of the subheap rooted at this task. */
+  uint64_t priority;               /**< \brief Priority in the queue; smaller values are processed first. */
+  uint64_t sequence;               /**< \brief Number of tasks added to the queue before this one. */
+  CMR_SEYMOUR_PARAMS* params;      /**< \brief Parameters for the computation. */
+  CMR_SEYMOUR_STATS* stats;        /**< \brief Statistics for the computation (may be \c NULL). */
+  clock_t startClock;              /**< \brief Clock for the start time. */
+  double timeLimit;                /**< \brief Time limit to impose. */
 } DecompositionTask;
 
 
@@ -157,6 +179,19 @@ CMR_ERROR CMRseymourAddMinor(
   CMR_MINOR* minor        /**< Minor to be added. */
 );
 
+/**
+ * \brief Clones \p node into \p *pclone, which shares the children of \p node by reference.
+ *
+ * The matrices, maps, minors and graphs are copied. Data that is only used while decomposing \p node, e.g., its
+ * nested minors, is not copied.
+ */
+
+CMR_ERROR CMRseymourCloneShallow(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* node,   /**< Seymour decomposition node. */
+  CMR_SEYMOUR_NODE** pclone /**< Pointer for storing the clone. */
+);
+
 /**
  * \brief Sets the number of children and allocates memory accordingly.
  */
@@ -276,7 +311,8 @@ CMR_ERROR CMRregularityTaskFree(
 
 typedef struct DecompositionQueue
 {
-  DecompositionTask* head;    /**< \brief Next task to be processed. */
+  DecompositionTask* root;    /**< \brief Root of the leftist heap of tasks; it is processed next. */
+  uint64_t numAdded;          /**< \brief Number of tasks added so far. */
   bool foundIrregularity;     /**< \brief Whether irregularity was detected for some node. */
   bool foundNongraphicness;   /**< \brief Whether non-graphiness was detected for some node. */
   bool foundNoncographicness; /**< \brief Whether non-cographiness was detected for some node. */
@@ -309,7 +345,9 @@ bool CMRregularityQueueEmpty(
 );
 
 /**
- * \brief Removes a task from a decomposition queue.
+ * \brief Removes the task with the highest priority from a decomposition queue.
+ *
+ * The priorities are determined by \ref CMR_SEYMOUR_PARAMS.schedule of the tasks' parameters.
  */
 
 DecompositionTask* CMRregularityQueueRemove(
@@ -471,6 +509,26 @@ CMR_ERROR CMRregularitySearchOnesum(
   DecompositionQueue* queue /**< Queue of unprocessed nodes. */
 );
 
+/**
+ * \brief Decomposes a modified binary matrix, reusing the decomposition of \p previous for unchanged 1-connected
+ *        components.
+ *
+ * See \ref CMRregularUpdateDecomposition for the meaning of the parameters.
+ */
+
+CMR_ERROR CMRregularityUpdateDecomposition(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* previous, /**< Root of the decomposition of the previous matrix. */
+  CMR_CHRMAT* matrix,         /**< New matrix. */
+  size_t* rowsToPrevious,     /**< Array mapping rows of \p matrix to previous rows or \c SIZE_MAX (may be \c NULL). */
+  size_t* columnsToPrevious,  /**< Array mapping columns of \p matrix to previous columns or \c SIZE_MAX
+                               **  (may be \c NULL). */
+  CMR_SEYMOUR_NODE** proot,   /**< Pointer for storing the root of the new decomposition. */
+  CMR_SEYMOUR_PARAMS* params, /**< Parameters for the computation. */
+  CMR_SEYMOUR_STATS* stats,   /**< Statistics for the computation (may be \c NULL). */
+  double timeLimit            /**< Time limit to impose. */
+);
+
 /**
  * \brief Tests ternary or binary linear matroid for regularity.
  *
@@ -30,6 +30,13 @@ CMR_ERROR CMRsort(CMR* cmr, size_t length, void* array, size_t elementSize, int
   return CMR_OKAY;
 }
 
+int CMRsortCompareIndices(const void* pa, const void* pb)
+{
+  size_t a = *((const size_t*) pa);
+  size_t b = *((const size_t*) pb);
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
 CMR_ERROR CMRsort2(CMR* cmr, size_t length, void* array1, size_t elementSize1, void* array2, size_t elementSize2,
   int (*compare)(const void**, const void**))
 {
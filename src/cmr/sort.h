@@ -22,6 +22,15 @@ CMR_ERROR CMRsort(
   int (*compare)(const void*, const void*)  /**< Comparison function for comparing two elements. */
 );
 
+/**
+ * \brief Compares two \c size_t values, e.g., row or column indices, for sorting them in increasing order.
+ */
+
+int CMRsortCompareIndices(
+  const void* pa, /**< Pointer to the first index. */
+  const void* pb  /**< Pointer to the second index. */
+);
+
 /**
  * \brief Sorts two arrays simultaneously.
  *
@@ -6,7 +6,9 @@
 #include "block_decomposition.h"
 #include "camion_internal.h"
 #include "hereditary_property.h"
+#include "parallel.h"
 #include "seymour_internal.h"
+#include "sort.h"
 
 #include <stdlib.h>
 #include <assert.h>
@@ -20,6 +22,7 @@ CMR_ERROR CMRtuParamsInit(CMR_TU_PARAMS* params)
   params->ternary = true;
   params->camionFirst = true;
   params->naiveSubmatrix = false;
+  params->screeningBudget = 0;
   CMR_CALL( CMRseymourParamsInit(&params->seymour) );
 
   return CMR_OKAY;
@@ -42,6 +45,35 @@ CMR_ERROR CMRtuStatsInit(CMR_TU_STATS* stats)
   stats->partitionColumnSubsets = 0;
   stats->partitionTime = 0.0;
 
+  stats->screeningCount = 0;
+  stats->screeningSuccess = 0;
+  stats->screeningTime = 0.0;
+
+  return CMR_OKAY;
+}
+
+CMR_ERROR CMRtuStatsAdd(CMR_TU_STATS* target, CMR_TU_STATS* source)
+{
+  assert(target);
+  assert(source);
+
+  CMR_CALL( CMRseymourStatsAdd(&target->seymour, &source->seymour) );
+  CMR_CALL( CMRcamionStatsAdd(&target->camion, &source->camion) );
+
+  target->enumerationTotalCount += source->enumerationTotalCount;
+  target->enumerationRowSubsets += source->enumerationRowSubsets;
+  target->enumerationColumnSubsets += source->enumerationColumnSubsets;
+  target->enumerationTime += source->enumerationTime;
+
+  target->partitionTotalCount += source->partitionTotalCount;
+  target->partitionRowSubsets += source->partitionRowSubsets;
+  target->partitionColumnSubsets += source->partitionColumnSubsets;
+  target->partitionTime += source->partitionTime;
+
+  target->screeningCount += source->screeningCount;
+  target->screeningSuccess += source->screeningSuccess;
+  target->screeningTime += source->screeningTime;
+
   return CMR_OKAY;
 }
 
@@ -81,13 +113,21 @@ CMR_ERROR CMRtuStatsPrint(FILE* stream, CMR_TU_STATS* stats, const char* prefix)
       stats->partitionTime);
   }
 
+  if (stats->screeningCount)
+  {
+    fprintf(stream, "%sscreening successes: %lu\n", prefix, (unsigned long)stats->screeningSuccess);
+    fprintf(stream, "%sscreening total: %lu in %f seconds\n", prefix, (unsigned long)stats->screeningCount,
+      stats->screeningTime);
+  }
+
   return CMR_OKAY;
 }
 
 typedef struct
 {
-  CMR_TU_STATS* stats;
-  CMR_TU_PARAMS* params;
+  CMR* cmr;                   /**< \brief \ref CMR environment of the caller. */
+  CMR_TU_STATS* workerStats;  /**< \brief Statistics per worker (may be \c NULL). */
+  CMR_TU_PARAMS* params;      /**< \brief Parameters for the tests. */
 } HereditaryPropertyTestData;
 
 static
@@ -96,7 +136,8 @@ CMR_ERROR tuDecomposition(
   CMR_CHRMAT* matrix,         /**< Some matrix to be tested for total unimodularity. */
   void* data,                 /**< Additional data (must be \c NULL). */
   bool* pisTotallyUnimodular, /**< Pointer for storing whether \p matrix is totally unimodular. */
-  CMR_SUBMAT** psubmatrix,    /**< Pointer for storing a proper non-totally unimodular submatrix of \p matrix. */
+  CMR_SUBMAT** psubmatrix,    /**< Pointer for storing a non-totally unimodular submatrix of \p matrix
+                               **  (may be \c NULL). */
   double timeLimit            /**< Time limit to impose. */
 )
 {
@@ -105,8 +146,6 @@ CMR_ERROR tuDecomposition(
   assert(pisTotallyUnimodular);
   assert(!psubmatrix || !*psubmatrix);
 
-  CMR_UNUSED(psubmatrix); /* TODO: Make use of submatrices. */
-
   HereditaryPropertyTestData* testData = (HereditaryPropertyTestData*) data;
 
 #if defined(CMR_DEBUG)
@@ -116,11 +155,23 @@ CMR_ERROR tuDecomposition(
 #endif /* CMR_DEBUG */
 
   *pisTotallyUnimodular = true;
-  clock_t time = clock();
-
-  double remainingTime = timeLimit - ((clock() - time) * 1.0 / CLOCKS_PER_SEC);
-  CMR_CALL( CMRtuTest(cmr, matrix, pisTotallyUnimodular, NULL, NULL, testData->params,
-    testData->stats ? testData->stats : NULL, remainingTime) );
+  double startTime = CMRwallClock();
+
+  double remainingTime = timeLimit - (CMRwallClock() - startTime);
+  CMR_TU_STATS* stats = NULL;
+  if (testData->workerStats)
+    stats = &testData->workerStats[CMRparallelWorkerIndex(testData->cmr, cmr)];
+  CMR_SEYMOUR_NODE* root = NULL;
+  CMR_CALL( CMRtuTest(cmr, matrix, pisTotallyUnimodular, psubmatrix ? &root : NULL, NULL, testData->params, stats,
+    remainingTime) );
+
+  /* A violator that is known in the decomposition tree lets the caller skip many candidates. */
+  if (root)
+  {
+    if (!*pisTotallyUnimodular)
+      CMR_CALL( CMRseymourExtractViolator(cmr, root, psubmatrix) );
+    CMR_CALL( CMRseymourRelease(cmr, &root) );
+  }
 
   return CMR_OKAY;
 }
@@ -262,12 +313,10 @@ CMR_ERROR tuEulerianColumns(
 
 /**
  * \brief Recursive enumeration of row subsets and subsequent testing of total unimodularity.
- *
- * \returns \c true if we can stop (due to time limit or a found violating submatrix).
  */
 
 static
-bool tuEulerianRows(
+CMR_ERROR tuEulerianRows(
   CMR_TU_ENUMERATION* enumeration,  /**< Enumeration information. */
   size_t numRows                    /**< Number of already selected rows. */
 )
@@ -407,6 +456,9 @@ CMR_ERROR tuEulerian(
   enumeration.sumEntries = 0;
   *pisTotallyUnimodular = true;
 
+  /* All stack memory of the enumeration is released at once, also if the enumeration fails. */
+  CMR_STACKMARK stackMark;
+  CMR_CALL( CMRstackMark(cmr, &stackMark) );
   CMR_CALL( CMRallocStackArray(cmr, &enumeration.subsetRows, matrix->numRows) );
   CMR_CALL( CMRallocStackArray(cmr, &enumeration.usableColumns, matrix->numColumns) );
   CMR_CALL( CMRallocStackArray(cmr, &enumeration.subsetUsable, matrix->numColumns) );
@@ -426,8 +478,8 @@ CMR_ERROR tuEulerian(
     CMRassertStackConsistency(cmr);
     CMRdbgMsg(8, "Considering submatrices of size %zux%zu.\n", enumeration.cardinality, enumeration.cardinality);
     CMRassertStackConsistency(cmr);
-    CMR_CALL( tuEulerianRows(&enumeration, 0) );
-    if (!*pisTotallyUnimodular || enumeration.timeLimit <= 0)
+    error = tuEulerianRows(&enumeration, 0);
+    if (error || !*pisTotallyUnimodular || enumeration.timeLimit <= 0)
       break;
   }
 
@@ -437,16 +489,12 @@ CMR_ERROR tuEulerian(
     stats->enumerationTime += (clock() - enumeration.startClock) * 1.0 / CLOCKS_PER_SEC;
   }
 
-  CMRassertStackConsistency(cmr);
-
-  CMR_CALL( CMRfreeStackArray(cmr, &enumeration.columnsNumNonzeros) );
-  CMR_CALL( CMRfreeStackArray(cmr, &enumeration.rowsNumNonzeros) );
-  CMR_CALL( CMRfreeStackArray(cmr, &enumeration.subsetUsable) );
-  CMR_CALL( CMRfreeStackArray(cmr, &enumeration.usableColumns) );
-  CMR_CALL( CMRfreeStackArray(cmr, &enumeration.subsetRows) );
+  CMR_CALL( CMRstackRelease(cmr, &stackMark, NULL) );
 
   CMRassertStackConsistency(cmr);
 
+  CMR_CALL( error );
+
   if (enumeration.timeLimit <= 0)
     return CMR_ERROR_TIMEOUT;
 
@@ -645,6 +693,568 @@ CMR_ERROR tuPartition(
   return error;
 }
 
+/**
+ * \brief A pair of nonzero columns of a row, used by the screening for small violators.
+ */
+
+typedef struct
+{
+  size_t first;     /**< \brief Smaller column. */
+  size_t second;    /**< \brief Larger column. */
+  size_t row;       /**< \brief Row containing both nonzeros. */
+  int sign;         /**< \brief Product of the two nonzeros. */
+} TuScreeningPair;
+
+/**
+ * \brief Row and its number of nonzeros, used to process sparse rows first.
+ */
+
+typedef struct
+{
+  size_t degree;    /**< \brief Number of nonzeros of the row. */
+  size_t row;       /**< \brief Row. */
+} TuScreeningRow;
+
+/**
+ * \brief Data of the screening for small violators.
+ */
+
+typedef struct
+{
+  CMR* cmr;                     /**< \brief \ref CMR environment. */
+  CMR_CHRMAT* matrix;           /**< \brief Matrix \f$ M \f$. */
+  CMR_CHRMAT* transpose;        /**< \brief Transpose of \f$ M \f$. */
+  size_t budget;                /**< \brief Remaining number of elementary steps. */
+  TuScreeningPair* pairs;       /**< \brief Sorted array of pairs of nonzeros of (sparse) rows. */
+  size_t numPairs;              /**< \brief Length of \ref pairs. */
+  bool isTotallyUnimodular;     /**< \brief Whether no violator was found, yet. */
+  CMR_SUBMAT** psubmatrix;      /**< \brief Pointer for storing the violator (may be \c NULL). */
+} TuScreening;
+
+static
+int compareScreeningPairs(const void* pa, const void* pb)
+{
+  const TuScreeningPair* a = (const TuScreeningPair*) pa;
+  const TuScreeningPair* b = (const TuScreeningPair*) pb;
+  if (a->first != b->first)
+    return a->first < b->first ? -1 : 1;
+  if (a->second != b->second)
+    return a->second < b->second ? -1 : 1;
+  if (a->sign != b->sign)
+    return a->sign < b->sign ? -1 : 1;
+  return a->row < b->row ? -1 : (a->row > b->row ? 1 : 0);
+}
+
+static
+int compareScreeningRows(const void* pa, const void* pb)
+{
+  const TuScreeningRow* a = (const TuScreeningRow*) pa;
+  const TuScreeningRow* b = (const TuScreeningRow*) pb;
+  if (a->degree != b->degree)
+    return a->degree < b->degree ? -1 : 1;
+  return a->row < b->row ? -1 : (a->row > b->row ? 1 : 0);
+}
+
+/**
+ * \brief Pseudo-random number generator (xorshift) of the screening, which keeps it deterministic.
+ */
+
+static inline
+uint64_t screeningRandom(
+  uint64_t* pstate  /**< Pointer to the state of the generator. */
+)
+{
+  uint64_t x = *pstate;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *pstate = x;
+  return x;
+}
+
+/**
+ * \brief Returns the entry of \p matrix at (\p row, \p column).
+ */
+
+static
+CMR_ERROR screeningEntry(
+  CMR_CHRMAT* matrix, /**< Matrix. */
+  size_t row,         /**< Row. */
+  size_t column,      /**< Column. */
+  int* pvalue         /**< Pointer for storing the entry. */
+)
+{
+  size_t entry;
+  CMR_CALL( CMRchrmatFindEntry(matrix, row, column, &entry) );
+  *pvalue = (entry == SIZE_MAX) ? 0 : matrix->entryValues[entry];
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Records the square violator with the given rows and columns, which are sorted in place.
+ */
+
+static
+CMR_ERROR screeningFound(
+  TuScreening* screening, /**< Screening data. */
+  size_t size,            /**< Number of rows and columns of the violator. */
+  size_t* rows,           /**< Rows of the violator. */
+  size_t* columns         /**< Columns of the violator. */
+)
+{
+  assert(screening);
+
+  CMRdbgMsg(2, "Screening found a %zux%zu violator.\n", size, size);
+
+  screening->isTotallyUnimodular = false;
+  if (!screening->psubmatrix)
+    return CMR_OKAY;
+
+  CMR_CALL( CMRsort(screening->cmr, size, rows, sizeof(size_t), CMRsortCompareIndices) );
+  CMR_CALL( CMRsort(screening->cmr, size, columns, sizeof(size_t), CMRsortCompareIndices) );
+  CMR_CALL( CMRsubmatCreate(screening->cmr, size, size, screening->psubmatrix) );
+  for (size_t i = 0; i < size; ++i)
+  {
+    (*screening->psubmatrix)->rows[i] = rows[i];
+    (*screening->psubmatrix)->columns[i] = columns[i];
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Collects the pairs of nonzeros of the sparsest rows and searches for 2-by-2 violators among them.
+ *
+ * Rows are processed by increasing number of nonzeros as long as the number of pairs stays within \p maxPairs.
+ * Afterwards, pairs are grouped by their columns, and a group with both signs yields a 2-by-2 violator.
+ */
+
+static
+CMR_ERROR screeningPairs(
+  TuScreening* screening, /**< Screening data. */
+  size_t maxPairs         /**< Maximum number of pairs to collect. */
+)
+{
+  assert(screening);
+
+  CMR* cmr = screening->cmr;
+  CMR_CHRMAT* matrix = screening->matrix;
+
+  TuScreeningRow* rows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rows, matrix->numRows) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    rows[row].degree = matrix->rowSlice[row + 1] - matrix->rowSlice[row];
+    rows[row].row = row;
+  }
+  CMR_CALL( CMRsort(cmr, matrix->numRows, rows, sizeof(TuScreeningRow), compareScreeningRows) );
+
+  size_t numRows = 0;
+  size_t numPairs = 0;
+  for (; numRows < matrix->numRows; ++numRows)
+  {
+    size_t degree = rows[numRows].degree;
+    size_t rowPairs = degree * (degree - (degree > 0 ? 1 : 0)) / 2;
+    if (numPairs + rowPairs > maxPairs)
+      break;
+    numPairs += rowPairs;
+  }
+
+  CMRdbgMsg(2, "Screening collects %zu pairs of the %zu sparsest rows.\n", numPairs, numRows);
+
+  CMR_CALL( CMRallocBlockArray(cmr, &screening->pairs, numPairs > 0 ? numPairs : 1) );
+  screening->numPairs = 0;
+  for (size_t r = 0; r < numRows; ++r)
+  {
+    size_t row = rows[r].row;
+    size_t first = matrix->rowSlice[row];
+    size_t beyond = matrix->rowSlice[row + 1];
+    for (size_t e1 = first; e1 < beyond; ++e1)
+    {
+      for (size_t e2 = e1 + 1; e2 < beyond; ++e2)
+      {
+        TuScreeningPair* pair = &screening->pairs[screening->numPairs++];
+        pair->first = matrix->entryColumns[e1];
+        pair->second = matrix->entryColumns[e2];
+        pair->row = row;
+        pair->sign = matrix->entryValues[e1] * matrix->entryValues[e2];
+      }
+    }
+  }
+  assert(screening->numPairs == numPairs);
+  screening->budget -= numPairs;
+
+  CMR_CALL( CMRfreeStackArray(cmr, &rows) );
+
+  CMR_CALL( CMRsort(cmr, screening->numPairs, screening->pairs, sizeof(TuScreeningPair), compareScreeningPairs) );
+
+  /* The 2-by-2 submatrix has determinant -2 or +2 if and only if the products of its rows differ. */
+  for (size_t begin = 0; begin < screening->numPairs; )
+  {
+    size_t end = begin + 1;
+    while (end < screening->numPairs && screening->pairs[end].first == screening->pairs[begin].first
+      && screening->pairs[end].second == screening->pairs[begin].second)
+    {
+      ++end;
+    }
+
+    if (screening->pairs[begin].sign != screening->pairs[end - 1].sign)
+    {
+      size_t violatorRows[2] = { screening->pairs[begin].row, screening->pairs[end - 1].row };
+      size_t violatorColumns[2] = { screening->pairs[begin].first, screening->pairs[begin].second };
+      CMR_CALL( screeningFound(screening, 2, violatorRows, violatorColumns) );
+      return CMR_OKAY;
+    }
+
+    begin = end;
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Returns the index of the first pair with columns \p first and \p second, or \c numPairs if there is none.
+ */
+
+static
+size_t screeningFindPairs(
+  TuScreening* screening, /**< Screening data. */
+  size_t first,           /**< Smaller column. */
+  size_t second           /**< Larger column. */
+)
+{
+  size_t lower = 0;
+  size_t upper = screening->numPairs;
+  while (lower < upper)
+  {
+    size_t middle = (lower + upper) / 2;
+    TuScreeningPair* pair = &screening->pairs[middle];
+    if (pair->first < first || (pair->first == first && pair->second < second))
+      lower = middle + 1;
+    else
+      upper = middle;
+  }
+
+  if (lower < screening->numPairs && screening->pairs[lower].first == first && screening->pairs[lower].second == second)
+    return lower;
+  return screening->numPairs;
+}
+
+#if !defined(NDEBUG)
+
+/**
+ * \brief Returns \c true if the nonzeros of each row of \p matrix are sorted by column.
+ */
+
+static
+bool screeningIsSorted(
+  CMR_CHRMAT* matrix  /**< Matrix. */
+)
+{
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    for (size_t e = matrix->rowSlice[row] + 1; e < matrix->rowSlice[row + 1]; ++e)
+    {
+      if (matrix->entryColumns[e - 1] >= matrix->entryColumns[e])
+        return false;
+    }
+  }
+
+  return true;
+}
+
+#endif /* !NDEBUG */
+
+/**
+ * \brief Searches for 3-by-3 violators, i.e., chordless cycles of length 6 in the bipartite graph.
+ *
+ * For a pair \f$ (i; c, d) \f$, each row \f$ j \f$ with a nonzero in column \f$ c \f$ and each further nonzero column
+ * \f$ e \f$ of \f$ j \f$ is considered. The third row \f$ k \f$ is looked up among the pairs \f$ (k; d, e) \f$. Each
+ * considered triple of rows costs one step of the budget. Entries are looked up by binary search, which is why the
+ * nonzeros of \p matrix must be sorted.
+ */
+
+static
+CMR_ERROR screeningHexagons(
+  TuScreening* screening, /**< Screening data. */
+  size_t minBudget        /**< Budget to leave for subsequent steps. */
+)
+{
+  assert(screening);
+
+  CMR_CHRMAT* matrix = screening->matrix;
+  CMR_CHRMAT* transpose = screening->transpose;
+  assert(screeningIsSorted(matrix));
+
+  for (size_t p = 0; p < screening->numPairs; ++p)
+  {
+    size_t i = screening->pairs[p].row;
+    size_t c = screening->pairs[p].first;
+    size_t d = screening->pairs[p].second;
+    int a_ic, a_id;
+    CMR_CALL( screeningEntry(matrix, i, c, &a_ic) );
+    CMR_CALL( screeningEntry(matrix, i, d, &a_id) );
+
+    /* Both orientations of (c,d) are needed since rows j are only taken from the column of c. */
+    for (size_t orientation = 0; orientation < 2; ++orientation)
+    {
+      if (orientation == 1)
+      {
+        size_t temp = c;
+        c = d;
+        d = temp;
+        int tempValue = a_ic;
+        a_ic = a_id;
+        a_id = tempValue;
+      }
+
+      size_t first = transpose->rowSlice[c];
+      size_t beyond = transpose->rowSlice[c + 1];
+      for (size_t e1 = first; e1 < beyond; ++e1)
+      {
+        if (screening->budget <= minBudget)
+          return CMR_OKAY;
+        --screening->budget;
+
+        size_t j = transpose->entryColumns[e1];
+        if (j == i)
+          continue;
+        int a_jc = transpose->entryValues[e1];
+        int a_jd;
+        CMR_CALL( screeningEntry(matrix, j, d, &a_jd) );
+        if (a_jd)
+          continue;
+
+        for (size_t e2 = matrix->rowSlice[j]; e2 < matrix->rowSlice[j + 1]; ++e2)
+        {
+          size_t e = matrix->entryColumns[e2];
+          if (e == c)
+            continue;
+          if (screening->budget <= minBudget)
+            return CMR_OKAY;
+          --screening->budget;
+
+          int a_je = matrix->entryValues[e2];
+          int a_ie;
+          CMR_CALL( screeningEntry(matrix, i, e, &a_ie) );
+          if (a_ie)
+            continue;
+
+          for (size_t q = screeningFindPairs(screening, d < e ? d : e, d < e ? e : d); q < screening->numPairs
+            && screening->pairs[q].first == (d < e ? d : e) && screening->pairs[q].second == (d < e ? e : d); ++q)
+          {
+            if (screening->budget <= minBudget)
+              return CMR_OKAY;
+            --screening->budget;
+
+            size_t k = screening->pairs[q].row;
+            if (k == i || k == j)
+              continue;
+            int a_kc;
+            CMR_CALL( screeningEntry(matrix, k, c, &a_kc) );
+            if (a_kc)
+              continue;
+
+            int a_kd, a_ke;
+            CMR_CALL( screeningEntry(matrix, k, d, &a_kd) );
+            CMR_CALL( screeningEntry(matrix, k, e, &a_ke) );
+            int sum = a_ic + a_id + a_jc + a_je + a_kd + a_ke;
+            if (sum % 4 != 0)
+            {
+              size_t violatorRows[3] = { i, j, k };
+              size_t violatorColumns[3] = { c, d, e };
+              CMR_CALL( screeningFound(screening, 3, violatorRows, violatorColumns) );
+              return CMR_OKAY;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Searches for larger violators via random walks in the bipartite graph.
+ *
+ * Each walk alternates between rows and columns until it reaches a row or column visited before. The closed cycle
+ * is a violator if it is chordless and if the sum of its entries is not divisible by 4.
+ */
+
+static
+CMR_ERROR screeningWalks(
+  TuScreening* screening  /**< Screening data. */
+)
+{
+  assert(screening);
+
+  CMR* cmr = screening->cmr;
+  CMR_CHRMAT* matrix = screening->matrix;
+  CMR_CHRMAT* transpose = screening->transpose;
+  if (matrix->numRows == 0)
+    return CMR_OKAY;
+
+  /* Path elements at even positions are rows and those at odd positions are columns. */
+  size_t* path = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &path, matrix->numRows + matrix->numColumns + 1) );
+  size_t* rowsPosition = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &rowsPosition, matrix->numRows) );
+  for (size_t row = 0; row < matrix->numRows; ++row)
+    rowsPosition[row] = SIZE_MAX;
+  size_t* columnsPosition = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &columnsPosition, matrix->numColumns) );
+  for (size_t column = 0; column < matrix->numColumns; ++column)
+    columnsPosition[column] = SIZE_MAX;
+  size_t* violatorRows = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &violatorRows, matrix->numRows) );
+  size_t* violatorColumns = NULL;
+  CMR_CALL( CMRallocStackArray(cmr, &violatorColumns, matrix->numColumns) );
+
+  uint64_t state = 0x9E3779B97F4A7C15ULL ^ (uint64_t) matrix->numNonzeros;
+  while (screening->budget > 0 && screening->isTotallyUnimodular)
+  {
+    size_t length = 0;
+    size_t cycleStart = SIZE_MAX;
+    path[length++] = screeningRandom(&state) % matrix->numRows;
+    rowsPosition[path[0]] = 0;
+    while (screening->budget > 0)
+    {
+      --screening->budget;
+
+      /* Choose a random neighbor of the last element, avoiding the previous one. */
+      bool atRow = (length % 2) == 1;
+      CMR_CHRMAT* adjacency = atRow ? matrix : transpose;
+      size_t current = path[length - 1];
+      size_t previous = length >= 2 ? path[length - 2] : SIZE_MAX;
+      size_t first = adjacency->rowSlice[current];
+      size_t degree = adjacency->rowSlice[current + 1] - first;
+      if (degree == 0 || (degree == 1 && adjacency->entryColumns[first] == previous))
+        break;
+      size_t e = first + screeningRandom(&state) % degree;
+      if (adjacency->entryColumns[e] == previous)
+        e = (e + 1 < first + degree) ? e + 1 : first;
+      size_t next = adjacency->entryColumns[e];
+
+      size_t* positions = atRow ? columnsPosition : rowsPosition;
+      if (positions[next] != SIZE_MAX)
+      {
+        cycleStart = positions[next];
+        break;
+      }
+      positions[next] = length;
+      path[length++] = next;
+    }
+
+    if (cycleStart < SIZE_MAX)
+    {
+      /* Collect the rows and columns of the cycle and check that each row has exactly two nonzeros in it. */
+      size_t size = 0;
+      size_t numColumns = 0;
+      for (size_t i = cycleStart; i < length; ++i)
+      {
+        if (i % 2 == 0)
+          violatorRows[size++] = path[i];
+        else
+          violatorColumns[numColumns++] = path[i];
+      }
+      assert(size == numColumns);
+
+      bool chordless = true;
+      int sum = 0;
+      for (size_t r = 0; r < size && chordless; ++r)
+      {
+        size_t row = violatorRows[r];
+        size_t first = matrix->rowSlice[row];
+        size_t beyond = matrix->rowSlice[row + 1];
+        size_t count = 0;
+        for (size_t e = first; e < beyond; ++e)
+        {
+          size_t position = columnsPosition[matrix->entryColumns[e]];
+          if (position != SIZE_MAX && position >= cycleStart)
+          {
+            ++count;
+            sum += matrix->entryValues[e];
+          }
+        }
+        screening->budget -= (beyond - first) < screening->budget ? (beyond - first) : screening->budget;
+        chordless = (count == 2);
+      }
+
+      if (chordless && sum % 4 != 0)
+        CMR_CALL( screeningFound(screening, size, violatorRows, violatorColumns) );
+    }
+
+    /* Reset the positions. */
+    for (size_t i = 0; i < length; ++i)
+    {
+      if (i % 2 == 0)
+        rowsPosition[path[i]] = SIZE_MAX;
+      else
+        columnsPosition[path[i]] = SIZE_MAX;
+    }
+  }
+
+  CMR_CALL( CMRfreeStackArray(cmr, &violatorColumns) );
+  CMR_CALL( CMRfreeStackArray(cmr, &violatorRows) );
+  CMR_CALL( CMRfreeStackArray(cmr, &columnsPosition) );
+  CMR_CALL( CMRfreeStackArray(cmr, &rowsPosition) );
+  CMR_CALL( CMRfreeStackArray(cmr, &path) );
+
+  return CMR_OKAY;
+}
+
+/**
+ * \brief Screens a ternary matrix for small violators within a budget of elementary steps.
+ *
+ * A quarter of the budget is used to collect pairs of nonzeros of sparse rows, which reveal all 2-by-2 violators
+ * among these rows. Another half is used to search for 3-by-3 violators based on these pairs. The remaining budget is
+ * spent on random walks that sample larger cycle submatrices.
+ */
+
+static
+CMR_ERROR tuScreening(
+  CMR* cmr,                   /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,         /**< Matrix \f$ M \f$. */
+  size_t budget,              /**< Number of elementary steps. */
+  bool* pisTotallyUnimodular, /**< Pointer for storing whether no violator was found. */
+  CMR_SUBMAT** psubmatrix     /**< Pointer for storing a violator (may be \c NULL). */
+)
+{
+  assert(cmr);
+  assert(matrix);
+  assert(pisTotallyUnimodular);
+
+  TuScreening screening;
+  screening.cmr = cmr;
+  screening.matrix = matrix;
+  screening.transpose = NULL;
+  screening.budget = budget;
+  screening.pairs = NULL;
+  screening.numPairs = 0;
+  screening.isTotallyUnimodular = true;
+  screening.psubmatrix = psubmatrix;
+
+  CMR_CALL( screeningPairs(&screening, budget / 4) );
+  if (screening.isTotallyUnimodular)
+  {
+    CMR_CALL( CMRchrmatTranspose(cmr, matrix, &screening.transpose) );
+    CMR_CALL( screeningHexagons(&screening, budget / 4) );
+    if (screening.isTotallyUnimodular)
+      CMR_CALL( screeningWalks(&screening) );
+    CMR_CALL( CMRchrmatFree(cmr, &screening.transpose) );
+  }
+  CMR_CALL( CMRfreeBlockArray(cmr, &screening.pairs) );
+
+  CMRdbgMsg(2, "Screening %s a violator with %zu of %zu steps left.\n",
+    screening.isTotallyUnimodular ? "did not find" : "found", screening.budget, budget);
+
+  *pisTotallyUnimodular = screening.isTotallyUnimodular;
+
+  return CMR_OKAY;
+}
+
 CMR_ERROR CMRtuTest(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CMR_SEYMOUR_NODE** proot,
   CMR_SUBMAT** psubmatrix, CMR_TU_PARAMS* params, CMR_TU_STATS* stats, double timeLimit)
 {
@@ -659,7 +1269,8 @@ CMR_ERROR CMRtuTest(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CM
     params = &defaultParams;
   }
 
-  clock_t totalClock = clock();
+  /* Workers of the violator search run in parallel, so the time limit refers to wall clock time. */
+  double startTime = CMRwallClock();
 
   if (!CMRchrmatIsTernary(cmr, matrix, psubmatrix))
   {
@@ -668,7 +1279,28 @@ CMR_ERROR CMRtuTest(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CM
     return CMR_OKAY;
   }
 
-  double remainingTime = timeLimit - ((clock() - totalClock) * 1.0 / CLOCKS_PER_SEC);
+  if (params->screeningBudget > 0)
+  {
+    clock_t screeningClock = clock();
+    bool isTotallyUnimodular;
+    CMR_CALL( tuScreening(cmr, matrix, params->screeningBudget, &isTotallyUnimodular, psubmatrix) );
+    if (stats)
+    {
+      stats->screeningCount++;
+      if (!isTotallyUnimodular)
+        stats->screeningSuccess++;
+      stats->screeningTime += (clock() - screeningClock) * 1.0 / CLOCKS_PER_SEC;
+    }
+
+    if (!isTotallyUnimodular)
+    {
+      if (pisTotallyUnimodular)
+        *pisTotallyUnimodular = false;
+      return CMR_OKAY;
+    }
+  }
+
+  double remainingTime = timeLimit - (CMRwallClock() - startTime);
 
   CMRdbgMsg(0, "CMRtuTest called with algorithm = %d.\n", params->algorithm);
 
@@ -684,7 +1316,7 @@ CMR_ERROR CMRtuTest(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CM
         return CMR_OKAY;
     }
 
-    double remainingTime = timeLimit - ((clock() - totalClock) * 1.0 / CLOCKS_PER_SEC);
+    double remainingTime = timeLimit - (CMRwallClock() - startTime);
 
     CMR_SEYMOUR_NODE* root = NULL;
     CMR_ERROR error = CMRseymourDecompose(cmr, matrix, params->ternary, &root, &(params->seymour),
@@ -699,6 +1331,11 @@ CMR_ERROR CMRtuTest(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CM
     int8_t regularity = CMRseymourRegularity(root);
     if (regularity != 0)
       *pisTotallyUnimodular = regularity > 0;
+
+    CMR_SUBMAT* treeViolator = NULL;
+    if (regularity < 0 && psubmatrix)
+      CMR_CALL( CMRseymourExtractViolator(cmr, root, &treeViolator) );
+
     if (proot)
       *proot = root;
     else
@@ -707,16 +1344,66 @@ CMR_ERROR CMRtuTest(CMR* cmr, CMR_CHRMAT* matrix, bool* pisTotallyUnimodular, CM
     if (regularity < 0 && psubmatrix)
     {
       assert(!*psubmatrix);
-      remainingTime = timeLimit - (clock() - totalClock) * 1.0 / CLOCKS_PER_SEC;
+      remainingTime = timeLimit - (CMRwallClock() - startTime);
 
+      /* If the decomposition tree yields a violator, then we only search for a minimal one inside it. */
+      CMR_CHRMAT* searchMatrix = matrix;
+      if (treeViolator)
+      {
+        CMRdbgMsg(2, "Decomposition tree yields a %zux%zu violator.\n", treeViolator->numRows,
+          treeViolator->numColumns);
+        searchMatrix = NULL;
+        CMR_CALL( CMRchrmatSlice(cmr, matrix, treeViolator, &searchMatrix) );
+      }
+
+      /* Each worker accumulates statistics separately, which are added afterwards. */
+      size_t numWorkers = CMRparallelNumWorkers(cmr);
       HereditaryPropertyTestData testData;
-      testData.stats = stats;
+      testData.cmr = cmr;
+      testData.workerStats = NULL;
       testData.params = params;
+      if (stats)
+      {
+        CMR_CALL( CMRallocStackArray(cmr, &testData.workerStats, numWorkers) );
+        for (size_t w = 0; w < numWorkers; ++w)
+          CMR_CALL( CMRtuStatsInit(&testData.workerStats[w]) );
+      }
 
       if (params->naiveSubmatrix)
-        CMR_CALL( CMRtestHereditaryPropertyNaive(cmr, matrix, tuDecomposition, &testData, psubmatrix, remainingTime) );
+      {
+        error = CMRtestHereditaryPropertyNaive(cmr, searchMatrix, tuDecomposition, &testData, psubmatrix,
+          remainingTime);
+      }
       else
-        CMR_CALL( CMRtestHereditaryPropertyGreedy(cmr, matrix, tuDecomposition, &testData, psubmatrix, remainingTime) );
+      {
+        error = CMRtestHereditaryPropertyDeltaDebugging(cmr, searchMatrix, tuDecomposition, &testData, psubmatrix,
+          remainingTime);
+      }
+
+      if (treeViolator)
+      {
+        /* Map the violator of the sliced matrix back. */
+        if (error == CMR_OKAY)
+        {
+          CMR_SUBMAT* submatrix = *psubmatrix;
+          for (size_t r = 0; r < submatrix->numRows; ++r)
+            submatrix->rows[r] = treeViolator->rows[submatrix->rows[r]];
+          for (size_t c = 0; c < submatrix->numColumns; ++c)
+            submatrix->columns[c] = treeViolator->columns[submatrix->columns[c]];
+        }
+        CMR_CALL( CMRchrmatFree(cmr, &searchMatrix) );
+        CMR_CALL( CMRsubmatFree(cmr, &treeViolator) );
+      }
+
+      if (stats)
+      {
+        for (size_t w = 0; w < numWorkers; ++w)
+          CMR_CALL( CMRtuStatsAdd(stats, &testData.workerStats[w]) );
+        CMR_CALL( CMRfreeStackArray(cmr, &testData.workerStats) );
+      }
+      if (error == CMR_ERROR_TIMEOUT)
+        return error;
+      CMR_CALL( error );
 
       return CMR_OKAY;
     }
@@ -359,12 +359,12 @@ CMR_ERROR genMatrixSeriesParallel(
       if (ternary)
       {
         CMR_CALL( CMRspTestTernary(cmr, matrix, NULL, reductions, &numReductions, NULL, &wheelMatrix,
-          &stats, DBL_MAX) );
+          NULL, &stats, DBL_MAX) );
       }
       else
       {
         CMR_CALL( CMRspTestBinary(cmr, matrix, NULL, reductions, &numReductions, NULL, &wheelMatrix,
-          &stats, DBL_MAX) );
+          NULL, &stats, DBL_MAX) );
       }
       numBenchmarkNonzeros += numTotalNonzeros;
 
@@ -33,6 +33,7 @@ CMR_ERROR testComplementTotalUnimodularity(
   char* outputOperationsFileName,   /**< File name for the operations; may be `-' for stdout. */
   char* outputMatrixFileName,       /**< File name for the matrix; may be `-' for stdout. */
   bool printStats,                  /**< Whether to print statistics to stderr. */
+  int numThreads,                   /**< Number of threads to use. */
   double timeLimit                  /**< Time limit to impose. */
 )
 {
@@ -43,6 +44,7 @@ CMR_ERROR testComplementTotalUnimodularity(
 
   CMR* cmr = NULL;
   CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
 
   /* Read matrix. */
 
@@ -218,6 +220,7 @@ int printUsage(const char* program)
 
   fputs("Advanced options:\n", stderr);
   fputs("  --stats            Print statistics about the computation to stderr.\n", stderr);
+  fputs("  --threads NUM      Use NUM threads for testing the complemented matrices; default: 1.\n", stderr);
   fputs("  --time-limit LIMIT Allow at most LIMIT seconds for the computation.\n", stderr);
   fputs("\n", stderr);
 
@@ -239,6 +242,7 @@ int main(int argc, char** argv)
   char* outputMatrixFileName = NULL;
   char* outputOperationsFileName = NULL;
   bool printStats = false;
+  int numThreads = 1;
   double timeLimit = DBL_MAX;
   for (int a = 1; a < argc; ++a)
   {
@@ -319,6 +323,15 @@ int main(int argc, char** argv)
       }
       ++a;
     }
+    else if (!strcmp(argv[a], "--threads") && (a+1 < argc))
+    {
+      if (sscanf(argv[a+1], "%d", &numThreads) == 0 || numThreads <= 0)
+      {
+        fprintf(stderr, "Error: Invalid number of threads <%s> specified.\n\n", argv[a+1]);
+        return printUsage(argv[0]);
+      }
+      ++a;
+    }
     else if (!inputMatrixFileName)
       inputMatrixFileName = argv[a];
     else if (!outputMatrixFileName)
@@ -349,7 +362,7 @@ int main(int argc, char** argv)
   if (task == TASK_RECOGNIZE)
   {
     error = testComplementTotalUnimodularity(inputMatrixFileName, inputFormat, outputFormat, outputOperationsFileName,
-      outputMatrixFileName, printStats, timeLimit);
+      outputMatrixFileName, printStats, numThreads, timeLimit);
   }
   else
   {
@@ -29,6 +29,7 @@ CMR_ERROR testRegularity(
   bool seriesParallel,              /**< Whether to allow series-parallel operations in the decomposition tree. */
   bool simpleThreeSeparations,      /**< Whether to test for simple 3-separations. */
   int decomposeStrategy,            /**< Which strategy to use for 3-separations. */
+  const char* traceFileName,        /**< File name to write a decomposition trace to, or \c NULL. */
   double timeLimit                  /**< Time limit to impose. */
 )
 {
@@ -90,11 +91,31 @@ CMR_ERROR testRegularity(
   params.seymour.seriesParallel = seriesParallel;
   params.seymour.simpleThreeSeparations = simpleThreeSeparations;
   params.seymour.decomposeStrategy = decomposeStrategy;
+  FILE* traceFile = NULL;
+  if (traceFileName)
+  {
+    traceFile = strcmp(traceFileName, "-") ? fopen(traceFileName, "w") : stdout;
+    if (!traceFile)
+    {
+      fprintf(stderr, "Error: Could not open trace file <%s>.\n", traceFileName);
+      CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+      CMR_CALL( CMRfreeEnvironment(&cmr) );
+      return CMR_ERROR_INPUT;
+    }
+    CMR_CALL( CMRseymourTraceCreate(cmr, traceFile, &params.seymour.trace) );
+  }
   CMR_REGULAR_STATS stats;
   CMR_CALL( CMRregularStatsInit(&stats) );
   CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, outputTreeFileName ? &decomposition : NULL,
     outputMinorFileName ? &minor : NULL, &params, &stats, timeLimit) );
 
+  if (traceFile)
+  {
+    CMR_CALL( CMRseymourTraceFree(cmr, &params.seymour.trace) );
+    if (traceFile != stdout)
+      fclose(traceFile);
+  }
+
   fprintf(stderr, "Matrix %sregular.\n", isRegular ? "IS " : "IS NOT ");
 
   if (printStats)
@@ -147,6 +168,8 @@ int printUsage(const char* program)
   fputs("Advanced options:\n", stderr);
   fputs("  --stats              Print statistics about the computation to stderr.\n", stderr);
   fputs("  --time-limit LIMIT   Allow at most LIMIT seconds for the computation.\n", stderr);
+  fputs("  --trace OUT-TRACE    Write a trace of the decomposition in Chrome trace format to file OUT-TRACE.\n",
+    stderr);
   fputs("  --decompose STRATEGY Strategy for decomposing among {DP, YP, P3, D3, Y3}; default: D3.\n", stderr);
   fputs("  --no-direct-graphic  Check only 3-connected matrices for regularity.\n", stderr);
   fputs("  --no-series-parallel Do not allow series-parallel operations in decomposition tree.\n", stderr);
@@ -162,7 +185,7 @@ int printUsage(const char* program)
 
   fputs("Formats for matrices: dense, sparse\n", stderr);
   fputs("If IN-MAT is `-' then the matrix is read from stdin.\n", stderr);
-  fputs("If OUT-DEC or NON-MINOR is `-' then the decomposition tree (resp. the minor) is written to stdout.\n", stderr);
+  fputs("If OUT-DEC, NON-MINOR or OUT-TRACE is `-' then the respective output is written to stdout.\n", stderr);
 
   return EXIT_FAILURE;
 }
@@ -173,6 +196,7 @@ int main(int argc, char** argv)
   FileFormat inputFormat = FILEFORMAT_MATRIX_DENSE;
   char* outputTree = NULL;
   char* outputMinor = NULL;
+  char* outputTrace = NULL;
   bool printStats = false;
   bool directGraphicness = true;
   bool seriesParallel = true;
@@ -206,6 +230,8 @@ int main(int argc, char** argv)
       outputMinor = argv[++a];
     else if (!strcmp(argv[a], "--stats"))
       printStats = true;
+    else if (!strcmp(argv[a], "--trace") && a+1 < argc)
+      outputTrace = argv[++a];
     else if (!strcmp(argv[a], "--no-direct-graphic"))
       directGraphicness = false;
     else if (!strcmp(argv[a], "--no-series-parallel"))
@@ -272,7 +298,7 @@ int main(int argc, char** argv)
 
   CMR_ERROR error;
   error = testRegularity(inputMatrixFileName, inputFormat, outputTree, outputMinor, printStats, directGraphicness,
-    seriesParallel, simpleThreeSeparations, decomposeStrategy, timeLimit);
+    seriesParallel, simpleThreeSeparations, decomposeStrategy, outputTrace, timeLimit);
 
   switch (error)
   {
@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -17,12 +18,15 @@ typedef enum
 CMR_ERROR recognizeSeriesParallel(
   const char* inputMatrixFileName,      /**< File name of input matrix (may be `-` for stdin). */
   FileFormat inputFormat,               /**< Format of input matrix. */
+  const char* inputReductionsFileName,  /**< File name of reductions to replay (may be \c NULL). */
   const char* outputReductionsFileName, /**< File name for output reductions (may be `-` for stdout). */
   const char* outputReducedFileName,    /**< File name for output of reduced matrix (may be `-` for stdout). */
   const char* outputSubmatrixFileName,  /**< File name for minimal non-series-parallel submatrix (may be `-` for stdout). */
   bool binary,                          /**< Whether to test for binary series-parallel. */
   bool printStats,                      /**< Whether to print statistics to stderr. */
-  double timeLimit                  /**< Time limit to impose. */
+  CMR_SP_ENGINE engine,                 /**< Engine for carrying out the reductions. */
+  CMR_SP_WHEEL_SEARCH wheelSearch,      /**< Data structure for the search for a wheel-submatrix. */
+  double timeLimit                      /**< Time limit to impose. */
 )
 {
   CMR* cmr = NULL;
@@ -50,6 +54,32 @@ CMR_ERROR recognizeSeriesParallel(
   fprintf(stderr, "Read %zux%zu matrix with %zu nonzeros in %f seconds.\n", matrix->numRows, matrix->numColumns,
     matrix->numNonzeros, (clock() - readClock) * 1.0 / CLOCKS_PER_SEC);
 
+  /* Read reductions to replay. */
+
+  CMR_SP_REDUCTION* script = NULL;
+  size_t numScript = 0;
+  if (inputReductionsFileName)
+  {
+    FILE* inputReductionsFile = fopen(inputReductionsFileName, "r");
+    if (!inputReductionsFile)
+    {
+      fprintf(stderr, "Input error: Could not open file <%s>.\n", inputReductionsFileName);
+      CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+      CMR_CALL( CMRfreeEnvironment(&cmr) );
+      return CMR_ERROR_INPUT;
+    }
+    error = CMRspReadReductions(cmr, inputReductionsFile, &script, &numScript);
+    fclose(inputReductionsFile);
+    if (error)
+    {
+      fprintf(stderr, "Input error: %s\n", CMRgetErrorMessage(cmr));
+      CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+      CMR_CALL( CMRfreeEnvironment(&cmr) );
+      return CMR_ERROR_INPUT;
+    }
+    fprintf(stderr, "Read %zu series-parallel reductions to replay.\n", numScript);
+  }
+
   /* Run the search. */
 
   CMR_SP_REDUCTION* reductions = NULL;
@@ -58,16 +88,36 @@ CMR_ERROR recognizeSeriesParallel(
   CMR_SUBMAT* reducedSubmatrix = NULL;
   CMR_SUBMAT* violatorSubmatrix = NULL;
 
+  CMR_SP_PARAMS params;
+  CMR_CALL( CMRspParamsInit(&params) );
+  params.engine = engine;
+  params.wheelSearch = wheelSearch;
   CMR_SP_STATISTICS stats;
   CMR_CALL( CMRspStatsInit(&stats) );
-  if (binary)
+  size_t numReplayed = 0;
+  if (inputReductionsFileName && binary)
+  {
+    CMR_CALL( CMRspReplayBinary(cmr, matrix, script, numScript, &numReplayed, NULL, reductions, SIZE_MAX,
+      &numReductions, outputReducedFileName ? &reducedSubmatrix : NULL,
+      outputSubmatrixFileName ? &violatorSubmatrix : NULL, NULL, &params, &stats, timeLimit) );
+  }
+  else if (inputReductionsFileName)
+  {
+    CMR_CALL( CMRspReplayTernary(cmr, matrix, script, numScript, &numReplayed, NULL, reductions, SIZE_MAX,
+      &numReductions, outputReducedFileName ? &reducedSubmatrix : NULL,
+      outputSubmatrixFileName ? &violatorSubmatrix : NULL, NULL, &params, &stats, timeLimit) );
+  }
+  else if (binary)
     CMR_CALL( CMRspTestBinary(cmr, matrix, NULL, reductions, &numReductions,
-      outputReducedFileName ? &reducedSubmatrix : NULL, outputSubmatrixFileName ? &violatorSubmatrix : NULL, &stats,
-      timeLimit) );
+      outputReducedFileName ? &reducedSubmatrix : NULL, outputSubmatrixFileName ? &violatorSubmatrix : NULL, &params,
+      &stats, timeLimit) );
   else
     CMR_CALL( CMRspTestTernary(cmr, matrix, NULL, reductions, &numReductions,
-      outputReducedFileName ? &reducedSubmatrix : NULL, outputSubmatrixFileName ? &violatorSubmatrix : NULL, &stats,
-      timeLimit) );
+      outputReducedFileName ? &reducedSubmatrix : NULL, outputSubmatrixFileName ? &violatorSubmatrix : NULL, &params,
+      &stats, timeLimit) );
+
+  if (inputReductionsFileName)
+    fprintf(stderr, "Replayed %zu of %zu series-parallel reductions.\n", numReplayed, numScript);
 
   fprintf(stderr, "Matrix %sseries-parallel. %zu reductions can be applied.\n",
     numReductions == matrix->numRows + matrix->numColumns ? "IS " : "is NOT ", numReductions);
@@ -82,9 +132,7 @@ CMR_ERROR recognizeSeriesParallel(
       outputReductionsToFile ? "file <" : "", outputReductionsToFile ? outputReductionsFileName : "stdout",
       outputReductionsToFile ? ">" : "");    
 
-    fprintf(outputReductionsFile, "%zu\n", numReductions);
-    for (size_t i = 0; i < numReductions; ++i)
-      fprintf(outputReductionsFile, "%s\n", CMRspReductionString(reductions[i], NULL));
+    CMR_CALL( CMRspWriteReductions(cmr, reductions, numReductions, outputReductionsFile) );
 
     if (outputReductionsToFile)
       fclose(outputReductionsFile);
@@ -115,6 +163,8 @@ CMR_ERROR recognizeSeriesParallel(
   CMR_CALL( CMRsubmatFree(cmr, &violatorSubmatrix) );
   CMR_CALL( CMRsubmatFree(cmr, &reducedSubmatrix) );
   CMR_CALL( CMRfreeBlockArray(cmr, &reductions) );
+  if (script)
+    CMR_CALL( CMRfreeBlockArray(cmr, &script) );
   CMR_CALL( CMRchrmatFree(cmr, &matrix) );
   CMR_CALL( CMRfreeEnvironment(&cmr) );
 
@@ -148,6 +198,10 @@ int printUsage(const char* program)
   fputs("Advanced options:\n", stderr);
   fputs("  --stats            Print statistics about the computation to stderr.\n", stderr);
   fputs("  --time-limit LIMIT Allow at most LIMIT seconds for the computation.\n", stderr);
+  fputs("  --engine ENGINE    Data structure for the reductions among {list, compact}; default: compact.\n", stderr);
+  fputs("  --wheel WHEEL      Data structure for the wheel search among {auto, list, bitset}; default: auto.\n",
+    stderr);
+  fputs("  --replay IN-SP     First carry out the valid reductions from file IN-SP, e.g., written via -S.\n", stderr);
   fputs("\n", stderr);
 
   fputs("Formats for matrices: dense, sparse\n", stderr);
@@ -162,11 +216,14 @@ int main(int argc, char** argv)
 {
   char* inputMatrixFileName = NULL;
   FileFormat inputFormat = FILEFORMAT_MATRIX_DENSE;
+  char* inputReductionsFileName = NULL;
   char* outputReductionsFileName = NULL;
   char* outputReducedFileName = NULL;
   char* outputSubmatrixFileName = NULL;
   bool binary = false;
   bool printStats = false;
+  CMR_SP_ENGINE engine = CMR_SP_ENGINE_COMPACT;
+  CMR_SP_WHEEL_SEARCH wheelSearch = CMR_SP_WHEEL_SEARCH_AUTO;
   double timeLimit = DBL_MAX;
   for (int a = 1; a < argc; ++a)
   {
@@ -198,6 +255,36 @@ int main(int argc, char** argv)
       binary = true;
     else if (!strcmp(argv[a], "--stats"))
       printStats = true;
+    else if (!strcmp(argv[a], "--engine") && a+1 < argc)
+    {
+      ++a;
+      if (!strcmp(argv[a], "list"))
+        engine = CMR_SP_ENGINE_LIST;
+      else if (!strcmp(argv[a], "compact"))
+        engine = CMR_SP_ENGINE_COMPACT;
+      else
+      {
+        fprintf(stderr, "Error: Invalid engine <%s> specified.\n\n", argv[a]);
+        return printUsage(argv[0]);
+      }
+    }
+    else if (!strcmp(argv[a], "--wheel") && a+1 < argc)
+    {
+      ++a;
+      if (!strcmp(argv[a], "auto"))
+        wheelSearch = CMR_SP_WHEEL_SEARCH_AUTO;
+      else if (!strcmp(argv[a], "list"))
+        wheelSearch = CMR_SP_WHEEL_SEARCH_LIST;
+      else if (!strcmp(argv[a], "bitset"))
+        wheelSearch = CMR_SP_WHEEL_SEARCH_BITSET;
+      else
+      {
+        fprintf(stderr, "Error: Invalid wheel search <%s> specified.\n\n", argv[a]);
+        return printUsage(argv[0]);
+      }
+    }
+    else if (!strcmp(argv[a], "--replay") && a+1 < argc)
+      inputReductionsFileName = argv[++a];
     else if (!strcmp(argv[a], "--time-limit") && (a+1 < argc))
     {
       if (sscanf(argv[a+1], "%lf", &timeLimit) == 0 || timeLimit <= 0)
@@ -222,8 +309,8 @@ int main(int argc, char** argv)
     return printUsage(argv[0]);
   }
 
-  CMR_ERROR error = recognizeSeriesParallel(inputMatrixFileName, inputFormat, outputReductionsFileName,
-    outputReducedFileName, outputSubmatrixFileName, binary, printStats, timeLimit);
+  CMR_ERROR error = recognizeSeriesParallel(inputMatrixFileName, inputFormat, inputReductionsFileName, outputReductionsFileName,
+    outputReducedFileName, outputSubmatrixFileName, binary, printStats, engine, wheelSearch, timeLimit);
 
   switch (error)
   {
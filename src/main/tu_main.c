@@ -32,13 +32,17 @@ CMR_ERROR testTotalUnimodularity(
   bool seriesParallel,                  /**< Whether to allow series-parallel operations in the decomposition tree. */
   bool simpleThreeSeparations,          /**< Whether to test for simple 3-separations. */
   int decomposeStrategy,                /**< Which strategy to use for 3-separations. */
-  bool naiveSubmatrix,                  /**< Use naive bad submatrix heuristic instead of greedy algorithm. */
+  CMR_SEYMOUR_SCHEDULE schedule,        /**< Order in which pending decomposition nodes are processed. */
+  bool naiveSubmatrix,                  /**< Use naive bad submatrix heuristic instead of delta debugging. */
   CMR_TU_ALGORITHM algorithm,           /**< Algorithm to use for TU test. */
+  int numThreads,                       /**< Number of threads to use. */
+  size_t screeningBudget,               /**< Budget for screening for small violators. */
   double timeLimit                      /**< Time limit to impose. */
 )
 {
   CMR* cmr = NULL;
   CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CALL( CMRsetNumThreads(cmr, numThreads) );
 
   /* Read matrix. */
 
@@ -95,8 +99,10 @@ CMR_ERROR testTotalUnimodularity(
   params.seymour.seriesParallel = seriesParallel;
   params.seymour.planarityCheck = planarityCheck;
   params.seymour.decomposeStrategy = decomposeStrategy;
+  params.seymour.schedule = schedule;
   params.seymour.simpleThreeSeparations = simpleThreeSeparations;
   params.naiveSubmatrix = naiveSubmatrix;
+  params.screeningBudget = screeningBudget;
   CMR_TU_STATS stats;
   CMR_CALL( CMRtuStatsInit(&stats));
   error = CMRtuTest(cmr, matrix, &isTU, outputTreeFileName ? &decomposition : NULL,
@@ -185,11 +191,15 @@ int printUsage(const char* program)
   fputs("  --stats              Print statistics about the computation to stderr.\n", stderr);
   fputs("  --time-limit LIMIT   Allow at most LIMIT seconds for the computation.\n", stderr);
   fputs("  --decompose STRATEGY Strategy for decomposing among {DP, YP, P3, D3, Y3}; default: D3.\n", stderr);
+  fputs("  --schedule ORDER     Order of processing decomposition nodes among {lifo, fifo, smallest, irregular};"
+    " default: lifo.\n", stderr);
   fputs("  --no-direct-graphic  Check only 3-connected matrices for regularity.\n", stderr);
   fputs("  --no-planarity       Do not test for planarity.\n", stderr);
   fputs("  --no-series-parallel Do not allow series-parallel operations in decomposition tree.\n", stderr);
   fputs("  --no-simple-3-sepa   Do not allow testing for simple 3-separations.\n", stderr);
-  fputs("  --naive-submatrix    Use naive bad submatrix algorithm instead of greedy heuristic.\n", stderr);
+  fputs("  --naive-submatrix    Use naive bad submatrix algorithm instead of delta debugging.\n", stderr);
+  fputs("  --threads NUM        Use NUM threads for the bad submatrix search; default: 1.\n", stderr);
+  fputs("  --screen BUDGET      Screen for small bad submatrices using BUDGET steps first; default: 0.\n", stderr);
   fputs("  --algo ALGO          Use algorithm from {decomposition, eulerian, partition}; default: decomposition.\n",
     stderr);
   fputs("\n", stderr);
@@ -223,7 +233,10 @@ int main(int argc, char** argv)
   bool simpleThreeSeparations = true;
   int decomposeStrategy = CMR_SEYMOUR_DECOMPOSE_FLAG_DISTRIBUTED_DELTASUM
     | CMR_SEYMOUR_DECOMPOSE_FLAG_CONCENTRATED_THREESUM;
+  CMR_SEYMOUR_SCHEDULE schedule = CMR_SEYMOUR_SCHEDULE_LIFO;
   double timeLimit = DBL_MAX;
+  int numThreads = 1;
+  size_t screeningBudget = 0;
   CMR_TU_ALGORITHM algorithm = CMR_TU_ALGORITHM_DECOMPOSITION;
   for (int a = 1; a < argc; ++a)
   {
@@ -295,6 +308,23 @@ int main(int argc, char** argv)
         return printUsage(argv[0]);
       }
     }
+    else if (!strcmp(argv[a], "--schedule") && (a+1 < argc))
+    {
+      if (!strcmp(argv[a+1], "lifo"))
+        schedule = CMR_SEYMOUR_SCHEDULE_LIFO;
+      else if (!strcmp(argv[a+1], "fifo"))
+        schedule = CMR_SEYMOUR_SCHEDULE_FIFO;
+      else if (!strcmp(argv[a+1], "smallest"))
+        schedule = CMR_SEYMOUR_SCHEDULE_SMALLEST;
+      else if (!strcmp(argv[a+1], "irregular"))
+        schedule = CMR_SEYMOUR_SCHEDULE_IRREGULAR;
+      else
+      {
+        fprintf(stderr, "Error: Invalid schedule <%s> specified.\n\n", argv[a+1]);
+        return printUsage(argv[0]);
+      }
+      ++a;
+    }
     else if (!strcmp(argv[a], "--time-limit") && (a+1 < argc))
     {
       if (sscanf(argv[a+1], "%lf", &timeLimit) == 0 || timeLimit <= 0)
@@ -304,6 +334,24 @@ int main(int argc, char** argv)
       }
       ++a;
     }
+    else if (!strcmp(argv[a], "--threads") && (a+1 < argc))
+    {
+      if (sscanf(argv[a+1], "%d", &numThreads) == 0 || numThreads <= 0)
+      {
+        fprintf(stderr, "Error: Invalid number of threads <%s> specified.\n\n", argv[a+1]);
+        return printUsage(argv[0]);
+      }
+      ++a;
+    }
+    else if (!strcmp(argv[a], "--screen") && (a+1 < argc))
+    {
+      if (sscanf(argv[a+1], "%zu", &screeningBudget) == 0)
+      {
+        fprintf(stderr, "Error: Invalid screening budget <%s> specified.\n\n", argv[a+1]);
+        return printUsage(argv[0]);
+      }
+      ++a;
+    }
     else if (!strcmp(argv[a], "--algo") && (a+1 < argc))
     {
       if (!strcmp(argv[a+1], "decomposition"))
@@ -336,7 +384,8 @@ int main(int argc, char** argv)
 
   CMR_ERROR error;
   error = testTotalUnimodularity(inputMatrixFileName, inputFormat, outputTree, outputSubmatrix, printStats,
-    directGraphicness, planarityCheck, seriesParallel, simpleThreeSeparations, decomposeStrategy, naiveSubmatrix, algorithm, timeLimit);
+    directGraphicness, planarityCheck, seriesParallel, simpleThreeSeparations, decomposeStrategy, schedule, naiveSubmatrix, algorithm, numThreads,
+    screeningBudget, timeLimit);
 
   switch (error)
   {
@@ -53,3 +53,155 @@ TEST(CTU, ExamplesSeymour)
 
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+TEST(CTU, Threads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  const char* matrixStrings[] = {
+    " 4 5 "
+    "1 0 0 1 1 "
+    "1 1 0 0 1 "
+    "0 1 1 0 1 "
+    "0 0 1 1 1 ",
+    " 5 5 "
+    "0 1 0 1 0 "
+    "1 1 1 0 1 "
+    "0 1 0 0 1 "
+    "1 0 0 0 1 "
+    "0 1 1 1 1 ",
+    " 6 6 "
+    "1 1 0 0 0 0 "
+    "0 1 1 0 0 0 "
+    "0 0 1 1 0 0 "
+    "0 0 0 1 1 0 "
+    "0 0 0 0 1 1 "
+    "1 0 0 0 0 1 "
+  };
+
+  for (int m = 0; m < 3; ++m)
+  {
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, matrixStrings[m]) );
+
+    bool isCTU[2];
+    size_t complementRow[2] = { SIZE_MAX, SIZE_MAX };
+    size_t complementColumn[2] = { SIZE_MAX, SIZE_MAX };
+    for (int i = 0; i < 2; ++i)
+    {
+      ASSERT_CMR_CALL( CMRsetNumThreads(cmr, i ? 4 : 1) );
+
+      CMR_CTU_STATISTICS stats;
+      ASSERT_CMR_CALL( CMRstatsComplementTotalUnimodularityInit(&stats) );
+      ASSERT_CMR_CALL( CMRctuTest(cmr, matrix, &isCTU[i], &complementRow[i], &complementColumn[i], NULL, &stats,
+        DBL_MAX) );
+      ASSERT_EQ( stats.totalCount, 1UL );
+    }
+
+    ASSERT_EQ( isCTU[0], isCTU[1] );
+    ASSERT_EQ( complementRow[0], complementRow[1] );
+    ASSERT_EQ( complementColumn[0], complementColumn[1] );
+
+    if (!isCTU[0])
+    {
+      /* The reported complemented matrix must not be TU. */
+      CMR_CHRMAT* complemented = NULL;
+      ASSERT_CMR_CALL( CMRctuComplementRowColumn(cmr, matrix, complementRow[0], complementColumn[0],
+        &complemented) );
+      bool isTU;
+      ASSERT_CMR_CALL( CMRtuTest(cmr, complemented, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+      ASSERT_FALSE( isTU );
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &complemented) );
+    }
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(CTU, ComplementRowColumn)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, " 5 6 "
+    "1 0 0 1 1 0 "
+    "0 0 0 0 0 0 "
+    "1 1 0 0 1 1 "
+    "0 1 1 0 1 0 "
+    "0 0 1 1 1 1 "
+  ) );
+
+  for (size_t complementRow = 0; complementRow <= matrix->numRows; ++complementRow)
+  {
+    size_t r = complementRow < matrix->numRows ? complementRow : SIZE_MAX;
+    for (size_t complementColumn = 0; complementColumn <= matrix->numColumns; ++complementColumn)
+    {
+      size_t c = complementColumn < matrix->numColumns ? complementColumn : SIZE_MAX;
+      CMR_CHRMAT* complemented = NULL;
+      ASSERT_CMR_CALL( CMRctuComplementRowColumn(cmr, matrix, r, c, &complemented) );
+
+      /* Compare with the definition: entry (i,j) is flipped if the 2x2 submatrix with rows i,r and columns j,c has
+       * an odd number of 1s outside of (i,j). Complementing the row (resp. column) alone means that column (resp. row)
+       * consists of 1s. */
+      for (size_t row = 0; row < matrix->numRows; ++row)
+      {
+        for (size_t column = 0; column < matrix->numColumns; ++column)
+        {
+          size_t entry;
+          ASSERT_CMR_CALL( CMRchrmatFindEntry(matrix, row, column, &entry) );
+          bool expected = entry != SIZE_MAX;
+          bool flip = false;
+          if (row == r || column == c)
+          {
+            if (row != r || column != c)
+            {
+              /* Flip if the entry at (r,c) is 1. */
+              if (r != SIZE_MAX && c != SIZE_MAX)
+              {
+                ASSERT_CMR_CALL( CMRchrmatFindEntry(matrix, r, c, &entry) );
+                flip = entry != SIZE_MAX;
+              }
+            }
+          }
+          else
+          {
+            int sum = 0;
+            if (r != SIZE_MAX && c != SIZE_MAX)
+            {
+              ASSERT_CMR_CALL( CMRchrmatFindEntry(matrix, r, c, &entry) );
+              sum += entry != SIZE_MAX;
+            }
+            if (c != SIZE_MAX)
+            {
+              ASSERT_CMR_CALL( CMRchrmatFindEntry(matrix, row, c, &entry) );
+              sum += entry != SIZE_MAX;
+            }
+            if (r != SIZE_MAX)
+            {
+              ASSERT_CMR_CALL( CMRchrmatFindEntry(matrix, r, column, &entry) );
+              sum += entry != SIZE_MAX;
+            }
+            flip = sum % 2 == 1;
+          }
+          if (flip)
+            expected = !expected;
+
+          ASSERT_CMR_CALL( CMRchrmatFindEntry(complemented, row, column, &entry) );
+          ASSERT_EQ( entry != SIZE_MAX, expected );
+          if (entry != SIZE_MAX)
+          {
+            ASSERT_EQ( complemented->entryValues[entry], 1 );
+          }
+        }
+      }
+
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &complemented) );
+    }
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include "common.h"
+#include "../src/cmr/densematrix.h"
+
+#include <cstdlib>
+#include <vector>
+
+TEST(DenseMatrix, RandomOperations)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(1);
+  const size_t numRows = 150;
+  const size_t numColumns = 140;
+  DenseBinaryMatrix* matrix = NULL;
+  ASSERT_CMR_CALL( CMRdensebinmatrixCreate(cmr, numRows, numColumns, &matrix) );
+  std::vector<std::vector<bool>> entries(numRows, std::vector<bool>(numColumns, false));
+
+  for (int round = 0; round < 2000; ++round)
+  {
+    size_t row = rand() % numRows;
+    size_t column = rand() % numColumns;
+    int operation = rand() % 4;
+    if (operation == 0)
+    {
+      ASSERT_CMR_CALL( CMRdensebinmatrixSet(cmr, matrix, row, column, true) );
+      entries[row][column] = true;
+    }
+    else if (operation == 1)
+    {
+      ASSERT_CMR_CALL( CMRdensebinmatrixSet(cmr, matrix, row, column, false) );
+      entries[row][column] = false;
+    }
+    else if (operation == 2)
+    {
+      ASSERT_CMR_CALL( CMRdensebinmatrixFlip(cmr, matrix, row, column) );
+      entries[row][column] = !entries[row][column];
+    }
+    else
+    {
+      size_t source = rand() % numRows;
+      if (source == row)
+        continue;
+      ASSERT_CMR_CALL( CMRdensebinmatrixAddRow(cmr, matrix, source, row) );
+      for (size_t c = 0; c < numColumns; ++c)
+        entries[row][c] = entries[row][c] != entries[source][c];
+    }
+  }
+
+  /* Rows and columns are consistent, and exactly the nonzero tiles are allocated. */
+  size_t numNonzeroTiles = 0;
+  for (size_t tileRow = 0; tileRow < matrix->numTileRows; ++tileRow)
+  {
+    for (size_t tileColumn = 0; tileColumn < matrix->numTileColumns; ++tileColumn)
+    {
+      bool isNonzero = false;
+      for (size_t row = tileRow * CMR_DENSEBINMATRIX_TILE_SIZE;
+        row < (tileRow + 1) * CMR_DENSEBINMATRIX_TILE_SIZE && row < numRows; ++row)
+      {
+        for (size_t column = tileColumn * CMR_DENSEBINMATRIX_TILE_SIZE;
+          column < (tileColumn + 1) * CMR_DENSEBINMATRIX_TILE_SIZE && column < numColumns; ++column)
+        {
+          isNonzero = isNonzero || entries[row][column];
+        }
+      }
+      if (isNonzero)
+        ++numNonzeroTiles;
+    }
+  }
+  ASSERT_EQ( matrix->numAllocatedTiles, numNonzeroTiles );
+  size_t numTransposedTiles = 0;
+  for (size_t t = 0; t < matrix->numTileRows * matrix->numTileColumns; ++t)
+  {
+    if (matrix->columnTiles[t])
+      ++numTransposedTiles;
+  }
+  ASSERT_EQ( matrix->numTransposedTiles, numTransposedTiles );
+
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    size_t column = CMRdensebinmatrixRowNext(matrix, row, 0);
+    for (size_t c = 0; c < numColumns; ++c)
+    {
+      ASSERT_EQ( CMRdensebinmatrixGet(matrix, row, c), entries[row][c] );
+      if (entries[row][c])
+      {
+        ASSERT_EQ( column, c );
+        column = CMRdensebinmatrixRowNext(matrix, row, c + 1);
+      }
+    }
+    ASSERT_EQ( column, numColumns );
+  }
+
+  for (size_t column = 0; column < numColumns; ++column)
+  {
+    size_t row = CMRdensebinmatrixColumnNext(matrix, 0, column);
+    for (size_t r = 0; r < numRows; ++r)
+    {
+      uint64_t word = CMRdensebinmatrixColumnWord(matrix, r / CMR_DENSEBINMATRIX_TILE_SIZE, column);
+      ASSERT_EQ( (bool) ((word >> (r % CMR_DENSEBINMATRIX_TILE_SIZE)) & 1), (bool) entries[r][column] );
+      if (entries[r][column])
+      {
+        ASSERT_EQ( row, r );
+        row = CMRdensebinmatrixColumnNext(matrix, r + 1, column);
+      }
+    }
+    ASSERT_EQ( row, numRows );
+  }
+
+  /* Clearing all entries frees all tiles. */
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t column = CMRdensebinmatrixRowNext(matrix, row, 0); column < numColumns;
+      column = CMRdensebinmatrixRowNext(matrix, row, column + 1))
+    {
+      ASSERT_CMR_CALL( CMRdensebinmatrixSet(cmr, matrix, row, column, false) );
+    }
+  }
+  ASSERT_EQ( matrix->numAllocatedTiles, 0UL );
+  ASSERT_EQ( matrix->numTransposedTiles, 0UL );
+
+  ASSERT_CMR_CALL( CMRdensebinmatrixFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(DenseMatrix, TransposedTiles)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  const size_t numRows = 100;
+  const size_t numColumns = 70;
+  DenseBinaryMatrix* matrix = NULL;
+  ASSERT_CMR_CALL( CMRdensebinmatrixCreate(cmr, numRows, numColumns, &matrix) );
+
+  /* Fill the first tile entry by entry; it is stored transposed only once it is dense enough. */
+  std::vector<std::pair<size_t, size_t>> entries;
+  for (size_t row = 0; row < CMR_DENSEBINMATRIX_TILE_SIZE; ++row)
+  {
+    for (size_t column = row % 3; column < CMR_DENSEBINMATRIX_TILE_SIZE; column += 3)
+      entries.push_back(std::make_pair(row, column));
+  }
+  ASSERT_GT( entries.size(), (size_t) CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS );
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    ASSERT_CMR_CALL( CMRdensebinmatrixSet(cmr, matrix, entries[i].first, entries[i].second, true) );
+    ASSERT_EQ( matrix->numTransposedTiles, i + 1 >= CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS ? 1UL : 0UL );
+  }
+  ASSERT_CMR_CALL( CMRdensebinmatrixSet(cmr, matrix, 80, 65, true) );
+  ASSERT_EQ( matrix->numAllocatedTiles, 2UL );
+  ASSERT_EQ( matrix->numTransposedTiles, 1UL );
+
+  /* Column words agree for the transposed and the sparse tile. */
+  for (size_t column = 0; column < numColumns; ++column)
+  {
+    for (size_t tileRow = 0; tileRow < matrix->numTileRows; ++tileRow)
+    {
+      uint64_t word = CMRdensebinmatrixColumnWord(matrix, tileRow, column);
+      for (size_t i = 0; i < CMR_DENSEBINMATRIX_TILE_SIZE; ++i)
+      {
+        size_t row = tileRow * CMR_DENSEBINMATRIX_TILE_SIZE + i;
+        bool entry = row < numRows && CMRdensebinmatrixGet(matrix, row, column);
+        ASSERT_EQ( (bool) ((word >> i) & 1), entry );
+      }
+    }
+  }
+
+  /* Row additions keep the transposed tile up to date. */
+  ASSERT_CMR_CALL( CMRdensebinmatrixAddRow(cmr, matrix, 1, 0) );
+  for (size_t column = 0; column < CMR_DENSEBINMATRIX_TILE_SIZE; ++column)
+  {
+    bool expected = (column % 3 == 0) != (column % 3 == 1);
+    ASSERT_EQ( CMRdensebinmatrixGet(matrix, 0, column), expected );
+    ASSERT_EQ( (bool) (CMRdensebinmatrixColumnWord(matrix, 0, column) & 1), expected );
+  }
+
+  /* The transposed tile is freed once the tile has less than half of the nonzeros required for it. */
+  for (size_t row = 0; row < CMR_DENSEBINMATRIX_TILE_SIZE; ++row)
+  {
+    for (size_t column = 0; column < CMR_DENSEBINMATRIX_TILE_SIZE; ++column)
+      ASSERT_CMR_CALL( CMRdensebinmatrixSet(cmr, matrix, row, column, false) );
+    if (matrix->tileNumNonzeros[0] >= CMR_DENSEBINMATRIX_TRANSPOSE_MIN_NONZEROS / 2)
+    {
+      ASSERT_EQ( matrix->numTransposedTiles, 1UL );
+    }
+  }
+  ASSERT_EQ( matrix->numTransposedTiles, 0UL );
+  ASSERT_EQ( matrix->numAllocatedTiles, 1UL );
+
+  ASSERT_CMR_CALL( CMRdensebinmatrixFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
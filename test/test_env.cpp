@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "common.h"
+#include "../src/cmr/env_internal.h"
+#include "../src/cmr/parallel.h"
+
+#include <cstring>
+
+TEST(Env, StackMark)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  int* outer = NULL;
+  ASSERT_CMR_CALL( CMRallocStackArray(cmr, &outer, 10) );
+  size_t usage = CMRgetStackUsage(cmr);
+
+  for (int round = 0; round < 3; ++round)
+  {
+    CMR_STACKMARK mark;
+    ASSERT_CMR_CALL( CMRstackMark(cmr, &mark) );
+
+    /* Allocations that span several stacks are not freed individually. */
+    char* small = NULL;
+    ASSERT_CMR_CALL( CMRallocStackArray(cmr, &small, 100) );
+    double* large = NULL;
+    ASSERT_CMR_CALL( CMRallocStackArray(cmr, &large, 100000) );
+    for (size_t i = 0; i < 100000; ++i)
+      large[i] = i;
+
+    /* A nested mark reports the peak usage on top of it. */
+    CMR_STACKMARK innerMark;
+    ASSERT_CMR_CALL( CMRstackMark(cmr, &innerMark) );
+    int* inner = NULL;
+    ASSERT_CMR_CALL( CMRallocStackArray(cmr, &inner, 1000) );
+    ASSERT_CMR_CALL( CMRfreeStackArray(cmr, &inner) );
+    size_t innerPeak;
+    ASSERT_CMR_CALL( CMRstackRelease(cmr, &innerMark, &innerPeak) );
+    ASSERT_GE(innerPeak, 1000 * sizeof(int));
+    ASSERT_LT(innerPeak, 1000 * sizeof(int) + 64);
+
+    size_t peak;
+    ASSERT_CMR_CALL( CMRstackRelease(cmr, &mark, &peak) );
+    ASSERT_GE(peak, 100000 * sizeof(double) + 100 + 1000 * sizeof(int));
+    ASSERT_EQ(CMRgetStackUsage(cmr), usage);
+    CMRassertStackConsistency(cmr);
+  }
+
+  ASSERT_CMR_CALL( CMRfreeStackArray(cmr, &outer) );
+  ASSERT_EQ(CMRgetStackUsage(cmr), 0UL);
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Env, SlabPool)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  size_t blockMemory = cmr->blockMemory;
+  for (int round = 0; round < 3; ++round)
+  {
+    /* Enough slabs to require further blocks. */
+    int* slabs[64];
+    for (size_t i = 0; i < 64; ++i)
+    {
+      slabs[i] = NULL;
+      ASSERT_CMR_CALL( CMRallocSlabArray(cmr, &slabs[i], 1000) );
+      slabs[i][999] = (int) i;
+    }
+    ASSERT_TRUE( cmr->slabPool.firstBlock->next != NULL );
+    for (size_t i = 0; i < 64; ++i)
+    {
+      ASSERT_EQ( slabs[i][999], (int) i );
+      ASSERT_CMR_CALL( CMRfreeSlabArray(cmr, &slabs[i]) );
+    }
+
+    /* Once no slab is in use, only the first block is kept, which does not count as block memory. */
+    ASSERT_TRUE( cmr->slabPool.firstBlock->next == NULL );
+    ASSERT_EQ( cmr->blockMemory, blockMemory );
+  }
+
+  /* Large slabs are allocated with their exact size and do not keep the pool from being rewound. */
+  int* small = NULL;
+  ASSERT_CMR_CALL( CMRallocSlabArray(cmr, &small, 10) );
+  char* large = NULL;
+  ASSERT_CMR_CALL( CMRallocSlabArray(cmr, &large, 10000000) );
+  large[9999999] = 1;
+  ASSERT_TRUE( cmr->slabPool.firstBlock->next == NULL );
+#if defined(CMR_WITH_MALLOC_USABLE_SIZE)
+  ASSERT_LT( cmr->blockMemory - blockMemory, 10100000UL );
+#endif
+  ASSERT_CMR_CALL( CMRfreeSlabArray(cmr, &small) );
+  ASSERT_CMR_CALL( CMRfreeSlabArray(cmr, &large) );
+  ASSERT_EQ( cmr->blockMemory, blockMemory );
+  ASSERT_EQ( cmr->slabPool.numUsedSlabs, 0UL );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+static
+CMR_ERROR failingTask(CMR* cmr, size_t task, void* data, bool* pfound)
+{
+  CMR_UNUSED(data);
+
+  *pfound = false;
+  if (task == 7)
+  {
+    CMRraiseErrorMessage(cmr, "Task %zu failed.", task);
+    return CMR_ERROR_INPUT;
+  }
+
+  return CMR_OKAY;
+}
+
+TEST(Env, ParallelErrorMessage)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  ASSERT_CMR_CALL( CMRsetNumThreads(cmr, 4) );
+
+  /* The message of the failing worker ends up in the caller's environment, whichever worker ran the task. */
+  for (int round = 0; round < 20; ++round)
+  {
+    CMRclearErrorMessage(cmr);
+    ASSERT_EQ( CMRparallelFor(cmr, 32, failingTask, NULL), CMR_ERROR_INPUT );
+    ASSERT_TRUE( CMRgetErrorMessage(cmr) );
+    ASSERT_STREQ( CMRgetErrorMessage(cmr), "Task 7 failed." );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
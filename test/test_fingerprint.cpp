@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "common.h"
+#include <cmr/matroid.h>
+#include "../src/cmr/fingerprint.h"
+
+#include <cstdlib>
+#include <sstream>
+
+static
+CMR_ERROR createRandomMatrix(CMR* cmr, size_t numRows, size_t numColumns, int percentage, bool isSigned,
+  CMR_CHRMAT** pmatrix)
+{
+  std::stringstream ss;
+  ss << numRows << " " << numColumns;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+      int entry = (rand() % 100 < percentage) ? 1 : 0;
+      if (entry && isSigned && rand() % 2)
+        entry = -1;
+      ss << " " << entry;
+    }
+  }
+  return stringToCharMatrix(cmr, pmatrix, ss.str().c_str());
+}
+
+static
+bool rowsAgree(CMR_CHRMAT* matrix, size_t row1, size_t row2, bool isSigned)
+{
+  size_t first1 = matrix->rowSlice[row1];
+  size_t first2 = matrix->rowSlice[row2];
+  size_t length = matrix->rowSlice[row1 + 1] - first1;
+  if (matrix->rowSlice[row2 + 1] - first2 != length)
+    return false;
+
+  for (size_t i = 0; i < length; ++i)
+  {
+    if (matrix->entryColumns[first1 + i] != matrix->entryColumns[first2 + i])
+      return false;
+    if (isSigned && matrix->entryValues[first1 + i] != matrix->entryValues[first2 + i])
+      return false;
+  }
+
+  return true;
+}
+
+static
+void expectEqualFingerprints(Fingerprints* fingerprints, Fingerprints* other)
+{
+  ASSERT_EQ(fingerprints->numRows, other->numRows);
+  ASSERT_EQ(fingerprints->numColumns, other->numColumns);
+  for (size_t row = 0; row < fingerprints->numRows; ++row)
+    EXPECT_EQ(fingerprints->rowFingerprints[row], other->rowFingerprints[row]);
+  for (size_t column = 0; column < fingerprints->numColumns; ++column)
+    EXPECT_EQ(fingerprints->columnFingerprints[column], other->columnFingerprints[column]);
+}
+
+TEST(Fingerprint, Initialization)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  ASSERT_CMR_CALL( CMRsetNumThreads(cmr, 4) );
+
+  srand(1);
+  for (size_t numRows : {1, 7, 300})
+  {
+    for (bool isSigned : {false, true})
+    {
+      size_t numColumns = numRows + 3;
+      CMR_CHRMAT* matrix = NULL;
+      ASSERT_CMR_CALL( createRandomMatrix(cmr, numRows, numColumns, numRows > 100 ? 80 : 30, isSigned, &matrix) );
+      CMR_CHRMAT* transpose = NULL;
+      ASSERT_CMR_CALL( CMRchrmatTranspose(cmr, matrix, &transpose) );
+
+      /* The fingerprints computed via a single scan, via the transpose and of the transpose must agree. */
+      Fingerprints* fingerprints = NULL;
+      ASSERT_CMR_CALL( CMRfingerprintsCreate(cmr, matrix, NULL, isSigned, &fingerprints) );
+      Fingerprints* other = NULL;
+      ASSERT_CMR_CALL( CMRfingerprintsCreate(cmr, matrix, transpose, isSigned, &other) );
+      expectEqualFingerprints(fingerprints, other);
+      ASSERT_CMR_CALL( CMRfingerprintsFree(cmr, &other) );
+
+      ASSERT_CMR_CALL( CMRfingerprintsCreate(cmr, transpose, NULL, isSigned, &other) );
+      for (size_t row = 0; row < numRows; ++row)
+        EXPECT_EQ(fingerprints->rowFingerprints[row], other->columnFingerprints[row]);
+      for (size_t column = 0; column < numColumns; ++column)
+        EXPECT_EQ(fingerprints->columnFingerprints[column], other->rowFingerprints[column]);
+      ASSERT_CMR_CALL( CMRfingerprintsFree(cmr, &other) );
+
+      /* Equal rows have equal fingerprints. */
+      for (size_t row = 1; row < numRows; ++row)
+      {
+        if (rowsAgree(matrix, 0, row, isSigned))
+        {
+          EXPECT_EQ(fingerprints->rowFingerprints[0], fingerprints->rowFingerprints[row]);
+        }
+        else
+        {
+          EXPECT_NE(fingerprints->rowFingerprints[0], fingerprints->rowFingerprints[row]);
+        }
+      }
+
+      ASSERT_CMR_CALL( CMRfingerprintsFree(cmr, &fingerprints) );
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &transpose) );
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+    }
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Fingerprint, Updates)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  const size_t size = 100;
+  long long* weights = NULL;
+  ASSERT_CMR_CALL( CMRfingerprintWeightsCreate(cmr, &weights, size) );
+
+  /* Removing entries in any order restores the previous fingerprints exactly, also close to the range's bounds. */
+  srand(2);
+  for (long long start : {0LL, RANGE_SIGNED_HASH - 1, -RANGE_SIGNED_HASH + 1})
+  {
+    long long fingerprint = start;
+    long long negated = -start;
+    std::vector<long long> multipliers(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+      multipliers[i] = (rand() % 5) - 2;
+      fingerprint = CMRfingerprintUpdate(fingerprint, weights[i], multipliers[i]);
+      negated = CMRfingerprintUpdate(negated, weights[i], -multipliers[i]);
+      ASSERT_LT(fingerprint, RANGE_SIGNED_HASH);
+      ASSERT_GT(fingerprint, -RANGE_SIGNED_HASH);
+      ASSERT_EQ(negated, -fingerprint);
+    }
+    for (size_t i = size; i > 0; --i)
+      fingerprint = CMRfingerprintUpdate(fingerprint, weights[(i * 37) % size], -multipliers[(i * 37) % size]);
+    ASSERT_EQ(fingerprint, start);
+  }
+
+  ASSERT_CMR_CALL( CMRfreeStackArray(cmr, &weights) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
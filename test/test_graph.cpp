@@ -83,15 +83,13 @@ TEST(Graph, EdgeList)
   CMRgraphAddEdge(cmr, graph, b, d, &bd);
   CMRgraphAddEdge(cmr, graph, c, d, &cd);
 
-  FILE* graphFile = NULL;
-  graphFile = fopen("graph.edgelist", "w");
+  FILE* graphFile = tmpfile();
+  ASSERT_TRUE( graphFile );
   const char* nodeLabels[4] = { "a", "b", "c", "d" };
   CMR_ELEMENT edgeElements[6] = { -1, -2, -3, 1, 2, 3 };
   ASSERT_CMR_CALL( CMRgraphWriteEdgeList(cmr, graph, edgeElements, nodeLabels, graphFile) );
-  fclose(graphFile);
+  rewind(graphFile);
 
-  graphFile = fopen("graph.edgelist", "r");
-  ASSERT_TRUE( graphFile );
   CMR_GRAPH* graph2 = NULL;
   CMR_ELEMENT* edgeElements2 = NULL;
   char** nodeLabels2 = NULL;
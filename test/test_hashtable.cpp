@@ -39,3 +39,245 @@ TEST(Hashtable, Functionality)
 
   CMRfreeEnvironment(&cmr);
 }
+
+TEST(Hashtable, ListMultimap)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_LISTHASHTABLE* hashtable = NULL;
+  ASSERT_CMR_CALL( CMRlisthashtableCreate(cmr, &hashtable, 4, 4) );
+
+  /* Many values share a hash such that the table grows and has long probe sequences. */
+  const size_t numValues = 20000;
+  const size_t numHashes = 1000;
+  std::vector<CMR_LISTHASHTABLE_ENTRY> entries(numValues);
+  std::vector<bool> present(numValues, true);
+  for (size_t value = 0; value < numValues; ++value)
+  {
+    ASSERT_CMR_CALL( CMRlisthashtableInsert(cmr, hashtable, (value * 7919) % numHashes, value, &entries[value]) );
+  }
+  for (size_t value = 0; value < numValues; value += 3)
+  {
+    ASSERT_CMR_CALL( CMRlisthashtableRemove(cmr, hashtable, entries[value]) );
+    present[value] = false;
+  }
+  ASSERT_EQ( CMRlisthashtableRemove(cmr, hashtable, entries[0]), CMR_ERROR_INVALID );
+
+  /* Reinsert some of the removed values, which reuses tombstones. */
+  for (size_t value = 0; value < numValues; value += 6)
+  {
+    ASSERT_CMR_CALL( CMRlisthashtableInsert(cmr, hashtable, (value * 7919) % numHashes, value, &entries[value]) );
+    present[value] = true;
+  }
+
+  for (size_t hash = 0; hash < numHashes + 10; ++hash)
+  {
+    std::vector<bool> found(numValues, false);
+    for (CMR_LISTHASHTABLE_ENTRY entry = CMRlisthashtableFindFirst(hashtable, hash); entry != SIZE_MAX;
+      entry = CMRlisthashtableFindNext(hashtable, hash, entry))
+    {
+      size_t value = CMRlisthashtableValue(hashtable, entry);
+      ASSERT_EQ( CMRlisthashtableHash(hashtable, entry), hash );
+      ASSERT_EQ( entries[value], entry );
+      ASSERT_FALSE( found[value] );
+      found[value] = true;
+    }
+    for (size_t value = 0; value < numValues; ++value)
+      ASSERT_EQ( found[value], present[value] && (value * 7919) % numHashes == hash );
+  }
+
+  ASSERT_CMR_CALL( CMRlisthashtableFree(cmr, &hashtable) );
+
+  CMRfreeEnvironment(&cmr);
+}
+
+/**
+ * \brief Chained hash table that was used as \ref CMR_LISTHASHTABLE before; only kept as a baseline for the benchmark.
+ *
+ * Entries with the same hash are found in reverse order of insertion.
+ */
+
+struct ChainedHashtable
+{
+  struct Node
+  {
+    size_t hash;                /**< Hash value. */
+    size_t next;                /**< Next entry in the bucket or in the free list. */
+    size_t value;               /**< Value. */
+  };
+
+  std::vector<size_t> buckets;  /**< First entry of each bucket. */
+  std::vector<Node> nodes;      /**< Entries. */
+  size_t firstFree;             /**< Start of free list. */
+
+  ChainedHashtable(size_t initialNumBuckets, size_t initialMemNodes)
+    : buckets(initialNumBuckets, SIZE_MAX), nodes(initialMemNodes), firstFree(0)
+  {
+    for (size_t i = 0; i < initialMemNodes; ++i)
+      nodes[i].next = (i + 1 < initialMemNodes) ? i + 1 : SIZE_MAX;
+  }
+
+  size_t findNext(size_t hash, size_t entry)
+  {
+    for (entry = nodes[entry].next; entry != SIZE_MAX; entry = nodes[entry].next)
+    {
+      if (nodes[entry].hash == hash)
+        return entry;
+    }
+    return SIZE_MAX;
+  }
+
+  size_t findFirst(size_t hash)
+  {
+    size_t entry = buckets[hash % buckets.size()];
+    if (entry == SIZE_MAX || nodes[entry].hash == hash)
+      return entry;
+    return findNext(hash, entry);
+  }
+
+  size_t insert(size_t hash, size_t value)
+  {
+    if (firstFree == SIZE_MAX)
+    {
+      size_t oldMemNodes = nodes.size();
+      nodes.resize(2 * oldMemNodes);
+      for (size_t i = oldMemNodes; i < nodes.size(); ++i)
+        nodes[i].next = (i + 1 < nodes.size()) ? i + 1 : SIZE_MAX;
+      firstFree = oldMemNodes;
+    }
+
+    size_t entry = firstFree;
+    firstFree = nodes[entry].next;
+    size_t bucket = hash % buckets.size();
+    nodes[entry].hash = hash;
+    nodes[entry].value = value;
+    nodes[entry].next = buckets[bucket];
+    buckets[bucket] = entry;
+    return entry;
+  }
+
+  void remove(size_t entry)
+  {
+    size_t* plink = &buckets[nodes[entry].hash % buckets.size()];
+    while (*plink != entry)
+      plink = &nodes[*plink].next;
+    *plink = nodes[entry].next;
+    nodes[entry].next = firstFree;
+    firstFree = entry;
+  }
+};
+
+/**
+ * \brief Inserts, finds and removes \p hashes with the chained hash table and returns the number of found entries.
+ */
+
+static
+size_t benchmarkChainedHashtable(
+  const std::vector<size_t>& hashes,      /**< Hash values to insert. */
+  const std::vector<size_t>& queries,     /**< Hash values to search. */
+  size_t initialNumBuckets,               /**< Initial number of buckets. */
+  double* ptime                           /**< Pointer for storing the time in seconds. */
+)
+{
+  clock_t startClock = clock();
+  ChainedHashtable hashtable(initialNumBuckets, initialNumBuckets);
+  std::vector<size_t> entries(hashes.size());
+  for (size_t i = 0; i < hashes.size(); ++i)
+    entries[i] = hashtable.insert(hashes[i], i);
+  size_t numFound = 0;
+  for (size_t round = 0; round < 2; ++round)
+  {
+    for (size_t query : queries)
+    {
+      for (size_t entry = hashtable.findFirst(query); entry != SIZE_MAX; entry = hashtable.findNext(query, entry))
+        ++numFound;
+    }
+    for (size_t i = round; i < hashes.size(); i += 2)
+      hashtable.remove(entries[i]);
+  }
+  *ptime = (clock() - startClock) * 1.0 / CLOCKS_PER_SEC;
+
+  return numFound;
+}
+
+/**
+ * \brief Inserts, finds and removes \p hashes with the open-addressing hash table and returns the number of found
+ *        entries.
+ */
+
+static
+size_t benchmarkListHashtable(
+  CMR* cmr,                               /**< \ref CMR environment. */
+  const std::vector<size_t>& hashes,      /**< Hash values to insert. */
+  const std::vector<size_t>& queries,     /**< Hash values to search. */
+  size_t initialNumBuckets,               /**< Initial number of buckets. */
+  double* ptime                           /**< Pointer for storing the time in seconds. */
+)
+{
+  clock_t startClock = clock();
+  CMR_LISTHASHTABLE* hashtable = NULL;
+  CMRlisthashtableCreate(cmr, &hashtable, initialNumBuckets, initialNumBuckets);
+  std::vector<CMR_LISTHASHTABLE_ENTRY> entries(hashes.size());
+  for (size_t i = 0; i < hashes.size(); ++i)
+    CMRlisthashtableInsert(cmr, hashtable, hashes[i], i, &entries[i]);
+  size_t numFound = 0;
+  for (size_t round = 0; round < 2; ++round)
+  {
+    for (size_t query : queries)
+    {
+      for (CMR_LISTHASHTABLE_ENTRY entry = CMRlisthashtableFindFirst(hashtable, query); entry != SIZE_MAX;
+        entry = CMRlisthashtableFindNext(hashtable, query, entry))
+      {
+        ++numFound;
+      }
+    }
+    for (size_t i = round; i < hashes.size(); i += 2)
+      CMRlisthashtableRemove(cmr, hashtable, entries[i]);
+  }
+  CMRlisthashtableFree(cmr, &hashtable);
+  *ptime = (clock() - startClock) * 1.0 / CLOCKS_PER_SEC;
+
+  return numFound;
+}
+
+TEST(Hashtable, ListThroughput)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* Hash values as they arise for rows of a matrix, including some duplicates. */
+  srand(0);
+  const size_t numHashes = 1 << 16;
+  std::vector<size_t> hashes(numHashes);
+  for (size_t i = 0; i < numHashes; ++i)
+  {
+    if (i > 0 && rand() % 8 == 0)
+      hashes[i] = hashes[rand() % i];
+    else
+      hashes[i] = ((size_t) rand() << 31) ^ (size_t) rand();
+  }
+  std::vector<size_t> queries(2 * numHashes);
+  for (size_t i = 0; i < numHashes; ++i)
+  {
+    queries[2*i] = hashes[rand() % numHashes];
+    queries[2*i+1] = ((size_t) rand() << 31) ^ (size_t) rand();
+  }
+
+  /* Presized as for the rows of a matrix, and starting small as for the nodes of a decomposition. */
+  size_t initialNumBuckets[2] = { nextPower2(numHashes), 1024 };
+  for (int i = 0; i < 2; ++i)
+  {
+    double chainedTime;
+    size_t chainedFound = benchmarkChainedHashtable(hashes, queries, initialNumBuckets[i], &chainedTime);
+    double listTime;
+    size_t listFound = benchmarkListHashtable(cmr, hashes, queries, initialNumBuckets[i], &listTime);
+    ASSERT_EQ( chainedFound, listFound );
+
+    printf("%zu insertions, %zu searches and %zu removals with %zu initial buckets: chained: %f seconds, "
+      "open addressing: %f seconds.\n", numHashes, 2 * queries.size(), numHashes, initialNumBuckets[i], chainedTime,
+      listTime);
+  }
+
+  CMRfreeEnvironment(&cmr);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "common.h"
+#include "../src/cmr/heap.h"
+
+#include <cstdlib>
+#include <vector>
+
+TEST(Heap, Sorting)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(1);
+  const int numKeys = 1000;
+  for (CMR_INTQUEUE_TYPE type : {CMR_INTQUEUE_HEAP, CMR_INTQUEUE_RADIX})
+  {
+    CMR_INTQUEUE queue;
+    ASSERT_CMR_CALL( CMRintqueueInitStack(cmr, &queue, type, numKeys) );
+
+    /* Insert all keys, decrease some of them and extract all. */
+    std::vector<int> values(numKeys);
+    for (int key = 0; key < numKeys; ++key)
+    {
+      values[key] = rand() % 100000;
+      CMRintqueueDecreaseInsert(&queue, key, values[key]);
+    }
+    for (int key = 0; key < numKeys; key += 3)
+    {
+      values[key] /= 2;
+      CMRintqueueDecreaseInsert(&queue, key, values[key]);
+    }
+    int last = -1;
+    for (int i = 0; i < numKeys; ++i)
+    {
+      ASSERT_FALSE(CMRintqueueEmpty(&queue));
+      int value;
+      int key = CMRintqueueExtractMinimum(&queue, &value);
+      ASSERT_EQ(value, values[key]);
+      ASSERT_LE(last, value);
+      ASSERT_EQ(CMRintqueueGetValueInfinity(&queue, key), INT_MAX);
+      last = value;
+    }
+    ASSERT_TRUE(CMRintqueueEmpty(&queue));
+
+    ASSERT_CMR_CALL( CMRintqueueClearStack(cmr, &queue) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Heap, ShortestPaths)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(2);
+  for (int round = 0; round < 20; ++round)
+  {
+    /* Random directed graph with arc lengths 0 and 1, given as adjacency lists. */
+    const int numNodes = 1 + rand() % 200;
+    std::vector<std::vector<std::pair<int, int>>> arcs(numNodes);
+    for (int i = 0; i < 3 * numNodes; ++i)
+      arcs[rand() % numNodes].push_back(std::make_pair(rand() % numNodes, rand() % 2));
+
+    /* Dijkstra's algorithm from node 0 with each queue type. */
+    std::vector<std::vector<int>> distances;
+    for (CMR_INTQUEUE_TYPE type : {CMR_INTQUEUE_HEAP, CMR_INTQUEUE_RADIX, CMR_INTQUEUE_DEQUE})
+    {
+      std::vector<int> distance(numNodes, INT_MAX);
+      std::vector<bool> completed(numNodes, false);
+      CMR_INTQUEUE queue;
+      ASSERT_CMR_CALL( CMRintqueueInitStack(cmr, &queue, type, numNodes) );
+      CMRintqueueDecreaseInsert(&queue, 0, 0);
+      while (!CMRintqueueEmpty(&queue))
+      {
+        int value;
+        int v = CMRintqueueExtractMinimum(&queue, &value);
+        ASSERT_FALSE(completed[v]);
+        completed[v] = true;
+        distance[v] = value;
+        for (auto& arc : arcs[v])
+        {
+          int w = arc.first;
+          if (!completed[w] && value + arc.second < CMRintqueueGetValueInfinity(&queue, w))
+            CMRintqueueDecreaseInsert(&queue, w, value + arc.second);
+        }
+      }
+      ASSERT_CMR_CALL( CMRintqueueClearStack(cmr, &queue) );
+      distances.push_back(distance);
+    }
+
+    ASSERT_EQ(distances[0], distances[1]);
+    ASSERT_EQ(distances[0], distances[2]);
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "common.h"
+#include "../src/cmr/hereditary_property.h"
+
+#include <cfloat>
+#include <sstream>
+
+/**
+ * \brief Test function for the hereditary property of having no entry equal to -1.
+ *
+ * Counts its calls in \p data. The call with the number stored in \p data[1] waits until the time limit is exceeded.
+ */
+
+static
+CMR_ERROR testNoMinusOne(CMR* cmr, CMR_CHRMAT* matrix, void* data, bool* phasProperty, CMR_SUBMAT** psubmatrix,
+  double timeLimit)
+{
+  CMR_UNUSED(cmr);
+  CMR_UNUSED(psubmatrix);
+
+  size_t* calls = (size_t*) data;
+  if (++calls[0] == calls[1])
+  {
+    double startTime = CMRwallClock();
+    while (CMRwallClock() - startTime <= timeLimit)
+      continue;
+  }
+
+  *phasProperty = true;
+  for (size_t e = 0; e < matrix->numNonzeros; ++e)
+  {
+    if (matrix->entryValues[e] == -1)
+      *phasProperty = false;
+  }
+
+  return CMR_OKAY;
+}
+
+TEST(HereditaryProperty, DeltaDebugging)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* A 20x20 matrix of ones with a single -1. */
+  std::stringstream ss;
+  ss << "20 20";
+  for (size_t row = 0; row < 20; ++row)
+  {
+    for (size_t column = 0; column < 20; ++column)
+      ss << ((row == 7 && column == 11) ? " -1" : " 1");
+  }
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, ss.str().c_str()) );
+
+  /* The minimal violator is the single -1. */
+  size_t calls[2] = { 0, SIZE_MAX };
+  CMR_SUBMAT* violator = NULL;
+  ASSERT_CMR_CALL( CMRtestHereditaryPropertyDeltaDebugging(cmr, matrix, testNoMinusOne, calls, &violator, DBL_MAX) );
+  ASSERT_TRUE( violator );
+  ASSERT_EQ( violator->numRows, 1UL );
+  ASSERT_EQ( violator->numColumns, 1UL );
+  ASSERT_EQ( violator->rows[0], 7UL );
+  ASSERT_EQ( violator->columns[0], 11UL );
+  ASSERT_GT( calls[0], 3UL );
+  ASSERT_CMR_CALL( CMRsubmatFree(cmr, &violator) );
+
+  /* If the time limit is exceeded during the minimization, then no violator is returned and no memory is leaked. */
+  size_t stackUsage = CMRgetStackUsage(cmr);
+  size_t blockMemory = cmr->blockMemory;
+  calls[0] = 0;
+  calls[1] = 3;
+  ASSERT_EQ( CMRtestHereditaryPropertyDeltaDebugging(cmr, matrix, testNoMinusOne, calls, &violator, 0.01),
+    CMR_ERROR_TIMEOUT );
+  ASSERT_FALSE( violator );
+  ASSERT_EQ( calls[0], 3UL );
+  ASSERT_EQ( CMRgetStackUsage(cmr), stackUsage );
+  ASSERT_EQ( cmr->blockMemory, blockMemory );
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "common.h"
+#include "../src/cmr/listmatrix.h"
+#include "../src/cmr/env_internal.h"
+
+#include <cstdlib>
+#include <vector>
+
+TEST(ListMatrix, Growth)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(1);
+  const size_t numRows = 50;
+  const size_t numColumns = 60;
+  ListMat8* listmatrix = NULL;
+  ASSERT_CMR_CALL( CMRlistmat8Alloc(cmr, numRows, numColumns, 10, &listmatrix) );
+  ASSERT_CMR_CALL( CMRlistmat8InitializeZero(cmr, listmatrix, numRows, numColumns) );
+  listmatrix->numNonzeros = 0;
+
+  /* Insert far more nonzeros than initially allocated; the first ones must not move. */
+  std::vector<ListMat8Nonzero*> inserted;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+      ASSERT_CMR_CALL( CMRlistmat8Insert(cmr, listmatrix, row, column, (row + column) % 2 ? 1 : -1, 0, NULL) );
+      inserted.push_back(listmatrix->rowElements[row].head.right);
+    }
+  }
+  ASSERT_EQ(listmatrix->numNonzeros, numRows * numColumns);
+  for (size_t i = 0; i < inserted.size(); ++i)
+  {
+    ASSERT_EQ(inserted[i]->row, i / numColumns);
+    ASSERT_EQ(inserted[i]->column, i % numColumns);
+    ASSERT_EQ(inserted[i]->value, (inserted[i]->row + inserted[i]->column) % 2 ? 1 : -1);
+  }
+
+  /* Delete every other nonzero and check the lists. */
+  for (size_t i = 0; i < inserted.size(); i += 2)
+    ASSERT_CMR_CALL( CMRlistmat8Delete(cmr, listmatrix, inserted[i]) );
+  ASSERT_EQ(listmatrix->numNonzeros, numRows * numColumns / 2);
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    size_t count = 0;
+    for (ListMat8Nonzero* nz = listmatrix->rowElements[row].head.right; nz != &listmatrix->rowElements[row].head;
+      nz = nz->right)
+    {
+      ASSERT_EQ((row * numColumns + nz->column) % 2, 1UL);
+      ++count;
+    }
+    ASSERT_EQ(count, numColumns / 2);
+  }
+
+  ASSERT_CMR_CALL( CMRlistmat8Free(cmr, &listmatrix) );
+
+  /* Once no slab is in use, the pool is rewound, i.e., memory is reused. */
+  ASSERT_EQ(cmr->slabPool.numUsedSlabs, 0UL);
+  ListMat64* first = NULL;
+  ASSERT_CMR_CALL( CMRlistmat64Alloc(cmr, numRows, numColumns, 100, &first) );
+  ListMat64Nonzero* nonzeros = first->nonzeros;
+  ASSERT_CMR_CALL( CMRlistmat64Free(cmr, &first) );
+  ListMat64* second = NULL;
+  ASSERT_CMR_CALL( CMRlistmat64Alloc(cmr, numRows, numColumns, 100, &second) );
+  ASSERT_EQ(second->nonzeros, nonzeros);
+  ASSERT_CMR_CALL( CMRlistmat64Free(cmr, &second) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <stdio.h>
+#include <vector>
 
 #include "common.h"
 #include <cmr/matroid.h>
@@ -195,3 +196,128 @@ TEST(Matroid, TernaryPivot)
 
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+/**
+ * \brief Applies a pivot to a dense matrix over GF(2) or GF(3) with entries in {-1,0,1}.
+ */
+
+static
+void densePivot(std::vector<std::vector<int>>& A, size_t r, size_t c, int characteristic)
+{
+  auto reduce = [characteristic](int value) {
+    value %= characteristic;
+    if (value < 0)
+      value += characteristic;
+    return (value == 2) ? -1 : value;
+  };
+
+  int p = A[r][c];
+  for (size_t i = 0; i < A.size(); ++i)
+  {
+    if (i == r || !A[i][c])
+      continue;
+    for (size_t j = 0; j < A[i].size(); ++j)
+    {
+      if (j != c)
+        A[i][j] = reduce(A[i][j] - A[i][c] * A[r][j] * p);
+    }
+    A[i][c] = reduce(A[i][c] * p);
+  }
+  for (size_t j = 0; j < A[r].size(); ++j)
+  {
+    if (j != c)
+      A[r][j] = reduce(A[r][j] * p);
+  }
+  A[r][c] = reduce(-p);
+}
+
+TEST(Matroid, RandomPivots)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(1);
+  for (int round = 0; round < 200; ++round)
+  {
+    int characteristic = (round % 2) ? 3 : 2;
+    size_t numRows = 1 + rand() % 90;
+    size_t numColumns = 1 + rand() % 90;
+    int percentage = (round % 4 < 2) ? 2 : 40;
+
+    /* Create a random matrix and its dense copy. */
+    std::vector<std::vector<int>> A(numRows, std::vector<int>(numColumns, 0));
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatCreate(cmr, &matrix, numRows, numColumns, numRows * numColumns) );
+    size_t entry = 0;
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      matrix->rowSlice[row] = entry;
+      for (size_t column = 0; column < numColumns; ++column)
+      {
+        if (rand() % 100 >= percentage)
+          continue;
+        A[row][column] = (characteristic == 2 || rand() % 2) ? 1 : -1;
+        matrix->entryColumns[entry] = column;
+        matrix->entryValues[entry] = A[row][column];
+        ++entry;
+      }
+    }
+    matrix->rowSlice[numRows] = entry;
+    matrix->numNonzeros = entry;
+
+    /* Choose pivots on nonzeros of the current dense matrix. */
+    std::vector<size_t> pivotRows;
+    std::vector<size_t> pivotColumns;
+    size_t numPivots = 1 + rand() % 20;
+    for (size_t p = 0; p < numPivots; ++p)
+    {
+      std::vector<std::pair<size_t, size_t>> nonzeros;
+      for (size_t row = 0; row < numRows; ++row)
+      {
+        for (size_t column = 0; column < numColumns; ++column)
+        {
+          if (A[row][column])
+            nonzeros.push_back(std::make_pair(row, column));
+        }
+      }
+      if (nonzeros.empty())
+        break;
+      auto pivot = nonzeros[rand() % nonzeros.size()];
+      densePivot(A, pivot.first, pivot.second, characteristic);
+      pivotRows.push_back(pivot.first);
+      pivotColumns.push_back(pivot.second);
+    }
+
+    if (pivotRows.empty())
+    {
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+      continue;
+    }
+
+    CMR_CHRMAT* result = NULL;
+    if (characteristic == 2)
+    {
+      ASSERT_CMR_CALL( CMRchrmatBinaryPivots(cmr, matrix, pivotRows.size(), pivotRows.data(), pivotColumns.data(),
+        &result) );
+    }
+    else
+    {
+      ASSERT_CMR_CALL( CMRchrmatTernaryPivots(cmr, matrix, pivotRows.size(), pivotRows.data(), pivotColumns.data(),
+        &result) );
+    }
+
+    std::vector<std::vector<int>> B(numRows, std::vector<int>(numColumns, 0));
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      for (size_t e = result->rowSlice[row]; e < result->rowSlice[row + 1]; ++e)
+        B[row][result->entryColumns[e]] = result->entryValues[e];
+    }
+    ASSERT_EQ(A, B) << "Round " << round << " with " << pivotRows.size() << " pivots over GF(" << characteristic
+      << ") on a " << numRows << "x" << numColumns << " matrix.";
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &result) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
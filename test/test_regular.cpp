@@ -10,6 +10,9 @@
 
 #include "common.h"
 
+#include <climits>
+#include <string>
+
 #include <cmr/regular.h>
 #include <cmr/separation.h>
 #include <cmr/graphic.h>
@@ -447,6 +450,34 @@ TEST(Regular, SequenceGraphicnessWheel)
     testSequenceGraphicness(cmr, matrix, true);
   }
 
+  {
+    /* Wheel whose dense representation spans several bit tiles. */
+    const size_t size = 70;
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatCreate(cmr, &matrix, size, size, 2 * size) );
+    size_t entry = 0;
+    for (size_t row = 0; row < size; ++row)
+    {
+      matrix->rowSlice[row] = entry;
+      if (row == 0)
+      {
+        matrix->entryColumns[entry] = 0;
+        matrix->entryValues[entry++] = 1;
+        matrix->entryColumns[entry] = size - 1;
+        matrix->entryValues[entry++] = 1;
+      }
+      else
+      {
+        matrix->entryColumns[entry] = row - 1;
+        matrix->entryValues[entry++] = 1;
+        matrix->entryColumns[entry] = row;
+        matrix->entryValues[entry++] = 1;
+      }
+    }
+    matrix->rowSlice[size] = entry;
+    testSequenceGraphicness(cmr, matrix, true);
+  }
+
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
 
@@ -917,6 +948,705 @@ TEST(Regular, TreeFlagsStopNongraphic)
 }
 
 
+/**
+ * \brief Returns the contents of \p stream, which is rewound before and after reading.
+ */
+
+static
+std::string streamContents(
+  FILE* stream  /**< Stream. */
+)
+{
+  std::string contents;
+  rewind(stream);
+  for (int c = fgetc(stream); c != EOF; c = fgetc(stream))
+    contents.push_back((char) c);
+  rewind(stream);
+  return contents;
+}
+
+/**
+ * \brief Appends \p number to \p contents in the encoding of serialized Seymour decompositions.
+ */
+
+static
+void appendNumber(
+  std::string& contents,  /**< Serialized contents. */
+  uint64_t number         /**< Number to append. */
+)
+{
+  for (; number >= 0x80; number >>= 7)
+    contents.push_back((char) (0x80 | (number & 0x7f)));
+  contents.push_back((char) number);
+}
+
+/**
+ * \brief Returns whether reading a Seymour decomposition from \p contents fails with \ref CMR_ERROR_INPUT.
+ */
+
+static
+bool isRejected(
+  CMR* cmr,                     /**< \ref CMR environment. */
+  const std::string& contents   /**< Serialized contents. */
+)
+{
+  FILE* stream = tmpfile();
+  if (!stream)
+    return false;
+  fwrite(contents.data(), 1, contents.size(), stream);
+  rewind(stream);
+  CMR_SEYMOUR_NODE* dec = NULL;
+  CMR_ERROR error = CMRseymourCreateFromStream(cmr, stream, &dec);
+  fclose(stream);
+  if (dec)
+    CMRseymourRelease(cmr, &dec);
+  return error == CMR_ERROR_INPUT;
+}
+
+/**
+ * \brief Writes \p dec, reads it back into \p *pcopy and checks that writing the copy yields the same bytes.
+ */
+
+static
+void testSerialization(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_SEYMOUR_NODE* dec,    /**< Seymour decomposition. */
+  CMR_SEYMOUR_NODE** pcopy  /**< Pointer for storing the copy. */
+)
+{
+  FILE* stream = tmpfile();
+  ASSERT_TRUE( stream );
+  ASSERT_CMR_CALL( CMRseymourWrite(cmr, dec, stream) );
+  std::string original = streamContents(stream);
+  ASSERT_CMR_CALL( CMRseymourCreateFromStream(cmr, stream, pcopy) );
+  fclose(stream);
+
+  stream = tmpfile();
+  ASSERT_TRUE( stream );
+  ASSERT_CMR_CALL( CMRseymourWrite(cmr, *pcopy, stream) );
+  ASSERT_EQ( streamContents(stream), original );
+  fclose(stream);
+
+  ASSERT_EQ( CMRseymourType(*pcopy), CMRseymourType(dec) );
+  ASSERT_EQ( CMRseymourRegularity(*pcopy), CMRseymourRegularity(dec) );
+  ASSERT_EQ( CMRseymourGraphicness(*pcopy), CMRseymourGraphicness(dec) );
+  ASSERT_EQ( CMRseymourCographicness(*pcopy), CMRseymourCographicness(dec) );
+  ASSERT_EQ( CMRseymourNumChildren(*pcopy), CMRseymourNumChildren(dec) );
+  ASSERT_TRUE( CMRchrmatCheckEqual(CMRseymourGetMatrix(*pcopy), CMRseymourGetMatrix(dec)) );
+}
+
+TEST(Regular, SerializeComplete)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  const char* matrixStrings[] = {
+    /* 1-sum of K_{3,3} and its dual. */
+    "9 9 "
+    "1 1 0 0 0 0 0 0 0 "
+    "1 1 1 0 0 0 0 0 0 "
+    "1 0 0 1 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0 0 "
+    "0 0 1 1 0 0 0 0 0 "
+    "0 0 0 0 1 1 1 0 0 "
+    "0 0 0 0 1 1 0 1 0 "
+    "0 0 0 0 0 1 0 1 1 "
+    "0 0 0 0 0 0 1 1 1 ",
+    /* R12, which is decomposed by a 3-sum. */
+    "6 6 "
+    "1 0 1 1 0 0 "
+    "0 1 1 1 0 0 "
+    "1 0 1 0 1 1 "
+    "0 1 0 1 1 1 "
+    "1 0 1 0 1 0 "
+    "0 1 0 1 0 1 ",
+    /* R10, which is irregular. */
+    "5 5 "
+    "1 1 0 0 1 "
+    "1 1 1 0 0 "
+    "0 1 1 1 0 "
+    "0 0 1 1 1 "
+    "1 0 0 1 1 "
+  };
+
+  for (size_t i = 0; i < sizeof(matrixStrings) / sizeof(matrixStrings[0]); ++i)
+  {
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, matrixStrings[i]) );
+
+    bool isRegular;
+    CMR_SEYMOUR_NODE* dec = NULL;
+    CMR_REGULAR_PARAMS params;
+    ASSERT_CMR_CALL( CMRregularParamsInit(&params) );
+    params.seymour.decomposeStrategy = CMR_SEYMOUR_DECOMPOSE_FLAG_SEYMOUR;
+    params.seymour.directGraphicness = false;
+    params.seymour.constructAllGraphs = true;
+    ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, &dec, NULL, &params, NULL, DBL_MAX) );
+
+    CMR_SEYMOUR_NODE* copy = NULL;
+    testSerialization(cmr, dec, &copy);
+    ASSERT_CMR_CALL( CMRseymourPrint(cmr, copy, stdout, true, true, true, true, true, true) );
+
+    ASSERT_CMR_CALL( CMRseymourRelease(cmr, &copy) );
+    ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, SerializePartial)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  {
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "6 6 "
+      "1 0 1 1 0 0 "
+      "0 1 1 1 0 0 "
+      "1 0 1 0 1 1 "
+      "0 1 0 1 1 1 "
+      "1 0 1 0 1 0 "
+      "0 1 0 1 0 1 "
+    ) );
+
+    /* An undecomposed root is continued after reading it back. */
+    CMR_SEYMOUR_NODE* dec = NULL;
+    ASSERT_CMR_CALL( CMRseymourCreate(cmr, &dec, false, matrix, true) );
+    CMR_SEYMOUR_NODE* copy = NULL;
+    testSerialization(cmr, dec, &copy);
+    ASSERT_EQ( CMRseymourType(copy), CMR_SEYMOUR_NODE_TYPE_UNKNOWN );
+
+    ASSERT_CMR_CALL( CMRregularRefineDecomposition(cmr, 1, &copy, NULL, NULL, DBL_MAX) );
+    ASSERT_GT( CMRseymourRegularity(copy), 0 );
+
+    /* A truncated stream is rejected. */
+    FILE* stream = tmpfile();
+    ASSERT_TRUE( stream );
+    ASSERT_CMR_CALL( CMRseymourWrite(cmr, copy, stream) );
+    std::string contents = streamContents(stream);
+    fclose(stream);
+    stream = tmpfile();
+    ASSERT_TRUE( stream );
+    fwrite(contents.data(), 1, contents.size() / 2, stream);
+    rewind(stream);
+    CMR_SEYMOUR_NODE* truncated = NULL;
+    ASSERT_EQ( CMRseymourCreateFromStream(cmr, stream, &truncated), CMR_ERROR_INPUT );
+    ASSERT_EQ( truncated, (CMR_SEYMOUR_NODE*) NULL );
+    fclose(stream);
+
+    /* A matrix whose header claims huge counts is rejected without allocating memory for them. */
+    CMR_CHRMAT* tiny = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &tiny, "1 1 1") );
+    CMR_SEYMOUR_NODE* tinyDec = NULL;
+    ASSERT_CMR_CALL( CMRseymourCreate(cmr, &tinyDec, false, tiny, true) );
+    stream = tmpfile();
+    ASSERT_TRUE( stream );
+    ASSERT_CMR_CALL( CMRseymourWrite(cmr, tinyDec, stream) );
+    contents = streamContents(stream);
+    fclose(stream);
+    size_t matrixStart = contents.find(std::string(4, '\x01'));
+    ASSERT_NE( matrixStart, std::string::npos );
+    std::string corrupted = contents.substr(0, matrixStart);
+    for (uint64_t number : { (uint64_t) 1000000, (uint64_t) 1000000, (uint64_t) INT_MAX })
+      appendNumber(corrupted, number);
+    corrupted.push_back('\x01');
+    stream = tmpfile();
+    ASSERT_TRUE( stream );
+    fwrite(corrupted.data(), 1, corrupted.size(), stream);
+    rewind(stream);
+    ASSERT_EQ( CMRseymourCreateFromStream(cmr, stream, &truncated), CMR_ERROR_INPUT );
+    ASSERT_EQ( truncated, (CMR_SEYMOUR_NODE*) NULL );
+    fclose(stream);
+    ASSERT_CMR_CALL( CMRseymourRelease(cmr, &tinyDec) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &tiny) );
+
+    ASSERT_CMR_CALL( CMRseymourRelease(cmr, &copy) );
+    ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, SerializeCorruptedGraph)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* The decomposition is a single graphic leaf whose graph has 3 nodes and 4 edges. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "2 2 1 1 0 1") );
+  bool isRegular;
+  CMR_SEYMOUR_NODE* dec = NULL;
+  ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, &dec, NULL, NULL, NULL, DBL_MAX) );
+  ASSERT_TRUE( CMRseymourGraph(dec) );
+  ASSERT_EQ( CMRgraphNumNodes(CMRseymourGraph(dec)), 3UL );
+  ASSERT_EQ( CMRgraphNumEdges(CMRseymourGraph(dec)), 4UL );
+  CMR_SEYMOUR_NODE* copy = NULL;
+  testSerialization(cmr, dec, &copy);
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &copy) );
+
+  FILE* stream = tmpfile();
+  ASSERT_TRUE( stream );
+  ASSERT_CMR_CALL( CMRseymourWrite(cmr, dec, stream) );
+  std::string contents = streamContents(stream);
+  fclose(stream);
+  ASSERT_FALSE( isRejected(cmr, contents) );
+
+  /* The graph consists of the counts, 4 edges, the number of isolated nodes and the rest. */
+  size_t graphStart = contents.find("\x03\x04");
+  ASSERT_NE( graphStart, std::string::npos );
+  std::string prefix = contents.substr(0, graphStart);
+  std::string edges = contents.substr(graphStart + 2, 8);
+  ASSERT_EQ( contents[graphStart + 10], '\0' );
+  std::string suffix = contents.substr(graphStart + 11);
+
+  /* Edges without nodes. */
+  std::string corrupted = prefix;
+  appendNumber(corrupted, 0);
+  appendNumber(corrupted, 4);
+  ASSERT_TRUE( isRejected(cmr, corrupted + edges + '\0' + suffix) );
+
+  /* More nodes than edges and isolated nodes can account for. */
+  corrupted = prefix;
+  appendNumber(corrupted, INT_MAX);
+  appendNumber(corrupted, 4);
+  ASSERT_TRUE( isRejected(cmr, corrupted + edges + '\0' + suffix) );
+
+  /* A huge number of edges in a truncated stream. */
+  corrupted = prefix;
+  appendNumber(corrupted, 3);
+  appendNumber(corrupted, INT_MAX / 2);
+  ASSERT_TRUE( isRejected(cmr, corrupted + edges) );
+
+  /* An isolated node with an incident edge. */
+  corrupted = prefix;
+  appendNumber(corrupted, 3);
+  appendNumber(corrupted, 4);
+  ASSERT_TRUE( isRejected(cmr, corrupted + edges + "\x01\x02" + suffix) );
+
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+/**
+ * \brief Returns the number of children of \p dec that are also children of \p previous.
+ */
+
+static
+size_t countReusedChildren(
+  CMR_SEYMOUR_NODE* dec,      /**< New decomposition. */
+  CMR_SEYMOUR_NODE* previous  /**< Previous decomposition. */
+)
+{
+  size_t count = 0;
+  for (size_t c = 0; c < CMRseymourNumChildren(dec); ++c)
+  {
+    for (size_t p = 0; p < CMRseymourNumChildren(previous); ++p)
+    {
+      if (CMRseymourChild(dec, c) == CMRseymourChild(previous, p))
+        ++count;
+    }
+  }
+  return count;
+}
+
+TEST(Regular, UpdateDecomposition)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* 1-sum of R12 and R10. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "11 11 "
+    "1 0 1 1 0 0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0 0 0 0 "
+    "1 0 1 0 1 1 0 0 0 0 0 "
+    "0 1 0 1 1 1 0 0 0 0 0 "
+    "1 0 1 0 1 0 0 0 0 0 0 "
+    "0 1 0 1 0 1 0 0 0 0 0 "
+    "0 0 0 0 0 0 1 1 0 0 1 "
+    "0 0 0 0 0 0 1 1 1 0 0 "
+    "0 0 0 0 0 0 0 1 1 1 0 "
+    "0 0 0 0 0 0 0 0 1 1 1 "
+    "0 0 0 0 0 0 1 0 0 1 1 "
+  ) );
+
+  CMR_REGULAR_PARAMS params;
+  ASSERT_CMR_CALL( CMRregularParamsInit(&params) );
+  params.seymour.stopWhenIrregular = false;
+  bool isRegular;
+  CMR_SEYMOUR_NODE* dec = NULL;
+  ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, &dec, NULL, &params, NULL, DBL_MAX) );
+  ASSERT_TRUE( isRegular );
+  ASSERT_EQ( CMRseymourType(dec), CMR_SEYMOUR_NODE_TYPE_ONESUM );
+  ASSERT_EQ( CMRseymourNumChildren(dec), 2UL );
+
+  /* Without changes, both components are reused. */
+  CMR_SEYMOUR_NODE* updated = NULL;
+  ASSERT_CMR_CALL( CMRregularUpdateDecomposition(cmr, dec, matrix, NULL, NULL, &isRegular, &updated, &params, NULL,
+    DBL_MAX) );
+  ASSERT_TRUE( isRegular );
+  ASSERT_EQ( countReusedChildren(updated, dec), 2UL );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &updated) );
+
+  /* Appending a row to the R12 component reuses the R10 component. */
+  CMR_CHRMAT* appended = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &appended, "12 11 "
+    "1 0 1 1 0 0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0 0 0 0 "
+    "1 0 1 0 1 1 0 0 0 0 0 "
+    "0 1 0 1 1 1 0 0 0 0 0 "
+    "1 0 1 0 1 0 0 0 0 0 0 "
+    "0 1 0 1 0 1 0 0 0 0 0 "
+    "0 0 0 0 0 0 1 1 0 0 1 "
+    "0 0 0 0 0 0 1 1 1 0 0 "
+    "0 0 0 0 0 0 0 1 1 1 0 "
+    "0 0 0 0 0 0 0 0 1 1 1 "
+    "0 0 0 0 0 0 1 0 0 1 1 "
+    "1 1 0 0 0 0 0 0 0 0 0 "
+  ) );
+  ASSERT_CMR_CALL( CMRregularUpdateDecomposition(cmr, dec, appended, NULL, NULL, &isRegular, &updated, &params, NULL,
+    DBL_MAX) );
+  ASSERT_EQ( countReusedChildren(updated, dec), 1UL );
+  bool isRegularScratch;
+  ASSERT_CMR_CALL( CMRregularTest(cmr, appended, &isRegularScratch, NULL, NULL, &params, NULL, DBL_MAX) );
+  ASSERT_EQ( isRegular, isRegularScratch );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &updated) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &appended) );
+
+  /* Removing the first R10 row and flipping an R10 entry reuses the R12 component. */
+  CMR_CHRMAT* modified = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &modified, "10 11 "
+    "1 0 1 1 0 0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0 0 0 0 "
+    "1 0 1 0 1 1 0 0 0 0 0 "
+    "0 1 0 1 1 1 0 0 0 0 0 "
+    "1 0 1 0 1 0 0 0 0 0 0 "
+    "0 1 0 1 0 1 0 0 0 0 0 "
+    "0 0 0 0 0 0 1 1 1 0 0 "
+    "0 0 0 0 0 0 0 1 1 1 0 "
+    "0 0 0 0 0 0 0 0 1 1 1 "
+    "0 0 0 0 0 0 1 0 0 0 1 "
+  ) );
+  size_t rowsToPrevious[10] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 10 };
+  ASSERT_CMR_CALL( CMRregularUpdateDecomposition(cmr, dec, modified, rowsToPrevious, NULL, &isRegular, &updated,
+    &params, NULL, DBL_MAX) );
+  ASSERT_EQ( countReusedChildren(updated, dec), 1UL );
+  ASSERT_CMR_CALL( CMRregularTest(cmr, modified, &isRegularScratch, NULL, NULL, &params, NULL, DBL_MAX) );
+  ASSERT_EQ( isRegular, isRegularScratch );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &updated) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &modified) );
+
+  /* Removing the R10 component entirely reuses the R12 decomposition as the root. */
+  CMR_CHRMAT* reduced = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &reduced, "6 6 "
+    "1 0 1 1 0 0 "
+    "0 1 1 1 0 0 "
+    "1 0 1 0 1 1 "
+    "0 1 0 1 1 1 "
+    "1 0 1 0 1 0 "
+    "0 1 0 1 0 1 "
+  ) );
+  ASSERT_CMR_CALL( CMRregularUpdateDecomposition(cmr, dec, reduced, NULL, NULL, &isRegular, &updated, &params, NULL,
+    DBL_MAX) );
+  ASSERT_TRUE( isRegular );
+  ASSERT_TRUE( updated == CMRseymourChild(dec, 0) || updated == CMRseymourChild(dec, 1) );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &updated) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &reduced) );
+
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, UpdateDecompositionUnknown)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* 1-sum of the Fano matrix and R10. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "8 9 "
+    "1 1 0 1 0 0 0 0 0 "
+    "1 0 1 1 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0 0 "
+    "0 0 0 0 1 1 0 0 1 "
+    "0 0 0 0 1 1 1 0 0 "
+    "0 0 0 0 0 1 1 1 0 "
+    "0 0 0 0 0 0 1 1 1 "
+    "0 0 0 0 1 0 0 1 1 "
+  ) );
+
+  /* Stopping at the Fano matrix leaves the other component undecided. */
+  CMR_REGULAR_PARAMS params;
+  ASSERT_CMR_CALL( CMRregularParamsInit(&params) );
+  params.seymour.stopWhenIrregular = true;
+  bool isRegular;
+  CMR_SEYMOUR_NODE* dec = NULL;
+  ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, &dec, NULL, &params, NULL, DBL_MAX) );
+  ASSERT_FALSE( isRegular );
+  ASSERT_EQ( CMRseymourType(dec), CMR_SEYMOUR_NODE_TYPE_ONESUM );
+  ASSERT_EQ( CMRseymourNumChildren(dec), 2UL );
+  size_t numUnknown = 0;
+  for (size_t c = 0; c < 2; ++c)
+    numUnknown += CMRseymourRegularity(CMRseymourChild(dec, c)) == 0 ? 1 : 0;
+  ASSERT_EQ( numUnknown, 1UL );
+
+  /* Only the decided component is reused, while the undecided one is decomposed. */
+  params.seymour.stopWhenIrregular = false;
+  CMR_SEYMOUR_NODE* updated = NULL;
+  ASSERT_CMR_CALL( CMRregularUpdateDecomposition(cmr, dec, matrix, NULL, NULL, &isRegular, &updated, &params, NULL,
+    DBL_MAX) );
+  ASSERT_FALSE( isRegular );
+  ASSERT_EQ( countReusedChildren(updated, dec), 1UL );
+  for (size_t c = 0; c < 2; ++c)
+    ASSERT_NE( CMRseymourRegularity(CMRseymourChild(updated, c)), 0 );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &updated) );
+
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, LowMemory)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* 1-sum of R12 and R10. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "11 11 "
+    "1 0 1 1 0 0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0 0 0 0 "
+    "1 0 1 0 1 1 0 0 0 0 0 "
+    "0 1 0 1 1 1 0 0 0 0 0 "
+    "1 0 1 0 1 0 0 0 0 0 0 "
+    "0 1 0 1 0 1 0 0 0 0 0 "
+    "0 0 0 0 0 0 1 1 0 0 1 "
+    "0 0 0 0 0 0 1 1 1 0 0 "
+    "0 0 0 0 0 0 0 1 1 1 0 "
+    "0 0 0 0 0 0 0 0 1 1 1 "
+    "0 0 0 0 0 0 1 0 0 1 1 "
+  ) );
+
+  CMR_REGULAR_PARAMS params;
+  ASSERT_CMR_CALL( CMRregularParamsInit(&params) );
+  CMR_REGULAR_STATS stats;
+  ASSERT_CMR_CALL( CMRregularStatsInit(&stats) );
+  bool isRegular;
+  CMR_SEYMOUR_NODE* dec = NULL;
+  ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, &dec, NULL, &params, &stats, DBL_MAX) );
+
+  CMR_REGULAR_STATS lowStats;
+  ASSERT_CMR_CALL( CMRregularStatsInit(&lowStats) );
+  params.seymour.lowMemory = true;
+  bool isRegularLow;
+  CMR_SEYMOUR_NODE* lowDec = NULL;
+  ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegularLow, &lowDec, NULL, &params, &lowStats, DBL_MAX) );
+  ASSERT_CMR_CALL( CMRregularStatsPrint(stdout, &lowStats, NULL) );
+
+  ASSERT_EQ( isRegularLow, isRegular );
+  ASSERT_EQ( CMRseymourRegularity(lowDec), CMRseymourRegularity(dec) );
+  ASSERT_TRUE( CMRseymourGetMatrix(lowDec) != NULL );
+  for (size_t c = 0; c < CMRseymourNumChildren(lowDec); ++c)
+  {
+    CMR_SEYMOUR_NODE* child = CMRseymourChild(lowDec, c);
+    ASSERT_EQ( CMRseymourGetMatrix(child) == NULL, CMRseymourNumChildren(child) > 0 );
+  }
+  if (stats.seymour.retainedBytes > 0)
+  {
+    ASSERT_LT( lowStats.seymour.retainedBytes, stats.seymour.retainedBytes );
+    ASSERT_GE( lowStats.seymour.peakBytes, lowStats.seymour.retainedBytes );
+  }
+
+  /* Components can still be reused. */
+  CMR_SEYMOUR_NODE* updated = NULL;
+  ASSERT_CMR_CALL( CMRregularUpdateDecomposition(cmr, lowDec, matrix, NULL, NULL, &isRegularLow, &updated, &params,
+    NULL, DBL_MAX) );
+  ASSERT_EQ( countReusedChildren(updated, lowDec), 2UL );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &updated) );
+
+  /* A reused component without matrix is copied such that only the copy gets the matrix. */
+  CMR_CHRMAT* reduced = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &reduced, "6 6 "
+    "1 0 1 1 0 0 "
+    "0 1 1 1 0 0 "
+    "1 0 1 0 1 1 "
+    "0 1 0 1 1 1 "
+    "1 0 1 0 1 0 "
+    "0 1 0 1 0 1 "
+  ) );
+  ASSERT_CMR_CALL( CMRregularUpdateDecomposition(cmr, lowDec, reduced, NULL, NULL, &isRegularLow, &updated, &params,
+    NULL, DBL_MAX) );
+  ASSERT_TRUE( isRegularLow );
+  ASSERT_TRUE( CMRseymourGetMatrix(updated) != NULL );
+  CMR_SEYMOUR_NODE* r12 = CMRseymourChild(lowDec, CMRseymourGetMatrix(CMRseymourChild(lowDec, 0)) ? 1 : 0);
+  ASSERT_TRUE( CMRseymourGetMatrix(r12) == NULL );
+  ASSERT_TRUE( updated != r12 );
+  ASSERT_EQ( CMRseymourType(updated), CMRseymourType(r12) );
+  ASSERT_EQ( CMRseymourNumChildren(updated), CMRseymourNumChildren(r12) );
+  for (size_t c = 0; c < CMRseymourNumChildren(r12); ++c)
+    ASSERT_EQ( CMRseymourChild(updated, c), CMRseymourChild(r12, c) );
+  ASSERT_TRUE( CMRseymourGetMatrix(r12) == NULL );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &updated) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &reduced) );
+
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &lowDec) );
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, ParallelThreeSeparation)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  const char* matrixStrings[] = {
+    /* R12, whose 3-separation is found by the enumeration. */
+    "6 6 "
+    "1 0 1 1 0 0 "
+    "0 1 1 1 0 0 "
+    "1 0 1 0 1 1 "
+    "0 1 0 1 1 1 "
+    "1 0 1 0 1 0 "
+    "0 1 0 1 0 1 ",
+    /* Irregular matrix whose decomposition enumerates candidates for several nodes. */
+    "14 14 "
+    "1 1 1 0 1 0 1 0  1 1 1 1 1 1 "
+    "1 0 1 0 1 0 1 0  1 1 1 1 1 0 "
+    "0 1 1 0 0 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 0 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 0 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 0  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 1  0 0 0 0 0 0 "
+    "0 1 1 1 1 1 1 1  1 0 0 0 0 0 "
+    "0 0 0 0 0 0 0 0  1 1 0 0 0 0 "
+    "0 0 0 0 0 0 0 0  0 1 1 0 0 0 "
+    "0 0 0 0 0 0 0 0  0 0 1 1 0 0 "
+    "0 0 0 0 0 0 0 0  0 0 0 1 1 0 "
+    "0 0 0 0 0 0 0 0  0 0 0 0 1 1 "
+  };
+
+  for (size_t i = 0; i < sizeof(matrixStrings) / sizeof(matrixStrings[0]); ++i)
+  {
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, matrixStrings[i]) );
+
+    std::string trees[2];
+    for (int t = 0; t < 2; ++t)
+    {
+      ASSERT_CMR_CALL( CMRsetNumThreads(cmr, t ? 4 : 1) );
+
+      bool isRegular;
+      CMR_SEYMOUR_NODE* dec = NULL;
+      CMR_REGULAR_PARAMS params;
+      ASSERT_CMR_CALL( CMRregularParamsInit(&params) );
+      params.seymour.directGraphicness = false;
+      params.seymour.simpleThreeSeparations = false;
+      CMR_REGULAR_STATS stats;
+      ASSERT_CMR_CALL( CMRregularStatsInit(&stats) );
+      ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, &dec, NULL, &params, &stats, DBL_MAX) );
+      ASSERT_GT( stats.seymour.enumerationCandidatesCount, 0U );
+
+      FILE* stream = tmpfile();
+      ASSERT_TRUE( stream );
+      ASSERT_CMR_CALL( CMRseymourWrite(cmr, dec, stream) );
+      trees[t] = streamContents(stream);
+      fclose(stream);
+
+      ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+    }
+
+    /* The decomposition does not depend on the number of threads. */
+    ASSERT_EQ( trees[0], trees[1] );
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(Regular, Trace)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* 1-sum of R12 and R10. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "11 11 "
+    "1 0 1 1 0 0 0 0 0 0 0 "
+    "0 1 1 1 0 0 0 0 0 0 0 "
+    "1 0 1 0 1 1 0 0 0 0 0 "
+    "0 1 0 1 1 1 0 0 0 0 0 "
+    "1 0 1 0 1 0 0 0 0 0 0 "
+    "0 1 0 1 0 1 0 0 0 0 0 "
+    "0 0 0 0 0 0 1 1 0 0 1 "
+    "0 0 0 0 0 0 1 1 1 0 0 "
+    "0 0 0 0 0 0 0 1 1 1 0 "
+    "0 0 0 0 0 0 0 0 1 1 1 "
+    "0 0 0 0 0 0 1 0 0 1 1 "
+  ) );
+
+  FILE* stream = tmpfile();
+  ASSERT_TRUE( stream );
+  CMR_REGULAR_PARAMS params;
+  ASSERT_CMR_CALL( CMRregularParamsInit(&params) );
+  params.seymour.directGraphicness = false;
+  params.seymour.simpleThreeSeparations = false;
+  ASSERT_CMR_CALL( CMRseymourTraceCreate(cmr, stream, &params.seymour.trace) );
+
+  bool isRegular;
+  CMR_SEYMOUR_NODE* dec = NULL;
+  ASSERT_CMR_CALL( CMRregularTest(cmr, matrix, &isRegular, &dec, NULL, &params, NULL, DBL_MAX) );
+  ASSERT_TRUE( isRegular );
+  ASSERT_CMR_CALL( CMRseymourTraceFree(cmr, &params.seymour.trace) );
+  ASSERT_TRUE( params.seymour.trace == NULL );
+
+  std::string trace = streamContents(stream);
+  fclose(stream);
+
+  /* The events form a JSON array of complete events. */
+  ASSERT_EQ( trace.front(), '[' );
+  ASSERT_EQ( trace.substr(trace.size() - 3), "\n]\n" );
+  ASSERT_NE( trace.find("{\"name\": \"1-sum\", \"cat\": \"seymour\", \"ph\": \"X\", \"ts\": "), std::string::npos );
+  ASSERT_NE( trace.find("\"name\": \"R10\""), std::string::npos );
+  ASSERT_NE( trace.find("\"name\": \"3-separation search\""), std::string::npos );
+  ASSERT_NE( trace.find("\"outcome\": \"R10\""), std::string::npos );
+  ASSERT_NE( trace.find("\"outcome\": \"3-sum\""), std::string::npos );
+
+  /* The whole decomposition is the last span and refers to the root node. */
+  size_t last = trace.rfind("{\"name\": ");
+  ASSERT_EQ( trace.find("{\"name\": \"decomposition\""), last );
+  ASSERT_NE( trace.find("\"args\": {\"node\": 1, \"rows\": 11, \"columns\": 11, \"ternary\": false", last),
+    std::string::npos );
+  ASSERT_NE( trace.find("\"outcome\": \"1-sum\"}}", last), std::string::npos );
+
+  /* All events but the first are separated by commas. */
+  size_t numEvents = 0;
+  size_t numCommas = 0;
+  for (size_t pos = trace.find("\"ph\": \"X\""); pos != std::string::npos; pos = trace.find("\"ph\": \"X\"", pos + 1))
+    ++numEvents;
+  for (size_t pos = trace.find("},\n{"); pos != std::string::npos; pos = trace.find("},\n{", pos + 1))
+    ++numCommas;
+  ASSERT_GE( numEvents, 5UL );
+  ASSERT_EQ( numCommas + 1, numEvents );
+
+  ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
 #if defined(MASSIVE_RANDOM)
 
 TEST(Regular, Random)
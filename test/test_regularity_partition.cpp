@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include "common.h"
+#include "../src/cmr/regularity_partition.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+/**
+ * \brief Finds a rank-2 submatrix by merging the sparse rows of \p matrix, as done before rows were packed.
+ */
+
+static
+bool unpackedFindRank2(
+  CMR_CHRMAT* matrix,                 /**< Matrix. */
+  ElementData* rowData,               /**< Row element data. */
+  ElementData* columnData,            /**< Column element data. */
+  size_t rowRepresentative[2][2],     /**< Row representatives for each part. */
+  size_t columnRepresentative[2][2],  /**< Column representatives for each part. */
+  short part                          /**< Part to which the investigated rows belong. */
+)
+{
+  size_t entryRepFirst = matrix->rowSlice[rowRepresentative[part][0]];
+  size_t beyondRep = matrix->rowSlice[rowRepresentative[part][0] + 1];
+  for (size_t row = rowRepresentative[part][0] + 1; row < matrix->numRows; ++row)
+  {
+    if (rowData[row].part != part)
+      continue;
+
+    size_t entry = matrix->rowSlice[row];
+    size_t beyond = matrix->rowSlice[row + 1];
+    size_t column = (entry < beyond) ? matrix->entryColumns[entry] : SIZE_MAX;
+    size_t entryRep = entryRepFirst;
+    size_t columnRep = (entryRep < beyondRep) ? matrix->entryColumns[entryRep] : SIZE_MAX;
+    bool isZero = true;
+    bool equalRep = true;
+    while (column != SIZE_MAX || columnRep != SIZE_MAX)
+    {
+      if (column < columnRep)
+      {
+        if (columnData[column].part == 1-part)
+        {
+          rowRepresentative[part][1] = row;
+          columnRepresentative[1-part][1] = column;
+          return true;
+        }
+        ++entry;
+        column = (entry < beyond) ? matrix->entryColumns[entry] : SIZE_MAX;
+      }
+      else if (columnRep < column)
+      {
+        if (columnData[columnRep].part == 1-part)
+        {
+          if (!isZero)
+          {
+            rowRepresentative[part][1] = row;
+            columnRepresentative[1-part][1] = columnRep;
+            return true;
+          }
+          equalRep = false;
+        }
+        ++entryRep;
+        columnRep = (entryRep < beyondRep) ? matrix->entryColumns[entryRep] : SIZE_MAX;
+      }
+      else
+      {
+        if (columnData[column].part == 1-part)
+        {
+          if (!equalRep)
+          {
+            rowRepresentative[part][1] = row;
+            columnRepresentative[1-part][1] = columnRep;
+            return true;
+          }
+          isZero = false;
+        }
+        ++entry;
+        column = (entry < beyond) ? matrix->entryColumns[entry] : SIZE_MAX;
+        ++entryRep;
+        columnRep = (entryRep < beyondRep) ? matrix->entryColumns[entryRep] : SIZE_MAX;
+      }
+    }
+  }
+
+  return false;
+}
+
+/**
+ * \brief Returns the type of \p row restricted to the columns of \p part by comparing dense vectors.
+ */
+
+static
+short unpackedType(
+  std::vector<std::vector<bool>>& dense,  /**< Dense matrix. */
+  ElementData* columnData,                /**< Column element data. */
+  short part,                             /**< Part of the considered columns. */
+  size_t representatives[2],              /**< Representative rows (\c SIZE_MAX if not existing). */
+  size_t row                              /**< Row index. */
+)
+{
+  bool compatible[4] = { true, representatives[0] < SIZE_MAX, representatives[1] < SIZE_MAX,
+    representatives[1] < SIZE_MAX };
+  for (size_t column = 0; column < dense[row].size(); ++column)
+  {
+    if (columnData[column].part != part)
+      continue;
+
+    bool current = dense[row][column];
+    bool first = representatives[0] < SIZE_MAX && dense[representatives[0]][column];
+    bool second = representatives[1] < SIZE_MAX && dense[representatives[1]][column];
+    compatible[0] = compatible[0] && !current;
+    compatible[1] = compatible[1] && current == first;
+    compatible[2] = compatible[2] && current == second;
+    compatible[3] = compatible[3] && current == (first != second);
+  }
+
+  for (short type = 3; type >= 0; --type)
+  {
+    if (compatible[type])
+      return type;
+  }
+
+  return -1;
+}
+
+TEST(RegularityPartition, PackedRanks)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(3);
+  size_t numRank2 = 0;
+  for (int round = 0; round < 300; ++round)
+  {
+    /* Many rows are copies or sums of few rows, such that ranks 1 and 2 as well as all types occur. */
+    size_t numRows = 2 + rand() % 40;
+    size_t numColumns = 1 + rand() % 150;
+    size_t numAssignedColumns = 1 + rand() % numColumns;
+    std::vector<std::vector<bool>> dense(numRows, std::vector<bool>(numColumns));
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      for (size_t column = 0; column < numColumns; ++column)
+      {
+        if (row >= 3 && rand() % 2)
+          dense[row][column] = dense[rand() % 3][column] != (rand() % 4 == 0 && dense[rand() % 3][column]);
+        else
+          dense[row][column] = rand() % (round % 2 ? 2 : 8) == 0;
+      }
+    }
+    std::stringstream ss;
+    ss << numRows << " " << numColumns;
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      for (size_t column = 0; column < numColumns; ++column)
+        ss << " " << (dense[row][column] ? 1 : 0);
+    }
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, ss.str().c_str()) );
+
+    std::vector<ElementData> rowData(numRows);
+    for (size_t row = 0; row < numRows; ++row)
+      rowData[row].part = (rand() % 3) - 1;
+    std::vector<ElementData> columnData(numColumns);
+    for (size_t column = 0; column < numColumns; ++column)
+      columnData[column].part = column < numAssignedColumns ? (rand() % 3) - 1 : -1;
+
+    PackedMatrix packed;
+    ASSERT_CMR_CALL( CMRregularityPackedCreate(cmr, matrix, numAssignedColumns, &packed) );
+    std::vector<uint64_t> masks[2] = { std::vector<uint64_t>(packed.numWords, 0),
+      std::vector<uint64_t>(packed.numWords, 0) };
+    for (size_t column = 0; column < numAssignedColumns; ++column)
+    {
+      if (columnData[column].part >= 0)
+        masks[columnData[column].part][column / 64] |= (uint64_t) 1 << (column % 64);
+    }
+
+    for (short part = 0; part < 2; ++part)
+    {
+      size_t rowRepresentative[2][2] = { { SIZE_MAX, SIZE_MAX }, { SIZE_MAX, SIZE_MAX } };
+      size_t columnRepresentative[2][2] = { { SIZE_MAX, SIZE_MAX }, { SIZE_MAX, SIZE_MAX } };
+      for (size_t row = 0; row < numRows && rowRepresentative[part][0] == SIZE_MAX; ++row)
+      {
+        for (size_t column = 0; column < numColumns; ++column)
+        {
+          if (rowData[row].part == part && columnData[column].part == 1-part && dense[row][column])
+          {
+            rowRepresentative[part][0] = row;
+            columnRepresentative[1-part][0] = column;
+            break;
+          }
+        }
+      }
+
+      if (rowRepresentative[part][0] < SIZE_MAX)
+      {
+        size_t unpackedRowRepresentative[2][2];
+        size_t unpackedColumnRepresentative[2][2];
+        memcpy(unpackedRowRepresentative, rowRepresentative, sizeof(rowRepresentative));
+        memcpy(unpackedColumnRepresentative, columnRepresentative, sizeof(columnRepresentative));
+
+        bool isRank2 = CMRregularityPackedFindRank2(&packed, numRows, &rowData[0], &masks[1-part][0],
+          rowRepresentative, columnRepresentative, part);
+        ASSERT_EQ( isRank2, unpackedFindRank2(matrix, &rowData[0], &columnData[0], unpackedRowRepresentative,
+          unpackedColumnRepresentative, part) );
+        ASSERT_EQ( rowRepresentative[part][1], unpackedRowRepresentative[part][1] );
+        ASSERT_EQ( columnRepresentative[1-part][1], unpackedColumnRepresentative[1-part][1] );
+        if (isRank2)
+          ++numRank2;
+      }
+
+      for (size_t row = 0; row < numRows; ++row)
+      {
+        ASSERT_EQ( CMRregularityPackedType(&packed, &masks[1-part][0], rowRepresentative[part], row),
+          unpackedType(dense, &columnData[0], 1-part, rowRepresentative[part], row) );
+      }
+    }
+
+    ASSERT_CMR_CALL( CMRfreeStackArray(cmr, &packed.words) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+  ASSERT_GT( numRank2, 0UL );
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -16,11 +16,11 @@ TEST(SeriesParallel, Empty)
     ) );
 
     ASSERT_CMR_CALL( CMRspTestBinary(cmr, mat0x0, NULL, reductions, &numReductions, NULL, NULL,
-      NULL, DBL_MAX) );
+      NULL, NULL, DBL_MAX) );
     ASSERT_EQ( numReductions, 0UL );
 
     ASSERT_CMR_CALL( CMRspTestTernary(cmr, mat0x0, NULL, reductions, &numReductions, NULL, NULL,
-      NULL, DBL_MAX) );
+      NULL, NULL, DBL_MAX) );
     ASSERT_EQ( numReductions, 0UL );
 
     ASSERT_CMR_CALL( CMRchrmatFree(cmr, &mat0x0) );
@@ -32,13 +32,13 @@ TEST(SeriesParallel, Empty)
     ) );
 
     ASSERT_CMR_CALL( CMRspTestBinary(cmr, mat2x0, NULL, reductions, &numReductions, NULL, NULL,
-      NULL, DBL_MAX) );
+      NULL, NULL, DBL_MAX) );
     ASSERT_EQ( numReductions, 2UL );
     ASSERT_EQ( reductions[0].element, -1 ); ASSERT_EQ( reductions[0].mate, 0 );
     ASSERT_EQ( reductions[1].element, -2 ); ASSERT_EQ( reductions[1].mate, 0 );
 
     ASSERT_CMR_CALL( CMRspTestTernary(cmr, mat2x0, NULL, reductions, &numReductions, NULL, NULL,
-      NULL, DBL_MAX) );
+      NULL, NULL, DBL_MAX) );
     ASSERT_EQ( numReductions, 2UL );
     ASSERT_EQ( reductions[0].element, -1 ); ASSERT_EQ( reductions[0].mate, 0 );
     ASSERT_EQ( reductions[1].element, -2 ); ASSERT_EQ( reductions[1].mate, 0 );
@@ -52,13 +52,13 @@ TEST(SeriesParallel, Empty)
     ) );
 
     ASSERT_CMR_CALL( CMRspTestBinary(cmr, mat0x2, NULL, reductions, &numReductions, NULL, NULL,
-      NULL, DBL_MAX) );
+      NULL, NULL, DBL_MAX) );
     ASSERT_EQ( numReductions, 2UL );
     ASSERT_EQ( reductions[0].element, 1 ); ASSERT_EQ( reductions[0].mate, 0 );
     ASSERT_EQ( reductions[1].element, 2 ); ASSERT_EQ( reductions[1].mate, 0 );
 
     ASSERT_CMR_CALL( CMRspTestTernary(cmr, mat0x2, NULL, reductions, &numReductions, NULL, NULL,
-      NULL, DBL_MAX) );
+      NULL, NULL, DBL_MAX) );
     ASSERT_EQ( numReductions, 2UL );
     ASSERT_EQ( reductions[0].element, 1 ); ASSERT_EQ( reductions[0].mate, 0 );
     ASSERT_EQ( reductions[1].element, 2 ); ASSERT_EQ( reductions[1].mate, 0 );
@@ -103,7 +103,7 @@ TEST(SeriesParallel, BinaryReduction)
   CMR_SUBMAT* submatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspTestBinary(cmr, matrix, NULL, reductions, &numReductions, &submatrix, NULL, NULL,
-    DBL_MAX) );
+    NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 20UL);
   ASSERT_EQ( reductions[0].element, -6);  ASSERT_EQ( reductions[0].mate, -2);
   ASSERT_EQ( reductions[1].element, -7);  ASSERT_EQ( reductions[1].mate, 5);
@@ -168,7 +168,7 @@ TEST(SeriesParallel, BinaryShortWheel)
   CMR_SUBMAT* wheelSubmatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspTestBinary(cmr, matrix, NULL, operations, &numOperations, NULL,
-    &wheelSubmatrix, NULL, DBL_MAX) );
+    &wheelSubmatrix, NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numOperations, 8UL );
 
   CMR_CHRMAT* wheelMatrix = NULL;
@@ -216,7 +216,7 @@ TEST(SeriesParallel, BinaryLongWheel)
   CMR_SUBMAT* wheelSubmatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspTestBinary(cmr, matrix, NULL, reductions, &numReductions, NULL, &wheelSubmatrix,
-    NULL, DBL_MAX) );
+    NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 8UL );
   for (size_t o = 0; o < numReductions; ++o)
   {
@@ -268,7 +268,7 @@ TEST(SeriesParallel, BinarySpecialWheel)
   CMR_SUBMAT* wheelSubmatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspTestBinary(cmr, matrix, NULL, reductions, &numReductions, NULL,
-    &wheelSubmatrix, NULL, DBL_MAX) );
+    &wheelSubmatrix, NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 8UL );
   for (size_t o = 0; o < numReductions; ++o)
   {
@@ -316,7 +316,7 @@ TEST(SeriesParallel, BinarySeparationFirstSearch)
   CMR_CHRMAT* reducedMatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspDecomposeBinary(cmr, matrix, NULL, reductions, SIZE_MAX, &numReductions,
-    &reducedSubmatrix, &wheelSubmatrix, &sepa, NULL, DBL_MAX) );
+    &reducedSubmatrix, &wheelSubmatrix, &sepa, NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 8UL );
 
 
@@ -372,7 +372,7 @@ TEST(SeriesParallel, BinarySeparationSecondSearch)
   CMR_SEPA* sepa = NULL;
 
   ASSERT_CMR_CALL( CMRspDecomposeBinary(cmr, matrix, NULL, reductions, SIZE_MAX, &numReductions, NULL,
-    &wheelSubmatrix, &sepa, NULL, DBL_MAX) );
+    &wheelSubmatrix, &sepa, NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 8UL );
 
   // TODO: CHECK flags.
@@ -418,7 +418,7 @@ TEST(SeriesParallel, BinaryWheelAfterSeparation)
   CMR_SUBMAT* wheelSubmatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspTestBinary(cmr, matrix, NULL, reductions, &numReductions, NULL,
-    &wheelSubmatrix, NULL, DBL_MAX) );
+    &wheelSubmatrix, NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 8UL );
   for (size_t o = 0; o < numReductions; ++o)
   {
@@ -460,7 +460,7 @@ TEST(SeriesParallel, TernarySeriesParallel)
   size_t numReductions;
 
   ASSERT_CMR_CALL( CMRspTestTernary(cmr, matrix, NULL, reductions, &numReductions, NULL, NULL, NULL,
-    DBL_MAX) );
+    NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 20U );
   for (size_t o = 0; o < numReductions; ++o)
   {
@@ -496,7 +496,7 @@ TEST(SeriesParallel, TernaryNonbinary)
   CMR_SUBMAT* violatorSubmatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspTestTernary(cmr, matrix, NULL, reductions, &numReductions, NULL,
-    &violatorSubmatrix, NULL, DBL_MAX) );
+    &violatorSubmatrix, NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 10UL );
   for (size_t o = 0; o < numReductions; ++o)
   {
@@ -542,7 +542,7 @@ TEST(SeriesParallel, TernaryWheel)
   CMR_SUBMAT* violatorSubmatrix = NULL;
 
   ASSERT_CMR_CALL( CMRspTestTernary(cmr, matrix, NULL, reductions, &numReductions, NULL,
-    &violatorSubmatrix, NULL, DBL_MAX) );
+    &violatorSubmatrix, NULL, NULL, DBL_MAX) );
   ASSERT_EQ( numReductions, 14UL );
   for (size_t o = 0; o < numReductions; ++o)
   {
@@ -596,7 +596,7 @@ TEST(SeriesParallel, TernarySeparation)
   CMR_SEPA* sepa = NULL;
 
   ASSERT_CMR_CALL( CMRspDecomposeTernary(cmr, matrix, NULL, reductions, SIZE_MAX, &numReductions, NULL,
-    &violatorSubmatrix, &sepa, NULL, DBL_MAX) );
+    &violatorSubmatrix, &sepa, NULL, NULL, DBL_MAX) );
 
   ASSERT_FALSE( violatorSubmatrix );
 
@@ -645,7 +645,7 @@ TEST(SeriesParallel, TernaryBadSeparation)
   CMR_SEPA* sepa = NULL;
 
   ASSERT_CMR_CALL( CMRspDecomposeTernary(cmr, matrix, NULL, reductions, SIZE_MAX, &numReductions,
-    &reducedSubmatrix, &violatorSubmatrix, &sepa, NULL, DBL_MAX) );
+    &reducedSubmatrix, &violatorSubmatrix, &sepa, NULL, NULL, DBL_MAX) );
 
   ASSERT_TRUE( violatorSubmatrix );
   ASSERT_FALSE( sepa );
@@ -666,3 +666,456 @@ TEST(SeriesParallel, TernaryBadSeparation)
   ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
+
+static
+void testDecompositionsAgree(
+  CMR* cmr,                 /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,       /**< Matrix to test. */
+  bool ternary,             /**< Whether to use the ternary version. */
+  CMR_SP_ENGINE engines[2], /**< Engines of both runs. */
+  int numThreads[2],        /**< Numbers of threads of both runs. */
+  CMR_SP_WHEEL_SEARCH wheelSearches[2]  /**< Wheel searches of both runs. */
+)
+{
+  size_t numElements = matrix->numRows + matrix->numColumns;
+  CMR_SP_REDUCTION* reductions[2];
+  size_t numReductions[2];
+  CMR_SUBMAT* reducedSubmatrix[2];
+  CMR_SUBMAT* violatorSubmatrix[2];
+  CMR_SEPA* sepa[2];
+  bool isSeriesParallel[2];
+
+  for (int e = 0; e < 2; ++e)
+  {
+    CMR_SP_PARAMS params;
+    ASSERT_CMR_CALL( CMRspParamsInit(&params) );
+    params.engine = engines[e];
+    params.wheelSearch = wheelSearches[e];
+    ASSERT_CMR_CALL( CMRsetNumThreads(cmr, numThreads[e]) );
+    CMR_SP_STATISTICS stats;
+    ASSERT_CMR_CALL( CMRspStatsInit(&stats) );
+
+    reductions[e] = new CMR_SP_REDUCTION[numElements + 1];
+    reducedSubmatrix[e] = NULL;
+    violatorSubmatrix[e] = NULL;
+    sepa[e] = NULL;
+    if (ternary)
+    {
+      ASSERT_CMR_CALL( CMRspDecomposeTernary(cmr, matrix, &isSeriesParallel[e], reductions[e], SIZE_MAX,
+        &numReductions[e], &reducedSubmatrix[e], &violatorSubmatrix[e], &sepa[e], &params, &stats, DBL_MAX) );
+    }
+    else
+    {
+      ASSERT_CMR_CALL( CMRspDecomposeBinary(cmr, matrix, &isSeriesParallel[e], reductions[e], SIZE_MAX,
+        &numReductions[e], &reducedSubmatrix[e], &violatorSubmatrix[e], &sepa[e], &params, &stats, DBL_MAX) );
+    }
+    if (engines[e] == CMR_SP_ENGINE_LIST)
+    {
+      ASSERT_EQ( stats.compactionCount, 0UL );
+    }
+    if (wheelSearches[e] == CMR_SP_WHEEL_SEARCH_LIST)
+    {
+      ASSERT_EQ( stats.bitsetWheelCount, 0UL );
+    }
+    else if (wheelSearches[e] == CMR_SP_WHEEL_SEARCH_BITSET)
+    {
+      ASSERT_EQ( stats.wheelCount, 0UL );
+    }
+  }
+
+  ASSERT_EQ( isSeriesParallel[0], isSeriesParallel[1] );
+  ASSERT_EQ( numReductions[0], numReductions[1] );
+  for (size_t r = 0; r < numReductions[0]; ++r)
+  {
+    ASSERT_EQ( reductions[0][r].element, reductions[1][r].element );
+    ASSERT_EQ( reductions[0][r].mate, reductions[1][r].mate );
+  }
+
+  ASSERT_EQ( reducedSubmatrix[0] == NULL, reducedSubmatrix[1] == NULL );
+  if (reducedSubmatrix[0])
+  {
+    ASSERT_EQ( reducedSubmatrix[0]->numRows, reducedSubmatrix[1]->numRows );
+    ASSERT_EQ( reducedSubmatrix[0]->numColumns, reducedSubmatrix[1]->numColumns );
+    for (size_t row = 0; row < reducedSubmatrix[0]->numRows; ++row)
+      ASSERT_EQ( reducedSubmatrix[0]->rows[row], reducedSubmatrix[1]->rows[row] );
+    for (size_t column = 0; column < reducedSubmatrix[0]->numColumns; ++column)
+      ASSERT_EQ( reducedSubmatrix[0]->columns[column], reducedSubmatrix[1]->columns[column] );
+  }
+
+  ASSERT_EQ( violatorSubmatrix[0] == NULL, violatorSubmatrix[1] == NULL );
+  if (violatorSubmatrix[0])
+  {
+    ASSERT_EQ( violatorSubmatrix[0]->numRows, violatorSubmatrix[1]->numRows );
+    ASSERT_EQ( violatorSubmatrix[0]->numColumns, violatorSubmatrix[1]->numColumns );
+    for (size_t row = 0; row < violatorSubmatrix[0]->numRows; ++row)
+      ASSERT_EQ( violatorSubmatrix[0]->rows[row], violatorSubmatrix[1]->rows[row] );
+    for (size_t column = 0; column < violatorSubmatrix[0]->numColumns; ++column)
+      ASSERT_EQ( violatorSubmatrix[0]->columns[column], violatorSubmatrix[1]->columns[column] );
+  }
+
+  ASSERT_EQ( sepa[0] == NULL, sepa[1] == NULL );
+  if (sepa[0])
+  {
+    ASSERT_EQ( sepa[0]->type, sepa[1]->type );
+    for (size_t row = 0; row < sepa[0]->numRows; ++row)
+      ASSERT_EQ( sepa[0]->rowsFlags[row], sepa[1]->rowsFlags[row] );
+    for (size_t column = 0; column < sepa[0]->numColumns; ++column)
+      ASSERT_EQ( sepa[0]->columnsFlags[column], sepa[1]->columnsFlags[column] );
+  }
+
+  for (int e = 1; e >= 0; --e)
+  {
+    ASSERT_CMR_CALL( CMRsepaFree(cmr, &sepa[e]) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &violatorSubmatrix[e]) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &reducedSubmatrix[e]) );
+    delete[] reductions[e];
+  }
+}
+
+/**
+ * \brief Returns a sparse random matrix with duplicated rows and columns so that many reductions apply.
+ */
+
+static
+std::vector<std::vector<char>> randomDense(
+  size_t numRows,     /**< Number of rows. */
+  size_t numColumns,  /**< Number of columns. */
+  double probability, /**< Probability of a nonzero. */
+  bool ternary        /**< Whether to create \f$ -1 \f$ entries. */
+)
+{
+  std::vector<std::vector<char>> dense(numRows, std::vector<char>(numColumns, 0));
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    if (row > 0 && rand() % 4 == 0)
+    {
+      dense[row] = dense[rand() % row];
+      continue;
+    }
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+      if ((rand() * 1.0 / RAND_MAX) < probability)
+        dense[row][column] = (ternary && rand() % 2) ? -1 : 1;
+    }
+  }
+  for (size_t column = 1; column < numColumns; ++column)
+  {
+    if (rand() % 4 == 0)
+    {
+      size_t source = rand() % column;
+      for (size_t row = 0; row < numRows; ++row)
+        dense[row][column] = dense[row][source];
+    }
+  }
+
+  return dense;
+}
+
+/**
+ * \brief Creates the sparse matrix with given dense entries.
+ */
+
+static
+void denseToMatrix(
+  CMR* cmr,                                     /**< \ref CMR environment. */
+  const std::vector<std::vector<char>>& dense,  /**< Dense entries. */
+  size_t numColumns,                            /**< Number of columns. */
+  CMR_CHRMAT** pmatrix                          /**< Pointer for storing the matrix. */
+)
+{
+  size_t numRows = dense.size();
+  ASSERT_CMR_CALL( CMRchrmatCreate(cmr, pmatrix, numRows, numColumns, numRows * numColumns) );
+  CMR_CHRMAT* matrix = *pmatrix;
+  matrix->numNonzeros = 0;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    matrix->rowSlice[row] = matrix->numNonzeros;
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+      if (dense[row][column])
+      {
+        matrix->entryColumns[matrix->numNonzeros] = column;
+        matrix->entryValues[matrix->numNonzeros] = dense[row][column];
+        matrix->numNonzeros++;
+      }
+    }
+  }
+  matrix->rowSlice[numRows] = matrix->numNonzeros;
+}
+
+TEST(SeriesParallel, EnginesAgree)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(0);
+  for (int i = 0; i < 400; ++i)
+  {
+    /* Sparse random matrices with duplicated rows/columns so that many reductions apply. */
+    size_t numRows = 4 + rand() % 30;
+    size_t numColumns = 4 + rand() % 30;
+    double probability = (1.5 + (rand() % 4)) / (numRows < numColumns ? numRows : numColumns);
+    bool ternary = i % 2;
+
+    std::vector<std::vector<char>> dense = randomDense(numRows, numColumns, probability, ternary);
+    CMR_CHRMAT* matrix = NULL;
+    denseToMatrix(cmr, dense, numColumns, &matrix);
+
+    CMR_SP_ENGINE engines[2] = { CMR_SP_ENGINE_LIST, CMR_SP_ENGINE_COMPACT };
+    int numThreads[2] = { 1, 1 };
+    CMR_SP_WHEEL_SEARCH wheelSearches[2] = { CMR_SP_WHEEL_SEARCH_AUTO, CMR_SP_WHEEL_SEARCH_AUTO };
+    testDecompositionsAgree(cmr, matrix, ternary, engines, numThreads, wheelSearches);
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(SeriesParallel, WheelSearchesAgree)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(1);
+  for (int i = 0; i < 400; ++i)
+  {
+    /* Random matrices that are mostly not series-parallel, with more than 64 columns for some. */
+    size_t numRows = 4 + rand() % 40;
+    size_t numColumns = 4 + rand() % 100;
+    double probability = (1.5 + (rand() % 8)) / (numRows < numColumns ? numRows : numColumns);
+    bool ternary = i % 2;
+
+    std::vector<std::vector<char>> dense = randomDense(numRows, numColumns, probability, ternary);
+    CMR_CHRMAT* matrix = NULL;
+    denseToMatrix(cmr, dense, numColumns, &matrix);
+
+    CMR_SP_ENGINE engines[2] = { CMR_SP_ENGINE_LIST, (i / 2) % 2 ? CMR_SP_ENGINE_LIST : CMR_SP_ENGINE_COMPACT };
+    int numThreads[2] = { 1, 1 };
+    CMR_SP_WHEEL_SEARCH wheelSearches[2] = { CMR_SP_WHEEL_SEARCH_LIST, CMR_SP_WHEEL_SEARCH_BITSET };
+    testDecompositionsAgree(cmr, matrix, ternary, engines, numThreads, wheelSearches);
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+/**
+ * \brief Creates a matrix whose rows are those of \p matrix, each one repeated if \p duplicate says so.
+ */
+
+static
+void duplicateRows(
+  CMR* cmr,               /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,     /**< Matrix. */
+  std::vector<bool>& duplicate, /**< Whether each row shall be duplicated. */
+  CMR_CHRMAT** presult    /**< Pointer for storing the result. */
+)
+{
+  size_t numRows = 0;
+  size_t numNonzeros = 0;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    size_t count = duplicate[row] ? 2 : 1;
+    numRows += count;
+    numNonzeros += count * (matrix->rowSlice[row + 1] - matrix->rowSlice[row]);
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatCreate(cmr, presult, numRows, matrix->numColumns, numNonzeros) );
+  CMR_CHRMAT* result = *presult;
+  result->numNonzeros = 0;
+  size_t resultRow = 0;
+  for (size_t row = 0; row < matrix->numRows; ++row)
+  {
+    for (size_t copy = duplicate[row] ? 2 : 1; copy > 0; --copy)
+    {
+      result->rowSlice[resultRow++] = result->numNonzeros;
+      for (size_t e = matrix->rowSlice[row]; e < matrix->rowSlice[row + 1]; ++e)
+      {
+        result->entryColumns[result->numNonzeros] = matrix->entryColumns[e];
+        result->entryValues[result->numNonzeros] = matrix->entryValues[e];
+        result->numNonzeros++;
+      }
+    }
+  }
+  result->rowSlice[numRows] = result->numNonzeros;
+}
+
+TEST(SeriesParallel, ParallelScanAgrees)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(1);
+  for (int i = 0; i < 4; ++i)
+  {
+    /* Large sparse random matrices with duplicated rows and columns such that the initial scan runs in parallel. */
+    size_t numRows = 20000;
+    size_t numColumns = 20000;
+    bool ternary = i % 2;
+
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatCreate(cmr, &matrix, numRows, numColumns, 4 * numRows) );
+    matrix->numNonzeros = 0;
+    for (size_t row = 0; row < numRows; ++row)
+    {
+      matrix->rowSlice[row] = matrix->numNonzeros;
+      size_t column = rand() % 8;
+      while (column < numColumns && matrix->numNonzeros < 4 * (row + 1))
+      {
+        matrix->entryColumns[matrix->numNonzeros] = column;
+        matrix->entryValues[matrix->numNonzeros] = (ternary && rand() % 2) ? -1 : 1;
+        matrix->numNonzeros++;
+        column += 1 + rand() % (numColumns / 4);
+      }
+    }
+    matrix->rowSlice[numRows] = matrix->numNonzeros;
+
+    for (int transpose = 0; transpose < 2; ++transpose)
+    {
+      std::vector<bool> duplicate(matrix->numRows);
+      for (size_t row = 0; row < matrix->numRows; ++row)
+        duplicate[row] = (rand() % 4 == 0);
+      CMR_CHRMAT* duplicated = NULL;
+      duplicateRows(cmr, matrix, duplicate, &duplicated);
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+      ASSERT_CMR_CALL( CMRchrmatTranspose(cmr, duplicated, &matrix) );
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &duplicated) );
+    }
+
+    CMR_SP_ENGINE engines[2] = { CMR_SP_ENGINE_COMPACT, i < 2 ? CMR_SP_ENGINE_COMPACT : CMR_SP_ENGINE_LIST };
+    int numThreads[2] = { 1, 4 };
+    CMR_SP_WHEEL_SEARCH wheelSearches[2] = { CMR_SP_WHEEL_SEARCH_AUTO, CMR_SP_WHEEL_SEARCH_AUTO };
+    testDecompositionsAgree(cmr, matrix, ternary, engines, numThreads, wheelSearches);
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+/**
+ * \brief Runs \ref CMRspReplayBinary or \ref CMRspReplayTernary with the given \p script.
+ */
+
+static
+void replay(
+  CMR* cmr,                                 /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,                       /**< Matrix. */
+  bool ternary,                             /**< Whether to use the ternary version. */
+  CMR_SP_ENGINE engine,                     /**< Engine. */
+  std::vector<CMR_SP_REDUCTION>& script,    /**< Reductions to replay. */
+  size_t* pnumReplayed,                     /**< Pointer for storing the number of replayed reductions. */
+  bool* pisSeriesParallel,                  /**< Pointer for storing whether \p matrix is series-parallel. */
+  std::vector<CMR_SP_REDUCTION>& reductions,/**< Vector for storing the reductions. */
+  CMR_SUBMAT** preducedSubmatrix            /**< Pointer for storing the SP-reduced submatrix. */
+)
+{
+  CMR_SP_PARAMS params;
+  ASSERT_CMR_CALL( CMRspParamsInit(&params) );
+  params.engine = engine;
+
+  size_t numReductions;
+  reductions.resize(matrix->numRows + matrix->numColumns + 1);
+  if (ternary)
+  {
+    ASSERT_CMR_CALL( CMRspReplayTernary(cmr, matrix, script.data(), script.size(), pnumReplayed, pisSeriesParallel,
+      reductions.data(), SIZE_MAX, &numReductions, preducedSubmatrix, NULL, NULL, &params, NULL, DBL_MAX) );
+  }
+  else
+  {
+    ASSERT_CMR_CALL( CMRspReplayBinary(cmr, matrix, script.data(), script.size(), pnumReplayed, pisSeriesParallel,
+      reductions.data(), SIZE_MAX, &numReductions, preducedSubmatrix, NULL, NULL, &params, NULL, DBL_MAX) );
+  }
+  reductions.resize(numReductions);
+}
+
+TEST(SeriesParallel, Replay)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  srand(2);
+  for (int i = 0; i < 200; ++i)
+  {
+    size_t numRows = 4 + rand() % 30;
+    size_t numColumns = 4 + rand() % 30;
+    double probability = (1.5 + (rand() % 4)) / (numRows < numColumns ? numRows : numColumns);
+    bool ternary = i % 2;
+    CMR_SP_ENGINE engine = (i / 2) % 2 ? CMR_SP_ENGINE_LIST : CMR_SP_ENGINE_COMPACT;
+
+    /* The base matrix and a scenario with some modified and some additional rows. */
+    std::vector<std::vector<char>> baseDense = randomDense(numRows, numColumns, probability, ternary);
+    std::vector<std::vector<char>> scenarioDense = baseDense;
+    char& modified = scenarioDense[rand() % numRows][rand() % numColumns];
+    modified = modified ? 0 : 1;
+    for (size_t extra = rand() % 3; extra > 0; --extra)
+      scenarioDense.push_back(randomDense(1, numColumns, probability, ternary)[0]);
+    CMR_CHRMAT* base = NULL;
+    denseToMatrix(cmr, baseDense, numColumns, &base);
+    CMR_CHRMAT* scenario = NULL;
+    denseToMatrix(cmr, scenarioDense, numColumns, &scenario);
+
+    /* Create the script via a file. */
+    std::vector<CMR_SP_REDUCTION> empty;
+    std::vector<CMR_SP_REDUCTION> baseReductions;
+    size_t numReplayed;
+    bool isSeriesParallel;
+    replay(cmr, base, ternary, engine, empty, &numReplayed, &isSeriesParallel, baseReductions, NULL);
+    ASSERT_EQ( numReplayed, 0UL );
+
+    FILE* stream = tmpfile();
+    ASSERT_CMR_CALL( CMRspWriteReductions(cmr, baseReductions.data(), baseReductions.size(), stream) );
+    rewind(stream);
+    CMR_SP_REDUCTION* readReductions = NULL;
+    size_t numReadReductions;
+    ASSERT_CMR_CALL( CMRspReadReductions(cmr, stream, &readReductions, &numReadReductions) );
+    fclose(stream);
+    ASSERT_EQ( numReadReductions, baseReductions.size() );
+    std::vector<CMR_SP_REDUCTION> script(readReductions, readReductions + numReadReductions);
+    ASSERT_CMR_CALL( CMRfreeBlockArray(cmr, &readReductions) );
+    for (size_t r = 0; r < script.size(); ++r)
+    {
+      ASSERT_EQ( script[r].element, baseReductions[r].element );
+      ASSERT_EQ( script[r].mate, baseReductions[r].mate );
+    }
+
+    /* Replaying the script for the same matrix reproduces it entirely. */
+    std::vector<CMR_SP_REDUCTION> reductions;
+    replay(cmr, base, ternary, engine, script, &numReplayed, &isSeriesParallel, reductions, NULL);
+    ASSERT_EQ( numReplayed, script.size() );
+    ASSERT_EQ( reductions.size(), script.size() );
+
+    /* Replaying it for the scenario yields as many reductions as a fresh decomposition. */
+    std::vector<CMR_SP_REDUCTION> freshReductions;
+    bool freshIsSeriesParallel;
+    CMR_SUBMAT* freshReducedSubmatrix = NULL;
+    replay(cmr, scenario, ternary, engine, empty, &numReplayed, &freshIsSeriesParallel, freshReductions,
+      &freshReducedSubmatrix);
+    CMR_SUBMAT* reducedSubmatrix = NULL;
+    replay(cmr, scenario, ternary, engine, script, &numReplayed, &isSeriesParallel, reductions, &reducedSubmatrix);
+    ASSERT_LE( numReplayed, script.size() );
+    ASSERT_EQ( isSeriesParallel, freshIsSeriesParallel );
+    ASSERT_EQ( reductions.size(), freshReductions.size() );
+    ASSERT_EQ( reducedSubmatrix->numRows, freshReducedSubmatrix->numRows );
+    ASSERT_EQ( reducedSubmatrix->numColumns, freshReducedSubmatrix->numColumns );
+    for (size_t r = 0; r < numReplayed; ++r)
+    {
+      ASSERT_EQ( reductions[r].element, script[r].element );
+      ASSERT_EQ( reductions[r].mate, script[r].mate );
+    }
+
+    /* All of these reductions are valid for the scenario. */
+    std::vector<CMR_SP_REDUCTION> replayedReductions;
+    replay(cmr, scenario, ternary, engine, reductions, &numReplayed, &isSeriesParallel, replayedReductions, NULL);
+    ASSERT_EQ( numReplayed, reductions.size() );
+
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &reducedSubmatrix) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &freshReducedSubmatrix) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &scenario) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &base) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
@@ -15,6 +15,10 @@
 #include <cmr/graphic.h>
 #include <cmr/linear_algebra.h>
 
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
 TEST(TU, EulerianAlgorithm)
 {
   CMR* cmr = NULL;
@@ -1330,6 +1334,451 @@ TEST(TU, ThreesumForbiddenSubmatrix)
   ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
 }
 
+TEST(TU, ForbiddenSubmatrixThreads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  {
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "14 14 "
+      "1 1 1 0 1 0 1 0  1 1 1 1 1 1 "
+      "1 0 1 0 1 0 1 0  1 1 1 1 1 0 "
+      "0 1 1 0 0 0 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 0 0 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 0 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 1 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 1 1  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 1 1  1 0 0 0 0 0 "
+      "0 0 0 0 0 0 0 0  1 1 0 0 0 0 "
+      "0 0 0 0 0 0 0 0  0 1 1 0 0 0 "
+      "0 0 0 0 0 0 0 0  0 0 1 1 0 0 "
+      "0 0 0 0 0 0 0 0  0 0 0 1 1 0 "
+      "0 0 0 0 0 0 0 0  0 0 0 0 1 1 "
+    ) );
+
+    CMR_SUBMAT* submatrices[2] = { NULL, NULL };
+    for (int i = 0; i < 2; ++i)
+    {
+      ASSERT_CMR_CALL( CMRsetNumThreads(cmr, i ? 4 : 1) );
+
+      bool isTU;
+      CMR_TU_STATS stats;
+      ASSERT_CMR_CALL( CMRtuStatsInit(&stats) );
+      ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, NULL, &submatrices[i], NULL, &stats, DBL_MAX) );
+      ASSERT_FALSE( isTU );
+      ASSERT_GT( stats.seymour.totalCount, 1UL );
+
+      CMR_CHRMAT* violatorMatrix = NULL;
+      ASSERT_CMR_CALL( CMRchrmatSlice(cmr, matrix, submatrices[i], &violatorMatrix) );
+      int64_t determinant;
+      ASSERT_CMR_CALL( CMRchrmatDeterminant(cmr, violatorMatrix, &determinant) );
+      ASSERT_TRUE( (determinant > 1) || (determinant < -1) );
+      ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violatorMatrix) );
+    }
+
+    /* The violator does not depend on the number of threads. */
+    ASSERT_EQ( submatrices[0]->numRows, submatrices[1]->numRows );
+    ASSERT_EQ( submatrices[0]->numColumns, submatrices[1]->numColumns );
+    for (size_t r = 0; r < submatrices[0]->numRows; ++r)
+      ASSERT_EQ( submatrices[0]->rows[r], submatrices[1]->rows[r] );
+    for (size_t c = 0; c < submatrices[0]->numColumns; ++c)
+      ASSERT_EQ( submatrices[0]->columns[c], submatrices[1]->columns[c] );
+
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &submatrices[1]) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &submatrices[0]) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TU, TraceThreads)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+  ASSERT_CMR_CALL( CMRsetNumThreads(cmr, 4) );
+
+  {
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "14 14 "
+      "1 1 1 0 1 0 1 0  1 1 1 1 1 1 "
+      "1 0 1 0 1 0 1 0  1 1 1 1 1 0 "
+      "0 1 1 0 0 0 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 0 0 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 0 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 0 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 1 0  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 1 1  0 0 0 0 0 0 "
+      "0 1 1 1 1 1 1 1  1 0 0 0 0 0 "
+      "0 0 0 0 0 0 0 0  1 1 0 0 0 0 "
+      "0 0 0 0 0 0 0 0  0 1 1 0 0 0 "
+      "0 0 0 0 0 0 0 0  0 0 1 1 0 0 "
+      "0 0 0 0 0 0 0 0  0 0 0 1 1 0 "
+      "0 0 0 0 0 0 0 0  0 0 0 0 1 1 "
+    ) );
+
+    FILE* stream = tmpfile();
+    ASSERT_TRUE( stream );
+    CMR_TU_PARAMS params;
+    ASSERT_CMR_CALL( CMRtuParamsInit(&params) );
+    ASSERT_CMR_CALL( CMRseymourTraceCreate(cmr, stream, &params.seymour.trace) );
+
+    bool isTU;
+    CMR_SUBMAT* submatrix = NULL;
+    ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, NULL, &submatrix, &params, NULL, DBL_MAX) );
+    ASSERT_FALSE( isTU );
+    ASSERT_CMR_CALL( CMRseymourTraceFree(cmr, &params.seymour.trace) );
+
+    std::string trace;
+    rewind(stream);
+    for (int c = fgetc(stream); c != EOF; c = fgetc(stream))
+      trace.push_back((char) c);
+    fclose(stream);
+
+    /* Events written by concurrent workers are not interleaved: each line is a complete event. */
+    ASSERT_EQ( trace.substr(0, 2), "[\n" );
+    ASSERT_EQ( trace.substr(trace.size() - 3), "\n]\n" );
+    size_t numEvents = 0;
+    for (size_t begin = 2, end; (end = trace.find('\n', begin)) < trace.size() - 3; begin = end + 1)
+    {
+      std::string line = trace.substr(begin, end - begin);
+      ASSERT_EQ( line.find("{\"name\": "), 0UL );
+      ASSERT_EQ( line.find("{", 1), line.find("\"args\": {") + 8 );
+      ASSERT_EQ( line.substr(line.size() - (line.back() == ',' ? 3 : 2)), line.back() == ',' ? "}}," : "}}" );
+      ++numEvents;
+    }
+    ASSERT_GT( numEvents, 1UL );
+    ASSERT_EQ( trace.find("\"tid\": 0,"), std::string::npos );
+
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &submatrix) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TU, ExtractViolatorFromTree)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  {
+    /* 1-sum of a network matrix and a matrix with a 2x2 submatrix of determinant -2. */
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "5 5 "
+      "1 1 0 0 0 "
+      "0 1 1 0 0 "
+      "0 0 0 1 1 "
+      "0 0 0 1 -1 "
+      "0 0 0 0 1 "
+    ) );
+
+    bool isTU;
+    CMR_SEYMOUR_NODE* dec = NULL;
+    ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, &dec, NULL, NULL, NULL, DBL_MAX) );
+    ASSERT_FALSE( isTU );
+
+    CMR_SUBMAT* violator = NULL;
+    ASSERT_CMR_CALL( CMRseymourExtractViolator(cmr, dec, &violator) );
+    ASSERT_TRUE( violator != NULL );
+
+    CMR_CHRMAT* violatorMatrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatSlice(cmr, matrix, violator, &violatorMatrix) );
+    int64_t determinant;
+    ASSERT_CMR_CALL( CMRchrmatDeterminant(cmr, violatorMatrix, &determinant) );
+    ASSERT_TRUE( (determinant > 1) || (determinant < -1) );
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violatorMatrix) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &violator) );
+    ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+/**
+ * \brief Asserts that \p violator is a square submatrix of \p matrix with a bad determinant all of whose proper
+ *        submatrices are totally unimodular.
+ */
+
+static
+void assertMinimalViolator(
+  CMR* cmr,             /**< \ref CMR environment. */
+  CMR_CHRMAT* matrix,   /**< Matrix. */
+  CMR_SUBMAT* violator  /**< Violating submatrix of \p matrix. */
+)
+{
+  ASSERT_TRUE( violator );
+  ASSERT_EQ( violator->numRows, violator->numColumns );
+
+  CMR_CHRMAT* violatorMatrix = NULL;
+  ASSERT_CMR_CALL( CMRchrmatSlice(cmr, matrix, violator, &violatorMatrix) );
+  int64_t determinant;
+  ASSERT_CMR_CALL( CMRchrmatDeterminant(cmr, violatorMatrix, &determinant) );
+  ASSERT_TRUE( (determinant > 1) || (determinant < -1) );
+
+  /* Removing any row or column yields a totally unimodular matrix. */
+  size_t size = violator->numRows;
+  for (size_t removed = 0; removed < 2 * size; ++removed)
+  {
+    CMR_SUBMAT* submatrix = NULL;
+    bool removeRow = removed < size;
+    ASSERT_CMR_CALL( CMRsubmatCreate(cmr, removeRow ? size - 1 : size, removeRow ? size : size - 1, &submatrix) );
+    for (size_t r = 0, i = 0; r < size; ++r)
+    {
+      if (!removeRow || r != removed)
+        submatrix->rows[i++] = r;
+    }
+    for (size_t c = 0, j = 0; c < size; ++c)
+    {
+      if (removeRow || c != removed - size)
+        submatrix->columns[j++] = c;
+    }
+    CMR_CHRMAT* subMatrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatSlice(cmr, violatorMatrix, submatrix, &subMatrix) );
+    bool isTU;
+    ASSERT_CMR_CALL( CMRtuTest(cmr, subMatrix, &isTU, NULL, NULL, NULL, NULL, DBL_MAX) );
+    ASSERT_TRUE( isTU );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &subMatrix) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &submatrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violatorMatrix) );
+}
+
+TEST(TU, ViolatorAlreadyMinimal)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* The matrix of an odd cycle is itself a minimal violator. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "3 3 "
+    "1 1 0 "
+    "0 1 1 "
+    "1 0 1 "
+  ) );
+
+  for (int naive = 0; naive < 2; ++naive)
+  {
+    CMR_TU_PARAMS params;
+    ASSERT_CMR_CALL( CMRtuParamsInit(&params) );
+    params.naiveSubmatrix = naive;
+
+    bool isTU;
+    CMR_SUBMAT* violator = NULL;
+    ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, NULL, &violator, &params, NULL, DBL_MAX) );
+    ASSERT_FALSE( isTU );
+    ASSERT_NO_FATAL_FAILURE( assertMinimalViolator(cmr, matrix, violator) );
+    std::vector<size_t> rows(violator->rows, violator->rows + violator->numRows);
+    std::vector<size_t> columns(violator->columns, violator->columns + violator->numColumns);
+    std::sort(rows.begin(), rows.end());
+    std::sort(columns.begin(), columns.end());
+    ASSERT_EQ( rows, std::vector<size_t>({ 0, 1, 2 }) );
+    ASSERT_EQ( columns, std::vector<size_t>({ 0, 1, 2 }) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &violator) );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TU, ViolatorShrinksFromLargeSubmatrix)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* The rows of an interval matrix with nonzeros in columns r and r+1, and one more row with nonzeros in columns 0 and
+   * 2, which closes the only cycle, i.e., the odd cycle in rows 0, 1 and 39 and columns 0, 1 and 2. */
+  const size_t numRows = 40;
+  const size_t numColumns = 40;
+  std::stringstream ss;
+  ss << numRows << " " << numColumns;
+  for (size_t row = 0; row < numRows; ++row)
+  {
+    for (size_t column = 0; column < numColumns; ++column)
+    {
+      bool isNonzero = (row + 1 < numRows) ? (column == row || column == row + 1) : (column == 0 || column == 2);
+      ss << (isNonzero ? " 1" : " 0");
+    }
+  }
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, ss.str().c_str()) );
+
+  for (int naive = 0; naive < 2; ++naive)
+  {
+    CMR_TU_PARAMS params;
+    ASSERT_CMR_CALL( CMRtuParamsInit(&params) );
+    params.naiveSubmatrix = naive;
+
+    bool isTU;
+    CMR_SUBMAT* violator = NULL;
+    ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, NULL, &violator, &params, NULL, DBL_MAX) );
+    ASSERT_FALSE( isTU );
+    ASSERT_NO_FATAL_FAILURE( assertMinimalViolator(cmr, matrix, violator) );
+    std::vector<size_t> rows(violator->rows, violator->rows + violator->numRows);
+    std::vector<size_t> columns(violator->columns, violator->columns + violator->numColumns);
+    std::sort(rows.begin(), rows.end());
+    std::sort(columns.begin(), columns.end());
+    ASSERT_EQ( rows, std::vector<size_t>({ 0, 1, numRows - 1 }) );
+    ASSERT_EQ( columns, std::vector<size_t>({ 0, 1, 2 }) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &violator) );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TU, Screening)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  CMR_TU_PARAMS params;
+  ASSERT_CMR_CALL( CMRtuParamsInit(&params) );
+  params.screeningBudget = 10000;
+
+  const char* violatorStrings[] = {
+    "4 4 "
+    "1 1 0 0 "
+    "0 1 1 0 "
+    "1 -1 0 1 "
+    "0 0 1 1 ",
+    "4 4 "
+    "1 1 0 0 "
+    "1 0 1 0 "
+    "0 1 1 0 "
+    "0 0 1 1 ",
+    "4 4 "
+    "1 1 0 0 "
+    "0 1 1 0 "
+    "0 0 1 1 "
+    "-1 0 0 1 "
+  };
+  size_t violatorSizes[] = { 2, 3, 4 };
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, violatorStrings[i]) );
+
+    bool isTU;
+    CMR_SEYMOUR_NODE* dec = NULL;
+    CMR_SUBMAT* violator = NULL;
+    CMR_TU_STATS stats;
+    ASSERT_CMR_CALL( CMRtuStatsInit(&stats) );
+    ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, &dec, &violator, &params, &stats, DBL_MAX) );
+    ASSERT_FALSE( isTU );
+    ASSERT_EQ( stats.screeningSuccess, 1UL );
+    ASSERT_EQ( stats.seymour.totalCount, 0UL );
+    ASSERT_TRUE( dec == NULL );
+    ASSERT_EQ( violator->numRows, violatorSizes[i] );
+    ASSERT_EQ( violator->numColumns, violatorSizes[i] );
+
+    CMR_CHRMAT* violatorMatrix = NULL;
+    ASSERT_CMR_CALL( CMRchrmatSlice(cmr, matrix, violator, &violatorMatrix) );
+    int64_t determinant;
+    ASSERT_CMR_CALL( CMRchrmatDeterminant(cmr, violatorMatrix, &determinant) );
+    ASSERT_TRUE( (determinant == 2) || (determinant == -2) );
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &violatorMatrix) );
+    ASSERT_CMR_CALL( CMRsubmatFree(cmr, &violator) );
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  {
+    /* Totally unimodular matrix, for which screening must fall through. */
+    CMR_CHRMAT* matrix = NULL;
+    ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "4 4 "
+      "1 1 0 0 "
+      "0 1 1 0 "
+      "0 0 1 1 "
+      "1 0 0 1 "
+    ) );
+
+    bool isTU;
+    CMR_TU_STATS stats;
+    ASSERT_CMR_CALL( CMRtuStatsInit(&stats) );
+    ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, NULL, NULL, &params, &stats, DBL_MAX) );
+    ASSERT_TRUE( isTU );
+    ASSERT_EQ( stats.screeningCount, 1UL );
+    ASSERT_EQ( stats.screeningSuccess, 0UL );
+
+    ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  }
+
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
+TEST(TU, Schedule)
+{
+  CMR* cmr = NULL;
+  ASSERT_CMR_CALL( CMRcreateEnvironment(&cmr) );
+
+  /* 1-sum of a larger interval matrix, which is totally unimodular, and a small irregular block. */
+  CMR_CHRMAT* matrix = NULL;
+  ASSERT_CMR_CALL( stringToCharMatrix(cmr, &matrix, "11 11 "
+    "1 1 1 0 0 0 0 0  0 0 0 "
+    "0 1 1 1 1 0 0 0  0 0 0 "
+    "0 0 0 1 1 1 0 0  0 0 0 "
+    "0 0 1 1 1 1 1 1  0 0 0 "
+    "1 1 1 1 1 1 1 0  0 0 0 "
+    "0 0 0 0 1 1 1 1  0 0 0 "
+    "0 1 1 1 0 0 0 0  0 0 0 "
+    "0 0 0 0 0 1 1 0  0 0 0 "
+    "0 0 0 0 0 0 0 0  1 1 0 "
+    "0 0 0 0 0 0 0 0  0 1 1 "
+    "0 0 0 0 0 0 0 0  1 0 1 "
+  ) );
+
+  CMR_SEYMOUR_SCHEDULE schedules[] = { CMR_SEYMOUR_SCHEDULE_LIFO, CMR_SEYMOUR_SCHEDULE_FIFO,
+    CMR_SEYMOUR_SCHEDULE_SMALLEST, CMR_SEYMOUR_SCHEDULE_IRREGULAR };
+  for (int s = 0; s < 4; ++s)
+  {
+    bool isTU;
+    CMR_SEYMOUR_NODE* dec = NULL;
+    CMR_TU_PARAMS params;
+    ASSERT_CMR_CALL( CMRtuParamsInit(&params) );
+    params.seymour.stopWhenIrregular = true;
+    params.seymour.schedule = schedules[s];
+
+    ASSERT_CMR_CALL( CMRtuTest(cmr, matrix, &isTU, &dec, NULL, &params, NULL, DBL_MAX) );
+    ASSERT_FALSE( isTU );
+    ASSERT_EQ( CMRseymourRegularity(dec), -1 );
+    ASSERT_EQ( CMRseymourType(dec), CMR_SEYMOUR_NODE_TYPE_ONESUM );
+    ASSERT_EQ( CMRseymourNumChildren(dec), 2UL );
+
+    CMR_SEYMOUR_NODE* small = CMRseymourChild(dec, 0);
+    CMR_SEYMOUR_NODE* large = CMRseymourChild(dec, 1);
+    if (CMRseymourNumRows(small) > CMRseymourNumRows(large))
+    {
+      CMR_SEYMOUR_NODE* swap = small;
+      small = large;
+      large = swap;
+    }
+    ASSERT_LT( CMRseymourRegularity(small), 0 );
+
+    /* With the default order, the large block is processed first. Otherwise, it is left untouched. */
+    if (schedules[s] == CMR_SEYMOUR_SCHEDULE_LIFO)
+    {
+      ASSERT_GT( CMRseymourRegularity(large), 0 );
+    }
+    if (schedules[s] == CMR_SEYMOUR_SCHEDULE_SMALLEST || schedules[s] == CMR_SEYMOUR_SCHEDULE_IRREGULAR)
+    {
+      ASSERT_EQ( CMRseymourType(large), CMR_SEYMOUR_NODE_TYPE_UNKNOWN );
+      ASSERT_EQ( CMRseymourRegularity(large), 0 );
+    }
+
+    ASSERT_CMR_CALL( CMRseymourRelease(cmr, &dec) );
+  }
+
+  ASSERT_CMR_CALL( CMRchrmatFree(cmr, &matrix) );
+  ASSERT_CMR_CALL( CMRfreeEnvironment(&cmr) );
+}
+
 TEST(TU, YsumForbiddenSubmatrix)
 {
   CMR* cmr = NULL;